@@ -634,6 +634,73 @@ dnnl_status_t DNNL_API dnnl_post_ops_append_prelu(
 dnnl_status_t DNNL_API dnnl_post_ops_get_params_prelu(
         const_dnnl_post_ops_t post_ops, int index, int *mask);
 
+/// Sets the softmax pre-ops: the operations applied to the source of a
+/// softmax forward primitive before the softmax itself.
+///
+/// The source is multiplied by @p scale, then the mask is added to it:
+///
+///     src'(x) = scale * src(x) + mask(x)
+///
+/// A buffer mask is passed at execution time as #DNNL_ARG_ATTR_SOFTMAX_MASK
+/// and must have the number of dimensions of the source, each of its
+/// dimensions being equal either to the source one or to 1. A causal mask is
+/// generated by the primitive from the positions of the elements in the last
+/// two dimensions, the softmax axis being the last one, and adds -infinity to
+/// the masked elements. The softmax of a row with all the elements masked is
+/// zero.
+///
+/// @param attr Primitive attributes.
+/// @param scale Scale of the source.
+/// @param mask_kind Kind of the mask.
+/// @param mask_desc Memory descriptor of the buffer mask. Must be NULL or a
+///     zero memory descriptor unless @p mask_kind is
+///     #dnnl_softmax_mask_buffer.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_softmax_pre_ops(
+        dnnl_primitive_attr_t attr, float scale,
+        dnnl_softmax_mask_kind_t mask_kind, const_dnnl_memory_desc_t mask_desc);
+
+/// Returns the softmax pre-ops.
+///
+/// @param attr Primitive attributes.
+/// @param scale Output scale of the source.
+/// @param mask_kind Output kind of the mask.
+/// @param mask_desc Output memory descriptor of the buffer mask. A zero
+///     memory descriptor is returned when the mask is not a buffer.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_softmax_pre_ops(
+        const_dnnl_primitive_attr_t attr, float *scale,
+        dnnl_softmax_mask_kind_t *mask_kind,
+        const_dnnl_memory_desc_t *mask_desc);
+
+/// Sets the dynamic quantization parameters of the source tensor.
+///
+/// A primitive with dynamic quantization of the source takes a floating-point
+/// source and quantizes it to int8 at execution time: each group of
+/// @p group_size consecutive elements along the reduction dimension gets its
+/// own scale, computed from the maximum absolute value of the group. The
+/// computation then runs on int8 data and the scales are applied to the
+/// result.
+///
+/// @param attr Primitive attributes.
+/// @param group_size Number of source elements sharing a scale. A value of 0
+///     disables dynamic quantization.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_src_dyn_quant_params(
+        dnnl_primitive_attr_t attr, uint64_t group_size);
+
+/// Returns the dynamic quantization parameters of the source tensor.
+///
+/// @param attr Primitive attributes.
+/// @param group_size Output number of source elements sharing a scale.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_src_dyn_quant_params(
+        const_dnnl_primitive_attr_t attr, uint64_t *group_size);
+
 /// @} dnnl_api_attributes
 
 /// @} dnnl_api_primitives
@@ -1216,6 +1283,27 @@ dnnl_status_t DNNL_API dnnl_reorder_primitive_desc_create(
         const_dnnl_memory_desc_t dst_desc, dnnl_engine_t dst_engine,
         const_dnnl_primitive_attr_t attr);
 
+/// Executes a batch of reorders, each from a source memory object to the
+/// destination memory object with the same index.
+///
+/// Reorders between memory objects with identical memory descriptors share a
+/// single primitive, so kernels are generated once per distinct reorder. On
+/// CPU all the copies are scheduled in a single parallel region balanced by
+/// the amount of data each of them moves. On an out-of-order CPU stream the
+/// batch is executed synchronously once the primitives submitted earlier
+/// have completed.
+///
+/// @param stream Stream to execute the reorders on. Its engine must be the
+///     engine each of the reorders would be created on.
+/// @param n Number of reorders.
+/// @param src_memories Array of @p n source memory objects.
+/// @param dst_memories Array of @p n destination memory objects.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_reorder_execute_batch(dnnl_stream_t stream, int n,
+        const_dnnl_memory_t const *src_memories,
+        dnnl_memory_t const *dst_memories);
+
 /// @} dnnl_api_reorder
 
 /// @addtogroup dnnl_api_concat
@@ -3182,6 +3270,72 @@ dnnl_status_t DNNL_API dnnl_reduction_primitive_desc_create(
 
 /// @} dnnl_api_reduction
 
+/// @addtogroup dnnl_api_topk Top-k
+/// @{
+
+/// Creates a primitive descriptor for a top-k primitive.
+///
+/// The number k of the selected elements is the size of the @p axis
+/// dimension of the destination.
+///
+/// @note
+///     Destination and indices memory descriptors are allowed to be
+///     initialized with #dnnl_format_tag_any or with format_kind set to
+///     #dnnl_format_kind_any.
+///
+/// @param primitive_desc Output primitive descriptor.
+/// @param engine Engine to use.
+/// @param src_desc Source memory descriptor.
+/// @param dst_desc Destination memory descriptor for the selected values.
+/// @param indices_desc Destination memory descriptor for the indices of the
+///     selected values.
+/// @param axis The axis along which the elements are selected.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_topk_primitive_desc_create(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        const_dnnl_memory_desc_t src_desc, const_dnnl_memory_desc_t dst_desc,
+        const_dnnl_memory_desc_t indices_desc, int axis,
+        const_dnnl_primitive_attr_t attr);
+
+/// @} dnnl_api_topk
+
+/// @addtogroup dnnl_api_embedding_bag Embedding bag
+/// @{
+
+/// Creates a primitive descriptor for an embedding bag primitive.
+///
+/// The source table rows selected by the indices are pooled into bags. The
+/// bag b takes the indices from offsets[b] up to offsets[b + 1], the last bag
+/// taking the indices up to the end. Without offsets, each index makes a bag
+/// of its own, so the primitive gathers the table rows.
+///
+/// @note
+///     Destination memory descriptor is allowed to be initialized with
+///     #dnnl_format_tag_any or with format_kind set to #dnnl_format_kind_any.
+///
+/// @param primitive_desc Output primitive descriptor.
+/// @param engine Engine to use.
+/// @param alg_kind Pooling algorithm kind: either #dnnl_reduction_sum or
+///     #dnnl_reduction_mean.
+/// @param src_desc Source memory descriptor of the table.
+/// @param indices_desc Memory descriptor of the indices of the table rows.
+/// @param offsets_desc Memory descriptor of the offsets of the bags in the
+///     indices (can be NULL or a zero memory descriptor).
+/// @param dst_desc Destination memory descriptor.
+/// @param attr Primitive attributes (can be NULL).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_embedding_bag_primitive_desc_create(
+        dnnl_primitive_desc_t *primitive_desc, dnnl_engine_t engine,
+        dnnl_alg_kind_t alg_kind, const_dnnl_memory_desc_t src_desc,
+        const_dnnl_memory_desc_t indices_desc,
+        const_dnnl_memory_desc_t offsets_desc,
+        const_dnnl_memory_desc_t dst_desc, const_dnnl_primitive_attr_t attr);
+
+/// @} dnnl_api_embedding_bag
+
 /// @} dnnl_api_primitives
 
 /// @addtogroup dnnl_api_primitive_cache
@@ -3210,6 +3364,42 @@ dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity(int *capacity);
 ///     success.
 dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity(int capacity);
 
+/// Returns the amount of memory in bytes that the primitives held in the
+/// primitive cache may take at the same time.
+///
+/// @param capacity Primitive cache memory capacity to query. The value of 0
+///     means that the cache is limited by the number of primitives only.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p capacity value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_memory_capacity(
+        size_t *capacity);
+
+/// Sets the amount of memory in bytes that the primitives held in the
+/// primitive cache may take at the same time.
+///
+/// The memory charged to a primitive includes the code generated for it.
+/// The limit applies in addition to the number of primitives limit set by
+/// dnnl_set_primitive_cache_capacity(). If the memory charged to the cached
+/// primitives exceeds the new @p capacity then the least recently used
+/// primitives will be evicted. Concurrently modifying @p capacity is safe.
+///
+/// @param capacity Primitive cache memory capacity to set. The value of 0
+///     (default) removes the limit.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_primitive_cache_memory_capacity(
+        size_t capacity);
+
+/// Returns primitive cache statistics.
+///
+/// @param stats Output primitive cache statistics. Concurrently accessing
+///     the statistics is safe.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p stats value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_stats(
+        dnnl_primitive_cache_stats_t *stats);
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_service
@@ -3352,6 +3542,32 @@ dnnl_status_t DNNL_API dnnl_set_cpu_isa_hints(dnnl_cpu_isa_hints_t isa_hints);
 /// library can follow.
 dnnl_cpu_isa_hints_t DNNL_API dnnl_get_cpu_isa_hints(void);
 
+/// Sets the allocator used for all host memory the library allocates
+/// internally: CPU memory objects and scratchpads, weights and other buffers
+/// cached by primitives and graph partitions, and internal objects.
+///
+/// The allocator may be changed at any time: every buffer is released with
+/// the allocator it was allocated by, so the deallocation call-back must stay
+/// valid until all the memory allocated by the allocation call-back is
+/// released. The function should still be invoked before any other oneDNN
+/// API call for all the library memory to come from the user allocator.
+///
+/// @note
+///     This setting overrides the ONEDNN_HOST_ALLOCATOR environment variable
+///     that selects the built-in caching allocator.
+///
+/// @sa @ref dev_guide_host_allocator for more details
+///
+/// @param allocate Allocation call-back. It must return memory aligned to
+///     the requested alignment, or NULL if allocation fails.
+/// @param deallocate Deallocation call-back.
+///     Passing NULL for both call-backs reverts to the default allocator.
+/// @returns #dnnl_success/#dnnl::status::success on success and a
+///     #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if only one
+///     of the call-backs is NULL.
+dnnl_status_t DNNL_API dnnl_set_host_allocator(
+        dnnl_host_allocate_f allocate, dnnl_host_deallocate_f deallocate);
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_blas
@@ -146,6 +146,10 @@ struct primitive : public handle<dnnl_primitive_t> {
         softmax = dnnl_softmax,
         /// A layer normalization primitive.
         layer_normalization = dnnl_layer_normalization,
+        /// A top-k primitive.
+        topk = dnnl_topk,
+        /// An embedding bag primitive.
+        embedding_bag = dnnl_embedding_bag,
     };
 
     using handle::handle;
@@ -298,6 +302,30 @@ inline dnnl_scratchpad_mode_t convert_to_c(scratchpad_mode mode) {
     return static_cast<dnnl_scratchpad_mode_t>(mode);
 }
 
+/// Kinds of the additive mask applied by the softmax pre-ops.
+enum class softmax_mask_kind {
+    /// No mask.
+    none = dnnl_softmax_mask_none,
+    /// The mask is a tensor passed at execution as
+    /// #DNNL_ARG_ATTR_SOFTMAX_MASK and broadcast to the source tensor.
+    buffer = dnnl_softmax_mask_buffer,
+    /// Causal mask aligned to the top left corner of the last two
+    /// dimensions: the element (i, j) is masked when j > i.
+    causal_top_left = dnnl_softmax_mask_causal_top_left,
+    /// Causal mask aligned to the bottom right corner of the last two
+    /// dimensions: the element (i, j) of an (M, N) matrix is masked when
+    /// j > i + N - M.
+    causal_bottom_right = dnnl_softmax_mask_causal_bottom_right,
+};
+
+/// Converts a softmax mask kind enum value from C++ API to C API type.
+///
+/// @param mask_kind C++ API softmax mask kind enum value.
+/// @returns Corresponding C API softmax mask kind enum value.
+inline dnnl_softmax_mask_kind_t convert_to_c(softmax_mask_kind mask_kind) {
+    return static_cast<dnnl_softmax_mask_kind_t>(mask_kind);
+}
+
 /// Propagation kind.
 enum class prop_kind {
     /// Undefined propagation kind.
@@ -3771,6 +3799,74 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
                 "could not set post-ops primitive attribute");
     }
 
+    /// Sets the softmax pre-ops: the source of a softmax forward primitive is
+    /// multiplied by @p scale and the mask is added to it before the softmax.
+    ///
+    /// A buffer mask is passed at execution time as
+    /// #DNNL_ARG_ATTR_SOFTMAX_MASK and must have the number of dimensions of
+    /// the source, each of its dimensions being equal either to the source
+    /// one or to 1. A causal mask is generated from the positions of the
+    /// elements in the last two dimensions, the softmax axis being the last
+    /// one.
+    ///
+    /// @param scale Scale of the source.
+    /// @param mask_kind Kind of the mask.
+    /// @param mask_desc Memory descriptor of the buffer mask. Must be empty
+    ///     unless @p mask_kind is #dnnl::softmax_mask_kind::buffer.
+    void set_softmax_pre_ops(float scale,
+            softmax_mask_kind mask_kind = softmax_mask_kind::none,
+            const memory::desc &mask_desc = memory::desc()) {
+        error::wrap_c_api(
+                dnnl_primitive_attr_set_softmax_pre_ops(get(), scale,
+                        convert_to_c(mask_kind), mask_desc.get()),
+                "could not set softmax pre-ops primitive attribute");
+    }
+
+    /// Returns the softmax pre-ops.
+    ///
+    /// @param scale Output scale of the source.
+    /// @param mask_kind Output kind of the mask.
+    /// @param mask_desc Output memory descriptor of the buffer mask.
+    void get_softmax_pre_ops(float &scale, softmax_mask_kind &mask_kind,
+            memory::desc &mask_desc) const {
+        dnnl_softmax_mask_kind_t c_mask_kind;
+        const_dnnl_memory_desc_t cdesc;
+        error::wrap_c_api(dnnl_primitive_attr_get_softmax_pre_ops(
+                                  get(), &scale, &c_mask_kind, &cdesc),
+                "could not get softmax pre-ops primitive attribute");
+        mask_kind = static_cast<softmax_mask_kind>(c_mask_kind);
+        dnnl_memory_desc_t cloned_md = nullptr;
+        error::wrap_c_api(dnnl_memory_desc_clone(&cloned_md, cdesc),
+                "could not clone a memory descriptor");
+        mask_desc = memory::desc(cloned_md);
+    }
+
+    /// Sets the dynamic quantization parameters of the source tensor: the
+    /// floating-point source is quantized to int8 at execution time with a
+    /// scale per group of @p group_size elements along the reduction
+    /// dimension.
+    ///
+    /// @param group_size Number of source elements sharing a scale. A value
+    ///     of 0 disables dynamic quantization.
+    void set_src_dyn_quant_params(uint64_t group_size) {
+        error::wrap_c_api(dnnl_primitive_attr_set_src_dyn_quant_params(
+                                  get(), group_size),
+                "could not set src dynamic quantization parameters "
+                "primitive attribute");
+    }
+
+    /// Returns the dynamic quantization parameters of the source tensor.
+    ///
+    /// @returns Number of source elements sharing a scale.
+    uint64_t get_src_dyn_quant_params() const {
+        uint64_t group_size = 0;
+        error::wrap_c_api(dnnl_primitive_attr_get_src_dyn_quant_params(
+                                  get(), &group_size),
+                "could not get src dynamic quantization parameters "
+                "primitive attribute");
+        return group_size;
+    }
+
     /// Sets quantization scale and shift parameters for RNN data tensors.
     ///
     /// For performance reasons, the low-precision configuration of the RNN
@@ -4701,6 +4797,37 @@ struct reorder : public primitive {
     void execute(const stream &astream, memory &src, memory &dst) const {
         primitive::execute(astream, {{DNNL_ARG_FROM, src}, {DNNL_ARG_TO, dst}});
     }
+
+    /// Reorders data from each of the @p src memory objects to the
+    /// destination memory object with the same index in @p dst.
+    ///
+    /// Reorders with identical memory descriptors share a single primitive,
+    /// and on CPU all the copies are scheduled together, which is cheaper
+    /// than creating and executing a reorder per pair, e.g. when loading
+    /// model weights.
+    ///
+    /// @param astream Stream object.
+    /// @param src Source memory objects.
+    /// @param dst Destination memory objects, one per source memory object.
+    static void execute_batch(const stream &astream,
+            const std::vector<memory> &src, const std::vector<memory> &dst) {
+        validate_container_size(
+                dst, "counts of source and destination memory objects differ",
+                (int)src.size(), (int)src.size());
+
+        std::vector<const_dnnl_memory_t> c_src;
+        std::vector<dnnl_memory_t> c_dst;
+        c_src.reserve(src.size());
+        c_dst.reserve(dst.size());
+        for (size_t i = 0; i < src.size(); i++) {
+            c_src.push_back(src[i].get());
+            c_dst.push_back(dst[i].get());
+        }
+        error::wrap_c_api(dnnl_reorder_execute_batch(astream.get(),
+                                  (int)c_src.size(), c_src.data(),
+                                  c_dst.data()),
+                "could not execute a batch of reorders");
+    }
 };
 
 /// @} dnnl_api_reorder
@@ -12363,6 +12490,15 @@ struct pooling_backward : public primitive {
             : dnnl::primitive_desc(pd, dnnl::primitive::kind::pooling,
                     dnnl::prop_kind::backward_data) {}
 
+        /// Returns a source memory descriptor.
+        ///
+        /// The source is only required for #dnnl::algorithm::pooling_max
+        /// when the hint forward primitive descriptor has no workspace. In
+        /// this case the backward recomputes the max indices from the source
+        /// tensor. Otherwise, a zero memory descriptor is returned.
+        /// @returns Source memory descriptor.
+        memory::desc src_desc() const { return base::src_desc(0); }
+
         /// @copydoc dnnl::primitive_desc_base::src_desc()const
         memory::desc diff_src_desc() const { return base::diff_src_desc(0); }
 
@@ -12690,6 +12826,239 @@ struct reduction : public primitive {
 
 /// @} dnnl_api_reduction
 
+/// @addtogroup dnnl_api_topk Top-k
+///
+/// A primitive to select the k largest elements of a tensor along an axis
+/// together with their indices.
+///
+/// @sa @ref dev_guide_topk in developer guide
+///
+/// @{
+
+/// Top-k.
+struct topk : public primitive {
+    /// Primitive descriptor for a top-k primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for a top-k primitive.
+        ///
+        /// The number k of the selected elements is the size of the @p axis
+        /// dimension of the destination.
+        ///
+        /// @note
+        ///     Destination and indices memory descriptors may be initialized
+        ///     with #dnnl::memory::format_tag::any value of @p format_tag.
+        ///
+        /// @param aengine Engine to use.
+        /// @param src_desc Source memory descriptor.
+        /// @param dst_desc Destination memory descriptor for the selected
+        ///     values.
+        /// @param indices_desc Destination memory descriptor for the indices
+        ///     of the selected values.
+        /// @param axis The axis along which the elements are selected.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, const memory::desc &src_desc,
+                const memory::desc &dst_desc, const memory::desc &indices_desc,
+                int axis, const primitive_attr &attr = default_attr(),
+                bool allow_empty = false) {
+
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status = dnnl_topk_primitive_desc_create(&pd,
+                    aengine.get(), src_desc.get(), dst_desc.get(),
+                    indices_desc.get(), axis, attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for a top-k "
+                        "primitive");
+            reset(pd);
+        }
+
+        /// Constructs a primitive descriptor for a top-k primitive from a C
+        /// API primitive descriptor that must have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for a top-k primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd, dnnl::primitive::kind::topk) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// Returns a memory descriptor for the indices of the selected
+        /// values.
+        /// @returns Indices memory descriptor.
+        memory::desc indices_desc() const { return base::dst_desc(1); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_axis()const
+        int get_axis() const { return base::get_axis(); }
+    };
+
+    /// Default constructor. Produces an empty object.
+    topk() = default;
+
+    /// Constructs a top-k primitive.
+    /// @param pd Primitive descriptor for a top-k primitive.
+    topk(const primitive_desc &pd) : primitive(pd) {}
+
+    /// Constructs a top-k primitive from a cache blob.
+    /// @param pd Primitive descriptor for a top-k primitive.
+    /// @param cache_blob Cache blob.
+    topk(const primitive_desc &pd, const std::vector<uint8_t> &cache_blob)
+        : primitive(pd, cache_blob) {}
+};
+
+/// @} dnnl_api_topk
+
+/// @addtogroup dnnl_api_embedding_bag Embedding bag
+///
+/// A primitive to pool the rows of a table selected by indices into bags.
+///
+/// @sa @ref dev_guide_embedding_bag in developer guide
+///
+/// @{
+
+/// Embedding bag.
+struct embedding_bag : public primitive {
+    /// Primitive descriptor for an embedding bag primitive.
+    struct primitive_desc : public dnnl::primitive_desc {
+        /// Default constructor. Produces an empty object.
+        primitive_desc() = default;
+
+        /// Constructs a primitive descriptor for an embedding bag primitive.
+        ///
+        /// The bag b takes the indices from offsets[b] up to offsets[b + 1],
+        /// the last bag taking the indices up to the end.
+        ///
+        /// @note
+        ///     Destination memory descriptor may be initialized with
+        ///     #dnnl::memory::format_tag::any value of @p format_tag.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aalgorithm Pooling algorithm kind: either
+        ///     #dnnl::algorithm::reduction_sum or
+        ///     #dnnl::algorithm::reduction_mean.
+        /// @param src_desc Source memory descriptor of the table.
+        /// @param indices_desc Memory descriptor of the indices of the table
+        ///     rows.
+        /// @param offsets_desc Memory descriptor of the offsets of the bags
+        ///     in the indices.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, algorithm aalgorithm,
+                const memory::desc &src_desc, const memory::desc &indices_desc,
+                const memory::desc &offsets_desc, const memory::desc &dst_desc,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false)
+            : primitive_desc(aengine, aalgorithm, src_desc, indices_desc,
+                    &offsets_desc, dst_desc, attr, allow_empty) {}
+
+        /// Constructs a primitive descriptor for an embedding bag primitive
+        /// without offsets, where each index makes a bag of its own.
+        ///
+        /// @note
+        ///     Destination memory descriptor may be initialized with
+        ///     #dnnl::memory::format_tag::any value of @p format_tag.
+        ///
+        /// @param aengine Engine to use.
+        /// @param aalgorithm Pooling algorithm kind: either
+        ///     #dnnl::algorithm::reduction_sum or
+        ///     #dnnl::algorithm::reduction_mean.
+        /// @param src_desc Source memory descriptor of the table.
+        /// @param indices_desc Memory descriptor of the indices of the table
+        ///     rows.
+        /// @param dst_desc Destination memory descriptor.
+        /// @param attr Primitive attributes to use. Attributes are optional
+        ///     and default to empty attributes.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const engine &aengine, algorithm aalgorithm,
+                const memory::desc &src_desc, const memory::desc &indices_desc,
+                const memory::desc &dst_desc,
+                const primitive_attr &attr = default_attr(),
+                bool allow_empty = false)
+            : primitive_desc(aengine, aalgorithm, src_desc, indices_desc,
+                    nullptr, dst_desc, attr, allow_empty) {}
+
+        /// Constructs a primitive descriptor for an embedding bag primitive
+        /// from a C API primitive descriptor that must have a matching kind.
+        ///
+        /// @param pd C API primitive descriptor for an embedding bag
+        ///     primitive.
+        primitive_desc(dnnl_primitive_desc_t pd)
+            : dnnl::primitive_desc(pd, dnnl::primitive::kind::embedding_bag) {}
+
+        /// @copydoc dnnl::primitive_desc_base::src_desc()const
+        memory::desc src_desc() const { return base::src_desc(0); }
+
+        /// Returns a memory descriptor for the indices of the table rows.
+        /// @returns Indices memory descriptor.
+        memory::desc indices_desc() const { return base::src_desc(1); }
+
+        /// Returns a memory descriptor for the offsets of the bags.
+        /// @returns Offsets memory descriptor, or a zero memory descriptor if
+        ///     the primitive has no offsets.
+        memory::desc offsets_desc() const { return base::src_desc(2); }
+
+        /// @copydoc dnnl::primitive_desc_base::dst_desc()const
+        memory::desc dst_desc() const { return base::dst_desc(0); }
+
+        /// @copydoc dnnl::primitive_desc_base::get_algorithm()const
+        algorithm get_algorithm() const { return base::get_algorithm(); }
+
+    private:
+        primitive_desc(const engine &aengine, algorithm aalgorithm,
+                const memory::desc &src_desc, const memory::desc &indices_desc,
+                const memory::desc *offsets_desc, const memory::desc &dst_desc,
+                const primitive_attr &attr, bool allow_empty) {
+
+            dnnl_primitive_desc_t pd = nullptr;
+            dnnl_status_t status = dnnl_embedding_bag_primitive_desc_create(
+                    &pd, aengine.get(), dnnl::convert_to_c(aalgorithm),
+                    src_desc.get(), indices_desc.get(),
+                    optional_arg(offsets_desc), dst_desc.get(), attr.get());
+
+            if (!allow_empty)
+                error::wrap_c_api(status,
+                        "could not create a primitive descriptor for an "
+                        "embedding bag primitive");
+            reset(pd);
+        }
+    };
+
+    /// Default constructor. Produces an empty object.
+    embedding_bag() = default;
+
+    /// Constructs an embedding bag primitive.
+    /// @param pd Primitive descriptor for an embedding bag primitive.
+    embedding_bag(const primitive_desc &pd) : primitive(pd) {}
+
+    /// Constructs an embedding bag primitive from a cache blob.
+    /// @param pd Primitive descriptor for an embedding bag primitive.
+    /// @param cache_blob Cache blob.
+    embedding_bag(
+            const primitive_desc &pd, const std::vector<uint8_t> &cache_blob)
+        : primitive(pd, cache_blob) {}
+};
+
+/// @} dnnl_api_embedding_bag
+
 /// @} dnnl_api_primitives
 
 /// @addtogroup dnnl_api_service Service
@@ -12819,6 +13188,12 @@ inline cpu_isa_hints get_cpu_isa_hints() {
     return static_cast<cpu_isa_hints>(dnnl_get_cpu_isa_hints());
 }
 
+/// @copydoc dnnl_set_host_allocator()
+inline status set_host_allocator(
+        dnnl_host_allocate_f allocate, dnnl_host_deallocate_f deallocate) {
+    return static_cast<status>(dnnl_set_host_allocator(allocate, deallocate));
+}
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_primitive_cache Primitive Cache
@@ -12842,6 +13217,31 @@ inline void set_primitive_cache_capacity(int capacity) {
             "could not set primitive cache capacity");
 }
 
+/// @copydoc dnnl_get_primitive_cache_memory_capacity(size_t *capacity)
+inline size_t get_primitive_cache_memory_capacity() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_memory_capacity(&result),
+            "could not get primitive cache memory capacity");
+    return result;
+}
+
+/// @copydoc dnnl_set_primitive_cache_memory_capacity(size_t capacity)
+inline void set_primitive_cache_memory_capacity(size_t capacity) {
+    error::wrap_c_api(dnnl_set_primitive_cache_memory_capacity(capacity),
+            "could not set primitive cache memory capacity");
+}
+
+/// @copydoc dnnl_primitive_cache_stats_t
+using primitive_cache_stats_t = dnnl_primitive_cache_stats_t;
+
+/// Returns primitive cache statistics.
+inline primitive_cache_stats_t get_primitive_cache_stats() {
+    primitive_cache_stats_t result {};
+    error::wrap_c_api(dnnl_get_primitive_cache_stats(&result),
+            "could not get primitive cache statistics");
+    return result;
+}
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_blas BLAS functions
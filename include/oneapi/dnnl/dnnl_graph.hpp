@@ -736,6 +736,7 @@ public:
         DynamicQuantize = dnnl_graph_op_dynamic_quantize,
         Elu = dnnl_graph_op_elu,
         EluBackward = dnnl_graph_op_elu_backward,
+        EmbeddingBag = dnnl_graph_op_embedding_bag,
         End = dnnl_graph_op_end,
         Exp = dnnl_graph_op_exp,
         GELU = dnnl_graph_op_gelu,
@@ -775,6 +776,7 @@ public:
         ReLU = dnnl_graph_op_relu,
         ReLUBackward = dnnl_graph_op_relu_backward,
         Reorder = dnnl_graph_op_reorder,
+        RotaryEmbedding = dnnl_graph_op_rotary_embedding,
         Round = dnnl_graph_op_round,
         Select = dnnl_graph_op_select,
         Sigmoid = dnnl_graph_op_sigmoid,
@@ -792,6 +794,7 @@ public:
         Subtract = dnnl_graph_op_subtract,
         Tanh = dnnl_graph_op_tanh,
         TanhBackward = dnnl_graph_op_tanh_backward,
+        TopK = dnnl_graph_op_topk,
         TypeCast = dnnl_graph_op_type_cast,
         Wildcard = dnnl_graph_op_wildcard,
         // Sentinel
@@ -838,6 +841,8 @@ public:
         begin_norm_axis = dnnl_graph_op_attr_begin_norm_axis,
         /// Specifies a groups attribute to an op.
         groups = dnnl_graph_op_attr_groups,
+        /// Specifies a k attribute to an op.
+        k = dnnl_graph_op_attr_k,
 
         // int64_t vector attributes. The value of these attributes can be a
         // vector of int64 numbers.
@@ -909,8 +914,8 @@ public:
         /// Specifies a data_format of an op. The value can be "NCX" or "NXC".
         data_format = dnnl_graph_op_attr_data_format,
         /// Specifies a mode attribute of an op. The value can be "nearest",
-        /// "linear", "bilinear", or "trilinear". The attribute is defined for
-        /// Interpolate operations.
+        /// "linear", "bilinear", or "trilinear" for Interpolate operations, and
+        /// "half" or "interleaved" for RotaryEmbedding operations.
         mode = dnnl_graph_op_attr_mode,
         /// Specifies a qtype attribute to an op. The value can be "per_channel"
         /// or "per_tensor". The attribute is defined for quantization
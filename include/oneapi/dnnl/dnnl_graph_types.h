@@ -252,6 +252,9 @@ typedef enum {
     dnnl_graph_op_hard_sigmoid_backward,
     dnnl_graph_op_select,
     dnnl_graph_op_pow,
+    dnnl_graph_op_rotary_embedding,
+    dnnl_graph_op_topk,
+    dnnl_graph_op_embedding_bag,
     dnnl_graph_op_last_symbol,
 } dnnl_graph_op_kind_t;
 
@@ -291,6 +294,8 @@ typedef enum {
     dnnl_graph_op_attr_begin_norm_axis,
     /// Specifies a groups attribute to an op.
     dnnl_graph_op_attr_groups,
+    /// Specifies a k attribute to an op.
+    dnnl_graph_op_attr_k,
 
     // int64_t vector attributes. The value of these attributes can be a vector
     // of int64 numbers.
@@ -361,8 +366,8 @@ typedef enum {
     /// Specifies a data_format of an op. The value can be "NCX" or "NXC".
     dnnl_graph_op_attr_data_format,
     /// Specifies a mode attribute of an op. The value can be "nearest",
-    /// "linear", "bilinear", or "trilinear". The attribute is defined for
-    /// Interpolate operations.
+    /// "linear", "bilinear", or "trilinear" for Interpolate operations, and
+    /// "half" or "interleaved" for RotaryEmbedding operations.
     dnnl_graph_op_attr_mode,
     /// Specifies a qtype attribute to an op. The value can be "per_channel" or
     /// "per_tensor". The attribute is defined for quantization operations.
@@ -1858,6 +1858,10 @@ typedef enum {
     dnnl_softmax,
     /// A layer normalization primitive.
     dnnl_layer_normalization,
+    /// A top-k primitive.
+    dnnl_topk,
+    /// An embedding bag primitive.
+    dnnl_embedding_bag,
 
     /// Parameter to allow internal only primitives without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -2232,6 +2236,22 @@ typedef enum {
     dnnl_scratchpad_mode_user,
 } dnnl_scratchpad_mode_t;
 
+/// Kinds of the additive mask applied by the softmax pre-ops.
+typedef enum {
+    /// No mask.
+    dnnl_softmax_mask_none = 0,
+    /// The mask is a tensor passed at execution as
+    /// #DNNL_ARG_ATTR_SOFTMAX_MASK and broadcast to the source tensor.
+    dnnl_softmax_mask_buffer,
+    /// Causal mask aligned to the top left corner of the last two
+    /// dimensions: the element (i, j) is masked when j > i.
+    dnnl_softmax_mask_causal_top_left,
+    /// Causal mask aligned to the bottom right corner of the last two
+    /// dimensions: the element (i, j) of an (M, N) matrix is masked when
+    /// j > i + N - M.
+    dnnl_softmax_mask_causal_bottom_right,
+} dnnl_softmax_mask_kind_t;
+
 /// @struct dnnl_primitive_attr
 /// @brief An opaque structure for primitive descriptor attributes.
 ///
@@ -2470,6 +2490,9 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// Output scaling factors provided at execution time.
 #define DNNL_ARG_ATTR_OUTPUT_SCALES 513
 
+/// Additive mask of the softmax pre-ops provided at execution time.
+#define DNNL_ARG_ATTR_SOFTMAX_MASK 514
+
 /// Starting index for source arguments for primitives that take a variable
 /// number of source arguments.
 #define DNNL_ARG_MULTIPLE_SRC 1024
@@ -2721,8 +2744,40 @@ typedef enum {
     dnnl_cpu_isa_prefer_ymm = 0x1,
 } dnnl_cpu_isa_hints_t;
 
+/// Host memory allocation call-back function interface. See
+/// dnnl_set_host_allocator().
+typedef void *(*dnnl_host_allocate_f)(size_t size, size_t alignment);
+
+/// Host memory deallocation call-back function interface. See
+/// dnnl_set_host_allocator().
+typedef void (*dnnl_host_deallocate_f)(void *ptr);
+
 /// @} dnnl_api_service
 
+/// @addtogroup dnnl_api_primitive_cache
+/// @{
+
+/// Primitive cache statistics. The counters are accumulated since the library
+/// was loaded.
+typedef struct {
+    /// Number of primitive creations served from the cache.
+    size_t hits;
+    /// Number of primitive creations that missed the cache.
+    size_t misses;
+    /// Number of primitives evicted from the cache, including the ones
+    /// dropped when the cache is cleared.
+    size_t evictions;
+    /// Number of primitives currently held in the cache.
+    size_t size;
+    /// Memory in bytes charged to the primitives currently held in the cache.
+    size_t memory_size;
+    /// Total time in milliseconds that the cache hits saved on primitive
+    /// creation, estimated from the creation time of the cached primitives.
+    double creation_time_saved_ms;
+} dnnl_primitive_cache_stats_t;
+
+/// @} dnnl_api_primitive_cache
+
 /// @} dnnl_api
 
 #ifdef __cplusplus
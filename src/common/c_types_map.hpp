@@ -174,6 +174,15 @@ const scratchpad_mode_t library = dnnl_scratchpad_mode_library;
 const scratchpad_mode_t user = dnnl_scratchpad_mode_user;
 } // namespace scratchpad_mode
 
+using softmax_mask_kind_t = dnnl_softmax_mask_kind_t;
+namespace softmax_mask_kind {
+const softmax_mask_kind_t none = dnnl_softmax_mask_none;
+const softmax_mask_kind_t buffer = dnnl_softmax_mask_buffer;
+const softmax_mask_kind_t causal_top_left = dnnl_softmax_mask_causal_top_left;
+const softmax_mask_kind_t causal_bottom_right
+        = dnnl_softmax_mask_causal_bottom_right;
+} // namespace softmax_mask_kind
+
 #ifdef DNNL_EXPERIMENTAL_SPARSE
 using sparse_encoding_t = dnnl_sparse_encoding_t;
 namespace sparse_encoding {
@@ -1761,6 +1770,8 @@ const primitive_kind_t resampling = dnnl_resampling;
 const primitive_kind_t reduction = dnnl_reduction;
 const primitive_kind_t softmax = dnnl_softmax;
 const primitive_kind_t layer_normalization = dnnl_layer_normalization;
+const primitive_kind_t topk = dnnl_topk;
+const primitive_kind_t embedding_bag = dnnl_embedding_bag;
 
 // Internal only primitive kinds.
 const primitive_kind_t internal_only_start = (primitive_kind_t)(1 << 12);
@@ -1886,6 +1897,7 @@ struct deconvolution_pd_t;
 struct eltwise_bwd_pd_t;
 struct eltwise_fwd_pd_t;
 struct eltwise_pd_t;
+struct embedding_bag_pd_t;
 struct gemm_pd_t;
 struct inner_product_bwd_data_pd_t;
 struct inner_product_bwd_weights_pd_t;
@@ -1913,6 +1925,7 @@ struct softmax_bwd_pd_t;
 struct softmax_fwd_pd_t;
 struct softmax_pd_t;
 struct sum_pd_t;
+struct topk_pd_t;
 
 } // namespace impl
 } // namespace dnnl
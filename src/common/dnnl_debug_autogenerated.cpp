@@ -1591,6 +1591,8 @@ const char *dnnl_prim_kind2str(dnnl_primitive_kind_t v) {
     if (v == dnnl_prelu) return "prelu";
     if (v == dnnl_softmax) return "softmax";
     if (v == dnnl_layer_normalization) return "layer_normalization";
+    if (v == dnnl_topk) return "topk";
+    if (v == dnnl_embedding_bag) return "embedding_bag";
     if (v == dnnl_primitive_kind_max) return "primitive_kind_max";
     assert(!"unknown prim_kind");
     return "unknown prim_kind";
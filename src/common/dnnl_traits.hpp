@@ -132,6 +132,8 @@ PKIND_TRAITS_INST(binary);
 PKIND_TRAITS_INST(matmul);
 PKIND_TRAITS_INST(resampling);
 PKIND_TRAITS_INST(reduction);
+PKIND_TRAITS_INST(topk);
+PKIND_TRAITS_INST(embedding_bag);
 #undef PKIND_TRAITS_INST
 
 } // namespace impl
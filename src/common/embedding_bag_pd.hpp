@@ -0,0 +1,133 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_EMBEDDING_BAG_PD_HPP
+#define COMMON_EMBEDDING_BAG_PD_HPP
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+
+status_t embedding_bag_desc_init(embedding_bag_desc_t *embedding_bag_desc,
+        alg_kind_t alg_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *indices_desc, const memory_desc_t *offsets_desc,
+        const memory_desc_t *dst_desc);
+
+struct embedding_bag_pd_t : public primitive_desc_t {
+    static constexpr auto base_pkind = primitive_kind::embedding_bag;
+
+    typedef embedding_bag_pd_t hint_class;
+
+    const embedding_bag_desc_t *desc() const { return &desc_; }
+    const op_desc_t *op_desc() const override {
+        return reinterpret_cast<const op_desc_t *>(this->desc());
+    }
+
+    status_t query(query_t what, int idx, void *result) const override {
+        switch (what) {
+            case query::alg_kind:
+                *(alg_kind_t *)result = desc()->alg_kind;
+                break;
+            default: return primitive_desc_t::query(what, idx, result);
+        }
+        return status::success;
+    }
+
+    arg_usage_t arg_usage(int arg) const override {
+        switch (arg) {
+            case DNNL_ARG_SRC:
+            case DNNL_ARG_SRC_1: return arg_usage_t::input; break;
+            case DNNL_ARG_SRC_2:
+                return with_offsets() ? arg_usage_t::input
+                                      : arg_usage_t::unused;
+                break;
+            case DNNL_ARG_DST: return arg_usage_t::output; break;
+            default: return primitive_desc_t::arg_usage(arg);
+        }
+    }
+
+    const memory_desc_t *arg_md(int arg) const override {
+        switch (arg) {
+            case DNNL_ARG_SRC: return src_md(0); break;
+            case DNNL_ARG_SRC_1: return src_md(1); break;
+            case DNNL_ARG_SRC_2: return src_md(2); break;
+            case DNNL_ARG_DST: return dst_md(0); break;
+            default: return primitive_desc_t::arg_md(arg);
+        }
+    }
+
+    // The table is the source 0, the indices are the source 1 and the offsets
+    // are the source 2.
+    const memory_desc_t *src_md(int index = 0) const override {
+        if (index == 0) return &src_md_;
+        if (index == 1) return &indices_md_;
+        if (index == 2 && with_offsets()) return &offsets_md_;
+        return &glob_zero_md;
+    }
+    const memory_desc_t *dst_md(int index = 0) const override {
+        return index == 0 ? &dst_md_ : &glob_zero_md;
+    }
+
+    int n_inputs() const override { return 2 + with_offsets(); }
+    int n_outputs() const override { return 1; }
+
+    bool with_offsets() const { return desc_.offsets_desc.ndims != 0; }
+    bool is_mean() const { return desc_.alg_kind == alg_kind::reduction_mean; }
+
+    dim_t nrows() const { return desc_.src_desc.dims[0]; }
+    dim_t emb_dim() const { return desc_.src_desc.dims[1]; }
+    dim_t nindices() const { return desc_.indices_desc.dims[0]; }
+    dim_t nbags() const { return desc_.dst_desc.dims[0]; }
+
+protected:
+    embedding_bag_desc_t desc_;
+
+    memory_desc_t src_md_;
+    memory_desc_t indices_md_;
+    memory_desc_t offsets_md_;
+    memory_desc_t dst_md_;
+
+    embedding_bag_pd_t(const embedding_bag_desc_t *adesc,
+            const primitive_attr_t *attr, const hint_class *hint_fwd)
+        : primitive_desc_t(attr, base_pkind)
+        , desc_(*adesc)
+        , src_md_(desc_.src_desc)
+        , indices_md_(desc_.indices_desc)
+        , offsets_md_(desc_.offsets_desc)
+        , dst_md_(desc_.dst_desc) {}
+
+    // The destination with `any` format gets the plain layout.
+    status_t set_default_params() {
+        if (dst_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(dst_md_, format_tag::ab));
+        return status::success;
+    }
+
+    // The scales of the source are either common or given per table row.
+    bool attr_scales_ok() const {
+        const auto &scales = attr()->scales_;
+        return scales.has_default_values({DNNL_ARG_SRC})
+                && utils::one_of(scales.get(DNNL_ARG_SRC).mask_, 0, 1);
+    }
+};
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
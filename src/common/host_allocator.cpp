@@ -0,0 +1,349 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "host_allocator.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace host_allocator {
+
+namespace {
+
+void *system_malloc(size_t size, size_t alignment) {
+    void *ptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, alignment);
+    int rc = ptr ? 0 : -1;
+#else
+    int rc = ::posix_memalign(&ptr, alignment, size);
+#endif
+    return (rc == 0) ? ptr : nullptr;
+}
+
+void system_free(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    ::free(p);
+#endif
+}
+
+struct user_allocator_t {
+    dnnl_host_allocate_f allocate;
+    dnnl_host_deallocate_f deallocate;
+};
+
+// Both call-backs are swapped at once, so that a buffer is never recorded
+// with the deallocation call-back of another allocator.
+std::atomic<const user_allocator_t *> user_allocator {nullptr};
+
+// Keeps every pair of call-backs ever set, since a concurrent allocation may
+// still be reading a replaced one.
+const user_allocator_t *register_user_allocator(
+        dnnl_host_allocate_f allocate, dnnl_host_deallocate_f deallocate) {
+    static std::mutex mutex;
+    // Intentionally leaked: allocations may happen at program exit after
+    // static objects are gone.
+    static std::list<user_allocator_t> *allocators
+            = new std::list<user_allocator_t>();
+    std::lock_guard<std::mutex> guard(mutex);
+    for (const auto &a : *allocators)
+        if (a.allocate == allocate && a.deallocate == deallocate) return &a;
+    allocators->push_back({allocate, deallocate});
+    return &allocators->back();
+}
+
+bool use_cached_allocator() {
+    static const bool val = getenv_string_user("HOST_ALLOCATOR") == "CACHED";
+    return val;
+}
+
+size_t cached_allocator_capacity() {
+    static const size_t val
+            = (size_t)nstl::max(
+                      0, getenv_int_user("HOST_ALLOCATOR_CAPACITY_MB", 1024))
+            * 1024 * 1024;
+    return val;
+}
+
+// The allocator a buffer came from: the user deallocation call-back, or the
+// size class of the built-in caching allocator if there is none.
+struct owner_t {
+    dnnl_host_deallocate_f deallocate;
+    size_t class_idx;
+};
+
+/*
+  Table of the buffers that are not released with the system allocator.
+
+  The owner of a buffer is recorded when the buffer is allocated, so a buffer
+  is always released by the allocator it came from, even if another allocator
+  has been set since then. The table is split into shards, each guarded by its
+  own lock, so that threads releasing different buffers rarely contend. The
+  buffers allocated by the system allocator are not recorded, and releasing
+  them skips the table entirely as long as it is empty.
+*/
+struct owner_table_t {
+    static owner_table_t &get() {
+        // Intentionally leaked: library objects may be freed at program exit
+        // after static objects are gone.
+        static owner_table_t *table = new owner_table_t();
+        return *table;
+    }
+
+    void insert(void *p, const owner_t &owner) {
+        shard_t &shard = get_shard(p);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        shard.owners.emplace(p, owner);
+        size_++;
+    }
+
+    // Returns false for the buffers that are not recorded.
+    bool remove(void *p, owner_t &owner) {
+        if (size_.load() == 0) return false;
+        shard_t &shard = get_shard(p);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        auto it = shard.owners.find(p);
+        if (it == shard.owners.end()) return false;
+        owner = it->second;
+        shard.owners.erase(it);
+        size_--;
+        return true;
+    }
+
+private:
+    struct shard_t {
+        std::mutex mutex;
+        std::unordered_map<void *, owner_t> owners;
+    };
+
+    static constexpr size_t num_shards = 64;
+
+    owner_table_t() = default;
+
+    shard_t &get_shard(const void *p) {
+        // Large buffers are page-aligned, so the low bits carry no entropy.
+        size_t h = reinterpret_cast<size_t>(p);
+        h ^= (h >> 21) ^ (h >> 12) ^ (h >> 6);
+        return shards_[h % num_shards];
+    }
+
+    shard_t shards_[num_shards];
+    std::atomic<size_t> size_ {0};
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(owner_table_t);
+};
+
+/*
+  Built-in allocator with reuse of large buffers.
+
+  Allocations of at least `min_cached_size` bytes are rounded up to a size
+  class (four classes per power of two, so at most 25% of a buffer is
+  wasted). Freed buffers are kept in per-class bins, each guarded by its own
+  lock, up to the total capacity of ONEDNN_HOST_ALLOCATOR_CAPACITY_MB, and
+  handed out again to the next allocation of the same class. Classes of a
+  huge page size and larger are allocated at the huge page boundary and
+  advised to be backed by huge pages to reduce DTLB misses in the kernels
+  touching them. The size class of a buffer is kept in the owner table rather
+  than in the buffer, so the whole buffer can be backed by huge pages.
+
+  Smaller allocations go directly to the system allocator.
+*/
+struct cached_allocator_t {
+    static cached_allocator_t &get() {
+        // Intentionally leaked: library objects may be freed at program exit
+        // after static objects are gone.
+        static cached_allocator_t *allocator = new cached_allocator_t();
+        return *allocator;
+    }
+
+    void *malloc(size_t size, size_t alignment) {
+        const size_t class_idx = get_class_idx(size);
+        if (class_idx == uncached
+                || alignment > get_class_alignment(get_class_size(class_idx)))
+            return system_malloc(size, alignment);
+
+        void *ptr = get_cached(class_idx);
+        if (ptr) owner_table_t::get().insert(ptr, {nullptr, class_idx});
+        return ptr;
+    }
+
+    void free(void *p, size_t class_idx) {
+        const size_t class_size = get_class_size(class_idx);
+        if (cached_bytes_.fetch_add(class_size) + class_size
+                <= cached_allocator_capacity()) {
+            bin_t &bin = bins_[class_idx];
+            std::lock_guard<std::mutex> guard(bin.mutex);
+            bin.buffers.push_back(p);
+            return;
+        }
+        cached_bytes_ -= class_size;
+        system_free(p);
+    }
+
+private:
+    struct bin_t {
+        std::mutex mutex;
+        std::vector<void *> buffers;
+    };
+
+    static constexpr size_t min_cached_size = 64 * 1024;
+    static constexpr size_t page_size = 4096;
+    static constexpr size_t classes_per_pow2 = 4;
+    // Classes from 64 KB up to 2^48 bytes.
+    static constexpr size_t num_classes = classes_per_pow2 * 32;
+    static constexpr size_t uncached = num_classes;
+
+    cached_allocator_t() = default;
+
+    // Returns `uncached` for the sizes that are not kept in the bins.
+    static size_t get_class_idx(size_t size) {
+        if (size < min_cached_size) return uncached;
+        size_t pow2 = min_cached_size, log2 = 0;
+        while (pow2 <= size / 2) {
+            pow2 *= 2;
+            log2++;
+        }
+        const size_t step = pow2 / classes_per_pow2;
+        const size_t idx = log2 * classes_per_pow2
+                + (utils::rnd_up(size, step) - pow2) / step;
+        return idx < num_classes ? idx : uncached;
+    }
+
+    static size_t get_class_size(size_t class_idx) {
+        const size_t pow2 = min_cached_size << (class_idx / classes_per_pow2);
+        const size_t step = pow2 / classes_per_pow2;
+        return pow2 + (class_idx % classes_per_pow2) * step;
+    }
+
+    static size_t get_class_alignment(size_t class_size) {
+        return class_size >= huge_page_size ? huge_page_size : page_size;
+    }
+
+    void *get_cached(size_t class_idx) {
+        const size_t class_size = get_class_size(class_idx);
+        {
+            bin_t &bin = bins_[class_idx];
+            std::lock_guard<std::mutex> guard(bin.mutex);
+            if (!bin.buffers.empty()) {
+                void *ptr = bin.buffers.back();
+                bin.buffers.pop_back();
+                cached_bytes_ -= class_size;
+                return ptr;
+            }
+        }
+
+        const size_t class_alignment = get_class_alignment(class_size);
+        void *ptr = system_malloc(class_size, class_alignment);
+        if (ptr == nullptr) {
+            // Give all cached memory back and retry once.
+            release_cached();
+            ptr = system_malloc(class_size, class_alignment);
+        }
+        if (ptr && class_size >= huge_page_size)
+            advise_huge_pages(ptr, class_size);
+        return ptr;
+    }
+
+    void release_cached() {
+        for (size_t idx = 0; idx < num_classes; idx++) {
+            bin_t &bin = bins_[idx];
+            std::lock_guard<std::mutex> guard(bin.mutex);
+            for (void *p : bin.buffers)
+                system_free(p);
+            cached_bytes_ -= bin.buffers.size() * get_class_size(idx);
+            bin.buffers.clear();
+        }
+    }
+
+    bin_t bins_[num_classes];
+    std::atomic<size_t> cached_bytes_ {0};
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(cached_allocator_t);
+};
+
+} // namespace
+
+void *malloc(size_t size, int alignment) {
+    const user_allocator_t *user = user_allocator.load();
+    if (user) {
+        void *ptr = user->allocate(size, (size_t)alignment);
+        if (ptr) owner_table_t::get().insert(ptr, {user->deallocate, 0});
+        return ptr;
+    }
+    if (use_cached_allocator())
+        return cached_allocator_t::get().malloc(size, (size_t)alignment);
+    return system_malloc(size, (size_t)alignment);
+}
+
+void free(void *p) {
+    if (p == nullptr) return;
+    owner_t owner;
+    if (!owner_table_t::get().remove(p, owner)) return system_free(p);
+    if (owner.deallocate) return owner.deallocate(p);
+    cached_allocator_t::get().free(p, owner.class_idx);
+}
+
+void advise_huge_pages(void *ptr, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    const size_t page = (size_t)getpagesize();
+    const size_t begin = utils::rnd_up((size_t)ptr, page);
+    const size_t end = utils::rnd_dn((size_t)ptr + size, page);
+    // The advice is a hint; a failure just leaves regular pages in place.
+    if (end > begin) madvise((void *)begin, end - begin, MADV_HUGEPAGE);
+#else
+    UNUSED(ptr);
+    UNUSED(size);
+#endif
+}
+
+status_t set_user_allocator(
+        dnnl_host_allocate_f allocate, dnnl_host_deallocate_f deallocate) {
+    if ((allocate == nullptr) != (deallocate == nullptr))
+        return status::invalid_arguments;
+    user_allocator.store(allocate
+                    ? register_user_allocator(allocate, deallocate)
+                    : nullptr);
+    return status::success;
+}
+
+} // namespace host_allocator
+} // namespace impl
+} // namespace dnnl
+
+dnnl_status_t dnnl_set_host_allocator(
+        dnnl_host_allocate_f allocate, dnnl_host_deallocate_f deallocate) {
+    return dnnl::impl::host_allocator::set_user_allocator(allocate, deallocate);
+}
@@ -0,0 +1,52 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_HOST_ALLOCATOR_HPP
+#define COMMON_HOST_ALLOCATOR_HPP
+
+#include <stddef.h>
+
+#include "c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace host_allocator {
+
+// Size of a transparent huge page the built-in allocator and the scratchpad
+// pool align large buffers to.
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+// Host allocation routines behind dnnl::impl::malloc() and
+// dnnl::impl::free(). The allocation is served, in the order of priority, by:
+// - the user allocator set with dnnl_set_host_allocator(),
+// - the built-in caching allocator if ONEDNN_HOST_ALLOCATOR=CACHED,
+// - the system allocator.
+// A buffer is always released by the allocator that allocated it.
+void *malloc(size_t size, int alignment);
+void free(void *p);
+
+// Hints the OS to back the pages fully covered by [ptr, ptr + size) with
+// transparent huge pages. No-op on the systems without such support.
+void advise_huge_pages(void *ptr, size_t size);
+
+status_t set_user_allocator(
+        dnnl_host_allocate_f allocate, dnnl_host_deallocate_f deallocate);
+
+} // namespace host_allocator
+} // namespace impl
+} // namespace dnnl
+
+#endif
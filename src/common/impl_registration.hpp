@@ -96,6 +96,13 @@
     {}
 #endif
 
+#if BUILD_PRIMITIVE_ALL || BUILD_EMBEDDING_BAG
+#define REG_EMBEDDING_BAG_P(...) __VA_ARGS__
+#else
+#define REG_EMBEDDING_BAG_P(...) \
+    { nullptr }
+#endif
+
 #if BUILD_PRIMITIVE_ALL || BUILD_INNER_PRODUCT
 #define REG_IP_P(...) __VA_ARGS__
 #else
@@ -187,6 +194,13 @@
     { nullptr }
 #endif
 
+#if BUILD_PRIMITIVE_ALL || BUILD_TOPK
+#define REG_TOPK_P(...) __VA_ARGS__
+#else
+#define REG_TOPK_P(...) \
+    { nullptr }
+#endif
+
 // Primitive CPU ISA section is in src/cpu/platform.hpp
 
 #if BUILD_PRIMITIVE_GPU_ISA_ALL || BUILD_GEN9
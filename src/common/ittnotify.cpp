@@ -78,6 +78,8 @@ void primitive_task_start(primitive_kind_t kind) {
             CASE(prelu),
             CASE(softmax),
             CASE(layer_normalization),
+            CASE(topk),
+            CASE(embedding_bag),
     };
 #undef CASE
     int kind_idx = (int)kind;
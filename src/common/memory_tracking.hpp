@@ -165,6 +165,8 @@ enum {
     key_brgemm_primitive_buffer_b,
     key_brgemm_primitive_buffer_comp,
     key_brgemm_primitive_buffer_d,
+    key_brgemm_primitive_src_dyn_quant,
+    key_brgemm_primitive_src_dyn_quant_scales,
     key_brgemm_primitive_zp_comp_a,
     key_brgemm_primitive_zp_comp_b,
     key_concat_iptrs,
@@ -278,6 +280,8 @@ enum {
     key_softmax_interim_store,
     key_sum_reduction,
     key_sum_srcs_cvt,
+    key_topk_heap,
+    key_topk_partials,
     key_wino_U,
     key_wino_V,
     key_wino_M,
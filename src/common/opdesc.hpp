@@ -386,6 +386,41 @@ struct reduction_desc_t {
     float p, eps;
 };
 
+// A descriptor of top-k operation.
+struct topk_desc_t {
+    // The kind of primitive. Used for self-identifying the primitive
+    // descriptor. Must be #dnnl_topk.
+    primitive_kind_t primitive_kind;
+    // Source memory descriptor.
+    memory_desc_t src_desc;
+    // Destination memory descriptor of the selected values. The number of
+    // the selected values is the size of the axis dimension.
+    memory_desc_t dst_desc;
+    // Destination memory descriptor of the indices of the selected values.
+    memory_desc_t indices_desc;
+    // The axis along which the values are selected.
+    int axis;
+};
+
+// A descriptor of an embedding bag operation.
+struct embedding_bag_desc_t {
+    // The kind of primitive. Used for self-identifying the primitive
+    // descriptor. Must be #dnnl_embedding_bag.
+    primitive_kind_t primitive_kind;
+    // The kind of the pooling algorithm. Possible values:
+    // #dnnl_reduction_sum and #dnnl_reduction_mean.
+    alg_kind_t alg_kind;
+    // Source memory descriptor of the table.
+    memory_desc_t src_desc;
+    // Memory descriptor of the indices of the table rows.
+    memory_desc_t indices_desc;
+    // Memory descriptor of the offsets of the bags in the indices. A zero
+    // memory descriptor makes each index a bag.
+    memory_desc_t offsets_desc;
+    // Destination memory descriptor.
+    memory_desc_t dst_desc;
+};
+
 /// A descriptor of a Softmax operation.
 struct softmax_desc_t {
     // The kind of primitive. Used for self-identifying the primitive
@@ -582,6 +617,8 @@ struct op_desc_t {
         resampling_desc_t resampling;
         zero_pad_desc_t zero_pad;
         reduction_desc_t reduction;
+        topk_desc_t topk;
+        embedding_bag_desc_t embedding_bag;
     };
 
 #define DECL_CTOR_AND_CONVERTERS(c_type) \
@@ -613,6 +650,8 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(resampling_desc_t);
     DECL_CTOR_AND_CONVERTERS(zero_pad_desc_t);
     DECL_CTOR_AND_CONVERTERS(reduction_desc_t);
+    DECL_CTOR_AND_CONVERTERS(topk_desc_t);
+    DECL_CTOR_AND_CONVERTERS(embedding_bag_desc_t);
 
     // concat_desc_t and sum_desc_t have data members which have non-trivial
     // special member functions hence the default destructor is implicitly
@@ -212,7 +212,7 @@ struct pooling_fwd_pd_t : public pooling_pd_t {
 
     std::vector<memory_desc_t> hint_mds(bool is_hint) const override {
         if (!is_hint) return {};
-        return {*dst_md(0), *workspace_md(0)};
+        return {*dst_md(0), *workspace_md(0), *src_md(0)};
     }
 
 protected:
@@ -248,17 +248,25 @@ struct pooling_bwd_pd_t : public pooling_pd_t {
         if (arg == DNNL_ARG_WORKSPACE && (!types::is_zero_md(workspace_md())))
             return arg_usage_t::input;
 
+        if (arg == DNNL_ARG_SRC && with_argmax_recompute())
+            return arg_usage_t::input;
+
         return primitive_desc_t::arg_usage(arg);
     }
 
     const memory_desc_t *arg_md(int arg) const override {
         switch (arg) {
+            case DNNL_ARG_SRC: return src_md(0);
             case DNNL_ARG_DIFF_SRC: return diff_src_md(0);
             case DNNL_ARG_DIFF_DST: return diff_dst_md(0);
             default: return pooling_pd_t::arg_md(arg);
         }
     }
 
+    const memory_desc_t *src_md(int index = 0) const override {
+        return index == 0 && with_argmax_recompute() ? &src_md_
+                                                     : &glob_zero_md;
+    }
     const memory_desc_t *diff_src_md(int index = 0) const override {
         return index == 0 ? &diff_src_md_ : &glob_zero_md;
     }
@@ -271,7 +279,8 @@ struct pooling_bwd_pd_t : public pooling_pd_t {
     }
 
     int n_inputs() const override {
-        return 1 + (!types::is_zero_md(workspace_md()));
+        return 1 + (!types::is_zero_md(workspace_md()))
+                + with_argmax_recompute();
     }
     int n_outputs() const override { return 1; }
 
@@ -281,17 +290,30 @@ struct pooling_bwd_pd_t : public pooling_pd_t {
         return hint_mds_;
     }
 
+    /* Max pooling with a hint that does not provide a workspace (i.e. created
+     * for forward inference): instead of reading the argmax indices from the
+     * workspace, the backward recomputes them from the forward source which
+     * is passed as DNNL_ARG_SRC. */
+    bool with_argmax_recompute() const {
+        return desc()->alg_kind == alg_kind::pooling_max
+                && hint_mds_.size() > 2 && types::is_zero_md(&hint_mds_[1])
+                && !types::is_zero_md(&hint_mds_[2]);
+    }
+
 protected:
+    memory_desc_t src_md_;
     memory_desc_t diff_src_md_;
     memory_desc_t diff_dst_md_;
 
     pooling_bwd_pd_t(const pooling_desc_t *adesc, const primitive_attr_t *attr,
             const pooling_fwd_pd_t *hint_fwd_pd)
         : pooling_pd_t(adesc, attr, hint_fwd_pd)
+        , src_md_()
         , diff_src_md_(desc_.diff_src_desc)
         , diff_dst_md_(desc_.diff_dst_desc) {
         if (hint_fwd_pd_)
             hint_mds_ = hint_fwd_pd_->hint_mds(true /* is_hint */);
+        if (with_argmax_recompute()) src_md_ = hint_mds_[2];
     }
 
     virtual status_t set_default_params() {
@@ -125,6 +125,8 @@ bool primitive_attr_t::has_default_values(dnnl_primitive_attr::skip_mask_t mask,
     CHECK_MASK(smask_t::rnn_weights_qparams, rnn_weights_qparams_);
     CHECK_MASK(smask_t::rnn_weights_projection_qparams,
             rnn_weights_projection_qparams_);
+    CHECK_MASK(smask_t::softmax_pre_ops, softmax_pre_ops_);
+    CHECK_MASK(smask_t::src_dyn_quant_params, src_dyn_quant_params_);
     CHECK_ARG(IMPLICATION((bool)(~mask & smask_t::sum_dt),
             post_ops_.sum_with_default_dt(dst_dt)));
     bool gpu_attr_ok = IMPLICATION((bool)(~mask & smask_t::gpu_attr),
@@ -150,6 +152,8 @@ bool primitive_attr_t::defined(dnnl_primitive_attr::skip_mask_t mask) const {
     CHECK_MASK(smask_t::rnn_weights_qparams, rnn_weights_qparams_);
     CHECK_MASK(smask_t::rnn_weights_projection_qparams,
             rnn_weights_projection_qparams_);
+    CHECK_MASK(smask_t::softmax_pre_ops, softmax_pre_ops_);
+    CHECK_MASK(smask_t::src_dyn_quant_params, src_dyn_quant_params_);
     return ok;
 #undef CHECK_MASK
 #undef CHECK_ARG
@@ -616,6 +620,43 @@ status_t dnnl_post_ops_get_params_prelu(
     return success;
 }
 
+status_t dnnl_primitive_attr_set_softmax_pre_ops(primitive_attr_t *attr,
+        float scale, softmax_mask_kind_t mask_kind,
+        const memory_desc_t *mask_desc) {
+    if (attr == nullptr) return invalid_arguments;
+
+    return attr->softmax_pre_ops_.set(scale, mask_kind, mask_desc);
+}
+
+status_t dnnl_primitive_attr_get_softmax_pre_ops(const primitive_attr_t *attr,
+        float *scale, softmax_mask_kind_t *mask_kind,
+        const memory_desc_t **mask_desc) {
+    if (attr == nullptr) return invalid_arguments;
+
+    const auto &pre_ops = attr->softmax_pre_ops_;
+    if (scale) *scale = pre_ops.scale_;
+    if (mask_kind) *mask_kind = pre_ops.mask_kind_;
+    if (mask_desc) *mask_desc = &pre_ops.mask_desc_;
+
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_src_dyn_quant_params(
+        primitive_attr_t *attr, uint64_t group_size) {
+    if (attr == nullptr) return invalid_arguments;
+
+    attr->src_dyn_quant_params_.group_size_ = group_size;
+    return success;
+}
+
+status_t dnnl_primitive_attr_get_src_dyn_quant_params(
+        const primitive_attr_t *attr, uint64_t *group_size) {
+    if (any_null(attr, group_size)) return invalid_arguments;
+
+    *group_size = attr->src_dyn_quant_params_.group_size_;
+    return success;
+}
+
 status_t dnnl_primitive_attr_set_rnn_data_qparams(
         primitive_attr_t *attr, const float scale, const float shift) {
     if (attr == nullptr) return invalid_arguments;
@@ -55,6 +55,66 @@ struct rnn_data_qparams_t : public c_compatible {
     float shift_;
 };
 
+// Operations applied to the softmax source before the softmax:
+// src' = scale * src + mask.
+struct softmax_pre_ops_t : public c_compatible {
+    softmax_pre_ops_t()
+        : scale_(1.f)
+        , mask_kind_(softmax_mask_kind::none)
+        , mask_desc_(types::zero_md()) {}
+
+    bool has_default_values() const {
+        return scale_ == 1.f && mask_kind_ == softmax_mask_kind::none;
+    }
+    bool defined() const { return !is_runtime_value(scale_); }
+
+    bool with_mask() const { return mask_kind_ != softmax_mask_kind::none; }
+    bool with_causal_mask() const {
+        return utils::one_of(mask_kind_, softmax_mask_kind::causal_top_left,
+                softmax_mask_kind::causal_bottom_right);
+    }
+
+    status_t set(float scale, softmax_mask_kind_t mask_kind,
+            const memory_desc_t *mask_desc) {
+        using namespace softmax_mask_kind;
+        const bool with_desc
+                = mask_desc != nullptr && !types::is_zero_md(mask_desc);
+        if (!utils::one_of(mask_kind, none, buffer, causal_top_left,
+                    causal_bottom_right)
+                || with_desc != (mask_kind == buffer))
+            return status::invalid_arguments;
+        scale_ = scale;
+        mask_kind_ = mask_kind;
+        mask_desc_ = with_desc ? *mask_desc : types::zero_md();
+        return status::success;
+    }
+
+    bool operator==(const softmax_pre_ops_t &rhs) const {
+        return utils::equal_with_nan(scale_, rhs.scale_)
+                && mask_kind_ == rhs.mask_kind_
+                && mask_desc_ == rhs.mask_desc_;
+    }
+
+    float scale_;
+    softmax_mask_kind_t mask_kind_;
+    memory_desc_t mask_desc_;
+};
+
+// Dynamic quantization of the source: a scale per group of `group_size_`
+// elements along the reduction dimension is computed at execution time.
+struct src_dyn_quant_params_t : public c_compatible {
+    src_dyn_quant_params_t() : group_size_(0) {}
+
+    bool has_default_values() const { return group_size_ == 0; }
+    bool defined() const { return true; }
+
+    bool operator==(const src_dyn_quant_params_t &rhs) const {
+        return group_size_ == rhs.group_size_;
+    }
+
+    uint64_t group_size_;
+};
+
 struct rnn_tparams_t : public c_compatible {
     rnn_tparams_t()
         : test_mode_(false), scales_(nullptr), ngates_(0), cscale_(0.0f) {}
@@ -651,6 +711,8 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         CHECK(rnn_weights_projection_qparams_.copy_from(
                 other.rnn_weights_projection_qparams_));
         CHECK(rnn_tparams_.copy_from(other.rnn_tparams_));
+        softmax_pre_ops_ = other.softmax_pre_ops_;
+        src_dyn_quant_params_ = other.src_dyn_quant_params_;
         if (other.gpu_attr_) gpu_attr_ = other.gpu_attr_->clone();
 
         return status::success;
@@ -672,7 +734,9 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         rnn_tparams = 1u << 9,
         sum_dt = 1u << 10,
         rnn_weights_projection_qparams = 1u << 11,
-        gpu_attr = 1u << 12
+        gpu_attr = 1u << 12,
+        softmax_pre_ops = 1u << 13,
+        src_dyn_quant_params = 1u << 14
     };
 
     /** Returns true if the attributes have default values.
@@ -695,6 +759,8 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
                 && rnn_weights_projection_qparams_
                         == rhs.rnn_weights_projection_qparams_
                 && rnn_tparams_ == rhs.rnn_tparams_
+                && softmax_pre_ops_ == rhs.softmax_pre_ops_
+                && src_dyn_quant_params_ == rhs.src_dyn_quant_params_
                 && ((gpu_attr_ && rhs.gpu_attr_
                             && gpu_attr_->is_equal(*rhs.gpu_attr_))
                         || (!gpu_attr_ && !rhs.gpu_attr_));
@@ -743,6 +809,8 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl::impl::scales_t rnn_weights_qparams_;
     dnnl::impl::scales_t rnn_weights_projection_qparams_;
     dnnl::impl::rnn_tparams_t rnn_tparams_;
+    dnnl::impl::softmax_pre_ops_t softmax_pre_ops_;
+    dnnl::impl::src_dyn_quant_params_t src_dyn_quant_params_;
 
     std::unique_ptr<dnnl::impl::primitive_attr_item_t> gpu_attr_;
 
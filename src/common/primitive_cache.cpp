@@ -39,7 +39,14 @@ struct primitive_cache_t {
         return cache_.set_capacity(capacity);
     }
     int get_capacity() const { return cache_.get_capacity(); }
+    status_t set_memory_capacity(size_t capacity) {
+        return cache_.set_memory_capacity(capacity);
+    }
+    size_t get_memory_capacity() const {
+        return cache_.get_memory_capacity();
+    }
     int get_size() const { return cache_.get_size(); }
+    utils::cache_stats_t get_stats() const { return cache_.get_stats(); }
 
     std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) {
         result_t result = cache_.get(key);
@@ -152,3 +159,37 @@ dnnl::impl::status_t dnnl_set_primitive_cache_capacity(int capacity) {
 #endif
     return dnnl::impl::status::success;
 }
+
+dnnl::impl::status_t dnnl_get_primitive_cache_memory_capacity(
+        size_t *capacity) {
+    if (capacity == nullptr) return dnnl::impl::status::invalid_arguments;
+    *capacity = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    *capacity = dnnl::impl::global_primitive_cache().get_memory_capacity();
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_set_primitive_cache_memory_capacity(
+        size_t capacity) {
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    return dnnl::impl::global_primitive_cache().set_memory_capacity(capacity);
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_get_primitive_cache_stats(
+        dnnl_primitive_cache_stats_t *stats) {
+    if (stats == nullptr) return dnnl::impl::status::invalid_arguments;
+    *stats = dnnl_primitive_cache_stats_t();
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    const auto s = dnnl::impl::global_primitive_cache().get_stats();
+    stats->hits = s.hits;
+    stats->misses = s.misses;
+    stats->evictions = s.evictions;
+    stats->size = s.size;
+    stats->memory_size = s.memory_size;
+    stats->creation_time_saved_ms = s.creation_time_saved_ms;
+#endif
+    return dnnl::impl::status::success;
+}
@@ -83,6 +83,8 @@ bool key_t::operator==(const key_t &rhs) const {
             CASE(shuffle)
             CASE(softmax)
             CASE(sum)
+            CASE(topk)
+            CASE(embedding_bag)
             CASE(zero_pad)
             default: assert(!"unknown primitive kind");
         }
@@ -275,6 +277,19 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
         seed = get_array_hash(seed, attr.rnn_weights_qparams_.scales_,
                 attr.rnn_weights_qparams_.count_);
     }
+    if (!attr.softmax_pre_ops_.has_default_values()) {
+        // softmax_pre_ops: scale, mask_kind, mask_desc
+        seed = hash_combine(seed, attr.softmax_pre_ops_.scale_);
+        seed = hash_combine(seed,
+                static_cast<size_t>(attr.softmax_pre_ops_.mask_kind_));
+        seed = hash_combine(
+                seed, get_md_hash(attr.softmax_pre_ops_.mask_desc_));
+    }
+    if (!attr.src_dyn_quant_params_.has_default_values()) {
+        // src_dyn_quant_params: group_size
+        seed = hash_combine(seed,
+                static_cast<size_t>(attr.src_dyn_quant_params_.group_size_));
+    }
     if (attr.gpu_attr_) {
         seed = hash_combine(seed, attr.gpu_attr_->get_hash());
     }
@@ -649,6 +664,34 @@ size_t get_desc_hash(const sum_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const topk_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.src_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    seed = hash_combine(seed, get_md_hash(desc.indices_desc));
+    // Axis
+    seed = hash_combine(seed, desc.axis);
+    // Combined hash for topk desc
+    return seed;
+}
+
+size_t get_desc_hash(const embedding_bag_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    seed = hash_combine(seed, static_cast<size_t>(desc.alg_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.src_desc));
+    seed = hash_combine(seed, get_md_hash(desc.indices_desc));
+    seed = hash_combine(seed, get_md_hash(desc.offsets_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    // Combined hash for embedding bag desc
+    return seed;
+}
+
 size_t get_desc_hash(const zero_pad_desc_t &desc) {
     size_t seed = 0;
     // Kinds
@@ -88,6 +88,8 @@ size_t get_desc_hash(const rnn_desc_t &desc);
 size_t get_desc_hash(const shuffle_desc_t &desc);
 size_t get_desc_hash(const softmax_desc_t &desc);
 size_t get_desc_hash(const sum_desc_t &desc);
+size_t get_desc_hash(const topk_desc_t &desc);
+size_t get_desc_hash(const embedding_bag_desc_t &desc);
 size_t get_desc_hash(const zero_pad_desc_t &desc);
 
 template <typename T>
@@ -174,6 +176,8 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
             CASE(shuffle)
             CASE(softmax)
             CASE(sum)
+            CASE(topk)
+            CASE(embedding_bag)
             CASE(zero_pad)
             default: assert(!"unknown primitive_kind");
         }
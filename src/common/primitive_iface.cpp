@@ -86,24 +86,52 @@ status_t primitive_execute(
     auto stream = ctx.stream();
     status_t status = success;
 
+    // The ITT task and the outputs unpoisoning of a deferred primitive are
+    // handled by primitive_execute_deferred() once the primitive is run.
+    const bool is_deferred = stream->defers_host_execution();
+
 #if defined(DNNL_ENABLE_ITT_TASKS)
-    const bool enable_itt = itt::get_itt(itt::__itt_task_level_low);
+    const bool enable_itt
+            = !is_deferred && itt::get_itt(itt::__itt_task_level_low);
     if (enable_itt)
         itt::primitive_task_start(primitive_iface->pd()->impl()->kind());
 #endif
 
     if (verbose_has_exec_profile()) {
-        stream->wait();
-        double start_ms = get_msec();
-        status = stream->enqueue_primitive(primitive_iface, ctx);
-        stream->wait();
-        double duration_ms = get_msec() - start_ms;
-        VPROF(start_ms, exec, VERBOSE_profile, primitive_iface->pd()->info(),
-                duration_ms);
+        // Errors of the primitives submitted earlier are reported here rather
+        // than dropped by the wait.
+        status = stream->wait();
+        if (status == success) {
+            double start_ms = get_msec();
+            status = stream->enqueue_primitive(primitive_iface, ctx);
+            if (status == success) status = stream->wait();
+            double duration_ms = get_msec() - start_ms;
+            VPROF(start_ms, exec, VERBOSE_profile,
+                    primitive_iface->pd()->info(), duration_ms);
+        }
     } else {
         status = stream->enqueue_primitive(primitive_iface, ctx);
     }
 
+#if defined(DNNL_ENABLE_ITT_TASKS)
+    if (enable_itt) itt::primitive_task_end();
+#endif
+
+    if (msan_enabled && !is_deferred) unpoison_outputs(ctx.args());
+
+    return status;
+}
+
+status_t primitive_execute_deferred(
+        const primitive_iface_t *primitive_iface, exec_ctx_t &ctx) {
+#if defined(DNNL_ENABLE_ITT_TASKS)
+    const bool enable_itt = itt::get_itt(itt::__itt_task_level_low);
+    if (enable_itt)
+        itt::primitive_task_start(primitive_iface->pd()->impl()->kind());
+#endif
+
+    status_t status = primitive_iface->execute(ctx);
+
 #if defined(DNNL_ENABLE_ITT_TASKS)
     if (enable_itt) itt::primitive_task_end();
 #endif
@@ -257,7 +285,11 @@ status_t dnnl_primitive::init() {
     const size_t scratchpad_size
             = primitive_->pd()->scratchpad_size(scratchpad_mode::library);
 
-    if (scratchpad_size) {
+    // With the shared scratchpad pool a buffer is borrowed per execution.
+    const bool borrow_scratchpad
+            = scratchpad_size && use_scratchpad_pool(pd_->engine());
+
+    if (scratchpad_size && !borrow_scratchpad) {
         const memory_tracking::registry_t &registry
                 = primitive_->pd()->scratchpad_registry();
         bool use_global_scratchpad = scratchpad_debug::is_protect_scratchpad()
@@ -291,12 +323,28 @@ const primitive_desc_iface_t *dnnl_primitive::pd() const {
 
 status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     const memory_storage_t *mem_storage = nullptr;
+    std::unique_ptr<scratchpad_t> borrowed_scratchpad;
     if (primitive_->pd()->attr()->scratchpad_mode_ == scratchpad_mode::user) {
         memory_t *scratchpad_memory = ctx.output(DNNL_ARG_SCRATCHPAD);
         mem_storage = scratchpad_memory ? scratchpad_memory->memory_storage()
                                         : nullptr;
-    } else if (scratchpad_) {
+    } else if (scratchpad_ && !ctx.stream()->defers_host_execution()) {
         mem_storage = scratchpad_->get_memory_storage();
+    } else {
+        const size_t scratchpad_size
+                = primitive_->pd()->scratchpad_size(scratchpad_mode::library);
+        if (scratchpad_size) {
+            // The primitive doesn't own a scratchpad, or is run by a stream
+            // that defers host execution where the owned one (possibly the
+            // per-thread global scratchpad) can't be used: take one from the
+            // shared pool, or a new one, for the duration of this execution.
+            borrowed_scratchpad.reset(
+                    create_scratchpad(pd_->engine(), scratchpad_size, false));
+            if (!borrowed_scratchpad
+                    || borrowed_scratchpad->size() < scratchpad_size)
+                return out_of_memory;
+            mem_storage = borrowed_scratchpad->get_memory_storage();
+        }
     }
 
     auto scratchpad_grantor
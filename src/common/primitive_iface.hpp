@@ -31,6 +31,10 @@ namespace dnnl {
 namespace impl {
 status_t primitive_execute(
         const primitive_iface_t *primitive_iface, exec_ctx_t &ctx);
+// Executes a primitive enqueued earlier to a stream that defers host
+// execution (see stream_t::defers_host_execution()).
+status_t primitive_execute_deferred(
+        const primitive_iface_t *primitive_iface, exec_ctx_t &ctx);
 }
 } // namespace dnnl
 
@@ -14,17 +14,29 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <assert.h>
+#include <memory>
+#include <vector>
+
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "impl_list_item.hpp"
+#include "memory.hpp"
+#include "primitive.hpp"
 #include "primitive_cache.hpp"
+#include "primitive_exec_types.hpp"
 #include "primitive_hashing.hpp"
+#include "resource.hpp"
+#include "scratchpad.hpp"
+#include "stream.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
+#include "reorder.hpp"
 #include "reorder_pd.hpp"
 
 using namespace dnnl::impl;
@@ -124,6 +136,163 @@ status_t reorder_primitive_desc_create(std::shared_ptr<primitive_desc_t> &pd,
             pd, engine, src_md, engine, dst_md, engine, attr);
 }
 
+namespace {
+// A reorder shared by all the pairs of a batch with the same memory
+// descriptors and engines.
+struct batch_reorder_t {
+    const memory_t *src;
+    const memory_t *dst;
+    engine_t *engine;
+    std::shared_ptr<primitive_t> prim;
+    size_t scratchpad_size;
+};
+
+status_t execute_batch_reorder(stream_t *stream, const batch_reorder_t &r,
+        const memory_t *src, memory_t *dst,
+        const resource_mapper_t &resource_mapper,
+        const memory_storage_t *scratchpad_storage) {
+    exec_args_t args;
+    args[DNNL_ARG_FROM] = {const_cast<memory_t *>(src), true};
+    args[DNNL_ARG_TO] = {dst, false};
+    exec_ctx_t ctx(stream, std::move(args));
+
+    auto scratchpad_grantor = r.prim->pd()->scratchpad_registry().grantor(
+            scratchpad_storage, ctx);
+    ctx.set_scratchpad_grantor(&scratchpad_grantor);
+    ctx.set_resource_mapper(&resource_mapper);
+    return r.prim->execute(ctx);
+}
+} // namespace
+
+status_t reorder_execute_batch(stream_t *stream, int n,
+        const memory_t *const *src_memories, memory_t *const *dst_memories) {
+    // Pairs with equal descriptors share a single primitive, so a kernel is
+    // generated once per distinct reorder even with the primitive cache off.
+    std::vector<batch_reorder_t> reorders;
+    std::vector<size_t> reorder_idx(n);
+    std::vector<size_t> bytes(n);
+    resource_mapper_t resource_mapper;
+    for (int i = 0; i < n; i++) {
+        const memory_t *src = src_memories[i];
+        memory_t *dst = dst_memories[i];
+        if (any_null(src, dst)) return invalid_arguments;
+        bytes[i] = memory_desc_wrapper(src->md()).size()
+                + memory_desc_wrapper(dst->md()).size();
+
+        auto it = std::find_if(reorders.begin(), reorders.end(),
+                [&](const batch_reorder_t &r) {
+                    return r.src->engine() == src->engine()
+                            && r.dst->engine() == dst->engine()
+                            && *r.src->md() == *src->md()
+                            && *r.dst->md() == *dst->md();
+                });
+        reorder_idx[i] = it - reorders.begin();
+        if (it != reorders.end()) continue;
+
+        batch_reorder_t r {src, dst, nullptr, nullptr, 0};
+        r.engine = get_reorder_engine(src->engine(), dst->engine());
+        if (r.engine != stream->engine()) return invalid_arguments;
+        std::shared_ptr<primitive_desc_t> pd;
+        CHECK(reorder_primitive_desc_create(pd, r.engine, src->md(),
+                src->engine(), dst->md(), dst->engine(), nullptr));
+        CHECK(pd->create_primitive(r.prim, r.engine));
+        if (!resource_mapper.has_resource(r.prim.get()))
+            CHECK(r.prim->create_resource(r.engine, resource_mapper));
+        r.scratchpad_size = pd->scratchpad_size(scratchpad_mode::library);
+        reorders.push_back(r);
+    }
+
+    const auto scratchpad = [](engine_t *engine, size_t size) {
+        return std::unique_ptr<scratchpad_t>(
+                size ? create_scratchpad(engine, size, false) : nullptr);
+    };
+    const auto storage = [](const std::unique_ptr<scratchpad_t> &s) {
+        return s ? s->get_memory_storage() : nullptr;
+    };
+
+    // Only host reorders on a native CPU runtime are scheduled together;
+    // everything else is executed one by one.
+    const bool cpu_batch = stream->engine()->kind() == engine_kind::cpu
+            && is_native_runtime(stream->engine()->runtime_kind())
+            && std::all_of(reorders.begin(), reorders.end(),
+                    [&](const batch_reorder_t &r) {
+                        return r.src->engine() == r.dst->engine();
+                    });
+    const int nthr = cpu_batch ? dnnl_get_max_threads() : 1;
+
+    // A pair larger than an even per-thread share of the batch keeps all
+    // threads busy on its own; the rest are spread over the threads of a
+    // single parallel region, largest first onto the least loaded thread.
+    size_t total_bytes = 0;
+    for (int i = 0; i < n; i++)
+        total_bytes += bytes[i];
+    const size_t thr_share = total_bytes / nthr;
+
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(),
+            [&](int a, int b) { return bytes[a] > bytes[b]; });
+
+    std::vector<std::vector<int>> thr_items(nthr);
+    std::vector<size_t> thr_bytes(nthr, 0);
+
+    // The batch runs on the calling thread, so the primitives submitted
+    // earlier to a stream that defers host execution have to complete first.
+    status_t status = success;
+    if (stream->defers_host_execution()) CHECK(stream->wait());
+    stream->before_exec_hook();
+    for (int i : order) {
+        const auto &r = reorders[reorder_idx[i]];
+        if (nthr > 1 && bytes[i] <= thr_share) {
+            const auto ithr = std::min_element(thr_bytes.begin(),
+                                      thr_bytes.end())
+                    - thr_bytes.begin();
+            thr_items[ithr].push_back(i);
+            thr_bytes[ithr] += bytes[i];
+            continue;
+        }
+        auto s = scratchpad(r.engine, r.scratchpad_size);
+        if (r.scratchpad_size && !s) status = out_of_memory;
+        if (status == success)
+            status = execute_batch_reorder(stream, r, src_memories[i],
+                    dst_memories[i], resource_mapper, storage(s));
+        if (status != success) break;
+    }
+
+    if (status == success && nthr > 1) {
+        size_t max_scratchpad_size = 0;
+        for (const auto &r : reorders)
+            max_scratchpad_size
+                    = std::max(max_scratchpad_size, r.scratchpad_size);
+        std::vector<std::unique_ptr<scratchpad_t>> thr_scratchpads(nthr);
+        for (int ithr = 0; ithr < nthr; ithr++) {
+            if (thr_items[ithr].empty()) continue;
+            thr_scratchpads[ithr]
+                    = scratchpad(stream->engine(), max_scratchpad_size);
+            if (max_scratchpad_size && !thr_scratchpads[ithr])
+                status = out_of_memory;
+        }
+
+        std::vector<status_t> thr_status(nthr, success);
+        if (status == success)
+            parallel(nthr, [&](int ithr, int) {
+                for (int i : thr_items[ithr]) {
+                    thr_status[ithr] = execute_batch_reorder(stream,
+                            reorders[reorder_idx[i]], src_memories[i],
+                            dst_memories[i], resource_mapper,
+                            storage(thr_scratchpads[ithr]));
+                    if (thr_status[ithr] != success) break;
+                }
+            });
+        for (int ithr = 0; ithr < nthr; ithr++)
+            if (status == success) status = thr_status[ithr];
+    }
+    stream->after_exec_hook();
+
+    return status;
+}
+
 } // namespace impl
 } // namespace dnnl
 
@@ -143,4 +312,14 @@ status_t dnnl_reorder_primitive_desc_create(
             new reorder_primitive_desc_iface_t(pd, e, src_engine, dst_engine));
 }
 
+status_t dnnl_reorder_execute_batch(stream_t *stream, int n,
+        const memory_t *const *src_memories, memory_t *const *dst_memories) {
+    if (any_null(stream) || n < 0
+            || (n > 0 && any_null(src_memories, dst_memories)))
+        return invalid_arguments;
+    if (n == 0) return success;
+
+    return reorder_execute_batch(stream, n, src_memories, dst_memories);
+}
+
 // vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -27,6 +27,10 @@ status_t reorder_primitive_desc_create(std::shared_ptr<primitive_desc_t> &pd,
         engine_t *engine, const memory_desc_t *src_md,
         const memory_desc_t *dst_md, const primitive_attr_t *attr = nullptr);
 
+// Executes `n` reorders from `src_memories` to `dst_memories` on `stream`.
+status_t reorder_execute_batch(stream_t *stream, int n,
+        const memory_t *const *src_memories, memory_t *const *dst_memories);
+
 } // namespace impl
 } // namespace dnnl
 
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2017-2022 Intel Corporation
+* Copyright 2017-2023 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -14,9 +14,15 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "engine.hpp"
+#include "host_allocator.hpp"
+#include "memory_debug.hpp"
+#include "scratchpad_debug.hpp"
 #include "utils.hpp"
 
 #if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
@@ -58,8 +64,186 @@ memory_storage_t *create_scratchpad_memory_storage(
     return mem_storage;
 }
 
+// Knobs of the shared scratchpad pool. All of them are read once.
+bool scratchpad_pool_requested() {
+    static const bool val = getenv_int_user("SCRATCHPAD_POOL", 0) != 0;
+    return val;
+}
+
+// Time in milliseconds an idle pool buffer is kept before it is released.
+// Non-positive value disables trimming.
+int scratchpad_pool_trim_ms() {
+    static const int val = getenv_int_user("SCRATCHPAD_POOL_TRIM_MS", 1000);
+    return val;
+}
+
+bool scratchpad_pool_huge_pages() {
+    static const bool val
+            = getenv_int_user("SCRATCHPAD_POOL_HUGE_PAGES", 1) != 0;
+    return val;
+}
+
+/*
+  A pool of host buffers shared by all threads. Each primitive execution takes
+  the smallest idle buffer that fits its scratchpad and gives it back once the
+  execution is completed, so the number of buffers alive is bounded by the
+  number of concurrent executions rather than by the number of threads that
+  ever executed a primitive.
+
+  Buffers that stay idle for longer than `scratchpad_pool_trim_ms()` are
+  released whenever a buffer is taken from or returned to the pool. There is
+  no background thread, hence trimming only happens while the pool is in use:
+  the buffers left idle by the last execution are kept until the next one.
+  Buffers
+  that are at least a huge page in size are aligned to the huge page boundary
+  and marked with MADV_HUGEPAGE to reduce TLB pressure in the kernels
+  touching them.
+*/
+struct scratchpad_pool_t {
+    static scratchpad_pool_t &get() {
+        // Intentionally leaked: scratchpads may be destroyed at program exit
+        // after static objects are gone.
+        static scratchpad_pool_t *pool = new scratchpad_pool_t();
+        return *pool;
+    }
+
+    void *acquire(size_t size, size_t &capacity) {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            trim(steady_clock_t::now());
+            size_t best = idle_.size();
+            for (size_t i = 0; i < idle_.size(); i++) {
+                if (idle_[i].capacity < size) continue;
+                if (best == idle_.size()
+                        || idle_[i].capacity < idle_[best].capacity)
+                    best = i;
+            }
+            if (best != idle_.size()) {
+                void *ptr = idle_[best].ptr;
+                capacity = idle_[best].capacity;
+                idle_[best] = idle_.back();
+                idle_.pop_back();
+                stats_.reuses++;
+                stats_.idle_buffers--;
+                stats_.idle_bytes -= capacity;
+                return ptr;
+            }
+        }
+
+        capacity = size;
+        void *ptr = allocate(capacity);
+        if (ptr) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stats_.allocations++;
+        }
+        return ptr;
+    }
+
+    void release(void *ptr, size_t capacity) {
+        if (ptr == nullptr) return;
+        std::lock_guard<std::mutex> guard(mutex_);
+        const auto now = steady_clock_t::now();
+        trim(now);
+        idle_.push_back({ptr, capacity, now});
+        stats_.idle_buffers++;
+        stats_.idle_bytes += capacity;
+    }
+
+    scratchpad_pool_stats_t stats() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return stats_;
+    }
+
+private:
+    using steady_clock_t = std::chrono::steady_clock;
+
+    struct buffer_t {
+        void *ptr;
+        size_t capacity;
+        steady_clock_t::time_point last_use;
+    };
+
+    static constexpr int default_alignment = 64;
+
+    scratchpad_pool_t() = default;
+
+    static void *allocate(size_t &capacity) {
+        using namespace host_allocator;
+        const bool use_huge_pages = scratchpad_pool_huge_pages()
+                && !memory_debug::is_mem_debug()
+                && capacity >= huge_page_size;
+        if (!use_huge_pages) return impl::malloc(capacity, default_alignment);
+
+        capacity = utils::rnd_up(capacity, huge_page_size);
+        void *ptr = impl::malloc(capacity, (int)huge_page_size);
+        if (ptr) advise_huge_pages(ptr, capacity);
+        return ptr;
+    }
+
+    // Must be called with `mutex_` acquired.
+    void trim(steady_clock_t::time_point now) {
+        const int trim_ms = scratchpad_pool_trim_ms();
+        if (trim_ms <= 0) return;
+        for (size_t i = 0; i < idle_.size();) {
+            if (now - idle_[i].last_use < std::chrono::milliseconds(trim_ms)) {
+                i++;
+                continue;
+            }
+            impl::free(idle_[i].ptr);
+            stats_.idle_buffers--;
+            stats_.idle_bytes -= idle_[i].capacity;
+            idle_[i] = idle_.back();
+            idle_.pop_back();
+        }
+    }
+
+    std::mutex mutex_;
+    std::vector<buffer_t> idle_;
+    scratchpad_pool_stats_t stats_ {};
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(scratchpad_pool_t);
+};
+
 } // namespace
 
+/*
+  Implementation of the scratchpad_t interface that borrows a buffer from the
+  shared scratchpad pool for its lifetime
+*/
+struct pooled_scratchpad_t : public scratchpad_t {
+    pooled_scratchpad_t(engine_t *engine, size_t size) : size_(0) {
+        ptr_ = scratchpad_pool_t::get().acquire(size, capacity_);
+        if (ptr_ == nullptr) return;
+
+        memory_storage_t *mem_storage = nullptr;
+        auto status = engine->create_memory_storage(
+                &mem_storage, memory_flags_t::use_runtime_ptr, size, ptr_);
+        if (status != status::success) return;
+
+        mem_storage_.reset(mem_storage);
+        size_ = size;
+    }
+
+    ~pooled_scratchpad_t() override {
+        mem_storage_.reset();
+        scratchpad_pool_t::get().release(ptr_, capacity_);
+    }
+
+    const memory_storage_t *get_memory_storage() const override {
+        return mem_storage_.get();
+    }
+
+    size_t size() const override { return size_; }
+
+private:
+    std::unique_ptr<memory_storage_t> mem_storage_;
+    void *ptr_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(pooled_scratchpad_t);
+};
+
 /*
   Implementation of the scratchpad_t interface that is compatible with
   a concurrent execution
@@ -139,10 +323,33 @@ thread_local size_t global_scratchpad_t::size_ = 0;
 thread_local unsigned int global_scratchpad_t::reference_count_ = 0;
 
 /*
-   Scratchpad creation routine
+   Scratchpad creation routines
 */
+bool use_scratchpad_pool(engine_t *engine) {
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE \
+        && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    // Pool buffers are returned right after `primitive_t::execute()`, hence
+    // the pool is limited to the runtimes with synchronous CPU execution.
+    // Protected scratchpads need their own guard pages and bypass the pool.
+    return scratchpad_pool_requested()
+            && !scratchpad_debug::is_protect_scratchpad()
+            && engine->kind() == engine_kind::cpu
+            && is_native_runtime(engine->runtime_kind());
+#else
+    UNUSED(engine);
+    return false;
+#endif
+}
+
+scratchpad_pool_stats_t get_scratchpad_pool_stats() {
+    return scratchpad_pool_t::get().stats();
+}
+
 scratchpad_t *create_scratchpad(
         engine_t *engine, size_t size, bool use_global_scratchpad) {
+    if (use_scratchpad_pool(engine))
+        return new pooled_scratchpad_t(engine, size);
+
 #ifndef DNNL_ENABLE_CONCURRENT_EXEC
     /*
      * TODO: global scratchpad should be able to handle memory
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2017-2020 Intel Corporation
+* Copyright 2017-2023 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -30,6 +30,23 @@ struct scratchpad_t {
     virtual size_t size() const = 0;
 };
 
+// Returns true if library-managed scratchpads for `engine` are borrowed from
+// the shared scratchpad pool on every execution (enabled with the
+// ONEDNN_SCRATCHPAD_POOL environment variable) rather than owned by primitives.
+bool use_scratchpad_pool(engine_t *engine);
+
+// Counters of the shared scratchpad pool. `allocations` and `reuses` count
+// the buffers handed out by the pool, `idle_buffers` and `idle_bytes` describe
+// the buffers currently kept for reuse.
+struct scratchpad_pool_stats_t {
+    size_t allocations;
+    size_t reuses;
+    size_t idle_buffers;
+    size_t idle_bytes;
+};
+
+scratchpad_pool_stats_t DNNL_API get_scratchpad_pool_stats();
+
 scratchpad_t *create_scratchpad(
         engine_t *engine, size_t size, bool use_global_scratchpad);
 
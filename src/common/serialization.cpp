@@ -50,6 +50,8 @@ status_t serialize_desc(
         CASE(shuffle)
         CASE(softmax)
         CASE(sum)
+        CASE(topk)
+        CASE(embedding_bag)
         default: return status::invalid_arguments;
     }
 #undef CASE
@@ -199,6 +201,16 @@ void serialize_attr(
         sstream.write(attr.rnn_weights_qparams_.scales_,
                 attr.rnn_weights_qparams_.count_);
     }
+    if (!attr.softmax_pre_ops_.has_default_values()) {
+        // softmax_pre_ops: scale, mask_kind, mask_desc
+        sstream.write(&attr.softmax_pre_ops_.scale_);
+        sstream.write(&attr.softmax_pre_ops_.mask_kind_);
+        serialize_md(sstream, attr.softmax_pre_ops_.mask_desc_);
+    }
+    if (!attr.src_dyn_quant_params_.has_default_values()) {
+        // src_dyn_quant_params: group_size
+        sstream.write(&attr.src_dyn_quant_params_.group_size_);
+    }
     if (attr.gpu_attr_) {
         attr.gpu_attr_->serialize(sstream);
     } else {
@@ -532,6 +544,29 @@ void serialize_desc(serialization_stream_t &sstream, const sum_desc_t &desc) {
         serialize_md(sstream, *desc.src_mds[i]);
 }
 
+void serialize_desc(serialization_stream_t &sstream, const topk_desc_t &desc) {
+    // Kinds
+    sstream.write(&desc.primitive_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.src_desc);
+    serialize_md(sstream, desc.dst_desc);
+    serialize_md(sstream, desc.indices_desc);
+    // Axis
+    sstream.write(&desc.axis);
+}
+
+void serialize_desc(
+        serialization_stream_t &sstream, const embedding_bag_desc_t &desc) {
+    // Kinds
+    sstream.write(&desc.primitive_kind);
+    sstream.write(&desc.alg_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.src_desc);
+    serialize_md(sstream, desc.indices_desc);
+    serialize_md(sstream, desc.offsets_desc);
+    serialize_md(sstream, desc.dst_desc);
+}
+
 } // namespace serialization
 } // namespace impl
 } // namespace dnnl
@@ -60,6 +60,9 @@ void serialize_desc(
 void serialize_desc(
         serialization_stream_t &sstream, const softmax_desc_t &desc);
 void serialize_desc(serialization_stream_t &sstream, const sum_desc_t &desc);
+void serialize_desc(serialization_stream_t &sstream, const topk_desc_t &desc);
+void serialize_desc(
+        serialization_stream_t &sstream, const embedding_bag_desc_t &desc);
 
 status_t serialize_desc(
         serialization_stream_t &sstream, const op_desc_t *op_desc);
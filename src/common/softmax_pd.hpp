@@ -122,6 +122,9 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
         if (arg == DNNL_ARG_WORKSPACE && (!types::is_zero_md(workspace_md())))
             return arg_usage_t::output;
 
+        if (arg == DNNL_ARG_ATTR_SOFTMAX_MASK && with_mask_buffer())
+            return arg_usage_t::input;
+
         return primitive_desc_t::arg_usage(arg);
     }
 
@@ -129,6 +132,9 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
         switch (arg) {
             case DNNL_ARG_SRC: return src_md(0);
             case DNNL_ARG_DST: return dst_md(0);
+            case DNNL_ARG_ATTR_SOFTMAX_MASK:
+                return with_mask_buffer() ? &pre_ops().mask_desc_
+                                          : &glob_zero_md;
             default: return softmax_pd_t::arg_md(arg);
         }
     }
@@ -140,11 +146,22 @@ struct softmax_fwd_pd_t : public softmax_pd_t {
         return index == 0 ? &dst_md_ : &glob_zero_md;
     }
 
-    int n_inputs() const override { return 1 + n_binary_po_inputs(); }
+    int n_inputs() const override {
+        return 1 + with_mask_buffer() + n_binary_po_inputs();
+    }
     int n_outputs() const override {
         return 1 + (!types::is_zero_md(workspace_md()));
     }
 
+    const softmax_pre_ops_t &pre_ops() const {
+        return attr()->softmax_pre_ops_;
+    }
+    bool with_pre_ops() const { return !pre_ops().has_default_values(); }
+    bool with_mask_buffer() const {
+        return pre_ops().mask_kind_ == softmax_mask_kind::buffer;
+    }
+    bool with_causal_mask() const { return pre_ops().with_causal_mask(); }
+
 protected:
     memory_desc_t src_md_;
 
@@ -170,6 +187,23 @@ protected:
         }
         return ok;
     }
+
+    // A mask buffer must be plain and broadcastable to the source; a causal
+    // mask acts on the last two dimensions with the softmax axis last.
+    bool attr_pre_ops_ok() const {
+        if (!with_pre_ops()) return true;
+        if (with_causal_mask()) return ndims() >= 2 && axis() == ndims() - 1;
+        if (!with_mask_buffer()) return true;
+
+        const memory_desc_wrapper mask_d(pre_ops().mask_desc_);
+        bool ok = mask_d.ndims() == ndims()
+                && utils::one_of(mask_d.data_type(), data_type::f32,
+                        data_type::bf16, data_type::f16)
+                && mask_d.is_plain() && !mask_d.has_runtime_dims_or_strides();
+        for (int d = 0; d < ndims() && ok; d++)
+            ok = utils::one_of(mask_d.dims()[d], 1, src_md_.dims[d]);
+        return ok;
+    }
 };
 
 struct softmax_bwd_pd_t : public softmax_pd_t {
@@ -47,6 +47,11 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
     /** blocks until all submitted primitives to the stream are completed */
     virtual dnnl::impl::status_t wait() = 0;
 
+    /** returns true if enqueue_primitive() may return before the primitive is
+     * executed on the host; such a stream executes the primitive later with
+     * dnnl::impl::primitive_execute_deferred() */
+    virtual bool defers_host_execution() const { return false; }
+
     virtual void before_exec_hook() {}
     virtual void after_exec_hook() {}
 
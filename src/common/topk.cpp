@@ -0,0 +1,103 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "oneapi/dnnl/dnnl.h"
+#include "opdesc.hpp"
+#include "primitive_desc_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::utils;
+
+#define VCHECK_TOPK(cond, msg, ...) \
+    VCONDCHECK(create, check, topk, (cond), status::invalid_arguments, msg, \
+            ##__VA_ARGS__);
+
+namespace dnnl {
+namespace impl {
+
+status_t topk_desc_init(topk_desc_t *topk_desc, const memory_desc_t *src_desc,
+        const memory_desc_t *dst_desc, const memory_desc_t *indices_desc,
+        int axis) {
+    VCHECK_TOPK(!any_null(src_desc, dst_desc, indices_desc), VERBOSE_NULL_ARG);
+    VCHECK_TOPK(src_desc->format_kind != format_kind::any,
+            VERBOSE_UNSUPPORTED_TAG_S, "src");
+    VCHECK_TOPK(axis >= 0 && axis < src_desc->ndims, VERBOSE_BAD_AXIS);
+
+    VCHECK_TOPK(src_desc->ndims == dst_desc->ndims, VERBOSE_INCONSISTENT_NDIMS,
+            "src", "dst");
+    VCHECK_TOPK(src_desc->ndims == indices_desc->ndims,
+            VERBOSE_INCONSISTENT_NDIMS, "src", "indices");
+
+    for (int d = 0; d < src_desc->ndims; ++d) {
+        const dim_t src_dim = src_desc->dims[d], dst_dim = dst_desc->dims[d];
+        const bool dst_dim_ok = d == axis ? dst_dim > 0 && dst_dim <= src_dim
+                                          : dst_dim == src_dim;
+        VCHECK_TOPK(dst_dim_ok, VERBOSE_INCONSISTENT_DIM, "src", d, "dst", d);
+        VCHECK_TOPK(indices_desc->dims[d] == dst_desc->dims[d],
+                VERBOSE_INCONSISTENT_DIM, "dst", d, "indices", d);
+    }
+
+    VCHECK_TOPK(indices_desc->data_type == data_type::s32,
+            VERBOSE_INVALID_DATATYPE, "indices");
+
+    VCONDCHECK(create, check, topk,
+            !memory_desc_wrapper(src_desc).has_runtime_dims_or_strides(),
+            status::unimplemented, VERBOSE_RUNTIMEDIM_UNSUPPORTED);
+    VCONDCHECK(create, check, topk,
+            !memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides(),
+            status::unimplemented, VERBOSE_RUNTIMEDIM_UNSUPPORTED);
+    VCONDCHECK(create, check, topk,
+            !memory_desc_wrapper(indices_desc).has_runtime_dims_or_strides(),
+            status::unimplemented, VERBOSE_RUNTIMEDIM_UNSUPPORTED);
+
+    VCHECK_TOPK(src_desc->extra.flags == 0, VERBOSE_UNSUPPORTED_MD_FLAG, "src");
+    VCHECK_TOPK(IMPLICATION(dst_desc->format_kind == format_kind::blocked,
+                        dst_desc->extra.flags == 0),
+            VERBOSE_UNSUPPORTED_MD_FLAG, "dst");
+    VCHECK_TOPK(IMPLICATION(indices_desc->format_kind == format_kind::blocked,
+                        indices_desc->extra.flags == 0),
+            VERBOSE_UNSUPPORTED_MD_FLAG, "indices");
+
+    auto td = topk_desc_t();
+    td.primitive_kind = primitive_kind::topk;
+    td.src_desc = *src_desc;
+    td.dst_desc = *dst_desc;
+    td.indices_desc = *indices_desc;
+    td.axis = axis;
+
+    (*topk_desc) = td;
+    return success;
+}
+
+} // namespace impl
+} // namespace dnnl
+
+dnnl_status_t dnnl_topk_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        const memory_desc_t *src_desc, const memory_desc_t *dst_desc,
+        const memory_desc_t *indices_desc, int axis,
+        const primitive_attr_t *attr) {
+
+    auto topk_desc = topk_desc_t();
+    CHECK(topk_desc_init(&topk_desc, src_desc, dst_desc, indices_desc, axis));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&topk_desc, nullptr, attr);
+}
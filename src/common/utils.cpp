@@ -39,6 +39,7 @@
 
 #include "oneapi/dnnl/dnnl.h"
 
+#include "host_allocator.hpp"
 #include "memory_debug.hpp"
 #include "utils.hpp"
 
@@ -144,29 +145,17 @@ int getpagesize() {
 }
 
 void *malloc(size_t size, int alignment) {
-    void *ptr;
     if (memory_debug::is_mem_debug())
         return memory_debug::malloc(size, alignment);
 
-#ifdef _WIN32
-    ptr = _aligned_malloc(size, alignment);
-    int rc = ptr ? 0 : -1;
-#else
-    int rc = ::posix_memalign(&ptr, alignment, size);
-#endif
-
-    return (rc == 0) ? ptr : nullptr;
+    return host_allocator::malloc(size, alignment);
 }
 
 void free(void *p) {
 
     if (memory_debug::is_mem_debug()) return memory_debug::free(p);
 
-#ifdef _WIN32
-    _aligned_free(p);
-#else
-    ::free(p);
-#endif
+    host_allocator::free(p);
 }
 
 // Atomic operations
@@ -40,6 +40,7 @@
 #include "convolution_pd.hpp"
 #include "deconvolution_pd.hpp"
 #include "eltwise_pd.hpp"
+#include "embedding_bag_pd.hpp"
 #include "inner_product_pd.hpp"
 #include "layer_normalization_pd.hpp"
 #include "lrn_pd.hpp"
@@ -53,6 +54,7 @@
 #include "shuffle_pd.hpp"
 #include "softmax_pd.hpp"
 #include "sum_pd.hpp"
+#include "topk_pd.hpp"
 
 #if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
 #include "common/dnnl_thread.hpp"
@@ -597,6 +599,29 @@ std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
            << ";";
     }
 
+    const softmax_pre_ops_t &sm_pre_ops = attr->softmax_pre_ops_;
+    if (!sm_pre_ops.has_default_values()) {
+        ss << "attr-softmax-pre-ops:" << sm_pre_ops.scale_;
+        switch (sm_pre_ops.mask_kind_) {
+            case softmax_mask_kind::buffer:
+                ss << ":buffer:" << sm_pre_ops.mask_desc_.data_type << ":"
+                   << md2dim_str(&sm_pre_ops.mask_desc_);
+                break;
+            case softmax_mask_kind::causal_top_left:
+                ss << ":causal_tl";
+                break;
+            case softmax_mask_kind::causal_bottom_right:
+                ss << ":causal_br";
+                break;
+            default: break;
+        }
+        ss << " ";
+    }
+
+    const src_dyn_quant_params_t &dyn_quant = attr->src_dyn_quant_params_;
+    if (!dyn_quant.has_default_values())
+        ss << "attr-src-dyn-quant:" << dyn_quant.group_size_ << " ";
+
     return ss;
 }
 
@@ -1069,6 +1094,47 @@ static std::string init_info_sum(const engine_t *e, const pd_t *pd) {
     return ss.str();
 }
 
+template <typename pd_t>
+static std::string init_info_topk(const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << "," << prop_kind::undef
+       << ",";
+
+    auto src_md = pd->src_md();
+    auto dst_md = pd->dst_md(0);
+    auto indices_md = pd->dst_md(1);
+    ss << "src_" << src_md << " dst_" << dst_md << " indices_" << indices_md
+       << ",";
+
+    ss << pd->attr() << ",";
+    ss << "axis:" << pd->axis() << " k:" << pd->k() << ",";
+    ss << md2dim_str(src_md) << ":" << md2dim_str(dst_md);
+
+    return ss.str();
+}
+
+template <typename pd_t>
+static std::string init_info_embedding_bag(const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << "," << prop_kind::undef
+       << ",";
+
+    auto src_md = pd->src_md(0);
+    auto indices_md = pd->src_md(1);
+    auto dst_md = pd->dst_md();
+    ss << "src_" << src_md << " indices_" << indices_md;
+    if (pd->with_offsets()) ss << " offsets_" << pd->src_md(2);
+    ss << " dst_" << dst_md << ",";
+
+    ss << pd->attr() << ",";
+    ss << "alg:" << pd->desc()->alg_kind << ",";
+    ss << md2dim_str(src_md) << ":" << md2dim_str(indices_md);
+    if (pd->with_offsets()) ss << ":" << md2dim_str(pd->src_md(2));
+    ss << ":" << md2dim_str(dst_md);
+
+    return ss.str();
+}
+
 } // namespace
 
 void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
@@ -1101,6 +1167,8 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             CASE(shuffle);
             CASE(softmax);
             CASE(sum);
+            CASE(topk);
+            CASE(embedding_bag);
             case primitive_kind::zero_pad: break;
             default: assert(!"unknown primitive kind");
         }
@@ -0,0 +1,54 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_CPU_EMBEDDING_BAG_PD_HPP
+#define CPU_CPU_EMBEDDING_BAG_PD_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/embedding_bag_pd.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+#include "cpu/cpu_engine.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+struct cpu_embedding_bag_pd_t : public embedding_bag_pd_t {
+    using embedding_bag_pd_t::embedding_bag_pd_t;
+
+    bool with_per_row_scales() const {
+        return attr()->scales_.get(DNNL_ARG_SRC).mask_ == 1;
+    }
+
+    // Returns the range [begin, end) of the indices pooled into the bag `b`.
+    void bag_range(const int32_t *offsets, const memory_desc_wrapper &offsets_d,
+            dim_t b, dim_t &begin, dim_t &end) const {
+        if (!with_offsets()) {
+            begin = b;
+            end = b + 1;
+            return;
+        }
+        begin = offsets[offsets_d.off_l(b)];
+        end = b + 1 < nbags() ? offsets[offsets_d.off_l(b + 1)] : nindices();
+    }
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
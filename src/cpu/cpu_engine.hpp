@@ -69,6 +69,8 @@ DECLARE_IMPL_LIST(resampling);
 DECLARE_IMPL_LIST(rnn);
 DECLARE_IMPL_LIST(shuffle);
 DECLARE_IMPL_LIST(softmax);
+DECLARE_IMPL_LIST(topk);
+DECLARE_IMPL_LIST(embedding_bag);
 
 #undef DECLARE_IMPL_LIST
 
@@ -104,6 +106,8 @@ public:
             CASE(rnn);
             CASE(shuffle);
             CASE(softmax);
+            CASE(topk);
+            CASE(embedding_bag);
             default: assert(!"unknown primitive kind"); return empty_list;
         }
 #undef CASE
@@ -31,6 +31,28 @@ namespace cpu {
 
 struct cpu_softmax_fwd_pd_t : public softmax_fwd_pd_t {
     using softmax_fwd_pd_t::softmax_fwd_pd_t;
+
+    // Returns the offset in the mask buffer of the source element at the
+    // logical position `pos`; broadcast dimensions of the mask are skipped.
+    dim_t mask_off(const dims_t pos) const {
+        const memory_desc_wrapper mask_d(pre_ops().mask_desc_);
+        dims_t mask_pos;
+        for (int d = 0; d < ndims(); d++)
+            mask_pos[d] = mask_d.dims()[d] == 1 ? 0 : pos[d];
+        return mask_d.off_v(mask_pos);
+    }
+
+    // Returns the number of leading elements along the softmax axis which
+    // the causal mask keeps in the row `row` of the last but one dimension.
+    dim_t causal_len(dim_t row) const {
+        const dim_t M = src_md_.dims[ndims() - 2];
+        const dim_t N = axis_size();
+        const dim_t shift = pre_ops().mask_kind_
+                        == softmax_mask_kind::causal_bottom_right
+                ? N - M
+                : 0;
+        return nstl::max<dim_t>(0, nstl::min<dim_t>(row + 1 + shift, N));
+    }
 };
 
 struct cpu_softmax_bwd_pd_t : public softmax_bwd_pd_t {
@@ -0,0 +1,267 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/dnnl_thread.hpp"
+#include "common/memory.hpp"
+#include "common/primitive_desc_iface.hpp"
+#include "common/primitive_exec_types.hpp"
+#include "common/primitive_iface.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_stream.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+/*
+  Executor of an out-of-order CPU stream.
+
+  Each submitted primitive becomes a task. The task executes the primitive on
+  private copies of the memory arguments that capture the data handles at
+  submission, so a handle changed by the user after the submission affects
+  neither the execution nor the dependencies. The task records the address
+  ranges it reads and writes: the memory arguments (const arguments are
+  read, the rest are written). A deferred primitive doesn't use the
+  scratchpad it owns but gets one per execution (see
+  dnnl_primitive::execute()), so executions of the same primitive don't
+  conflict. A new task depends on every in-flight task it has a
+  read-after-write, write-after-read or write-after-write conflict with, so
+  the results match the in-order execution.
+
+  Ready tasks are executed by the threading runtime of the library. With TBB
+  they are enqueued to a task arena of the stream and run asynchronously.
+  OpenMP and the sequential runtime have no asynchronous tasks, so the ready
+  tasks are run by the thread that waits for the stream. In both cases a
+  primitive uses the threading runtime for its internal parallelism as usual
+  and no threads are created by the stream.
+*/
+struct ooo_executor_t {
+    ooo_executor_t()
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+        : arena_(dnnl_get_max_threads(), 0)
+#endif
+    {
+    }
+
+    ~ooo_executor_t() { wait(); }
+
+    status_t submit(const primitive_iface_t *primitive_iface,
+            const exec_ctx_t &ctx) {
+        std::vector<std::unique_ptr<memory_t>> snapshots;
+        exec_args_t args;
+        CHECK(snapshot_args(ctx, snapshots, args));
+        std::unique_ptr<task_t> task(new task_t(
+                primitive_iface, ctx, std::move(args), std::move(snapshots)));
+        init_ranges(*task);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (auto &t : in_flight_) {
+            if (!conflicts(*t, *task)) continue;
+            t->dependents.push_back(task.get());
+            task->n_deps++;
+        }
+        const_cast<primitive_iface_t *>(primitive_iface)->retain();
+        in_flight_.push_back(std::move(task));
+        task_t *t = in_flight_.back().get();
+        t->pos = std::prev(in_flight_.end());
+        if (t->n_deps == 0) schedule(t);
+        return status::success;
+    }
+
+    status_t wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!ready_.empty()) {
+            task_t *task = ready_.front();
+            ready_.pop_front();
+            lock.unlock();
+            run(task);
+            lock.lock();
+        }
+        done_cv_.wait(lock, [this]() { return in_flight_.empty(); });
+        status_t status = status_;
+        status_ = status::success;
+        return status;
+    }
+
+private:
+    struct range_t {
+        uintptr_t begin, end;
+        bool is_write;
+    };
+
+    struct task_t {
+        task_t(const primitive_iface_t *primitive_iface, const exec_ctx_t &ctx,
+                exec_args_t &&args,
+                std::vector<std::unique_ptr<memory_t>> &&snapshots)
+            : primitive_iface(primitive_iface)
+            , snapshots(std::move(snapshots))
+            , ctx(ctx, std::move(args)) {}
+
+        const primitive_iface_t *primitive_iface;
+        // Memory arguments with the data handles taken at submission.
+        std::vector<std::unique_ptr<memory_t>> snapshots;
+        exec_ctx_t ctx;
+        std::vector<range_t> ranges;
+        std::vector<task_t *> dependents;
+        int n_deps = 0;
+        std::list<std::unique_ptr<task_t>>::iterator pos;
+    };
+
+    static status_t snapshot_args(const exec_ctx_t &ctx,
+            std::vector<std::unique_ptr<memory_t>> &snapshots,
+            exec_args_t &args) {
+        // The same memory may be passed as several arguments, e.g. for an
+        // in-place execution, and keeps being a single object.
+        std::unordered_map<const memory_t *, memory_t *> mem2snapshot;
+        for (const auto &arg : ctx.args()) {
+            const memory_t *mem = arg.second.mem;
+            if (mem == nullptr) {
+                args[arg.first] = arg.second;
+                continue;
+            }
+            auto it = mem2snapshot.find(mem);
+            if (it != mem2snapshot.end()) {
+                args[arg.first] = {it->second, arg.second.is_const};
+                continue;
+            }
+            const int nhandles = (int)mem->get_num_handles();
+            std::vector<unsigned> flags(
+                    nhandles, memory_flags_t::use_runtime_ptr);
+            std::vector<void *> handles(nhandles, nullptr);
+            for (int i = 0; i < nhandles; i++)
+                CHECK(mem->get_data_handle(&handles[i], i));
+
+            std::unique_ptr<memory_t> snapshot(
+                    new memory_t(mem->engine(), mem->md(), flags, handles));
+            if (snapshot->get_num_handles() != (size_t)nhandles)
+                return status::out_of_memory;
+            for (int i = 0; i < nhandles; i++)
+                snapshot->memory_storage(i)->set_offset(
+                        mem->memory_storage(i)->offset());
+
+            args[arg.first] = {snapshot.get(), arg.second.is_const};
+            mem2snapshot[mem] = snapshot.get();
+            snapshots.push_back(std::move(snapshot));
+        }
+        return status::success;
+    }
+
+    static void init_ranges(task_t &task) {
+        for (const auto &arg : task.ctx.args()) {
+            const memory_t *mem = arg.second.mem;
+            if (mem == nullptr) continue;
+            const memory_desc_wrapper mdw(mem->md());
+            for (int i = 0; i < (int)mem->get_num_handles(); i++) {
+                const auto *storage = mem->memory_storage(i);
+                if (storage == nullptr || storage->is_null()) continue;
+                const auto begin
+                        = reinterpret_cast<uintptr_t>(storage->data_handle())
+                        + storage->offset();
+                const size_t size = mdw.size(i);
+                if (size == 0) continue;
+                task.ranges.push_back(
+                        {begin, begin + size, !arg.second.is_const});
+            }
+        }
+    }
+
+    static bool conflicts(const task_t &prev, const task_t &next) {
+        for (const auto &a : prev.ranges) {
+            for (const auto &b : next.ranges) {
+                if (!(a.is_write || b.is_write)) continue;
+                if (a.begin < b.end && b.begin < a.end) return true;
+            }
+        }
+        return false;
+    }
+
+    // Hands a task without pending dependencies over for execution. Called
+    // with the mutex held.
+    void schedule(task_t *task) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+        arena_.enqueue([this, task]() { run(task); });
+#else
+        ready_.push_back(task);
+#endif
+    }
+
+    void run(task_t *task) {
+        status_t status
+                = primitive_execute_deferred(task->primitive_iface, task->ctx);
+        const_cast<primitive_iface_t *>(task->primitive_iface)->release();
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (status != status::success && status_ == status::success)
+            status_ = status;
+        for (task_t *d : task->dependents)
+            if (--d->n_deps == 0) schedule(d);
+        in_flight_.erase(task->pos);
+        if (in_flight_.empty()) done_cv_.notify_all();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+    std::list<std::unique_ptr<task_t>> in_flight_;
+    // Ready tasks waiting for a thread that waits for the stream. Only used
+    // by the threading runtimes without asynchronous tasks.
+    std::deque<task_t *> ready_;
+    status_t status_ = status::success;
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+    tbb::task_arena arena_;
+#endif
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(ooo_executor_t);
+};
+
+cpu_stream_t::cpu_stream_t(engine_t *engine, unsigned flags)
+    : stream_t(engine, flags) {
+#if DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    if (flags & stream_flags::out_of_order)
+        ooo_executor_.reset(new ooo_executor_t());
+#endif
+}
+
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+cpu_stream_t::cpu_stream_t(engine_t *engine,
+        dnnl::threadpool_interop::threadpool_iface *threadpool)
+    : stream_t(engine, threadpool) {}
+#endif
+
+cpu_stream_t::~cpu_stream_t() = default;
+
+status_t cpu_stream_t::enqueue_primitive(
+        const primitive_iface_t *primitive_iface, exec_ctx_t &ctx) {
+    if (ooo_executor_) return ooo_executor_->submit(primitive_iface, ctx);
+    return stream_t::enqueue_primitive(primitive_iface, ctx);
+}
+
+status_t cpu_stream_t::wait() {
+    // In-order CPU execution is synchronous so return immediately
+    if (!ooo_executor_) return status::success;
+    return ooo_executor_->wait();
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
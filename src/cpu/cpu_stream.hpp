@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2019-2020 Intel Corporation
+* Copyright 2019-2023 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -23,6 +23,8 @@
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
 #endif
 
+#include <memory>
+
 #include "common/c_types_map.hpp"
 #include "common/dnnl_thread.hpp"
 #include "common/stream.hpp"
@@ -31,19 +33,34 @@ namespace dnnl {
 namespace impl {
 namespace cpu {
 
+// Executes primitives submitted to an out-of-order CPU stream with the
+// threading runtime of the library. See cpu_stream.cpp for details.
+struct ooo_executor_t;
+
 struct cpu_stream_t : public stream_t {
-    cpu_stream_t(engine_t *engine, unsigned flags) : stream_t(engine, flags) {}
-    virtual ~cpu_stream_t() = default;
+    cpu_stream_t(engine_t *engine, unsigned flags);
+    ~cpu_stream_t() override;
+
+    // In-order CPU execution is synchronous: a primitive is executed on the
+    // calling thread. An out-of-order stream enqueues the primitive and
+    // returns immediately; the primitive starts once all the primitives
+    // previously submitted to the stream and accessing the same memory are
+    // completed.
+    dnnl::impl::status_t enqueue_primitive(
+            const primitive_iface_t *primitive_iface,
+            dnnl::impl::exec_ctx_t &ctx) override;
 
-    dnnl::impl::status_t wait() override {
-        // CPU execution is synchronous so return immediately
-        return dnnl::impl::status::success;
+    // Blocks until all submitted primitives are completed and returns the
+    // first error they reported, if any.
+    dnnl::impl::status_t wait() override;
+
+    bool defers_host_execution() const override {
+        return ooo_executor_ != nullptr;
     }
 
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     cpu_stream_t(engine_t *engine,
-            dnnl::threadpool_interop::threadpool_iface *threadpool)
-        : stream_t(engine, threadpool) {}
+            dnnl::threadpool_interop::threadpool_iface *threadpool);
 
     void before_exec_hook() override {
         dnnl::threadpool_interop::threadpool_iface *tp;
@@ -55,6 +72,9 @@ struct cpu_stream_t : public stream_t {
         threadpool_utils::deactivate_threadpool();
     }
 #endif
+
+private:
+    std::unique_ptr<ooo_executor_t> ooo_executor_;
 };
 
 } // namespace cpu
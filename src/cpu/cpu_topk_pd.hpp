@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_CPU_TOPK_PD_HPP
+#define CPU_CPU_TOPK_PD_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/topk_pd.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+#include "cpu/cpu_engine.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+struct cpu_topk_pd_t : public topk_pd_t {
+    using topk_pd_t::topk_pd_t;
+
+    // The selections are independent along the dimensions before (outer) and
+    // after (inner) the axis.
+    dim_t outer_size() const {
+        return utils::array_product(src_md()->dims, axis());
+    }
+    dim_t inner_size() const {
+        const int ndims = src_md()->ndims;
+        return utils::array_product(
+                src_md()->dims + axis() + 1, ndims - axis() - 1);
+    }
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
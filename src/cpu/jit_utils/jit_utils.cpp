@@ -17,6 +17,7 @@
 
 #include <mutex>
 
+#include "common/cache_utils.hpp"
 #include "common/utils.hpp"
 #include "common/verbose.hpp"
 
@@ -123,6 +124,9 @@ void register_jit_code_linux_perf(const void *code, size_t code_size,
 
 void register_jit_code(const void *code, size_t code_size,
         const char *code_name, const char *source_file_name) {
+    // Charge the code to the primitive cache entry being created, if any.
+    utils::cache_footprint_t::account(code_size);
+
     // The #ifdef guards are required to avoid generating a function that only
     // consists of lock and unlock code
 #if DNNL_ENABLE_JIT_PROFILING || DNNL_ENABLE_JIT_DUMP
@@ -25,6 +25,7 @@
 
 #include "cpu/cpu_primitive.hpp"
 #include "cpu/ref_io_helper.hpp"
+#include "cpu/simple_q10n.hpp"
 
 #include "cpu/matmul/matmul_utils.hpp"
 #include "cpu/matmul/ref_matmul.hpp"
@@ -97,6 +98,45 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
         return acc;
     };
 
+    // dynamically quantized src section: each group of src values along K is
+    // quantized to s8 with a symmetric scale derived from its absolute maximum
+    const dim_t dyn_quant_group_size = static_cast<dim_t>(
+            pd()->attr()->src_dyn_quant_params_.group_size_);
+    auto ker_src_dyn_quant = [&](const dims_t dst_dims_idx, dim_t m, dim_t n) {
+        float acc = 0;
+        dims_t src_dims_idx, weights_dims_idx;
+        utils::copy_dims_with_mask(src_dims_idx, dst_dims_idx, ndims, src_mask);
+        utils::copy_dims_with_mask(
+                weights_dims_idx, dst_dims_idx, ndims, wei_mask);
+        src_dims_idx[ndims - 2] = m;
+        weights_dims_idx[ndims - 1] = n;
+        auto &src_k_dim = src_dims_idx[ndims - 1];
+        auto &wei_k_dim = weights_dims_idx[ndims - 2];
+        for (dim_t g = 0; g < K; g += dyn_quant_group_size) {
+            const dim_t k_end = g + dyn_quant_group_size;
+            float absmax = 0.f;
+            for (dim_t k = g; k < k_end; ++k) {
+                src_k_dim = k;
+                const float s = io::load_float_value(
+                        src_d.data_type(), src, src_d.off_v(src_dims_idx));
+                absmax = nstl::max(absmax, ::fabsf(s));
+            }
+            const float mult = 127.f / nstl::max(absmax, 1e-30f);
+            int32_t acc_g = 0;
+            for (dim_t k = g; k < k_end; ++k) {
+                src_k_dim = k;
+                wei_k_dim = k;
+                const float s = io::load_float_value(
+                        src_d.data_type(), src, src_d.off_v(src_dims_idx));
+                const int32_t w = io::load_int_value(weights_d.data_type(),
+                        weights, weights_d.off_v(weights_dims_idx));
+                acc_g += saturate_and_round<int8_t>(s * mult) * w;
+            }
+            acc += acc_g * (absmax * (1.f / 127.f));
+        }
+        return acc;
+    };
+
     // bias section
     auto ker_bias = [&](const dims_t &dst_dims_idx) -> float {
         dims_t bia_dims_idx;
@@ -124,7 +164,9 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
         // account for M, N dims for index calculations
         const size_t l_offset = mb * M * N + m * N + n;
         utils::l_dims_by_l_offset(dst_dims_idx, l_offset, dst_d.dims(), ndims);
-        float d = ker(dst_dims_idx, m, n);
+        float d = dyn_quant_group_size > 0
+                ? ker_src_dyn_quant(dst_dims_idx, m, n)
+                : ker(dst_dims_idx, m, n);
         if (with_src_scales) d *= src_scales[0];
         if (with_wei_scales) d *= wei_scales[wei_scale_stride * n];
         if (bias) d += ker_bias(dst_dims_idx);
@@ -48,11 +48,15 @@ struct ref_matmul_t : public primitive_t {
             const auto wei_type = weights_md(0)->data_type;
             const auto bia_type = weights_md(1)->data_type;
             const auto dst_type = dst_md(0)->data_type;
+            const bool with_src_dyn_quant
+                    = !attr()->src_dyn_quant_params_.has_default_values();
 
             bool ok = is_dense_data() && utils::one_of(src_type, f32, bf16, f16)
-                    && utils::one_of(wei_type, f32, bf16, f16)
                     && utils::one_of(dst_type, f32, bf16, f16)
-                    && src_type == wei_type
+                    && (with_src_dyn_quant
+                                    ? wei_type == s8 && src_dyn_quant_ok()
+                                    : utils::one_of(wei_type, f32, bf16, f16)
+                                            && src_type == wei_type)
                     && IMPLICATION(src_type == f32, dst_type == f32)
                     && IMPLICATION(src_type == bf16,
                             utils::one_of(dst_type, f32, bf16))
@@ -68,7 +72,8 @@ struct ref_matmul_t : public primitive_t {
                                             utils::one_of(bia_type, f32, bf16)))
                     && platform::has_data_type_support(src_type)
                     && attr()->has_default_values(smask_t::scales_runtime
-                                    | smask_t::post_ops | smask_t::sum_dt,
+                                    | smask_t::post_ops | smask_t::sum_dt
+                                    | smask_t::src_dyn_quant_params,
                             dst_type)
                     && attr_.post_ops_.check_sum_consistency(dst_type,
                             /* is_int8 */ false)
@@ -76,6 +81,14 @@ struct ref_matmul_t : public primitive_t {
                     && attr_.set_default_formats(dst_md(0)) == status::success;
             return ok ? status::success : status::unimplemented;
         }
+
+    private:
+        bool src_dyn_quant_ok() const {
+            const dim_t group_size = static_cast<dim_t>(
+                    attr()->src_dyn_quant_params_.group_size_);
+            return !has_runtime_dims_or_strides() && K() % group_size == 0
+                    && attr()->scales_.get(DNNL_ARG_SRC).has_default_values();
+        }
     };
 
     ref_matmul_t(const pd_t *apd) : primitive_t(apd) {}
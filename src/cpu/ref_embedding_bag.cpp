@@ -0,0 +1,70 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/ref_embedding_bag.hpp"
+#include "cpu/ref_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_embedding_bag_t::execute(const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto indices = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_1);
+    auto offsets = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_2);
+    auto dst = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DST, status);
+    CHECK(status);
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+
+    const memory_desc_wrapper src_d(pd()->src_md(0));
+    const memory_desc_wrapper indices_d(pd()->src_md(1));
+    const memory_desc_wrapper offsets_d(pd()->src_md(2));
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+
+    const bool per_row_scales = pd()->with_per_row_scales();
+    const bool is_mean = pd()->is_mean();
+
+    parallel_nd(pd()->nbags(), pd()->emb_dim(), [&](dim_t b, dim_t d) {
+        dim_t begin = 0, end = 0;
+        pd()->bag_range(offsets, offsets_d, b, begin, end);
+
+        float acc = 0.f;
+        for (dim_t i = begin; i < end; ++i) {
+            const dim_t row = indices[indices_d.off_l(i)];
+            const float s = src_scales[per_row_scales ? row : 0];
+            acc += s
+                    * io::load_float_value(
+                            src_d.data_type(), src, src_d.off(row, d));
+        }
+        // The mean of an empty bag is zero.
+        if (is_mean && end > begin) acc /= (end - begin);
+
+        io::store_float_value(dst_d.data_type(), acc, dst, dst_d.off(b, d));
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
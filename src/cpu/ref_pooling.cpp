@@ -202,12 +202,15 @@ status_t ref_pooling_bwd_t::execute(const exec_ctx_t &ctx) const {
 
     const auto diff_dst = CTX_IN_MEM(const void *, DNNL_ARG_DIFF_DST);
     const auto ws = CTX_IN_MEM(const void *, DNNL_ARG_WORKSPACE);
+    const auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
     auto diff_src_ptr = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DIFF_SRC, status);
     CHECK(status);
 
     const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
     const memory_desc_wrapper diff_src_d(pd()->diff_src_md());
     const memory_desc_wrapper ws_d(pd()->workspace_md());
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const bool argmax_recompute = pd()->with_argmax_recompute();
 
     auto scratchpad = ctx.get_scratchpad_grantor();
     float *cvt_src = scratchpad.template get<float>(
@@ -238,9 +241,39 @@ status_t ref_pooling_bwd_t::execute(const exec_ctx_t &ctx) const {
     const dim_t DH = pd()->KDH();
     const dim_t DW = pd()->KDW();
 
+    // Returns the index the forward pass would have stored in the workspace.
+    auto recompute_index = [=](dim_t mb, dim_t oc, dim_t od, dim_t oh,
+                                   dim_t ow) {
+        float d = nstl::numeric_limits<float>::lowest();
+        dim_t index = 0;
+        for (dim_t kd = 0; kd < KD; ++kd) {
+            const dim_t id = od * SD - padF + kd * (DD + 1);
+            if (id < 0 || id >= ID) continue;
+            for (dim_t kh = 0; kh < KH; ++kh) {
+                const dim_t ih = oh * SH - padT + kh * (DH + 1);
+                if (ih < 0 || ih >= IH) continue;
+                for (dim_t kw = 0; kw < KW; ++kw) {
+                    const dim_t iw = ow * SW - padL + kw * (DW + 1);
+                    if (iw < 0 || iw >= IW) continue;
+
+                    const auto off = get_offset(src_d, mb, oc, id, ih, iw);
+                    const float s = io::load_float_value(
+                            src_d.data_type(), src, off);
+                    if (s > d) {
+                        d = s;
+                        index = (kd * KH + kh) * KW + kw;
+                    }
+                }
+            }
+        }
+        return index;
+    };
+
     auto ker_max = [=](dim_t mb, dim_t oc, dim_t od, dim_t oh, dim_t ow) {
-        const auto ws_off = get_offset(ws_d, mb, oc, od, oh, ow);
-        const dim_t index = io::load_int_value(ws_d.data_type(), ws, ws_off);
+        const dim_t index = argmax_recompute
+                ? recompute_index(mb, oc, od, oh, ow)
+                : io::load_int_value(ws_d.data_type(), ws,
+                        get_offset(ws_d, mb, oc, od, oh, ow));
         const dim_t kd = (index / KW) / KH;
         const dim_t kh = (index / KW) % KH;
         const dim_t kw = index % KW;
@@ -102,7 +102,12 @@ struct ref_pooling_bwd_t : public primitive_t {
                     && attr()->has_default_values();
             if (!ok) return status::unimplemented;
 
-            if (desc()->alg_kind == alg_kind::pooling_max) {
+            if (with_argmax_recompute()) {
+                const auto src_type = src_md(0)->data_type;
+                if (!(platform::has_data_type_support(src_type)
+                            && utils::one_of(src_type, f32, bf16, f16)))
+                    return status::unimplemented;
+            } else if (desc()->alg_kind == alg_kind::pooling_max) {
                 const auto ws_dt = hint_fwd_pd_->workspace_md()->data_type;
                 init_default_ws(ws_dt);
                 if (!compare_ws(hint_fwd_pd_)) return status::unimplemented;
@@ -230,6 +230,29 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
     const auto axis_size = pd()->axis_size(true);
     const int nthr = pd()->nthr_;
 
+    const auto mask = CTX_IN_MEM(const void *, DNNL_ARG_ATTR_SOFTMAX_MASK);
+    const auto &pre_ops = pd()->pre_ops();
+    const bool with_pre_ops = pd()->with_pre_ops();
+    const int ndims = pd()->ndims();
+
+    // Returns the source value at the logical offset `l_off` with the scale
+    // and the mask of the softmax pre-ops applied.
+    auto load_src = [&](size_t src_off, dim_t l_off) {
+        float s = io::load_float_value(src_d.data_type(), src, src_off);
+        if (!with_pre_ops) return s;
+
+        dims_t pos;
+        utils::l_dims_by_l_offset(pos, l_off, src_d.dims(), ndims);
+        s *= pre_ops.scale_;
+        if (pd()->with_mask_buffer())
+            s += io::load_float_value(pre_ops.mask_desc_.data_type, mask,
+                    pd()->mask_off(pos));
+        else if (pd()->with_causal_mask()
+                && pos[ndims - 1] >= pd()->causal_len(pos[ndims - 2]))
+            s = -INFINITY;
+        return s;
+    };
+
     parallel_nd_ext(nthr, outer_size_, [&](int ithr, int, dim_t ou) {
         const dim_t thr_shift = ithr * axis_size;
 
@@ -249,14 +272,14 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
             dim_t ou_in_offset = ou * channels_ * inner_size_ + in;
 
             for (int c = 0; c < channels_; c++) {
-                size_t off = src_d.off_l(ou_in_offset + c * inner_size_);
-                float s = io::load_float_value(src_d.data_type(), src, off);
+                const dim_t l_off = ou_in_offset + c * inner_size_;
+                float s = load_src(src_d.off_l(l_off), l_off);
                 space_max[in] = nstl::max(space_max[in], s);
             }
 
             for (int c = 0; c < channels_; c++) {
-                size_t src_off = src_d.off_l(ou_in_offset + c * inner_size_);
-                float s = io::load_float_value(src_d.data_type(), src, src_off);
+                const dim_t l_off = ou_in_offset + c * inner_size_;
+                float s = load_src(src_d.off_l(l_off), l_off);
                 float d = s - space_max[in];
                 if (pd()->is_softmax()) {
                     d = expf(d);
@@ -284,7 +307,8 @@ status_t ref_softmax_fwd_t::execute_forward_generic(
                         interim_dt, interim_ptr, interim_off);
                 float sd = space_denom[in];
                 if (pd()->is_softmax()) {
-                    d /= sd;
+                    // A row hidden by the mask entirely has zero outputs.
+                    d = sd ? d / sd : 0.f;
                 } else if (pd()->is_logsoftmax()) {
                     d -= sd;
                 }
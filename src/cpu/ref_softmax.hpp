@@ -59,10 +59,12 @@ struct ref_softmax_fwd_t : public primitive_t {
 
             VCHECK_SOFTMAX(
                     attr()->has_default_values(skip_mask_t::scales_runtime
-                            | skip_mask_t::post_ops),
+                            | skip_mask_t::post_ops
+                            | skip_mask_t::softmax_pre_ops),
                     VERBOSE_UNSUPPORTED_ATTR);
             VCHECK_SOFTMAX(attr_scales_ok(), VERBOSE_UNSUPPORTED_SCALES_CFG);
             VCHECK_SOFTMAX(post_ops_ok(), VERBOSE_UNSUPPORTED_POSTOP);
+            VCHECK_SOFTMAX(attr_pre_ops_ok(), VERBOSE_UNSUPPORTED_ATTR);
 #undef VCHECK_SOFTMAX
 
             ok = set_default_formats() == status::success
@@ -123,7 +125,8 @@ struct ref_softmax_fwd_t : public primitive_t {
             if (bd.inner_idxs[iblk] == axis)
                 axis_blk_size *= bd.inner_blks[iblk];
 
-        use_dense_ = inner_size_ == 1 && src_d == dst_d && src_d.is_dense(true)
+        use_dense_ = inner_size_ == 1 && !pd()->with_pre_ops()
+                && src_d == dst_d && src_d.is_dense(true)
                 && src_d.only_padded_dim(axis)
                 && bd.strides[axis] == axis_blk_size;
 
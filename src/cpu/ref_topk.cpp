@@ -0,0 +1,82 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/ref_io_helper.hpp"
+#include "cpu/ref_topk.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_topk_t::execute(const exec_ctx_t &ctx) const {
+    using namespace memory_tracking::names;
+    using topk_utils::entry_t;
+
+    status_t status = status::success;
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DST, status);
+    CHECK(status);
+    auto indices = CTX_OUT_CLEAN_MEM(int32_t *, DNNL_ARG_DST_1, status);
+    CHECK(status);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md(0));
+    const memory_desc_wrapper indices_d(pd()->dst_md(1));
+    const data_type_t dt = src_d.data_type();
+
+    const dim_t outer = pd()->outer_size();
+    const dim_t inner = pd()->inner_size();
+    const dim_t axis_size = pd()->axis_size();
+    const dim_t k = pd()->k();
+
+    auto heaps = ctx.get_scratchpad_grantor().template get<entry_t>(
+            key_topk_heap);
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        dim_t start = 0, end = 0;
+        balance211(outer * inner, nthr, ithr, start, end);
+        entry_t *heap = heaps + ithr * k;
+
+        for (dim_t row = start; row < end; ++row) {
+            const dim_t ou = row / inner, in = row % inner;
+
+            topk_utils::selector_t selector(heap, k);
+            for (dim_t a = 0; a < axis_size; ++a) {
+                const dim_t l_off = (ou * axis_size + a) * inner + in;
+                selector.push(
+                        io::load_float_value(dt, src, src_d.off_l(l_off)), a);
+            }
+            selector.finalize();
+
+            for (dim_t j = 0; j < k; ++j) {
+                const dim_t l_off = (ou * k + j) * inner + in;
+                io::store_float_value(
+                        dt, heap[j].value, dst, dst_d.off_l(l_off));
+                indices[indices_d.off_l(l_off)] = heap[j].index;
+            }
+        }
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,85 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_TOPK_UTILS_HPP
+#define CPU_TOPK_UTILS_HPP
+
+#include <algorithm>
+
+#include "common/c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace topk_utils {
+
+struct entry_t {
+    float value;
+    int32_t index;
+};
+
+// The order of the top-k destination: the larger values go first and the
+// equal values go in the order of their indices. NaN values go after all the
+// others.
+inline bool goes_before(const entry_t &a, const entry_t &b) {
+    const bool a_nan = a.value != a.value, b_nan = b.value != b.value;
+    if (a_nan != b_nan) return b_nan;
+    if (!a_nan && a.value != b.value) return a.value > b.value;
+    return a.index < b.index;
+}
+
+// Keeps the k best entries pushed so far in a caller-provided buffer
+// arranged as a heap with the worst kept entry on top.
+struct selector_t {
+    selector_t(entry_t *buf, dim_t k) : buf_(buf), k_(k), size_(0) {}
+
+    bool full() const { return size_ == k_; }
+    const entry_t *data() const { return buf_; }
+
+    // An element must be greater than or unordered with this value to
+    // possibly be kept. Valid only once the selector is full.
+    float threshold() const { return buf_[0].value; }
+
+    void push(float value, dim_t index) {
+        const entry_t e {value, static_cast<int32_t>(index)};
+        if (size_ < k_) {
+            buf_[size_++] = e;
+            std::push_heap(buf_, buf_ + size_, goes_before);
+        } else if (goes_before(e, buf_[0])) {
+            std::pop_heap(buf_, buf_ + size_, goes_before);
+            buf_[size_ - 1] = e;
+            std::push_heap(buf_, buf_ + size_, goes_before);
+        }
+    }
+
+    // Sorts the kept entries, the best first, and returns their number.
+    dim_t finalize() {
+        std::sort_heap(buf_, buf_ + size_, goes_before);
+        return size_;
+    }
+
+private:
+    entry_t *buf_;
+    dim_t k_;
+    dim_t size_;
+};
+
+} // namespace topk_utils
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
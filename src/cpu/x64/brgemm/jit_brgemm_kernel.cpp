@@ -77,9 +77,12 @@ struct jit_brgemm_kernel_t : public jit_generator {
                     ld_tail_mask, use_exact_tail_scalar_bcast};
             const binary_injector::static_params_t bsp {
                     this->param1, enabled_bcast_strategy, rhs_sp};
+            eltwise_injector::static_params_t esp;
+            esp.fast_math = eltwise_injector::is_fast_math_allowed(
+                    brg.attr->fpmath_mode_);
 
             postops_injector_ = utils::make_unique<po_injector_t>(
-                    this, brg.attr->post_ops_, bsp);
+                    this, brg.attr->post_ops_, bsp, esp);
 
             with_binary_non_scalar_bcast_ = binary_injector::
                     any_binary_postop_rhs_non_scalar_broadcast(
@@ -50,6 +50,10 @@ bool is_supported(cpu_isa_t isa, alg_kind_t alg) {
     return is_isa_supported(isa) && is_alg_supported(alg);
 }
 
+bool is_fast_math_allowed(fpmath_mode_t fpmath_mode) {
+    return utils::one_of(fpmath_mode, fpmath_mode::bf16, fpmath_mode::any);
+}
+
 } // namespace eltwise_injector
 
 using namespace Xbyak;
@@ -253,6 +257,19 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::test_mask() {
     }
 }
 
+template <cpu_isa_t isa, typename Wmm>
+void jit_uni_eltwise_injector_f32<isa, Wmm>::compute_polynomial(
+        const Vmm &vmm_dst, const Vmm &vmm_arg, key_t pol_key) {
+    // the number of coefficients depends on the registered table, e.g. fast
+    // math tables are shorter
+    const int n_coeffs = static_cast<int>(entry_map_.count(pol_key));
+    assert(n_coeffs > 0);
+
+    h->uni_vmovups(vmm_dst, table_val(pol_key, n_coeffs - 1));
+    for (int i = n_coeffs - 2; i >= 0; i--)
+        h->uni_vfmadd213ps(vmm_dst, vmm_arg, table_val(pol_key, i));
+}
+
 template <cpu_isa_t isa, typename Wmm>
 void jit_uni_eltwise_injector_f32<isa, Wmm>::exp_compute_vector_fwd(
         const Vmm &vmm_src) {
@@ -306,11 +323,7 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::exp_compute_vector_fwd(
     blend_with_mask(vmm_aux2, vmm_src);
 
     // compute polynomial
-    h->uni_vmovups(vmm_src, table_val(exp_pol, 4));
-    h->uni_vfmadd213ps(vmm_src, vmm_aux1, table_val(exp_pol, 3));
-    h->uni_vfmadd213ps(vmm_src, vmm_aux1, table_val(exp_pol, 2));
-    h->uni_vfmadd213ps(vmm_src, vmm_aux1, table_val(exp_pol, 1));
-    h->uni_vfmadd213ps(vmm_src, vmm_aux1, table_val(exp_pol, 0));
+    compute_polynomial(vmm_src, vmm_aux1, exp_pol);
     h->uni_vfmadd213ps(vmm_src, vmm_aux1, table_val(one));
     // y = y * 2^n
     h->uni_vmulps(vmm_src, vmm_src, vmm_aux2);
@@ -352,6 +365,11 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::elu_compute_vector_fwd(
 template <cpu_isa_t isa, typename Wmm>
 void jit_uni_eltwise_injector_f32<isa, Wmm>::tanh_compute_vector_fwd(
         const Vmm &vmm_src) {
+    if (fast_math_) {
+        tanh_fast_math_compute_vector_fwd(vmm_src);
+        return;
+    }
+
     // we add a check as the avx2 code cannot be used for avx
     assert(IMPLICATION(isa == avx2, mayiuse(avx2)));
 
@@ -548,6 +566,45 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::tanh_compute_vector_fwd(
     h->uni_vmovups(vmm_src, vmm_dst);
 }
 
+template <cpu_isa_t isa, typename Wmm>
+void jit_uni_eltwise_injector_f32<isa, Wmm>::tanh_fast_math_compute_vector_fwd(
+        const Vmm &vmm_src) {
+    // tanh(x) = sign(x) * (1 - exp(-2|x|)) / (1 + exp(-2|x|)). Close to zero
+    // the expression suffers from cancellation, so tanh(x) = x - x^3 / 3 is
+    // used for |x| < tanh_fast_pol_ubound instead. Large arguments saturate
+    // naturally as exp(-2|x|) goes to zero.
+
+    // keep x for sign and |x| for further computations
+    h->uni_vmovups(vmm_aux3, vmm_src);
+    h->uni_vandps(vmm_src, vmm_src, table_val(positive_mask));
+    h->uni_vmovups(vmm_aux4, vmm_src);
+
+    // e = exp(-2|x|)
+    h->uni_vmulps(vmm_src, vmm_src, table_val(minus_two));
+    exp_compute_vector_fwd(vmm_src); // pollutes aux0 (mask), aux1, aux2
+
+    // (1 - e) / (1 + e)
+    h->uni_vmovups(vmm_aux1, table_val(one));
+    h->uni_vsubps(vmm_aux1, vmm_aux1, vmm_src);
+    h->uni_vaddps(vmm_src, vmm_src, table_val(one));
+    h->uni_vdivps(vmm_aux1, vmm_aux1, vmm_src);
+
+    // |x| - |x|^3 / 3
+    h->uni_vmovups(vmm_src, vmm_aux4);
+    h->uni_vmulps(vmm_src, vmm_src, vmm_src);
+    h->uni_vmulps(vmm_src, vmm_src, table_val(tanh_fast_pol));
+    h->uni_vfmadd213ps(vmm_src, vmm_aux4, vmm_aux4);
+
+    // select the polynomial for small arguments
+    compute_cmp_mask(vmm_aux4, table_val(tanh_fast_pol_ubound), _cmp_lt_os);
+    blend_with_mask(vmm_aux1, vmm_src);
+
+    // restore the sign
+    h->uni_vandps(vmm_aux3, vmm_aux3, table_val(sign_mask));
+    h->uni_vorps(vmm_aux1, vmm_aux1, vmm_aux3);
+    h->uni_vmovups(vmm_src, vmm_aux1);
+}
+
 template <cpu_isa_t isa, typename Wmm>
 void jit_uni_eltwise_injector_f32<isa, Wmm>::gelu_tanh_compute_vector_fwd(
         const Vmm &vmm_src) {
@@ -698,11 +755,7 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::soft_relu_compute_vector_fwd(
     h->uni_vmulps(vmm_aux0, vmm_aux0, table_val(ln2f));
     h->uni_vsubps(vmm_aux1, vmm_aux1, vmm_aux0);
     // compute exponent polynomial
-    h->uni_vmovups(vmm_aux3, table_val(exp_pol, 4));
-    h->uni_vfmadd213ps(vmm_aux3, vmm_aux1, table_val(exp_pol, 3));
-    h->uni_vfmadd213ps(vmm_aux3, vmm_aux1, table_val(exp_pol, 2));
-    h->uni_vfmadd213ps(vmm_aux3, vmm_aux1, table_val(exp_pol, 1));
-    h->uni_vfmadd213ps(vmm_aux3, vmm_aux1, table_val(exp_pol, 0));
+    compute_polynomial(vmm_aux3, vmm_aux1, exp_pol);
     h->uni_vfmadd213ps(vmm_aux3, vmm_aux1, table_val(one));
 
     // We do not count 2^-n here, because n can reach 128 and 2^(-128) is not
@@ -952,10 +1005,7 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::log_compute_vector_fwd(
     h->uni_vfmsub213ps(vmm_aux2, vmm_src, table_val(one));
 
     // compute polynomial(rel_err)
-    h->uni_vmovups(vmm_src, table_val(log_pol, 3));
-    h->uni_vfmadd213ps(vmm_src, vmm_aux2, table_val(log_pol, 2));
-    h->uni_vfmadd213ps(vmm_src, vmm_aux2, table_val(log_pol, 1));
-    h->uni_vfmadd213ps(vmm_src, vmm_aux2, table_val(log_pol, 0));
+    compute_polynomial(vmm_src, vmm_aux2, log_pol);
     h->uni_vfmadd213ps(vmm_src, vmm_aux2, table_val(one));
     h->uni_vmulps(vmm_src, vmm_src, vmm_aux2);
 
@@ -1254,15 +1304,7 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::gelu_erf_compute_vector_fwd(
     h->uni_vmulps(vmm_src, vmm_src, vmm_aux4);
 
     // compute polynomialial r
-    h->uni_vmovups(vmm_aux1, table_val(gelu_erf_Abramowitz_Stegun_pol, 4));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 3));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 2));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 1));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 0));
+    compute_polynomial(vmm_aux1, vmm_aux4, gelu_erf_Abramowitz_Stegun_pol);
 
     // erf = sign * (1 - r * t * exp(-x*x))
     h->uni_vfmadd213ps(vmm_src, vmm_aux1, table_val(one));
@@ -1599,15 +1641,7 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::gelu_erf_compute_vector_bwd(
     h->uni_vmulps(vmm_src, vmm_src, vmm_aux4);
 
     // compute polynomial r
-    h->uni_vmovups(vmm_aux1, table_val(gelu_erf_Abramowitz_Stegun_pol, 4));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 3));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 2));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 1));
-    h->uni_vfmadd213ps(
-            vmm_aux1, vmm_aux4, table_val(gelu_erf_Abramowitz_Stegun_pol, 0));
+    compute_polynomial(vmm_aux1, vmm_aux4, gelu_erf_Abramowitz_Stegun_pol);
 
     // erf = sign * (1 - r * t * exp(-x*x))
     h->uni_vfmadd213ps(vmm_src, vmm_aux1, table_val(one));
@@ -1948,6 +1982,15 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::register_table_entries() {
             {exp_pol, {0x3c07cfce, true}} // p5 = 0.00828929059f
     };
 
+    // exp(x) polynomial approximation for fast math, maximum relative error
+    // is 1.1e-4
+    static const table_t exp_fast_math_polynomial {
+            // p0 = 1.0f
+            {exp_pol, {0x3f80066b, true}}, // p1 = 1.00019586f
+            {exp_pol, {0x3f010eb0, true}}, // p2 = 0.504130363f
+            {exp_pol, {0x3e2924e2, true}} // p3 = 0.165179759f
+    };
+
     // mish(x) constants
     static const table_t mish_consts {
             {fwd_mish_max_x_for_equation_f, {0x42317217, true}},
@@ -1959,6 +2002,12 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::register_table_entries() {
             {tanh_linear_ubound, {0x39ddb3d7, true}},
             {tanh_saturation_lbound, {0x41102cb3, true}}};
 
+    // tanh(x) constants for fast math approximation
+    static const table_t tanh_fast_math_consts {
+            {tanh_fast_pol_ubound, {0x3e800000, true}}, // 0.25f
+            {tanh_fast_pol, {0xbeaaaaab, true}}, // -0.333333343f
+    };
+
     // tanh(x) polynomial approximation
     // For each coefficient, there is 32 entries
     static const table_t tanh_polynomial_table {
@@ -2244,6 +2293,23 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::register_table_entries() {
             {gelu_erf_Abramowitz_Stegun_pol, {0x3f87dc22, true}},
     };
 
+    // gelu_erf(x) constants and shorter polynomial for fast math, also by
+    // Abramowitz and Stegun (7.1.25 instead of 7.1.26)
+    static const table_t gelu_erf_Abramowitz_Stegun_fast_math_consts {
+            {gelu_erf_Abramowitz_Stegun_approx_const, {0x3ef0e172, true}},
+            {gelu_erf_Abramowitz_Stegun_one_over_sqrt_two, {0x3f3504f3, true}},
+            {gelu_erf_Abramowitz_Stegun_one_over_sqrt_pi, {0x3f106eba, true}},
+    };
+
+    static const table_t gelu_erf_Abramowitz_Stegun_fast_math_polynomial {
+            // p1 = 0.348024189f
+            {gelu_erf_Abramowitz_Stegun_pol, {0x3eb2303a, true}},
+            // p2 = -0.0958797964f
+            {gelu_erf_Abramowitz_Stegun_pol, {0xbdc45ca1, true}},
+            // p3 = 0.747855604f
+            {gelu_erf_Abramowitz_Stegun_pol, {0x3f3f7377, true}},
+    };
+
     // gelu_erf(x) constants for direct erf approximation (formula defined)
     static const table_t gelu_erf_minimax_consts {
             {gelu_erf_idx_bias, {0xc21fffff, true}},
@@ -2473,6 +2539,11 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::register_table_entries() {
             {log_pol, {0x3e4cc8a3, true}}, // p4 =  0.199984118f
     };
 
+    // log(x) polynomial approximation for fast math
+    static const table_t log_fast_math_polynomial {
+            {log_pol, {0xbf000000, true}}, // p1 = -0.5f
+    };
+
     // log(x) pre-defined values. First goes index}, then val[index].
     static const table_t log_predefined_values {
             {log_predefined_vals, {0x3f800000, true}}, //  0: 1
@@ -2614,6 +2685,8 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::register_table_entries() {
     };
 
     need_t need(alg_);
+    // fast math tanh is computed via exp
+    const bool need_exp = need.exp() || (fast_math_ && need.tanh());
 
     auto push_arg_entry_of = [&](const key_t key, const table_entry_val_t val,
                                      const bool broadcast) {
@@ -2633,23 +2706,33 @@ void jit_uni_eltwise_injector_f32<isa, Wmm>::register_table_entries() {
     push_arg_entry_of(alpha, float2int(alpha_), true);
     push_arg_entry_of(beta, float2int(beta_), true);
     push_entries_of(common_values);
-    if (need.exp()) push_entries_of(exp_consts);
-    if (need.exp()) push_entries_of(exp_polynomial);
+    if (need_exp) push_entries_of(exp_consts);
+    if (need_exp)
+        push_entries_of(
+                fast_math_ ? exp_fast_math_polynomial : exp_polynomial);
     if (need.mish()) push_entries_of(mish_consts);
-    if (need.tanh()) push_entries_of(tanh_consts);
-    if (need.tanh()) push_entries_of(tanh_polynomial_table);
+    if (need.tanh() && fast_math_) push_entries_of(tanh_fast_math_consts);
+    if (need.tanh() && !fast_math_) push_entries_of(tanh_consts);
+    if (need.tanh() && !fast_math_) push_entries_of(tanh_polynomial_table);
     if (need.soft_relu()) push_entries_of(soft_relu_consts);
     if (need.soft_relu()) push_entries_of(soft_relu_polynomial);
     if (need.gelu_tanh()) push_entries_of(gelu_tanh_consts);
-    if (need.gelu_erf()) push_entries_of(gelu_erf_Abramowitz_Stegun_consts);
-    if (need.gelu_erf()) push_entries_of(gelu_erf_Abramowitz_Stegun_polynomial);
+    if (need.gelu_erf())
+        push_entries_of(fast_math_
+                        ? gelu_erf_Abramowitz_Stegun_fast_math_consts
+                        : gelu_erf_Abramowitz_Stegun_consts);
+    if (need.gelu_erf())
+        push_entries_of(fast_math_
+                        ? gelu_erf_Abramowitz_Stegun_fast_math_polynomial
+                        : gelu_erf_Abramowitz_Stegun_polynomial);
     if (need.gelu_erf() && is_superset(isa, avx512_core))
         push_entries_of(gelu_erf_minimax_consts);
     if (need.gelu_erf() && is_superset(isa, avx512_core))
         push_entries_of(gelu_erf_minimax_polynomial);
 
     if (need.log()) push_entries_of(log_consts);
-    if (need.log()) push_entries_of(log_polynomial);
+    if (need.log())
+        push_entries_of(fast_math_ ? log_fast_math_polynomial : log_polynomial);
     if (need.log()) push_entries_of(log_predefined_values);
 
     // Now that we registered the entries, we set the offsets.  No
@@ -40,14 +40,15 @@ struct static_params_t {
             Xbyak::Reg64 p_table = Xbyak::util::rax,
             Xbyak::Opmask k_mask = Xbyak::Opmask(1), bool is_fwd = true,
             bool use_dst = false, bool preserve_vmm = true,
-            bool preserve_p_table = true)
+            bool preserve_p_table = true, bool fast_math = false)
         : save_state(save_state)
         , p_table(p_table)
         , k_mask(k_mask)
         , is_fwd(is_fwd)
         , use_dst(use_dst)
         , preserve_vmm(preserve_vmm)
-        , preserve_p_table(preserve_p_table) {}
+        , preserve_p_table(preserve_p_table)
+        , fast_math(fast_math) {}
 
     bool save_state;
     Xbyak::Reg64 p_table;
@@ -56,6 +57,7 @@ struct static_params_t {
     bool use_dst;
     bool preserve_vmm;
     bool preserve_p_table;
+    bool fast_math;
 };
 
 /*
@@ -73,6 +75,13 @@ bool is_alg_supported(alg_kind_t alg);
  */
 bool is_supported(cpu_isa_t isa, alg_kind_t alg);
 
+/*
+ * Checks if fpmath mode allows eltwise injector to use fast approximations of
+ * transcendental functions. Their accuracy is sufficient for bf16 computations,
+ * see `fast_math` argument of the injector.
+ */
+bool is_fast_math_allowed(fpmath_mode_t fpmath_mode);
+
 } // namespace eltwise_injector
 
 template <cpu_isa_t isa, typename Wmm = typename cpu_isa_traits<isa>::Vmm>
@@ -91,12 +100,17 @@ struct jit_uni_eltwise_injector_f32 {
     //   - algorithm derivative.
     // use_dst - defines whether source or destination point is passed to alg
     //   code. Depends on algorithm. See `_use_dst_for_bwd` algs definition.
+    // fast_math - when true, exp, tanh, gelu_erf and log (and algorithms based
+    //   on them) use lower degree approximations. Maximum relative error is
+    //   1.1e-4 for exp, 5.2e-4 for tanh and 4.7e-4 for log, absolute error of
+    //   gelu_erf is 3.4e-5 * |s|. gelu_erf is not affected on avx512 as its
+    //   minimax approximation is already fast.
     jit_uni_eltwise_injector_f32(jit_generator *host, alg_kind_t alg,
             float alpha, float beta, float scale, bool save_state = true,
             Xbyak::Reg64 p_table = Xbyak::util::rax,
             Xbyak::Opmask k_mask = Xbyak::Opmask(1), bool is_fwd = true,
             bool use_dst = false, bool preserve_vmm = true,
-            bool preserve_p_table = true)
+            bool preserve_p_table = true, bool fast_math = false)
         : alg_(alg)
         , alpha_(alpha)
         , beta_(beta)
@@ -108,7 +122,8 @@ struct jit_uni_eltwise_injector_f32 {
         , is_fwd_(is_fwd)
         , use_dst_(use_dst)
         , preserve_vmm_(preserve_vmm)
-        , preserve_p_table_(preserve_p_table) {
+        , preserve_p_table_(preserve_p_table)
+        , fast_math_(fast_math) {
         assert(eltwise_injector::is_supported(isa, alg_));
 
         register_table_entries();
@@ -119,10 +134,10 @@ struct jit_uni_eltwise_injector_f32 {
             bool save_state = true, Xbyak::Reg64 p_table = Xbyak::util::rax,
             Xbyak::Opmask k_mask = Xbyak::Opmask(1), bool is_fwd = true,
             bool use_dst = false, bool preserve_vmm = true,
-            bool preserve_p_table = true)
+            bool preserve_p_table = true, bool fast_math = false)
         : jit_uni_eltwise_injector_f32(host, eltwise.alg, eltwise.alpha,
                 eltwise.beta, eltwise.scale, save_state, p_table, k_mask,
-                is_fwd, use_dst, preserve_vmm, preserve_p_table) {}
+                is_fwd, use_dst, preserve_vmm, preserve_p_table, fast_math) {}
 
     void compute_vector_range(size_t start_idx, size_t end_idx);
     void compute_vector_range(const injector_utils::vmm_index_set_t &vmm_idxs);
@@ -145,6 +160,7 @@ private:
     const bool use_dst_;
     const bool preserve_vmm_;
     const bool preserve_p_table_;
+    const bool fast_math_;
 
     Xbyak::Label l_table;
 
@@ -204,6 +220,7 @@ private:
     void relu_zero_ns_compute_vector_fwd(const Vmm &vmm_src);
     void elu_compute_vector_fwd(const Vmm &vmm_src);
     void tanh_compute_vector_fwd(const Vmm &vmm_src);
+    void tanh_fast_math_compute_vector_fwd(const Vmm &vmm_src);
     void square_compute_vector_fwd(const Vmm &vmm_src);
     void abs_compute_vector_fwd(const Vmm &vmm_src);
     void sqrt_compute_vector_fwd(const Vmm &vmm_src);
@@ -272,6 +289,8 @@ private:
         tanh_linear_ubound, // arg below which tanh(x) = x
         tanh_saturation_lbound, // arg after which tanh(x) = 1.f
         tanh_pol_table, // table of polynomial coefficients
+        tanh_fast_pol_ubound, // arg below which tanh(x) = x - x^3 / 3
+        tanh_fast_pol, // -1.f / 3.f
         soft_relu_one_twenty_six, // 126.f
         soft_relu_mantissa_sign_mask, // mask for mantissa bits and sign
         soft_relu_pol, // see correspondent table for float values
@@ -318,6 +337,11 @@ private:
         return h->ptr[p_table + off];
     }
 
+    // computes polynomial with coefficients registered for pol_key using
+    // Horner's scheme: vmm_dst = p[0] + p[1] * arg + ... + p[n-1] * arg^(n-1)
+    void compute_polynomial(
+            const Vmm &vmm_dst, const Vmm &vmm_arg, key_t pol_key);
+
     // we accept only 32bit hexadecimal table values to avoid any rounding
     using table_entry_val_t = uint32_t;
     using table_entry_offset_t = size_t; // offsets are in bytes wrt p_table
@@ -68,7 +68,8 @@ jit_uni_postops_injector_t<isa, Vmm>::jit_uni_postops_injector_t(
                     jit_uni_eltwise_injector_f32<isa, Vmm>(host_,
                             post_op.eltwise, esp.save_state, esp.p_table,
                             esp.k_mask, esp.is_fwd, esp.use_dst,
-                            esp.preserve_vmm, esp.preserve_p_table));
+                            esp.preserve_vmm, esp.preserve_p_table,
+                            esp.fast_math));
         } else if (post_op.is_like_binary()) {
             is_like_binary = true;
         }
@@ -497,6 +497,7 @@ struct jit_pool_conf_t {
     bool is_backward;
     bool simple_alg;
     bool is_c_padded;
+    bool argmax_recompute;
     data_type_t ind_dt;
 
     int c_block, c_tail, nb_c;
@@ -881,6 +882,23 @@ struct jit_reduction_conf_t {
 
     dim_t idle_size = 0;
     dim_t reduce_size = 0;
+    // Number of the source elements reduced into a destination element,
+    // differs from reduce_size for the stages of the split reduction.
+    dim_t full_reduce_size = 0;
+
+    float p = 0.f;
+    float eps = 0.f;
+
+    // The split reduction partitions reduce_size into split_nchunks chunks of
+    // split_chunk_size elements reduced in parallel into the f32 partial
+    // accumulators, which are then combined into the destination.
+    bool is_split = false;
+    dim_t split_nchunks = 1;
+    dim_t split_chunk_size = 0;
+    // Stages of the split reduction: a partial kernel stores the raw
+    // accumulator, a combine kernel reduces the partial accumulators.
+    bool is_partial = false;
+    bool is_combine = false;
 
     bool is_saturation_needed = false;
 
@@ -899,6 +917,58 @@ struct jit_reduction_call_s {
     const void *dst_orig = nullptr;
 };
 
+struct jit_topk_conf_t {
+    data_type_t src_type = data_type::undef;
+    std::size_t src_dt_size = 0;
+    cpu_isa_t isa = isa_undef;
+
+    dim_t nrows = 0;
+    dim_t axis_size = 0;
+    dim_t k = 0;
+
+    // The split selection partitions the axis into split_nchunks chunks of at
+    // least split_chunk_size elements selected in parallel into per-chunk
+    // top-k entries, which are then merged into the destination.
+    bool is_split = false;
+    dim_t split_nchunks = 1;
+    dim_t split_chunk_size = 0;
+};
+
+struct jit_topk_call_s {
+    const void *src = nullptr;
+    // One bit per element of a vector, set if the element may be selected.
+    uint16_t *masks = nullptr;
+    std::size_t work = 0;
+    float threshold = 0.f;
+};
+
+struct jit_embedding_bag_conf_t {
+    data_type_t src_type = data_type::undef;
+    data_type_t dst_type = data_type::undef;
+    std::size_t src_dt_size = 0;
+    std::size_t dst_dt_size = 0;
+    cpu_isa_t isa = isa_undef;
+
+    dim_t emb_dim = 0;
+    // The distance between the table rows in bytes.
+    dim_t src_row_stride = 0;
+    bool with_per_row_scales = false;
+    // The sums are multiplied by a factor for the mean and the common scale.
+    bool with_factor = false;
+    // The rows of the indices this many positions ahead are prefetched.
+    int prefetch_distance = 0;
+};
+
+struct jit_embedding_bag_call_s {
+    const void *src = nullptr;
+    // The indices of the bag.
+    const int32_t *indices = nullptr;
+    const float *scales = nullptr;
+    void *dst = nullptr;
+    std::size_t count = 0;
+    float factor = 1.f;
+};
+
 } // namespace x64
 } // namespace cpu
 } // namespace impl
@@ -86,9 +86,13 @@ struct jit_uni_kernel_t : public jit_uni_eltwise_kernel {
         // using the first 7 vregs can be considered volatile during the call
         // to eltwise injector
         const bool save_state = is_fwd_ ? false : true;
+        const bool fast_math = eltwise_injector::is_fast_math_allowed(
+                pd_->attr()->fpmath_mode_);
         eltwise_injector_.reset(new jit_uni_eltwise_injector_f32<isa>(this,
                 desc.alg_kind, desc.alpha, desc.beta, 1.f, save_state,
-                reg_injector_table, injector_mask, is_fwd_, pd_->use_dst()));
+                reg_injector_table, injector_mask, is_fwd_, pd_->use_dst(),
+                /* preserve_vmm = */ true, /* preserve_p_table = */ true,
+                fast_math));
         io::io_conf_t io_conf;
         io::io_tail_conf_t io_tail_conf(simd_w_, tail_size_, tail_opmask_idx_,
                 vmm_tail_mask.getIdx(), reg_tmp);
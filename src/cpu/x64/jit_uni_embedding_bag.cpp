@@ -0,0 +1,171 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+
+#include "cpu/x64/jit_uni_embedding_bag.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+static cpu_isa_t get_supported_isa() {
+    if (mayiuse(avx512_core_fp16)) return avx512_core_fp16;
+    if (mayiuse(avx512_core)) return avx512_core;
+    if (mayiuse(avx2_vnni_2)) return avx2_vnni_2;
+    if (mayiuse(avx2)) return avx2;
+
+    return isa_undef;
+}
+
+static bool impl_supports_datatype(data_type_t data_type) {
+    switch (data_type) {
+        case data_type::bf16:
+            return mayiuse(avx512_core) || mayiuse(avx2_vnni_2);
+        case data_type::f16:
+            return mayiuse(avx512_core_fp16) || mayiuse(avx2_vnni_2);
+        case data_type::f32:
+        case data_type::s8:
+        case data_type::u8: return true;
+        default: return false;
+    }
+}
+
+status_t jit_uni_embedding_bag_t::pd_t::init(engine_t *engine) {
+    using namespace data_type;
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    conf_.isa = get_supported_isa();
+    conf_.src_type = src_md(0)->data_type;
+    conf_.dst_type = dst_md()->data_type;
+
+    bool ok = conf_.isa != isa_undef
+            && utils::one_of(conf_.src_type, f32, bf16, f16, s8, u8)
+            && utils::one_of(conf_.dst_type, f32, bf16, f16)
+            && impl_supports_datatype(conf_.src_type)
+            && impl_supports_datatype(conf_.dst_type)
+            && attr()->has_default_values(skip_mask_t::scales_runtime)
+            && attr_scales_ok()
+            && set_default_params() == status::success;
+    if (!ok) return status::unimplemented;
+
+    // The table rows and the destination rows must be dense, and the
+    // indices of a bag are read consecutively.
+    const memory_desc_wrapper src_d(src_md(0));
+    const memory_desc_wrapper indices_d(src_md(1));
+    const memory_desc_wrapper dst_d(dst_md());
+    ok = src_d.is_plain() && dst_d.is_plain() && indices_d.is_dense()
+            && src_d.blocking_desc().strides[1] == 1
+            && dst_d.blocking_desc().strides[1] == 1;
+    if (!ok) return status::unimplemented;
+
+    conf_.src_dt_size = types::data_type_size(conf_.src_type);
+    conf_.dst_dt_size = types::data_type_size(conf_.dst_type);
+    conf_.emb_dim = emb_dim();
+    conf_.src_row_stride
+            = src_d.blocking_desc().strides[0] * conf_.src_dt_size;
+    if (conf_.src_row_stride > INT32_MAX) return status::unimplemented;
+
+    conf_.with_per_row_scales = with_per_row_scales();
+    conf_.with_factor = is_mean()
+            || !attr()->scales_.get(DNNL_ARG_SRC).has_default_values();
+    // Short rows take little time to accumulate, so their loads have to be
+    // requested further ahead to arrive in time.
+    conf_.prefetch_distance = emb_dim() * conf_.src_dt_size <= 256 ? 16 : 8;
+
+    return status::success;
+}
+
+status_t jit_uni_embedding_bag_t::init(engine_t *engine) {
+    const jit_embedding_bag_conf_t &conf = pd()->get_conf();
+
+    switch (conf.isa) {
+        case avx512_core_fp16:
+            CHECK(safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx512_core_fp16>(
+                            conf)));
+            break;
+        case avx512_core:
+            CHECK(safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx512_core>(conf)));
+            break;
+        case avx2_vnni_2:
+            CHECK(safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx2_vnni_2>(conf)));
+            break;
+        case avx2:
+            CHECK(safe_ptr_assign(kernel_,
+                    new jit_uni_embedding_bag_kernel_t<avx2>(conf)));
+            break;
+        default: return status::runtime_error;
+    }
+
+    return kernel_->create_kernel();
+}
+
+status_t jit_uni_embedding_bag_t::execute(const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto indices = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_1);
+    auto offsets = CTX_IN_MEM(const int32_t *, DNNL_ARG_SRC_2);
+    auto dst = CTX_OUT_CLEAN_MEM(char *, DNNL_ARG_DST, status);
+    CHECK(status);
+
+    DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
+
+    const jit_embedding_bag_conf_t &conf = pd()->get_conf();
+    const memory_desc_wrapper src_d(pd()->src_md(0));
+    const memory_desc_wrapper indices_d(pd()->src_md(1));
+    const memory_desc_wrapper offsets_d(pd()->src_md(2));
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+
+    const bool is_mean = pd()->is_mean();
+    // The common scale is folded into the factor; the per-row scales are
+    // applied by the kernel.
+    const float common_scale = conf.with_per_row_scales ? 1.f : src_scales[0];
+
+    src += src_d.off(0, 0) * conf.src_dt_size;
+    indices += indices_d.off(0);
+
+    parallel_nd(pd()->nbags(), [&](dim_t b) {
+        dim_t begin = 0, end = 0;
+        pd()->bag_range(offsets, offsets_d, b, begin, end);
+        const dim_t count = nstl::max<dim_t>(end - begin, 0);
+
+        jit_embedding_bag_call_s args;
+        args.src = src;
+        args.indices = indices + begin;
+        args.scales = src_scales;
+        args.dst = dst + dst_d.off(b, 0) * conf.dst_dt_size;
+        args.count = count;
+        args.factor = is_mean && count > 0 ? common_scale / count
+                                           : common_scale;
+        (*kernel_)(&args);
+    });
+
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,167 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/x64/jit_uni_embedding_bag_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace Xbyak;
+#define GET_OFF(field) offsetof(jit_embedding_bag_call_s, field)
+
+template <cpu_isa_t isa, typename Vmm>
+jit_uni_embedding_bag_kernel_t<isa, Vmm>::jit_uni_embedding_bag_kernel_t(
+        const jit_embedding_bag_conf_t &conf)
+    : jit_uni_embedding_bag_kernel_base_t(conf)
+    , tail_size_(conf.emb_dim % simd_w_)
+    , io_load_(this, isa, conf_.src_type, {false},
+              io::io_tail_conf_t {simd_w_, tail_size_, k_tail_load_mask_,
+                      vmm_tail_load_mask_.getIdx(), reg_tmp_},
+              io::io_emu_bf16_conf_t {vmm_bf16_emu_1_, vmm_bf16_emu_2_,
+                      vmm_bf16_emu_3_, reg_tmp_, vmm_bf16_emu_4_})
+    , io_store_(this, isa, conf_.dst_type, {false},
+              io::io_tail_conf_t {simd_w_, tail_size_, k_tail_store_mask_,
+                      vmm_tail_store_mask_.getIdx(), reg_tmp_},
+              io::io_emu_bf16_conf_t {vmm_bf16_emu_1_, vmm_bf16_emu_2_,
+                      vmm_bf16_emu_3_, reg_tmp_, vmm_bf16_emu_4_}) {}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::load_params() {
+    mov(reg_src_, ptr[reg_param_ + GET_OFF(src)]);
+    mov(reg_indices_, ptr[reg_param_ + GET_OFF(indices)]);
+    mov(reg_scales_, ptr[reg_param_ + GET_OFF(scales)]);
+    mov(reg_dst_, ptr[reg_param_ + GET_OFF(dst)]);
+    mov(reg_count_, ptr[reg_param_ + GET_OFF(count)]);
+    if (conf_.with_factor)
+        uni_vbroadcastss(vmm_factor_, ptr[reg_param_ + GET_OFF(factor)]);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::prefetch_rows(int nvec) {
+    const int distance = conf_.prefetch_distance;
+    if (distance == 0) return;
+
+    // The indices are random, so the hardware prefetcher does not know the
+    // next rows. The block of the row `distance` indices ahead is requested
+    // while the current rows are accumulated.
+    Label skip;
+    cmp(reg_work_, distance);
+    jle(skip, T_NEAR);
+    const int row_stride = static_cast<int>(conf_.src_row_stride);
+    movsxd(reg_pf_row_, dword[reg_idx_ptr_ + distance * sizeof(int32_t)]);
+    imul(reg_pf_row_, reg_pf_row_, row_stride);
+    const int block_bytes = nvec * simd_w_ * conf_.src_dt_size;
+    for (int off = 0; off < block_bytes; off += 64)
+        prefetcht0(ptr[reg_src_ + reg_pf_row_ + off]);
+    L(skip);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::compute_block(
+        int nvec, bool tail) {
+    const int nacc = nvec + tail;
+    for (int v = 0; v < nacc; ++v)
+        uni_vpxor(Vmm(v), Vmm(v), Vmm(v));
+
+    mov(reg_idx_ptr_, reg_indices_);
+    mov(reg_work_, reg_count_);
+
+    const int row_stride = static_cast<int>(conf_.src_row_stride);
+    Label loop, loop_end;
+    L(loop);
+    {
+        cmp(reg_work_, 0);
+        je(loop_end, T_NEAR);
+
+        prefetch_rows(nacc);
+
+        movsxd(reg_row_, dword[reg_idx_ptr_]);
+        if (conf_.with_per_row_scales)
+            uni_vbroadcastss(vmm_scale_, ptr[reg_scales_ + reg_row_ * 4]);
+        imul(reg_row_, reg_row_, row_stride);
+
+        for (int v = 0; v < nacc; ++v) {
+            const bool is_tail = tail && v == nvec;
+            io_load_.load(
+                    ptr[reg_src_ + reg_row_ + v * simd_w_ * conf_.src_dt_size],
+                    vmm_tmp_, is_tail);
+            if (conf_.with_per_row_scales)
+                uni_vfmadd231ps(Vmm(v), vmm_tmp_, vmm_scale_);
+            else
+                uni_vaddps(Vmm(v), Vmm(v), vmm_tmp_);
+        }
+
+        add(reg_idx_ptr_, sizeof(int32_t));
+        dec(reg_work_);
+        jmp(loop, T_NEAR);
+    }
+    L(loop_end);
+
+    for (int v = 0; v < nacc; ++v) {
+        const bool is_tail = tail && v == nvec;
+        if (conf_.with_factor) uni_vmulps(Vmm(v), Vmm(v), vmm_factor_);
+        io_store_.store(Vmm(v),
+                ptr[reg_dst_ + v * simd_w_ * conf_.dst_dt_size], is_tail);
+    }
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_embedding_bag_kernel_t<isa, Vmm>::generate() {
+    preamble();
+
+    io_load_.init_bf16();
+    io_store_.init_bf16();
+    if (tail_size_ > 0) {
+        io_load_.prepare_tail_mask();
+        io_store_.prepare_tail_mask();
+    }
+    load_params();
+
+    const dim_t block_size = max_unroll_ * simd_w_;
+    const dim_t nblocks = conf_.emb_dim / block_size;
+    const int rem_nvec = (conf_.emb_dim % block_size) / simd_w_;
+
+    if (nblocks > 0) {
+        Label block_loop;
+        mov(reg_block_, nblocks);
+        L(block_loop);
+        {
+            compute_block(max_unroll_, false);
+            add(reg_src_, block_size * conf_.src_dt_size);
+            add(reg_dst_, block_size * conf_.dst_dt_size);
+            dec(reg_block_);
+            jnz(block_loop, T_NEAR);
+        }
+    }
+    if (rem_nvec > 0 || tail_size_ > 0) compute_block(rem_nvec, tail_size_ > 0);
+
+    postamble();
+}
+
+template struct jit_uni_embedding_bag_kernel_t<avx512_core_fp16>;
+template struct jit_uni_embedding_bag_kernel_t<avx512_core>;
+template struct jit_uni_embedding_bag_kernel_t<avx2_vnni_2>;
+template struct jit_uni_embedding_bag_kernel_t<avx2>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
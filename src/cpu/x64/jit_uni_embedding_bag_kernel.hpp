@@ -0,0 +1,103 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_UNI_EMBEDDING_BAG_KERNEL_HPP
+#define CPU_X64_UNI_EMBEDDING_BAG_KERNEL_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_primitive_conf.hpp"
+#include "cpu/x64/utils/jit_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+struct jit_uni_embedding_bag_kernel_base_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_embedding_bag)
+
+    jit_uni_embedding_bag_kernel_base_t(const jit_embedding_bag_conf_t &conf)
+        : jit_generator(jit_name(), nullptr, MAX_CODE_SIZE, true, conf.isa)
+        , conf_(conf) {}
+    virtual ~jit_uni_embedding_bag_kernel_base_t() = default;
+
+protected:
+    const jit_embedding_bag_conf_t conf_;
+};
+
+// Pools the table rows of one bag into a destination row. The row is
+// processed in blocks of up to max_unroll_ vectors accumulated in registers
+// over all the indices of the bag, and the rows of the upcoming indices are
+// prefetched for the block.
+template <cpu_isa_t isa, typename Vmm = typename cpu_isa_traits<isa>::Vmm>
+struct jit_uni_embedding_bag_kernel_t
+    : public jit_uni_embedding_bag_kernel_base_t {
+    jit_uni_embedding_bag_kernel_t(const jit_embedding_bag_conf_t &conf);
+
+    virtual ~jit_uni_embedding_bag_kernel_t() = default;
+
+private:
+    void load_params();
+    void prefetch_rows(int nvec);
+    void compute_block(int nvec, bool tail);
+    void generate() override;
+
+    // Vmm(0) + i accumulates the i-th vector of a block.
+    static constexpr int max_unroll_ = 8;
+    const Vmm vmm_tmp_ = Vmm(8);
+    const Vmm vmm_scale_ = Vmm(9);
+    const Vmm vmm_factor_ = Vmm(10);
+    const Vmm vmm_tail_load_mask_ = Vmm(11);
+    const Vmm vmm_tail_store_mask_ = Vmm(12);
+    const Xbyak::Zmm vmm_bf16_emu_1_ = Xbyak::Zmm(28);
+    const Xbyak::Zmm vmm_bf16_emu_2_ = Xbyak::Zmm(29);
+    const Xbyak::Zmm vmm_bf16_emu_3_ = Xbyak::Zmm(30);
+    const Xbyak::Zmm vmm_bf16_emu_4_ = Xbyak::Zmm(31);
+
+    const Xbyak::Opmask k_tail_load_mask_ = k1;
+    const Xbyak::Opmask k_tail_store_mask_ = k2;
+
+    const Xbyak::Reg64 reg_src_ = rbx;
+    const Xbyak::Reg64 reg_indices_ = r8;
+    const Xbyak::Reg64 reg_scales_ = r9;
+    const Xbyak::Reg64 reg_dst_ = r10;
+    const Xbyak::Reg64 reg_count_ = r11;
+    const Xbyak::Reg64 reg_idx_ptr_ = r12;
+    const Xbyak::Reg64 reg_work_ = r13;
+    const Xbyak::Reg64 reg_row_ = r14;
+    const Xbyak::Reg64 reg_pf_row_ = r15;
+    const Xbyak::Reg64 reg_block_ = rax;
+    const Xbyak::Reg64 reg_param_ = abi_param1;
+    const Xbyak::Reg64 reg_tmp_ = abi_not_param1;
+
+    static constexpr bool is_zmm_ = std::is_same<Vmm, Xbyak::Zmm>::value;
+    static constexpr std::size_t vlen_ = is_zmm_ ? 64 : 32;
+    static constexpr std::size_t simd_w_ = vlen_ / sizeof(float);
+
+    const std::size_t tail_size_;
+    io::jit_io_helper_t<Vmm> io_load_;
+    io::jit_io_helper_t<Vmm> io_store_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -121,6 +121,9 @@ status_t jit_uni_pool_kernel<isa>::init_conf(jit_pool_conf_t &jpp,
     jpp.nthr = dnnl_get_max_threads();
     jpp.is_training = pd.prop_kind == prop_kind::forward_training;
     jpp.is_backward = pd.prop_kind == prop_kind::backward_data;
+    jpp.argmax_recompute = jpp.is_backward
+            && static_cast<const pooling_bwd_pd_t *>(ppd)
+                       ->with_argmax_recompute();
 
     jpp.id = (ndims == 5) ? src_d.dims()[2] : 1;
     jpp.ih = (ndims == 3) ? 1 : src_d.dims()[ndims - 2];
@@ -165,7 +168,9 @@ status_t jit_uni_pool_kernel<isa>::init_conf(jit_pool_conf_t &jpp,
                     || utils::one_of(src_d.data_type(), data_type::bf16,
                             data_type::f16));
 
+    // Recomputing argmax from a transposed src is not supported.
     const bool backward_ncsp_allowed = jpp.is_backward
+            && !jpp.argmax_recompute
             && ((jpp.ih > 1 && jpp.iw > 1 && jpp.c_without_padding > 1
                         && block_size <= L3_cache_size_per_core)
                     || (utils::one_of(src_d.data_type(), data_type::bf16,
@@ -282,6 +287,10 @@ status_t jit_uni_pool_kernel<isa>::init_conf(jit_pool_conf_t &jpp,
     jpp.simple_alg = jpp.is_training
             || IMPLICATION(jpp.is_backward, jpp.kd <= jpp.stride_d);
 
+    // The argmax over the whole kernel is only available when a single kernel
+    // call covers all kd positions.
+    if (jpp.argmax_recompute && !jpp.simple_alg) return status::unimplemented;
+
     jpp.ur = 0;
     if (jpp.alg == pooling_max) {
         jpp.ur = is_avx512 ? 16 : 4;
@@ -1150,11 +1159,16 @@ inline void jit_uni_pool_kernel<isa>::max_step_bwd(int ur_w, int ur_bc,
             return with_c_tail_proccessing && bc == (ur_bc - 1);
     };
 
+    if (jpp.argmax_recompute)
+        recompute_argmax(ur_w, ur_bc, pad_l, pad_r, is_tail_processing);
+
     for_(int jj = 0; jj < ur_w; jj++)
     for (int bci = 0; bci < ur_bc; bci++) {
         const auto outr_i = reg_ind(0, bci, jj, ur_bc, ur_w);
         auto out_offset = jpp.dt_size * (jj * c_off + bci * c_block);
         load(reg_idx(outr_i), reg_output, out_offset, is_tail_processing(bci));
+        if (jpp.argmax_recompute) continue;
+
         const size_t step_index = (jj * c_off + bci * c_block)
                 * types::data_type_size(jpp.ind_dt);
 
@@ -1332,6 +1346,122 @@ inline void jit_uni_pool_kernel<isa>::max_step_bwd(int ur_w, int ur_bc,
     }
 }
 
+// Computes the argmax indices the forward pass would have stored in the
+// workspace from the src tensor pointed by reg_index. The result is left in
+// the index registers (shift 1) consumed by max_step_bwd().
+template <cpu_isa_t isa>
+void jit_uni_pool_kernel<isa>::recompute_argmax(int ur_w, int ur_bc,
+        int pad_l, int pad_r,
+        const std::function<bool(int)> &is_tail_processing) {
+    const int iw = jpp.iw;
+    const int kw = jpp.kw;
+    const int stride_w = jpp.stride_w;
+    const int c_block = jpp.c_block;
+    const int c_off
+            = (jpp.tag_kind == jit_memory_tag_kind_t::nspc) ? jpp.c : c_block;
+    const bool with_c_tail_proccessing = is_tail_processing(ur_bc - 1);
+    Label kd_label, kh_label;
+
+    mov(tmp_gpr, float2int(nstl::numeric_limits<float>::lowest()));
+    uni_vmovq(xmm_tmp, tmp_gpr);
+    uni_vbroadcastss(vmm_tmp, xmm_tmp);
+
+    for_(int jj = 0; jj < ur_w; jj++)
+    for (int bci = 0; bci < ur_bc; bci++) {
+        uni_vmovups(vreg(reg_ind(0, bci, jj, ur_bc, ur_w)), vmm_tmp);
+        const auto indvr = vreg(reg_ind(1, bci, jj, ur_bc, ur_w));
+        uni_vpxor(indvr, indvr, indvr);
+    }
+    uni_vmovq(xmm_tmp, reg_k_shift);
+    uni_vpbroadcastd(vmm_k_offset, xmm_tmp);
+
+    if (jpp.ndims == 5) {
+        push(reg_input);
+        push(reg_output);
+        mov(aux_reg_input_d, reg_index);
+        mov(ki, ptr[reg_param + GET_OFF(kd_padding)]);
+        L(kd_label);
+        mov(aux_reg_input, aux_reg_input_d);
+    } else {
+        mov(aux_reg_input, reg_index);
+    }
+    xor_(kj, kj);
+    L(kh_label);
+    {
+        for (int ki = 0; ki < kw; ki++) {
+            int jj_start = nstl::max(0, utils::div_up(pad_l - ki, stride_w));
+            int jj_end = ur_w
+                    - utils::div_up(
+                            nstl::max(0, ki + pad_r - (kw - 1)), stride_w);
+            for_(int jj = jj_start; jj < jj_end; jj++)
+            for (int bci = 0; bci < ur_bc; bci++) {
+                const auto accvr = vreg(reg_ind(0, bci, jj, ur_bc, ur_w));
+                const auto indvr = vreg(reg_ind(1, bci, jj, ur_bc, ur_w));
+                const auto inpr_i = reg_ind(2, bci, jj, ur_bc, ur_w);
+                const auto inpvr = vreg(inpr_i);
+                const auto cvtvr = vreg(reg_ind(3, bci, jj, ur_bc, ur_w));
+                int aux_input_offset
+                        = (ki + jj * stride_w - pad_l) * c_off + bci * c_block;
+                if (aux_input_offset >= iw * c_off) continue;
+                int input_offset = jpp.dt_size * aux_input_offset;
+                load(reg_idx(inpr_i), aux_reg_input, input_offset,
+                        is_tail_processing(bci));
+                if (isa == sse41) {
+                    movups(vmm_mask, accvr);
+                    cmpps(vmm_mask, inpvr, _cmp_lt_os);
+                    blendvps(accvr, inpvr);
+                    blendvps(indvr, vmm_k_offset);
+                } else if (isa == avx || isa == avx2) {
+                    vcmpps(cvtvr, accvr, inpvr, _cmp_lt_os);
+                    vblendvps(accvr, accvr, inpvr, cvtvr);
+                    vblendvps(indvr, indvr, vmm_k_offset, cvtvr);
+                } else {
+                    vcmpps(k_store_mask, accvr, inpvr, _cmp_lt_os);
+                    vblendmps(accvr | k_store_mask, accvr, inpvr);
+                    vblendmps(indvr | k_store_mask, indvr, vmm_k_offset);
+                }
+            }
+
+            if (with_c_tail_proccessing && (isa == avx || isa == avx2)) {
+                push_vmm_val(vmm_c_tail_mask.getIdx());
+                put_one_in_vmm();
+            }
+
+            if (isa == avx && !mayiuse(avx2)) {
+                avx_vpadd1(vmm_k_offset, vmm_one, xmm_tmp);
+            } else {
+                uni_vpaddd(vmm_k_offset, vmm_k_offset, vmm_one);
+            }
+
+            if (with_c_tail_proccessing && (isa == avx || isa == avx2))
+                pop_vmm_val(vmm_c_tail_mask.getIdx());
+        }
+        add(aux_reg_input, jpp.dt_size * iw * c_off);
+        inc(kj);
+        cmp(kj, reg_kh);
+        jl(kh_label, T_NEAR);
+    }
+
+    if (jpp.ndims == 5) {
+        add(aux_reg_input_d, jpp.dt_size * jpp.ih * iw * c_off);
+        mov(tmp_gpr, ptr[reg_param + GET_OFF(kd_padding_shift)]);
+        uni_vmovq(xmm_tmp, tmp_gpr);
+        uni_vpbroadcastd(vmm_tmp, xmm_tmp);
+        if (isa == avx && !mayiuse(avx2)) {
+            Xmm t(vmm_mask.getIdx());
+            avx_vpadd1(vmm_k_offset, xmm_tmp, t);
+        } else {
+            uni_vpaddd(vmm_k_offset, vmm_k_offset, vmm_tmp);
+        }
+
+        dec(ki);
+        cmp(ki, 0);
+        jg(kd_label, T_NEAR);
+        pop(reg_output);
+        pop(reg_input);
+    }
+}
+
 template <cpu_isa_t isa>
 void jit_uni_pool_kernel<isa>::zero_diff_src(
         int ur_bc, bool with_c_tail_proccessing) {
@@ -1489,7 +1619,13 @@ void jit_uni_pool_kernel<isa>::generate() {
         add(reg_input,
                 dt_size * nstl::max(0, ur_w * stride_w - lpad) * c_off - shift);
         add(reg_output, dt_size * ur_w * c_off - shift);
-        if (jpp.alg == pooling_max && (jpp.is_training || jpp.is_backward)) {
+        if (jpp.argmax_recompute) {
+            // reg_index walks src in lockstep with diff_src
+            add(reg_index,
+                    dt_size * nstl::max(0, ur_w * stride_w - lpad) * c_off
+                            - shift);
+        } else if (jpp.alg == pooling_max
+                && (jpp.is_training || jpp.is_backward)) {
             auto ishift = (isa == sse41) ? jpp.c_block / 2 : 0;
             auto ind_dt_size = types::data_type_size(jpp.ind_dt);
             add(reg_index, (ur_w * c_off - ishift) * ind_dt_size);
@@ -168,6 +168,8 @@ private:
             bool with_c_tail_proccessing);
     void max_step_bwd(int ur_w, int ur_bc, int pad_l, int pad_r,
             bool with_c_tail_proccessing);
+    void recompute_argmax(int ur_w, int ur_bc, int pad_l, int pad_r,
+            const std::function<bool(int)> &is_tail_processing);
 
     void zero_diff_src(int ur_bc, bool with_c_tail_proccessing);
 
@@ -188,7 +190,9 @@ private:
             bool with_c_tail_processing) {
         add(reg_input, sizeof(float) * 4);
         add(reg_output, sizeof(float) * 4);
-        if (jpp.alg == alg_kind::pooling_max
+        if (jpp.argmax_recompute)
+            add(reg_index, sizeof(float) * 4);
+        else if (jpp.alg == alg_kind::pooling_max
                 && (jpp.is_training || jpp.is_backward))
             add(reg_index, types::data_type_size(jpp.ind_dt) * 4);
 
@@ -887,8 +887,8 @@ status_t jit_uni_pooling_bwd_t<isa, d_type>::init(engine_t *engine) {
 
 template <cpu_isa_t isa, data_type_t d_type>
 void jit_uni_pooling_bwd_t<isa, d_type>::execute_backward(
-        const data_t *diff_dst, const char *indices, data_t *diff_src,
-        const exec_ctx_t &ctx) const {
+        const data_t *diff_dst, const char *indices, const data_t *src,
+        data_t *diff_src, const exec_ctx_t &ctx) const {
 
     using namespace jit_uni_pooling_utils;
     using wsp_data_t = typename prec_traits<wsp_dt_>::type;
@@ -939,6 +939,9 @@ void jit_uni_pooling_bwd_t<isa, d_type>::execute_backward(
                 const size_t ind_off = indices_d.blk_off(n, c_off, oh);
                 arg.indices = &indices[ind_off * ind_dt_size];
             }
+        } else if (jpp.argmax_recompute) {
+            // src shares the diff_src layout, see pd_t::init()
+            arg.indices = &src[diff_src_d.blk_off(n, c_off, ih)];
         }
 
         const int zero_ih_start = (oh == 0) ? 0 : get_last_ih(oh - 1);
@@ -1006,8 +1009,8 @@ void jit_uni_pooling_bwd_t<isa, d_type>::execute_backward(
 
 template <cpu_isa_t isa, data_type_t d_type>
 void jit_uni_pooling_bwd_t<isa, d_type>::execute_backward_3d(
-        const data_t *diff_dst, const char *indices, data_t *diff_src,
-        const exec_ctx_t &ctx) const {
+        const data_t *diff_dst, const char *indices, const data_t *src,
+        data_t *diff_src, const exec_ctx_t &ctx) const {
     const memory_desc_wrapper diff_src_d(pd()->diff_src_md());
     const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
     const memory_desc_wrapper indices_d(pd()->workspace_md());
@@ -1073,6 +1076,10 @@ void jit_uni_pooling_bwd_t<isa, d_type>::execute_backward_3d(
                 const size_t ind_off = indices_d.blk_off(n, c_off, od, oh);
                 arg.indices = (const void *)&indices[ind_off * ind_dt_size];
             }
+        } else if (jpp.argmax_recompute) {
+            // src shares the diff_src layout, see pd_t::init()
+            arg.indices = (const void *)&src[diff_src_d.blk_off(
+                    n, c_off, id + kd, ih)];
         }
 
         if (zero_inp) {
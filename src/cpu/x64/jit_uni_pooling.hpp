@@ -128,7 +128,12 @@ struct jit_uni_pooling_bwd_t : public primitive_t {
                     && attr()->has_default_values() && !is_dilated();
             if (!ok) return status::unimplemented;
 
-            if (desc()->alg_kind == alg_kind::pooling_max) {
+            if (with_argmax_recompute()) {
+                // The kernel walks src with the diff_src offsets.
+                const memory_desc_wrapper src_d(src_md());
+                if (!src_d.similar_to(diff_src_md(), true, true))
+                    return status::unimplemented;
+            } else if (desc()->alg_kind == alg_kind::pooling_max) {
                 const auto ws_dt = hint_fwd_pd_->workspace_md()->data_type;
                 init_default_ws(ws_dt);
                 if (!compare_ws(hint_fwd_pd_)) return status::unimplemented;
@@ -157,21 +162,22 @@ struct jit_uni_pooling_bwd_t : public primitive_t {
     status_t execute(const exec_ctx_t &ctx) const override {
         auto diff_dst = CTX_IN_MEM(const data_t *, DNNL_ARG_DIFF_DST);
         auto ws = CTX_IN_MEM(const char *, DNNL_ARG_WORKSPACE);
+        auto src = CTX_IN_MEM(const data_t *, DNNL_ARG_SRC);
         auto diff_src = CTX_OUT_MEM(data_t *, DNNL_ARG_DIFF_SRC);
 
         if (pd()->ndims() == 5)
-            execute_backward_3d(diff_dst, ws, diff_src, ctx);
+            execute_backward_3d(diff_dst, ws, src, diff_src, ctx);
         else
-            execute_backward(diff_dst, ws, diff_src, ctx);
+            execute_backward(diff_dst, ws, src, diff_src, ctx);
 
         return status::success;
     }
 
 private:
     void execute_backward(const data_t *diff_dst, const char *indices,
-            data_t *diff_src, const exec_ctx_t &ctx) const;
+            const data_t *src, data_t *diff_src, const exec_ctx_t &ctx) const;
     void execute_backward_3d(const data_t *diff_dst, const char *indices,
-            data_t *diff_src, const exec_ctx_t &ctx) const;
+            const data_t *src, data_t *diff_src, const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
     status_t init_ncsp_trans_ctx();
 
@@ -139,26 +139,97 @@ status_t jit_uni_reduction_t::pd_t::init(engine_t *engine) {
         if (src_dims[d] != dst_dims[d]) return status::unimplemented;
 
     conf_.alg = desc()->alg_kind;
+    conf_.p = desc()->p;
+    conf_.eps = desc()->eps;
+    // Only the L1 and L2 norms are computed by the jit kernel.
     if (utils::one_of(conf_.alg, reduction_norm_lp_max, reduction_norm_lp_sum,
-                reduction_norm_lp_power_p_max, reduction_norm_lp_power_p_sum))
+                reduction_norm_lp_power_p_max, reduction_norm_lp_power_p_sum)
+            && !utils::one_of(conf_.p, 1.f, 2.f))
         return status::unimplemented;
+    conf_.full_reduce_size = conf_.reduce_size;
+
+    init_split_conf();
+    init_scratchpad();
 
     return status::success;
 }
 
+void jit_uni_reduction_t::pd_t::init_split_conf() {
+    // A chunk is a multiple of the widest vector so that only the last chunk
+    // of a row has a tail.
+    static constexpr dim_t chunk_granularity = 64;
+    static constexpr dim_t min_chunk_size = 1024;
+
+    const dim_t nthr = dnnl_get_max_threads();
+    if (conf_.idle_size >= nthr) return;
+
+    const dim_t max_nchunks = nstl::min(utils::div_up(nthr, conf_.idle_size),
+            conf_.reduce_size / min_chunk_size);
+    if (max_nchunks < 2) return;
+
+    conf_.split_chunk_size = utils::rnd_up(
+            utils::div_up(conf_.reduce_size, max_nchunks), chunk_granularity);
+    conf_.split_nchunks
+            = utils::div_up(conf_.reduce_size, conf_.split_chunk_size);
+    conf_.is_split = conf_.split_nchunks > 1;
+}
+
+void jit_uni_reduction_t::pd_t::init_scratchpad() {
+    if (!conf_.is_split) return;
+    auto scratchpad = scratchpad_registry().registrar();
+    scratchpad.template book<float>(memory_tracking::names::key_reduction,
+            conf_.idle_size * conf_.split_nchunks);
+}
+
 status_t jit_uni_reduction_t::init(engine_t *engine) {
     using namespace format_tag;
 
     const memory_desc_t *dst_md = pd()->dst_md();
     const jit_reduction_conf_t &conf = pd()->get_conf();
 
-    CHECK(get_proper_kernel(dst_md, conf));
+    if (!conf.is_split) {
+        CHECK(get_proper_kernel(kernel_, dst_md, conf));
+        CHECK(kernel_->create_kernel());
+        return status::success;
+    }
+
+    // The partial kernels reduce a chunk of a row into an f32 accumulator,
+    // with a separate kernel for the last chunk when it is shorter.
+    jit_reduction_conf_t partial_conf = conf;
+    partial_conf.is_partial = true;
+    partial_conf.dst_type = data_type::f32;
+    partial_conf.dst_dt_size = sizeof(float);
+    partial_conf.is_saturation_needed = false;
+    partial_conf.post_ops = post_ops_t();
+    partial_conf.with_postops = partial_conf.with_eltwise
+            = partial_conf.with_binary = partial_conf.with_sum = false;
+    partial_conf.sum_scales = std::queue<float>();
+    partial_conf.reduce_size = conf.split_chunk_size;
+    CHECK(get_proper_kernel(kernel_, dst_md, partial_conf));
     CHECK(kernel_->create_kernel());
 
+    const dim_t last_chunk_size = conf.reduce_size
+            - (conf.split_nchunks - 1) * conf.split_chunk_size;
+    if (last_chunk_size != conf.split_chunk_size) {
+        partial_conf.reduce_size = last_chunk_size;
+        CHECK(get_proper_kernel(last_chunk_kernel_, dst_md, partial_conf));
+        CHECK(last_chunk_kernel_->create_kernel());
+    }
+
+    jit_reduction_conf_t combine_conf = conf;
+    combine_conf.is_combine = true;
+    combine_conf.src_type = data_type::f32;
+    combine_conf.src_dt_size = sizeof(float);
+    combine_conf.reduce_size = conf.split_nchunks;
+    CHECK(get_proper_kernel(combine_kernel_, dst_md, combine_conf));
+    CHECK(combine_kernel_->create_kernel());
+
     return status::success;
 }
 
 status_t jit_uni_reduction_t::execute(const exec_ctx_t &ctx) const {
+    if (pd()->get_conf().is_split) return execute_split(ctx);
+
     const auto src = CTX_IN_MEM(const uint8_t *, DNNL_ARG_SRC);
     auto dst = CTX_OUT_MEM(uint8_t *, DNNL_ARG_DST);
 
@@ -186,51 +257,97 @@ status_t jit_uni_reduction_t::execute(const exec_ctx_t &ctx) const {
     return status::success;
 }
 
+status_t jit_uni_reduction_t::execute_split(const exec_ctx_t &ctx) const {
+    const auto src = CTX_IN_MEM(const uint8_t *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_MEM(uint8_t *, DNNL_ARG_DST);
+
+    const jit_reduction_conf_t &conf = pd()->get_conf();
+    const dim_t idle_size = conf.idle_size;
+    const dim_t reduce_size = conf.reduce_size;
+    const dim_t nchunks = conf.split_nchunks;
+    const dim_t chunk_size = conf.split_chunk_size;
+    const std::size_t src_dt_size = conf.src_dt_size;
+    const std::size_t dst_dt_size = conf.dst_dt_size;
+    const auto &post_ops = pd()->attr()->post_ops_;
+    const auto &post_ops_binary_rhs_arg_vec
+            = binary_injector::prepare_binary_args(post_ops, ctx);
+
+    auto partials = ctx.get_scratchpad_grantor().template get<float>(
+            memory_tracking::names::key_reduction);
+
+    parallel_nd(idle_size, nchunks, [&](dim_t i, dim_t c) {
+        const dim_t src_off = (i * reduce_size + c * chunk_size) * src_dt_size;
+        const bool is_last_chunk = c == nchunks - 1;
+
+        jit_reduction_call_s args = jit_reduction_call_s();
+        args.src = src + src_off;
+        args.dst = partials + i * nchunks + c;
+
+        if (is_last_chunk && last_chunk_kernel_)
+            (*last_chunk_kernel_)(&args);
+        else
+            (*kernel_)(&args);
+    });
+
+    parallel_nd(idle_size, [&](dim_t i) {
+        jit_reduction_call_s args = jit_reduction_call_s();
+        args.src = partials + i * nchunks;
+        args.dst = dst + i * dst_dt_size;
+        args.dst_orig = dst;
+        args.post_ops_binary_rhs_arg_vec = post_ops_binary_rhs_arg_vec.data();
+
+        (*combine_kernel_)(&args);
+    });
+
+    return status::success;
+}
+
 status_t jit_uni_reduction_t::get_proper_kernel(
+        std::unique_ptr<jit_uni_reduction_kernel_base_t> &kernel,
         const memory_desc_t *dst_md, const jit_reduction_conf_t &conf) {
     using namespace data_type;
 
     if (conf.isa == avx512_core_fp16)
-        return safe_ptr_assign(kernel_,
+        return safe_ptr_assign(kernel,
                 new jit_uni_reduction_kernel_t<avx512_core_fp16>(conf, dst_md));
     if (conf.isa == avx512_core_bf16)
-        return safe_ptr_assign(kernel_,
+        return safe_ptr_assign(kernel,
                 new jit_uni_reduction_kernel_t<avx512_core_bf16>(conf, dst_md));
     else if (conf.isa == avx512_core)
-        return safe_ptr_assign(kernel_,
+        return safe_ptr_assign(kernel,
                 new jit_uni_reduction_kernel_t<avx512_core>(conf, dst_md));
     else if (is_superset(conf.isa, avx)) {
         const bool is_src_i8 = utils::one_of(conf.src_type, s8, u8);
         const bool is_dst_i8 = utils::one_of(conf.dst_type, s8, u8);
         if (conf.isa == avx2_vnni_2) {
             if (is_src_i8 || is_dst_i8)
-                return safe_ptr_assign(kernel_,
+                return safe_ptr_assign(kernel,
                         new jit_uni_reduction_kernel_t<avx2_vnni_2, Xbyak::Xmm>(
                                 conf, dst_md));
             else
-                return safe_ptr_assign(kernel_,
+                return safe_ptr_assign(kernel,
                         new jit_uni_reduction_kernel_t<avx2_vnni_2>(
                                 conf, dst_md));
         } else if (conf.isa == avx2) {
             if (is_src_i8 || is_dst_i8)
-                return safe_ptr_assign(kernel_,
+                return safe_ptr_assign(kernel,
                         new jit_uni_reduction_kernel_t<avx2, Xbyak::Xmm>(
                                 conf, dst_md));
             else
-                return safe_ptr_assign(kernel_,
+                return safe_ptr_assign(kernel,
                         new jit_uni_reduction_kernel_t<avx2>(conf, dst_md));
         } else {
             if (is_src_i8 || is_dst_i8)
-                return safe_ptr_assign(kernel_,
+                return safe_ptr_assign(kernel,
                         new jit_uni_reduction_kernel_t<avx, Xbyak::Xmm>(
                                 conf, dst_md));
             else
-                return safe_ptr_assign(kernel_,
+                return safe_ptr_assign(kernel,
                         new jit_uni_reduction_kernel_t<avx>(conf, dst_md));
         }
     } else if (conf.isa == sse41)
         return safe_ptr_assign(
-                kernel_, new jit_uni_reduction_kernel_t<sse41>(conf, dst_md));
+                kernel, new jit_uni_reduction_kernel_t<sse41>(conf, dst_md));
     else
         return status::runtime_error;
 }
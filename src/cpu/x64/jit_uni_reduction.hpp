@@ -44,6 +44,8 @@ struct jit_uni_reduction_t : public primitive_t {
 
     private:
         bool fill_post_ops_conf();
+        void init_split_conf();
+        void init_scratchpad();
 
         jit_reduction_conf_t conf_;
     };
@@ -55,12 +57,17 @@ struct jit_uni_reduction_t : public primitive_t {
     status_t execute(const exec_ctx_t &ctx) const override;
 
 private:
+    status_t execute_split(const exec_ctx_t &ctx) const;
     status_t get_proper_kernel(
+            std::unique_ptr<jit_uni_reduction_kernel_base_t> &kernel,
             const memory_desc_t *dst_md, const jit_reduction_conf_t &conf);
 
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
 
     std::unique_ptr<jit_uni_reduction_kernel_base_t> kernel_;
+    // Kernels of the split reduction, kernel_ being the partial one.
+    std::unique_ptr<jit_uni_reduction_kernel_base_t> last_chunk_kernel_;
+    std::unique_ptr<jit_uni_reduction_kernel_base_t> combine_kernel_;
 };
 
 } // namespace x64
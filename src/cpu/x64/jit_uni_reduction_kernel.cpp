@@ -74,6 +74,10 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::init_acc() {
         case reduction_mean:
         case reduction_sum: starting_val = 0.f; break;
         case reduction_mul: starting_val = 1.f; break;
+        case reduction_norm_lp_max:
+        case reduction_norm_lp_sum:
+        case reduction_norm_lp_power_p_max:
+        case reduction_norm_lp_power_p_sum: starting_val = 0.f; break;
         default: assert(!"unknown alg");
     }
 
@@ -98,6 +102,10 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::init_compute_op() {
             break;
         case reduction_mean:
         case reduction_sum:
+        case reduction_norm_lp_max:
+        case reduction_norm_lp_sum:
+        case reduction_norm_lp_power_p_max:
+        case reduction_norm_lp_power_p_sum:
             compute_op_ = [&](const Xbyak::Xmm &acc, const Xbyak::Xmm &to_acc) {
                 uni_vaddps(acc, acc, to_acc);
             };
@@ -130,6 +138,10 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::init_compute_scalar_op() {
             break;
         case reduction_mean:
         case reduction_sum:
+        case reduction_norm_lp_max:
+        case reduction_norm_lp_sum:
+        case reduction_norm_lp_power_p_max:
+        case reduction_norm_lp_power_p_sum:
             compute_scalar_op_
                     = [&](const Xbyak::Xmm &acc, const Xbyak::Xmm &to_acc) {
                           addss(acc, to_acc);
@@ -145,6 +157,25 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::init_compute_scalar_op() {
     }
 }
 
+template <cpu_isa_t isa, typename Vmm>
+bool jit_uni_reduction_kernel_t<isa, Vmm>::is_lp_norm() const {
+    using namespace alg_kind;
+    return utils::one_of(conf_.alg, reduction_norm_lp_max,
+            reduction_norm_lp_sum, reduction_norm_lp_power_p_max,
+            reduction_norm_lp_power_p_sum);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_reduction_kernel_t<isa, Vmm>::apply_elem_op(const Vmm &vmm) {
+    // The partial accumulators are combined as they are.
+    if (!is_lp_norm() || conf_.is_combine) return;
+
+    if (conf_.p == 1.f)
+        uni_vandps(vmm, vmm, vmm_abs_mask_);
+    else
+        uni_vmulps(vmm, vmm, vmm);
+}
+
 template <cpu_isa_t isa, typename Vmm>
 void jit_uni_reduction_kernel_t<isa, Vmm>::init_post_ops_injector(
         const memory_desc_t *dst_md) {
@@ -271,6 +302,8 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::reduce_ne_convert_xf16() {
         cmp(reg_work_, 2);
         jl(label_work_tail_begin);
         io_load_.load_two_simdw_xf16(ptr[reg_src_], vmm_tmp1_, vmm_tmp2_);
+        apply_elem_op(vmm_tmp1_);
+        apply_elem_op(vmm_tmp2_);
 
         compute_op_(vmm_acc_, vmm_tmp1_);
         compute_op_(vmm_acc_, vmm_tmp2_);
@@ -286,6 +319,7 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::reduce_ne_convert_xf16() {
         cmp(reg_work_, 0);
         je(label_work_tail_end);
         io_load_.load(ptr[reg_src_], vmm_tmp1_, false);
+        apply_elem_op(vmm_tmp1_);
         compute_op_(vmm_acc_, vmm_tmp1_);
 
         add(reg_src_, simd_w_ * conf_.src_dt_size);
@@ -297,6 +331,7 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::reduce_ne_convert_xf16() {
 
     if (load_tail_size_) {
         io_load_.load(ptr[reg_src_], vmm_tmp1_, true);
+        apply_elem_op(vmm_tmp1_);
         reduce_vmm_to_scalar(
                 vmm_tmp1_, vmm_tmp2_, vmm_tmp3_, vmm_tmp4_, load_tail_size_);
         compute_scalar_op_(Xmm(vmm_acc_.getIdx()), Xmm(vmm_tmp1_.getIdx()));
@@ -312,6 +347,7 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::reduce_base() {
         cmp(reg_work_, 0);
         je(label_work_end);
         io_load_.load(ptr[reg_src_], vmm_tmp1_, false);
+        apply_elem_op(vmm_tmp1_);
         compute_op_(vmm_acc_, vmm_tmp1_);
 
         add(reg_src_, simd_w_ * conf_.src_dt_size);
@@ -323,6 +359,7 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::reduce_base() {
 
     if (load_tail_size_) {
         io_load_.load(ptr[reg_src_], vmm_tmp1_, true);
+        apply_elem_op(vmm_tmp1_);
         reduce_vmm_to_scalar(
                 vmm_tmp1_, vmm_tmp2_, vmm_tmp3_, vmm_tmp4_, load_tail_size_);
         compute_scalar_op_(Xmm(vmm_acc_.getIdx()), Xmm(vmm_tmp1_.getIdx()));
@@ -387,6 +424,25 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::apply_postops(const int data_idx) {
     postops_injector_->compute_vector(data_idx, rhs_arg_params);
 }
 
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_reduction_kernel_t<isa, Vmm>::finalize_lp_norm() {
+    using namespace alg_kind;
+
+    const Xmm xmm_acc(vmm_acc_.getIdx());
+    const Xmm xmm_eps(vmm_tmp1_.getIdx());
+    mov(reg_tmp_.cvt32(), float2int(conf_.eps));
+    uni_vmovd(xmm_eps, reg_tmp_.cvt32());
+    if (utils::one_of(
+                conf_.alg, reduction_norm_lp_max, reduction_norm_lp_power_p_max))
+        uni_vmaxss(xmm_acc, xmm_acc, xmm_eps);
+    else
+        uni_vaddss(xmm_acc, xmm_acc, xmm_eps);
+
+    if (utils::one_of(conf_.alg, reduction_norm_lp_max, reduction_norm_lp_sum)
+            && conf_.p == 2.f)
+        uni_vsqrtps(xmm_acc, xmm_acc);
+}
+
 template <cpu_isa_t isa, typename Vmm>
 void jit_uni_reduction_kernel_t<isa, Vmm>::finalize() {
     if (static_cast<std::size_t>(conf_.reduce_size) > load_tail_size_) {
@@ -394,14 +450,23 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::finalize() {
                 vmm_acc_, vmm_tmp1_, vmm_tmp2_, vmm_tmp3_, simd_w_);
     }
 
+    // The partial accumulators are stored as they are.
+    if (conf_.is_partial) {
+        io_store_.store(vmm_acc_, ptr[reg_dst_], true);
+        return;
+    }
+
     if (conf_.alg == alg_kind::reduction_mean) {
         const Xmm xmm_acc(vmm_acc_.getIdx());
         const Xmm xmm_reduce_size(vmm_tmp1_.getIdx());
-        mov(reg_tmp_.cvt32(), float2int(static_cast<float>(conf_.reduce_size)));
+        mov(reg_tmp_.cvt32(),
+                float2int(static_cast<float>(conf_.full_reduce_size)));
         uni_vmovd(xmm_reduce_size, reg_tmp_.cvt32());
         uni_vdivss(xmm_acc, xmm_acc, xmm_reduce_size);
     }
 
+    if (is_lp_norm()) finalize_lp_norm();
+
     if (conf_.with_postops) apply_postops(vmm_acc_.getIdx());
 
     io_store_.store(vmm_acc_, ptr[reg_dst_], true);
@@ -417,6 +482,13 @@ void jit_uni_reduction_kernel_t<isa, Vmm>::generate() {
     if (load_tail_size_ > 0) io_load_.prepare_tail_mask();
     io_store_.prepare_tail_mask();
 
+    if (is_lp_norm() && !conf_.is_combine && conf_.p == 1.f) {
+        const Xmm xmm_abs_mask(vmm_abs_mask_.getIdx());
+        mov(reg_tmp_.cvt32(), 0x7fffffff);
+        uni_vmovd(xmm_abs_mask, reg_tmp_.cvt32());
+        uni_vbroadcastss(vmm_abs_mask_, xmm_abs_mask);
+    }
+
     load_params();
     init_acc();
     reduce();
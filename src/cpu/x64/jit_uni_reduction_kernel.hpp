@@ -45,7 +45,7 @@ struct jit_uni_reduction_kernel_base_t : public jit_generator {
     virtual std::size_t get_simd_w() = 0;
 
 protected:
-    const jit_reduction_conf_t &conf_;
+    const jit_reduction_conf_t conf_;
     std::queue<float> sum_scales_;
 };
 
@@ -67,6 +67,9 @@ private:
     void init_compute_scalar_op();
     void init_post_ops_injector(const memory_desc_t *dst_md);
 
+    bool is_lp_norm() const;
+    void apply_elem_op(const Vmm &vmm);
+
     void reduce_ymm_to_xmm(const Xbyak::Xmm &acc, const Xbyak::Xmm &tmp);
     void reduce_xmm_to_scalar(const Xbyak::Xmm &acc, const Xbyak::Xmm &tmp,
             const std::size_t number_of_values_to_reduce
@@ -88,6 +91,7 @@ private:
     void load_params();
     void apply_sum(const int data_idx);
     void apply_postops(const int data_idx);
+    void finalize_lp_norm();
     void finalize();
     void generate() override;
 
@@ -102,6 +106,7 @@ private:
     const Vmm vmm_tmp4_ = Vmm(8);
     const Vmm vmm_sum_scale_ = Vmm(9);
     const Vmm rhs_dt_helper_vmm_ = Vmm(10);
+    const Vmm vmm_abs_mask_ = Vmm(11);
     const Xbyak::Zmm vmm_bf16_emu_1_ = Xbyak::Zmm(28);
     const Xbyak::Zmm vmm_bf16_emu_2_ = Xbyak::Zmm(29);
     const Xbyak::Zmm vmm_bf16_emu_3_ = Xbyak::Zmm(30);
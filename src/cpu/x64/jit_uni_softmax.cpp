@@ -85,8 +85,10 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
     Reg64 reg_interim_spat_offt = abi_not_param1;
     Reg64 reg_src_scales = rsi;
     Reg64 reg_dst_scales = rdx;
+    Reg64 reg_mask = rbp;
 
     Opmask injector_mask = Opmask(1);
+    Opmask causal_opmask = Opmask(3);
 
     Vmm vtmp; // assigned at placed where used
     Vmm tail_vmask = Vmm(0);
@@ -100,6 +102,12 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
     Vmm vzero = Vmm(is_superset(isa, avx512_core) ? 21 : 11);
     Vmm vcvt_vmm = Vmm(is_superset(isa, avx512_core) ? 22 : 10);
     Vmm vsaturation_ubound = vneg_flt_max;
+    Xmm xpre_scale = Xmm(6);
+    Vmm vpre_scale = Vmm(6);
+    Vmm vmask = Vmm(7);
+    Vmm viota = Vmm(8);
+    Xmm xneg_inf = Xmm(9);
+    Vmm vneg_inf = Vmm(9);
 
     bool is_bf16_ = false;
     bool is_f16_ = false;
@@ -111,6 +119,11 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
     bool with_postops_ = false;
     bool with_binary_ = false;
     bool with_eltwise_ = false;
+    bool with_pre_ops_ = false;
+    bool with_pre_scale_ = false;
+    bool with_mask_buffer_ = false;
+    bool with_causal_mask_ = false;
+    data_type_t mask_dt_ = data_type::undef;
 
     size_t simd_w_ = 0;
     size_t unroll_regs_ = 4;
@@ -124,6 +137,9 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
     size_t interim_axis_stride_;
     size_t dst_axis_stride_;
     size_t diff_dst_axis_stride_;
+    size_t mask_axis_stride_ = 0;
+
+    Label l_iota_table_;
 
     const int bf16_emu_zmm_1_idx_ = 23;
     const int bf16_emu_zmm_2_idx_ = 24;
@@ -152,6 +168,8 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
         dst_axis_stride_ = compute_axis_stride(dst_d_);
         if (!pd_->is_fwd())
             diff_dst_axis_stride_ = compute_axis_stride(diff_dst_d_);
+        if (with_mask_buffer_)
+            mask_axis_stride_ = simd_w_ * types::data_type_size(mask_dt_);
         axis_is_blocked_ = pd_->axis_size(true) != pd_->axis_size();
     }
 
@@ -187,6 +205,19 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
         }
         mov(reg_src_scales, ptr[reg_param + PARAM_OFF(src_scales)]);
         mov(reg_dst_scales, ptr[reg_param + PARAM_OFF(dst_scales)]);
+
+        if (with_pre_scale_) {
+            mov(reg_tmp, float2int(pd_->attr()->softmax_pre_ops_.scale_));
+            uni_vmovq(xpre_scale, reg_tmp);
+            uni_vbroadcastss(vpre_scale, xpre_scale);
+        }
+        if (with_causal_mask_) {
+            mov(reg_tmp, float2int(-INFINITY));
+            uni_vmovq(xneg_inf, reg_tmp);
+            uni_vbroadcastss(vneg_inf, xneg_inf);
+            mov(reg_tmp, l_iota_table_);
+            uni_vmovups(viota, ptr[reg_tmp]);
+        }
     }
 
     Address diff_src_ptr(size_t offt = 0) {
@@ -209,6 +240,8 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
         return vmmword[reg_diff_dst + reg_diff_dst_spat_offt + offt];
     }
 
+    Address mask_ptr(size_t offt = 0) { return vmmword[reg_mask + offt]; }
+
     enum class op_t : unsigned { max, sum };
 
     void perform_op(Vmm v, Vmm vtmp, op_t op) {
@@ -251,6 +284,8 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
             xor_(reg_interim_spat_offt, reg_interim_spat_offt); // scratch addr
         if (!pd_->is_fwd())
             xor_(reg_diff_dst_spat_offt, reg_diff_dst_spat_offt); // d_dst addr
+        if (with_mask_buffer_)
+            mov(reg_mask, ptr[reg_param + PARAM_OFF(mask)]); // mask addr
         L(main_loop);
         {
             if (n_loops_) {
@@ -267,6 +302,8 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
                 if (!pd_->is_fwd())
                     add(reg_diff_dst_spat_offt,
                             unroll_regs_ * diff_dst_axis_stride_);
+                if (with_mask_buffer_)
+                    add(reg_mask, unroll_regs_ * mask_axis_stride_);
                 jmp(main_loop);
             }
         }
@@ -283,6 +320,8 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
                 if (!pd_->is_fwd())
                     add(reg_diff_dst_spat_offt,
                             loop_tail_ * diff_dst_axis_stride_);
+                if (with_mask_buffer_)
+                    add(reg_mask, loop_tail_ * mask_axis_stride_);
             }
         }
 
@@ -353,6 +392,36 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
         io_[dt]->store(src_vmm, addr, tail && !axis_is_blocked_);
     }
 
+    // Applies softmax pre-ops to the i-th vector of the current source block:
+    // scales it, then adds the mask buffer or sets elements beyond the causal
+    // boundary to -inf.
+    void apply_pre_ops(const Vmm &vsrc, int i, bool tail) {
+        if (with_pre_scale_) uni_vmulps(vsrc, vsrc, vpre_scale);
+        if (with_mask_buffer_) {
+            io_[mask_dt_]->load(mask_ptr(mask_axis_stride_ * i), vmask, tail);
+            uni_vaddps(vsrc, vsrc, vmask);
+        }
+        if (with_causal_mask_) {
+            // vmask = causal_len - index of the first element of vsrc
+            const int dt_size_log2
+                    = math::ilog2q(types::data_type_size(src_d_.data_type()));
+            mov(reg_tmp, reg_src_spat_offt);
+            if (dt_size_log2) shr(reg_tmp, dt_size_log2);
+            neg(reg_tmp);
+            add(reg_tmp, ptr[reg_param + PARAM_OFF(causal_len)]);
+            if (i) sub(reg_tmp, i * simd_w_);
+            uni_vmovq(Xmm(vmask.getIdx()), reg_tmp);
+            uni_vpbroadcastd(vmask, Xmm(vmask.getIdx()));
+            if (is_superset(isa, avx512_core)) {
+                vpcmpgtd(causal_opmask, vmask, viota);
+                vblendmps(vsrc | causal_opmask, vneg_inf, vsrc);
+            } else {
+                vpcmpgtd(vmask, vmask, viota);
+                uni_vblendvps(vsrc, vneg_inf, vsrc, vmask);
+            }
+        }
+    }
+
     // Use ne_convert instruction to load xf16 even/odd elements from memory
     void accumulate_avx2_ne_xf16_vmax() {
         // flush to -FLT_MAX before accumulation
@@ -396,11 +465,13 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
                 // do maxps directly from memory on f32 avx2 for performance purpose
                 if (!tail && is_superset(isa, avx2)
                         && !is_superset(isa, avx512_core)
-                        && src_d_.data_type() == data_type::f32) {
+                        && src_d_.data_type() == data_type::f32
+                        && !with_pre_ops_) {
                     uni_vmaxps(vmax, vmax, src_ptr(src_axis_stride_ * i));
                 } else {
                     io_[src_d_.data_type()]->load(
                             src_ptr(src_axis_stride_ * i), vreg_tmp_src, tail);
+                    apply_pre_ops(vreg_tmp_src, i, tail);
                     uni_vmaxps_maybe_tail(vmax, vreg_tmp_src, vtmp, tail);
                 }
             }
@@ -469,6 +540,7 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
                 vtmp = Vmm(i + 2);
                 io_[src_d_.data_type()]->load(
                         src_ptr(src_axis_stride_ * i), vreg_tmp_src, tail);
+                apply_pre_ops(vreg_tmp_src, i, tail);
                 uni_vsubps(vreg_tmp_src, vreg_tmp_src, vmax);
                 if (is_logsoftmax_) { // store before applying exp
                     if (need_scratchpad_)
@@ -492,6 +564,13 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
         });
 
         get_horizontal_op(vsum, vtmp = vmax, op_t::sum);
+        if (is_softmax_ && with_pre_ops_) {
+            // a row hidden by the mask entirely has zero outputs
+            mov(reg_tmp, float2int(FLT_MIN));
+            uni_vmovq(Xmm(vmax.getIdx()), reg_tmp);
+            uni_vbroadcastss(vmax, Xmm(vmax.getIdx()));
+            uni_vmaxps(vsum, vsum, vmax);
+        }
         if (is_softmax_) uni_vdivps(vsum, vone, vsum, vtmp = vmax);
         if (is_logsoftmax_) log_injector_->compute_vector(vsum.getIdx());
     }
@@ -659,14 +738,22 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
     // that are participated are not defined at the moment of base ctor
     // initialization.
     void generate() override {
+        const bool fast_math = eltwise_injector::is_fast_math_allowed(
+                pd_->attr()->fpmath_mode_);
         if (pd_->is_fwd() || is_logsoftmax_)
             exp_injector_.reset(new jit_uni_eltwise_injector_f32<isa>(this,
                     alg_kind::eltwise_exp, 0.0f, 0.0f, 1.0f, true,
-                    reg_exp_injector_table, injector_mask));
+                    reg_exp_injector_table, injector_mask,
+                    /* is_fwd = */ true, /* use_dst = */ false,
+                    /* preserve_vmm = */ true, /* preserve_p_table = */ true,
+                    fast_math));
         if (pd_->is_fwd() && is_logsoftmax_) {
             log_injector_.reset(new jit_uni_eltwise_injector_f32<isa>(this,
                     alg_kind::eltwise_log, 0.0f, 0.0f, 1.0f, true,
-                    reg_log_injector_table, injector_mask));
+                    reg_log_injector_table, injector_mask,
+                    /* is_fwd = */ true, /* use_dst = */ false,
+                    /* preserve_vmm = */ true, /* preserve_p_table = */ true,
+                    fast_math));
         }
         if (with_postops_) {
             static constexpr bool preserve_gpr = true;
@@ -684,9 +771,12 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
             const binary_injector::static_params_t bsp {
                     reg_param, get_supported_bcast_strategies(), rhs_sp};
 
+            eltwise_injector::static_params_t esp;
+            esp.fast_math = fast_math;
+
             postops_injector_ = utils::make_unique<
                     injector::jit_uni_postops_injector_t<isa>>(
-                    this, pd_->attr()->post_ops_, bsp);
+                    this, pd_->attr()->post_ops_, bsp, esp);
         }
 #undef PARAM_OFF
 
@@ -702,6 +792,12 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
         else
             backward();
         postamble();
+        if (with_causal_mask_) {
+            align(vlen);
+            L(l_iota_table_);
+            for (size_t i = 0; i < simd_w_; i++)
+                dd(i);
+        }
         if (exp_injector_) exp_injector_->prepare_table();
         if (log_injector_) log_injector_->prepare_table();
         if (with_eltwise_ && postops_injector_)
@@ -731,6 +827,14 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
         with_binary_ = post_ops.find(primitive_kind::binary) != -1;
         with_eltwise_ = post_ops.find(primitive_kind::eltwise) != -1;
 
+        const auto &pre_ops = pd_->attr()->softmax_pre_ops_;
+        with_pre_ops_ = !pre_ops.has_default_values();
+        with_pre_scale_ = pre_ops.scale_ != 1.f;
+        with_mask_buffer_ = pre_ops.mask_kind_ == softmax_mask_kind::buffer;
+        with_causal_mask_ = pre_ops.with_causal_mask();
+        mask_dt_ = with_mask_buffer_ ? pre_ops.mask_desc_.data_type
+                                     : data_type::f32;
+
         io::io_conf_t io_conf;
         io::io_tail_conf_t io_tail_conf(simd_w_, axis_simd_tail_,
                 tail_opmask_idx_, tail_vmask.getIdx(), reg_tmp);
@@ -741,7 +845,7 @@ struct jit_softmax_kernel_t : jit_softmax_kernel_base_t, public jit_generator {
                 vzero.getIdx(), vsaturation_ubound.getIdx(), reg_tmp);
         io_ = io::jit_io_multi_dt_helper_t<Vmm>(this, isa,
                 {src_d_.data_type(), dst_d_.data_type(),
-                        data_type::f32 /* stats */},
+                        data_type::f32 /* stats */, mask_dt_},
                 io_conf, io_tail_conf, io_bf16_conf,
                 {{dst_d_.data_type(), io_saturation_conf}});
     }
@@ -815,6 +919,11 @@ status_t jit_uni_softmax_fwd_t::execute(const exec_ctx_t &ctx) const {
 
     const int nthr = pd()->nthr_;
 
+    const auto mask = CTX_IN_MEM(const char *, DNNL_ARG_ATTR_SOFTMAX_MASK);
+    const auto mask_dt_size = pd()->with_mask_buffer()
+            ? types::data_type_size(pd()->pre_ops().mask_desc_.data_type)
+            : 0;
+
     const char *dst_orig_ptr = dst;
     parallel_nd_ext(nthr, outer_size, inner_size,
             [&](int ithr, int, dim_t ou, dim_t in) {
@@ -835,6 +944,19 @@ status_t jit_uni_softmax_fwd_t::execute(const exec_ctx_t &ctx) const {
                 p.dst_orig = dst_orig_ptr;
                 p.post_ops_binary_rhs_arg_vec
                         = post_ops_binary_rhs_arg_vec.data();
+                // pre-ops
+                p.mask = nullptr;
+                p.causal_len = 0;
+                if (pd()->with_pre_ops()) {
+                    // src is plain with the softmax axis last here
+                    dims_t pos = {0};
+                    for (int d = 0; d < axis; d++)
+                        pos[d] = (offset / bd.strides[d]) % src_d.dims()[d];
+                    if (pd()->with_mask_buffer())
+                        p.mask = mask + pd()->mask_off(pos) * mask_dt_size;
+                    if (pd()->with_causal_mask())
+                        p.causal_len = pd()->causal_len(pos[axis - 1]);
+                }
                 (*ker_)(&p);
             });
 
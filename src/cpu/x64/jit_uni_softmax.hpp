@@ -60,6 +60,10 @@ struct jit_softmax_kernel_base_t {
         // post ops
         const void *dst_orig;
         const void *post_ops_binary_rhs_arg_vec;
+
+        // pre-ops
+        const void *mask; // mask row matching the src row
+        size_t causal_len; // elements of the row kept by a causal mask
     };
 
     virtual void operator()(const call_params_t *p) const = 0;
@@ -139,10 +143,13 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
 
             VCHECK_SOFTMAX(
                     attr()->has_default_values(skip_mask_t::scales_runtime
-                            | skip_mask_t::post_ops),
+                            | skip_mask_t::post_ops
+                            | skip_mask_t::softmax_pre_ops),
                     VERBOSE_UNSUPPORTED_ATTR);
             VCHECK_SOFTMAX(attr_scales_ok(), VERBOSE_UNSUPPORTED_SCALES_CFG);
             VCHECK_SOFTMAX(post_ops_ok(), VERBOSE_UNSUPPORTED_POSTOP);
+            VCHECK_SOFTMAX(attr_pre_ops_ok() && pre_ops_ok(),
+                    VERBOSE_UNSUPPORTED_ATTR);
 #undef VCHECK_SOFTMAX
 
             ok = set_default_formats() == status::success
@@ -192,6 +199,33 @@ struct jit_uni_softmax_fwd_t : public primitive_t {
                     softmax_impl::get_supported_bcast_strategies());
             return !with_sum && injector::post_ops_ok(post_ops_args);
         }
+
+        // The kernel applies pre-ops to plain rows along the last axis only,
+        // and reads a mask buffer row contiguously along that axis.
+        bool pre_ops_ok() const {
+            using namespace data_type;
+            if (!with_pre_ops()) return true;
+
+            const auto src_dt = src_md()->data_type;
+            bool ok = is_superset(isa_, avx2)
+                    && memory_desc_wrapper(src_md()).is_plain()
+                    && axis() == ndims() - 1
+                    // AVX2 loads xf16 src as even/odd halves
+                    && IMPLICATION(utils::one_of(src_dt, bf16, f16),
+                            is_superset(isa_, avx512_core));
+            if (!ok || !with_mask_buffer()) return ok;
+
+            const memory_desc_wrapper mask_d(pre_ops().mask_desc_);
+            const auto mask_dt = mask_d.data_type();
+            return mask_d.dims()[axis()] == axis_size()
+                    && mask_d.blocking_desc().strides[axis()] == 1
+                    && IMPLICATION(mask_dt == bf16,
+                            is_superset(isa_, avx512_core)
+                                    || is_superset(isa_, avx2_vnni_2))
+                    && IMPLICATION(mask_dt == f16,
+                            is_superset(isa_, avx512_core_fp16)
+                                    || is_superset(isa_, avx2_vnni_2));
+        }
     };
 
     jit_uni_softmax_fwd_t(const pd_t *apd);
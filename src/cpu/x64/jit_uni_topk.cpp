@@ -0,0 +1,268 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/ref_io_helper.hpp"
+
+#include "cpu/x64/jit_uni_topk.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using topk_utils::entry_t;
+using topk_utils::selector_t;
+
+static cpu_isa_t get_supported_isa() {
+    if (mayiuse(avx512_core_fp16)) return avx512_core_fp16;
+    if (mayiuse(avx512_core)) return avx512_core;
+    if (mayiuse(avx2_vnni_2)) return avx2_vnni_2;
+    if (mayiuse(avx2)) return avx2;
+
+    return isa_undef;
+}
+
+static bool impl_supports_datatype(data_type_t data_type) {
+    switch (data_type) {
+        case data_type::bf16:
+            return mayiuse(avx512_core) || mayiuse(avx2_vnni_2);
+        case data_type::f16:
+            return mayiuse(avx512_core_fp16) || mayiuse(avx2_vnni_2);
+        case data_type::f32: return true;
+        default: return false;
+    }
+}
+
+status_t jit_uni_topk_t::pd_t::init(engine_t *engine) {
+    conf_.isa = get_supported_isa();
+    conf_.src_type = src_md()->data_type;
+    conf_.src_dt_size = types::data_type_size(conf_.src_type);
+
+    bool ok = conf_.isa != isa_undef
+            && utils::one_of(conf_.src_type, data_type::f32, data_type::bf16,
+                    data_type::f16)
+            && impl_supports_datatype(conf_.src_type)
+            && dst_md()->data_type == conf_.src_type
+            && attr()->has_default_values()
+            && set_default_params() == status::success
+            && axis_size() <= INT32_MAX;
+    if (!ok) return status::unimplemented;
+
+    // The elements of a row must be dense in the source. The destinations
+    // are written element by element, so any plain layout is fine.
+    const memory_desc_wrapper src_d(src_md());
+    const memory_desc_wrapper dst_d(dst_md(0));
+    const memory_desc_wrapper indices_d(dst_md(1));
+    ok = src_d.is_plain() && dst_d.is_plain() && indices_d.is_plain()
+            && src_d.blocking_desc().strides[axis()] == 1;
+    if (!ok) return status::unimplemented;
+
+    conf_.nrows = outer_size() * inner_size();
+    conf_.axis_size = axis_size();
+    conf_.k = k();
+
+    init_split_conf();
+    init_scratchpad();
+
+    return status::success;
+}
+
+void jit_uni_topk_t::pd_t::init_split_conf() {
+    // A chunk is long enough for the filtering to reject most of its
+    // elements once the selection is full, and is never shorter than k.
+    const dim_t min_chunk_size = nstl::max<dim_t>(1024, 16 * conf_.k);
+
+    const dim_t nthr = dnnl_get_max_threads();
+    if (conf_.nrows >= nthr) return;
+
+    const dim_t nchunks = nstl::min(utils::div_up(nthr, conf_.nrows),
+            conf_.axis_size / min_chunk_size);
+    if (nchunks < 2) return;
+
+    // The last chunk takes the remainder of the axis.
+    conf_.split_nchunks = nchunks;
+    conf_.split_chunk_size = conf_.axis_size / nchunks;
+    conf_.is_split = true;
+}
+
+void jit_uni_topk_t::pd_t::init_scratchpad() {
+    using namespace memory_tracking::names;
+    auto scratchpad = scratchpad_registry().registrar();
+    scratchpad.template book<entry_t>(
+            key_topk_heap, dnnl_get_max_threads() * conf_.k);
+    if (conf_.is_split)
+        scratchpad.template book<entry_t>(key_topk_partials,
+                conf_.nrows * conf_.split_nchunks * conf_.k);
+}
+
+status_t jit_uni_topk_t::init(engine_t *engine) {
+    const jit_topk_conf_t &conf = pd()->get_conf();
+
+    switch (conf.isa) {
+        case avx512_core_fp16:
+            CHECK(safe_ptr_assign(kernel_,
+                    new jit_uni_topk_kernel_t<avx512_core_fp16>(conf)));
+            break;
+        case avx512_core:
+            CHECK(safe_ptr_assign(
+                    kernel_, new jit_uni_topk_kernel_t<avx512_core>(conf)));
+            break;
+        case avx2_vnni_2:
+            CHECK(safe_ptr_assign(
+                    kernel_, new jit_uni_topk_kernel_t<avx2_vnni_2>(conf)));
+            break;
+        case avx2:
+            CHECK(safe_ptr_assign(
+                    kernel_, new jit_uni_topk_kernel_t<avx2>(conf)));
+            break;
+        default: return status::runtime_error;
+    }
+
+    return kernel_->create_kernel();
+}
+
+void jit_uni_topk_t::select(const char *row_src, dim_t begin, dim_t end,
+        selector_t &selector) const {
+    // The number of the vectors filtered by a kernel call.
+    static constexpr dim_t block_nvec = 64;
+
+    const jit_topk_conf_t &conf = pd()->get_conf();
+    const data_type_t dt = conf.src_type;
+    const dim_t simd_w = kernel_->get_simd_w();
+
+    dim_t i = begin;
+    for (; i < end && !selector.full(); ++i)
+        selector.push(cpu::io::load_float_value(dt, row_src, i), i);
+
+    uint16_t masks[block_nvec];
+    jit_topk_call_s args;
+    while (end - i >= simd_w) {
+        const dim_t nvec = nstl::min(block_nvec, (end - i) / simd_w);
+        args.src = row_src + i * conf.src_dt_size;
+        args.masks = masks;
+        args.work = nvec;
+        args.threshold = selector.threshold();
+        (*kernel_)(&args);
+
+        // The threshold only grows as the candidates are pushed, so the
+        // selector rejects the candidates that are not good enough anymore.
+        for (dim_t v = 0; v < nvec; ++v) {
+            for (unsigned m = masks[v], b = 0; m != 0; m >>= 1, ++b) {
+                if (!(m & 1)) continue;
+                const dim_t idx = i + v * simd_w + b;
+                selector.push(cpu::io::load_float_value(dt, row_src, idx), idx);
+            }
+        }
+        i += nvec * simd_w;
+    }
+
+    for (; i < end; ++i)
+        selector.push(cpu::io::load_float_value(dt, row_src, i), i);
+}
+
+status_t jit_uni_topk_t::execute(const exec_ctx_t &ctx) const {
+    using namespace memory_tracking::names;
+
+    status_t status = status::success;
+    auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DST, status);
+    CHECK(status);
+    auto indices = CTX_OUT_CLEAN_MEM(int32_t *, DNNL_ARG_DST_1, status);
+    CHECK(status);
+
+    const jit_topk_conf_t &conf = pd()->get_conf();
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md(0));
+    const memory_desc_wrapper indices_d(pd()->dst_md(1));
+
+    const int axis = pd()->axis();
+    const dim_t inner = pd()->inner_size();
+    const dim_t axis_size = conf.axis_size;
+    const dim_t k = conf.k;
+    const dim_t dst_stride = dst_d.blocking_desc().strides[axis];
+    const dim_t indices_stride = indices_d.blocking_desc().strides[axis];
+
+    const auto &scratchpad = ctx.get_scratchpad_grantor();
+    entry_t *heaps = scratchpad.template get<entry_t>(key_topk_heap);
+
+    auto row_src = [&](dim_t row) {
+        const dim_t ou = row / inner, in = row % inner;
+        return src
+                + src_d.off_l(ou * axis_size * inner + in) * conf.src_dt_size;
+    };
+
+    auto write_row = [&](dim_t row, selector_t &selector) {
+        selector.finalize();
+        const entry_t *best = selector.data();
+        const dim_t ou = row / inner, in = row % inner;
+        const dim_t l_off = ou * k * inner + in;
+        const dim_t dst_off = dst_d.off_l(l_off);
+        const dim_t indices_off = indices_d.off_l(l_off);
+        for (dim_t j = 0; j < k; ++j) {
+            cpu::io::store_float_value(conf.src_type, best[j].value, dst,
+                    dst_off + j * dst_stride);
+            indices[indices_off + j * indices_stride] = best[j].index;
+        }
+    };
+
+    if (!conf.is_split) {
+        parallel(0, [&](const int ithr, const int nthr) {
+            dim_t start = 0, end = 0;
+            balance211(conf.nrows, nthr, ithr, start, end);
+            for (dim_t row = start; row < end; ++row) {
+                selector_t selector(heaps + ithr * k, k);
+                select(row_src(row), 0, axis_size, selector);
+                write_row(row, selector);
+            }
+        });
+        return status::success;
+    }
+
+    // Each chunk has at least k elements, so its selection is full.
+    entry_t *partials = scratchpad.template get<entry_t>(key_topk_partials);
+    const dim_t nchunks = conf.split_nchunks;
+    parallel_nd(conf.nrows, nchunks, [&](dim_t row, dim_t c) {
+        const dim_t begin = c * conf.split_chunk_size;
+        const dim_t end
+                = c == nchunks - 1 ? axis_size : begin + conf.split_chunk_size;
+        selector_t selector(partials + (row * nchunks + c) * k, k);
+        select(row_src(row), begin, end, selector);
+    });
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        dim_t start = 0, end = 0;
+        balance211(conf.nrows, nthr, ithr, start, end);
+        for (dim_t row = start; row < end; ++row) {
+            selector_t selector(heaps + ithr * k, k);
+            const entry_t *row_partials = partials + row * nchunks * k;
+            for (dim_t e = 0; e < nchunks * k; ++e)
+                selector.push(row_partials[e].value, row_partials[e].index);
+            write_row(row, selector);
+        }
+    });
+
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
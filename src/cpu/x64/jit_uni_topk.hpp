@@ -0,0 +1,78 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_UNI_TOPK_HPP
+#define CPU_X64_UNI_TOPK_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/primitive.hpp"
+
+#include "cpu/cpu_topk_pd.hpp"
+#include "cpu/topk_utils.hpp"
+
+#include "cpu/x64/jit_primitive_conf.hpp"
+#include "cpu/x64/jit_uni_topk_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// The selection of each row keeps the k best elements seen so far in a heap.
+// Once the heap is full, the vectorized kernel filters the rest of the row
+// against the worst kept value, so only the few candidates go to the heap.
+// Rows that are too few to occupy all the threads are split along the axis
+// into chunks selected in parallel and merged afterwards.
+struct jit_uni_topk_t : public primitive_t {
+    struct pd_t : public cpu_topk_pd_t {
+        using cpu_topk_pd_t::cpu_topk_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", conf_.isa, ""), jit_uni_topk_t);
+
+        status_t init(engine_t *engine);
+
+        const jit_topk_conf_t &get_conf() const { return conf_; };
+
+    private:
+        void init_split_conf();
+        void init_scratchpad();
+
+        jit_topk_conf_t conf_;
+    };
+
+    jit_uni_topk_t(const pd_t *apd) : primitive_t(apd) {}
+    virtual ~jit_uni_topk_t() = default;
+
+    status_t init(engine_t *engine) override;
+    status_t execute(const exec_ctx_t &ctx) const override;
+
+private:
+    // Pushes the elements [begin, end) of a row to the selector.
+    void select(const char *row_src, dim_t begin, dim_t end,
+            topk_utils::selector_t &selector) const;
+
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<jit_uni_topk_kernel_base_t> kernel_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
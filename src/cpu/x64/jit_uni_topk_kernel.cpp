@@ -0,0 +1,109 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/c_types_map.hpp"
+#include "common/type_helpers.hpp"
+
+#include "jit_uni_topk_kernel.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace Xbyak;
+#define GET_OFF(field) offsetof(jit_topk_call_s, field)
+
+template <cpu_isa_t isa, typename Vmm>
+jit_uni_topk_kernel_t<isa, Vmm>::jit_uni_topk_kernel_t(
+        const jit_topk_conf_t &conf)
+    : jit_uni_topk_kernel_base_t(conf)
+    , io_load_(this, isa, conf_.src_type, {false}, utils::nullopt,
+              io::io_emu_bf16_conf_t {vmm_bf16_emu_1_, vmm_bf16_emu_2_,
+                      vmm_bf16_emu_3_, reg_tmp_, vmm_bf16_emu_4_}) {}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_topk_kernel_t<isa, Vmm>::load_params() {
+    mov(reg_src_, ptr[reg_param_ + GET_OFF(src)]);
+    mov(reg_masks_, ptr[reg_param_ + GET_OFF(masks)]);
+    mov(reg_work_, ptr[reg_param_ + GET_OFF(work)]);
+    uni_vbroadcastss(vmm_threshold_, ptr[reg_param_ + GET_OFF(threshold)]);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_topk_kernel_t<isa, Vmm>::compute_mask(int unroll) {
+    for (int u = 0; u < unroll; ++u)
+        io_load_.load(ptr[reg_src_ + u * simd_w_ * conf_.src_dt_size],
+                Vmm(vmm_src_idx_ + u), false);
+
+    // The elements not less than or equal to the threshold, NaN included,
+    // are the candidates.
+    for (int u = 0; u < unroll; ++u) {
+        const Vmm vmm_src(vmm_src_idx_ + u);
+        if (is_zmm_) {
+            vcmpps(k_cmp_mask_, vmm_src, vmm_threshold_, _cmp_nle_us);
+            kmovw(reg_mask_.cvt32(), k_cmp_mask_);
+        } else {
+            vcmpps(vmm_src, vmm_src, vmm_threshold_, _cmp_nle_us);
+            vmovmskps(reg_mask_.cvt32(), vmm_src);
+        }
+        mov(ptr[reg_masks_ + u * sizeof(uint16_t)], reg_mask_.cvt16());
+    }
+
+    add(reg_src_, unroll * simd_w_ * conf_.src_dt_size);
+    add(reg_masks_, unroll * sizeof(uint16_t));
+    sub(reg_work_, unroll);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+void jit_uni_topk_kernel_t<isa, Vmm>::generate() {
+    preamble();
+
+    io_load_.init_bf16();
+    load_params();
+
+    Label unroll_loop, unroll_loop_end, loop, loop_end;
+
+    L(unroll_loop);
+    {
+        cmp(reg_work_, max_unroll_);
+        jl(unroll_loop_end, T_NEAR);
+        compute_mask(max_unroll_);
+        jmp(unroll_loop, T_NEAR);
+    }
+    L(unroll_loop_end);
+
+    L(loop);
+    {
+        cmp(reg_work_, 0);
+        jle(loop_end, T_NEAR);
+        compute_mask(1);
+        jmp(loop, T_NEAR);
+    }
+    L(loop_end);
+
+    postamble();
+}
+
+template struct jit_uni_topk_kernel_t<avx512_core_fp16>;
+template struct jit_uni_topk_kernel_t<avx512_core>;
+template struct jit_uni_topk_kernel_t<avx2_vnni_2>;
+template struct jit_uni_topk_kernel_t<avx2>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
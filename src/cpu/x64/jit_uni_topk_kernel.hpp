@@ -0,0 +1,93 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_UNI_TOPK_KERNEL_HPP
+#define CPU_X64_UNI_TOPK_KERNEL_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_primitive_conf.hpp"
+#include "cpu/x64/utils/jit_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+struct jit_uni_topk_kernel_base_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_topk)
+
+    jit_uni_topk_kernel_base_t(const jit_topk_conf_t &conf)
+        : jit_generator(jit_name(), nullptr, MAX_CODE_SIZE, true, conf.isa)
+        , conf_(conf) {}
+    virtual ~jit_uni_topk_kernel_base_t() = default;
+
+    virtual std::size_t get_simd_w() = 0;
+
+protected:
+    const jit_topk_conf_t conf_;
+};
+
+// Filters `work` vectors of the source against a threshold: the bit of an
+// element is set in the mask of its vector if the element is greater than or
+// unordered with the threshold, i.e. if it may displace the worst entry of a
+// full selection.
+template <cpu_isa_t isa, typename Vmm = typename cpu_isa_traits<isa>::Vmm>
+struct jit_uni_topk_kernel_t : public jit_uni_topk_kernel_base_t {
+    jit_uni_topk_kernel_t(const jit_topk_conf_t &conf);
+
+    virtual ~jit_uni_topk_kernel_t() = default;
+
+    std::size_t get_simd_w() override { return simd_w_; }
+
+private:
+    void load_params();
+    void compute_mask(int unroll);
+    void generate() override;
+
+    const Vmm vmm_threshold_ = Vmm(0);
+    // Vmm(1) + i holds the i-th unrolled vector.
+    static constexpr int vmm_src_idx_ = 1;
+    static constexpr int max_unroll_ = 4;
+    const Xbyak::Zmm vmm_bf16_emu_1_ = Xbyak::Zmm(28);
+    const Xbyak::Zmm vmm_bf16_emu_2_ = Xbyak::Zmm(29);
+    const Xbyak::Zmm vmm_bf16_emu_3_ = Xbyak::Zmm(30);
+    const Xbyak::Zmm vmm_bf16_emu_4_ = Xbyak::Zmm(31);
+
+    const Xbyak::Opmask k_cmp_mask_ = k1;
+
+    const Xbyak::Reg64 reg_work_ = rax;
+    const Xbyak::Reg64 reg_src_ = rbx;
+    const Xbyak::Reg64 reg_masks_ = rdx;
+    const Xbyak::Reg64 reg_mask_ = r8;
+    const Xbyak::Reg64 reg_param_ = abi_param1;
+    const Xbyak::Reg64 reg_tmp_ = abi_not_param1;
+
+    static constexpr bool is_zmm_ = std::is_same<Vmm, Xbyak::Zmm>::value;
+    static constexpr std::size_t vlen_ = is_zmm_ ? 64 : 32;
+    static constexpr std::size_t simd_w_ = vlen_ / sizeof(float);
+
+    io::jit_io_helper_t<Vmm> io_load_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -50,7 +50,10 @@ using namespace data_type;
 
 template <cpu_isa_t isa>
 status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
-    const auto src_dt = src_md_.data_type;
+    const bool with_src_dyn_quant
+            = !attr()->src_dyn_quant_params_.has_default_values();
+    // The dynamically quantized source is computed on as s8.
+    const auto src_dt = with_src_dyn_quant ? s8 : src_md_.data_type;
     const auto wei_dt = weights_md_.data_type;
     const auto dst_dt = dst_md_.data_type;
 
@@ -89,6 +92,20 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     auto check_attr_zero_points
             = [&]() -> bool { return attr()->zero_points_.common(); };
 
+    auto check_src_dyn_quant = [&]() -> bool {
+        if (!with_src_dyn_quant) return true;
+        const auto bia_dt = weights_md(1)->data_type;
+        // Scales are computed per row, so a group must span the whole K.
+        return is_superset(isa, avx512_core)
+                && one_of(src_md_.data_type, f32, bf16)
+                && attr()->src_dyn_quant_params_.group_size_
+                == static_cast<uint64_t>(K())
+                && attr()->scales_.get(DNNL_ARG_SRC).has_default_values()
+                && attr()->zero_points_.has_default_values(DNNL_ARG_SRC)
+                && IMPLICATION(with_bias(), one_of(bia_dt, f32, bf16))
+                && !has_runtime_dims_or_strides() && batch() == 1;
+    };
+
     // The current version supports runtime value for M dimension in the case
     // of 2d problems only and do not support any runtime strides for B and C
     // tensors. A tensor strides correctness check is performed in
@@ -108,7 +125,9 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
                     primitive_attr_t::skip_mask_t::scales_runtime
                             | primitive_attr_t::skip_mask_t::zero_points_runtime
                             | primitive_attr_t::skip_mask_t::post_ops
-                            | primitive_attr_t::skip_mask_t::sum_dt,
+                            | primitive_attr_t::skip_mask_t::sum_dt
+                            | primitive_attr_t::skip_mask_t::
+                                    src_dyn_quant_params,
                     dst_dt),
             VERBOSE_UNSUPPORTED_ATTR);
     VCHECK_MATMUL(attr()->post_ops_.check_sum_consistency(dst_dt, is_int8),
@@ -116,9 +135,13 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     VCHECK_MATMUL(check_attr_scales(), VERBOSE_UNSUPPORTED_SCALES_CFG);
     VCHECK_MATMUL(check_attr_zero_points(), VERBOSE_UNSUPPORTED_ZP_CFG);
     VCHECK_MATMUL(check_bias(), VERBOSE_UNSUPPORTED_BIAS_CFG);
+    VCHECK_MATMUL(check_src_dyn_quant(), VERBOSE_UNSUPPORTED_ATTR);
 
-    CHECK(init_brgemm_matmul_conf(isa, bgmmc_, *desc(), src_md_, weights_md_,
-            dst_md_, bias_md_, attr_));
+    if (with_src_dyn_quant)
+        CHECK(init_src_dyn_quant_conf(engine));
+    else
+        CHECK(init_brgemm_matmul_conf(isa, bgmmc_, *desc(), src_md_,
+                weights_md_, dst_md_, bias_md_, attr_));
 
     const float alpha = 1.0;
     const float beta = 1.0;
@@ -162,7 +185,7 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
 
         auto LDD = bgmmc_.LDD;
         CHECK(brgemm_desc_set_postops(
-                &brg, attr(), &dst_md_, LDD, bgmmc_.bia_dt));
+                &brg, brg_attr(), &dst_md_, LDD, bgmmc_.bia_dt));
 
         brgemm_attr_t brgattr;
         brgattr.generate_skip_accumulation
@@ -196,6 +219,60 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     return status::success;
 }
 
+template <cpu_isa_t isa>
+status_t brgemm_matmul_t<isa>::pd_t::init_src_dyn_quant_conf(
+        engine_t *engine) {
+    using namespace alg_kind;
+    const int ndims = dst_md_.ndims;
+
+    if (with_bias() && bias_md_.format_kind == format_kind::any)
+        CHECK(memory_desc_init_by_strides(bias_md_, nullptr));
+
+    // The brgemm kernels apply the bias before any post-op, so it is moved
+    // after the per-row scales as a binary add.
+    brg_attr_ = std::make_shared<primitive_attr_t>(attr_);
+    if (!brg_attr_->is_initialized()) return status::out_of_memory;
+    brg_attr_->src_dyn_quant_params_ = src_dyn_quant_params_t();
+
+    post_ops_t &po = brg_attr_->post_ops_;
+    po.entry_.clear();
+    dims_t row_scales_dims;
+    utils::array_copy(row_scales_dims, dst_md_.dims, ndims);
+    row_scales_dims[ndims - 1] = 1;
+    memory_desc_t row_scales_md;
+    CHECK(memory_desc_init_by_strides(
+            row_scales_md, ndims, row_scales_dims, f32, nullptr));
+    CHECK(po.append_binary(binary_mul, &row_scales_md));
+    if (with_bias()) CHECK(po.append_binary(binary_add, &bias_md_));
+    for (const auto &e : attr_.post_ops_.entry_)
+        po.entry_.push_back(e);
+
+    matmul_desc_t mmd = *desc();
+    mmd.src_desc.data_type = s8;
+    mmd.bias_desc = types::zero_md();
+    memory_desc_t src_s8_md = src_md_;
+    src_s8_md.data_type = s8;
+    memory_desc_t no_bias_md = types::zero_md();
+    CHECK(init_brgemm_matmul_conf(isa, bgmmc_, mmd, src_s8_md, weights_md_,
+            dst_md_, no_bias_md, *brg_attr_));
+    CHECK(attr_.set_default_formats(&dst_md_));
+
+    if (src_md_.format_kind == format_kind::any) {
+        src_md_.format_kind = src_s8_md.format_kind;
+        src_md_.format_desc = src_s8_md.format_desc;
+    }
+    // The quantized source is a dense row-major copy of the user one.
+    const memory_desc_wrapper src_d(src_md_);
+    const auto &strides = src_d.blocking_desc().strides;
+    VCHECK_MATMUL(src_d.is_plain() && strides[ndims - 1] == 1
+                    && strides[ndims - 2] == K(),
+            VERBOSE_UNSUPPORTED_TAG);
+
+    bgmmc_.with_src_dyn_quant = true;
+    bgmmc_.orig_src_dt = src_md_.data_type;
+    return status::success;
+}
+
 template <cpu_isa_t isa>
 status_t brgemm_matmul_t<isa>::init(engine_t *engine) {
     const auto &bgmmc = pd()->get_brgemm_matmul_conf();
@@ -222,6 +299,9 @@ status_t brgemm_matmul_t<isa>::init(engine_t *engine) {
     if (bgmmc.use_buffer_a || bgmmc.use_buffer_a_tail_only)
         CHECK(create_brgemm_matmul_copy_a(copy_A_kernel_, &bgmmc));
 
+    if (bgmmc.with_src_dyn_quant)
+        CHECK(create_brgemm_matmul_quantize_a(quantize_A_kernel_, &bgmmc));
+
     if (bgmmc.nthr_k > 1 && bgmmc.acc_dt == f32) {
         CHECK(safe_ptr_assign(
                 acc_ker_f32_, new cpu_accumulator_1d_t<data_type::f32>()));
@@ -253,6 +333,8 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
     const float *oscales = precompute_scales(
             scratchpad, src_scales, wei_scales, pd()->N(), pd()->attr());
 
+    if (pd()->get_brgemm_matmul_conf().with_src_dyn_quant) quantize_src(ctx);
+
     brg_matmul_exec_ctx_t brgmm_ctx(ctx, pd(), oscales, src_zero_point,
             wei_zero_point, dst_zero_point, dst_scales, helper);
 
@@ -707,6 +789,27 @@ void brgemm_matmul_t<isa>::accumulate(
         assert(!"unsupported accumulation data type");
 }
 
+template <cpu_isa_t isa>
+void brgemm_matmul_t<isa>::quantize_src(const exec_ctx_t &ctx) const {
+    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    const auto &scratchpad = ctx.get_scratchpad_grantor();
+    auto src_s8 = scratchpad.template get<int8_t>(
+            key_brgemm_primitive_src_dyn_quant);
+    auto row_scales = scratchpad.template get<float>(
+            key_brgemm_primitive_src_dyn_quant_scales);
+    const dim_t src_row_sz
+            = bgmmc.K * types::data_type_size(bgmmc.orig_src_dt);
+
+    parallel_nd(bgmmc.batch * bgmmc.M, [&](dim_t row) {
+        jit_brgemm_matmul_quantize_a_t::ctx_t qctx;
+        qctx.src = src + row * src_row_sz;
+        qctx.dst = src_s8 + row * bgmmc.K;
+        qctx.scale = row_scales + row;
+        (*quantize_A_kernel_)(&qctx);
+    });
+}
+
 template <cpu_isa_t isa>
 struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
     brg_matmul_exec_ctx_t(const exec_ctx_t &ctx, const pd_t *pd,
@@ -783,6 +886,19 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
 
         post_ops_binary_rhs_arg_vec_ = binary_injector::prepare_binary_args(
                 pd->attr()->post_ops_, ctx);
+        if (bgmmc.with_src_dyn_quant) {
+            // The kernels read the quantized source, and the leading binary
+            // post-ops take the per-row scales and the bias.
+            data_A_ptr_ = scratchpad.template get<const char>(
+                    key_brgemm_primitive_src_dyn_quant);
+            std::vector<const void *> dyn_quant_args {
+                    scratchpad.template get<const void>(
+                            key_brgemm_primitive_src_dyn_quant_scales)};
+            if (pd->with_bias()) dyn_quant_args.push_back(bias_ptr_);
+            post_ops_binary_rhs_arg_vec_.insert(
+                    post_ops_binary_rhs_arg_vec_.begin(),
+                    dyn_quant_args.begin(), dyn_quant_args.end());
+        }
         base_brg_ker_idx_
                 = pd->get_brg_kernel_idx(false, true, 0, false, false);
         vnni_factor = data_type_vnni_granularity(bgmmc.wei_dt);
@@ -95,9 +95,20 @@ struct brgemm_matmul_t : public primitive_t {
             return bgmmc_;
         }
 
+        // Attributes the brgemm kernels are generated with.
+        const primitive_attr_t *brg_attr() const {
+            return brg_attr_ ? brg_attr_.get() : attr();
+        }
+
     private:
+        status_t init_src_dyn_quant_conf(engine_t *engine);
+
         brgemm_t brg_descs_[max_num_brg_kernels_matmul];
         brgemm_matmul_conf_t bgmmc_;
+        // With dynamic quantization of the source the per-row scales and the
+        // bias are applied as leading binary post-ops, shared between pd
+        // copies as brgemm descriptors keep a pointer to it.
+        std::shared_ptr<primitive_attr_t> brg_attr_;
     };
 
     brgemm_matmul_t(const pd_t *apd) : primitive_t(apd) {}
@@ -117,6 +128,7 @@ private:
     void compute_kernel(const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr,
             int b_idx, int m_blk_idx, int n_blk_idx, int k_blk_idx,
             bool do_init, int &prev_ker_idx) const;
+    void quantize_src(const exec_ctx_t &ctx) const;
     void copy_a_chunk_in_buffer(const brg_matmul_exec_ctx_t &brgmm_ctx,
             int ithr, int b_idx, int m_blk_idx, int k_blk_idx) const;
     void copy_b_chunk_in_buffer(const brg_matmul_exec_ctx_t &brgmm_ctx,
@@ -132,6 +144,7 @@ private:
 
     std::unique_ptr<jit_brgemm_matmul_copy_b_t> copy_B_kernel_;
     std::unique_ptr<jit_brgemm_matmul_copy_a_t> copy_A_kernel_;
+    std::unique_ptr<jit_brgemm_matmul_quantize_a_t> quantize_A_kernel_;
     std::unique_ptr<cpu_accumulator_1d_t<data_type::f32>> acc_ker_f32_;
     std::unique_ptr<cpu_accumulator_1d_t<data_type::s32>> acc_ker_s32_;
 };
@@ -2912,6 +2912,160 @@ status_t create_brgemm_matmul_copy_b(
     return copy_ker->create_kernel();
 }
 
+struct jit_brgemm_matmul_quantize_a_impl_t
+    : public jit_brgemm_matmul_quantize_a_t,
+      public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_brgemm_matmul_quantize_a_impl_t)
+
+    jit_brgemm_matmul_quantize_a_impl_t(const brgemm_matmul_conf_t *conf)
+        : jit_brgemm_matmul_quantize_a_t(conf)
+        , jit_generator(jit_name())
+        , typesize_(types::data_type_size(conf_->orig_src_dt))
+        , is_bf16_(conf_->orig_src_dt == data_type::bf16)
+        , K_(conf_->K) {}
+
+    void operator()(ctx_t *ctx) override { jit_generator::operator()(ctx); }
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    using reg64_t = const Xbyak::Reg64;
+    using reg32_t = const Xbyak::Reg32;
+
+    static constexpr int simd_w_ = 16;
+    const size_t typesize_;
+    const bool is_bf16_;
+    const dim_t K_;
+
+    reg64_t reg_src = rax;
+    reg64_t reg_dst = rbx;
+    reg64_t reg_scale = rdx;
+    reg64_t reg_src_aux = rsi;
+    reg64_t reg_dst_aux = r8;
+    reg64_t reg_loop = r9;
+    reg64_t reg_tmp = r10;
+    reg32_t regw_tmp = reg_tmp.cvt32();
+
+    const Xbyak::Opmask kTail = k1;
+
+    const Zmm vmm_abs_mask = zmm0;
+    const Zmm vmm_max = zmm1;
+    const Zmm vmm_mult = zmm2;
+    const Zmm vmm_src = zmm3;
+    const Zmm vmm_tmp = zmm4;
+    const Xmm xmm_max = Xmm(vmm_max.getIdx());
+    const Xmm xmm_tmp = Xmm(vmm_tmp.getIdx());
+    const Xmm xmm_aux = Xmm(vmm_src.getIdx());
+
+    void load_src(const Zmm &vmm, const Address &addr, bool is_tail) {
+        const Zmm vmm_masked = is_tail ? vmm | kTail | T_z : vmm;
+        if (is_bf16_) {
+            vpmovzxwd(vmm_masked, addr);
+            vpslld(vmm, vmm, 16);
+        } else
+            vmovups(vmm_masked, addr);
+    }
+
+    void load_float_const(const Xmm &xmm, float value) {
+        mov(regw_tmp, float2int(value));
+        vmovd(xmm, regw_tmp);
+    }
+
+    // Runs `body(is_tail)` over the row, advancing the source and, if
+    // requested, the destination pointers.
+    template <typename body_t>
+    void k_loop(bool advance_dst, body_t body) {
+        const dim_t nblocks = K_ / simd_w_;
+        const dim_t tail = K_ % simd_w_;
+        mov(reg_src_aux, reg_src);
+        mov(reg_dst_aux, reg_dst);
+        if (nblocks > 0) {
+            Label loop;
+            mov(reg_loop, nblocks);
+            L(loop);
+            {
+                body(false);
+                add(reg_src_aux, simd_w_ * typesize_);
+                if (advance_dst) add(reg_dst_aux, simd_w_);
+                dec(reg_loop);
+                jnz(loop, T_NEAR);
+            }
+        }
+        if (tail > 0) body(true);
+    }
+
+    void generate() override;
+};
+
+void jit_brgemm_matmul_quantize_a_impl_t::generate() {
+    preamble();
+
+    mov(reg_src, ptr[param1 + GET_OFF(src)]);
+    mov(reg_dst, ptr[param1 + GET_OFF(dst)]);
+    mov(reg_scale, ptr[param1 + GET_OFF(scale)]);
+
+    const int tail = K_ % simd_w_;
+    if (tail > 0) {
+        mov(regw_tmp, (1 << tail) - 1);
+        kmovw(kTail, regw_tmp);
+    }
+    mov(regw_tmp, 0x7fffffff);
+    vpbroadcastd(vmm_abs_mask, regw_tmp);
+    vpxord(vmm_max, vmm_max, vmm_max);
+
+    // Pass 1: maximum absolute value of the row.
+    k_loop(false, [&](bool is_tail) {
+        load_src(vmm_src, ptr[reg_src_aux], is_tail);
+        vpandd(vmm_src, vmm_src, vmm_abs_mask);
+        vmaxps(vmm_max, vmm_max, vmm_src);
+    });
+
+    const Ymm ymm_max = Ymm(vmm_max.getIdx());
+    const Ymm ymm_tmp = Ymm(vmm_tmp.getIdx());
+    vextractf64x4(ymm_tmp, vmm_max, 1);
+    vmaxps(ymm_max, ymm_max, ymm_tmp);
+    vextractf128(xmm_tmp, ymm_max, 1);
+    vmaxps(xmm_max, xmm_max, xmm_tmp);
+    vshufps(xmm_tmp, xmm_max, xmm_max, 0x4E);
+    vmaxps(xmm_max, xmm_max, xmm_tmp);
+    vshufps(xmm_tmp, xmm_max, xmm_max, 0xB1);
+    vmaxps(xmm_max, xmm_max, xmm_tmp);
+
+    // scale = absmax / 127; an all-zero row yields a zero scale.
+    load_float_const(xmm_tmp, 1.f / 127.f);
+    vmulss(xmm_tmp, xmm_max, xmm_tmp);
+    vmovss(ptr[reg_scale], xmm_tmp);
+
+    // mult = 127 / absmax; the lower bound keeps the multiplier finite so
+    // that zeros stay zeros instead of turning into NaNs.
+    load_float_const(xmm_tmp, 1e-30f);
+    vmaxss(xmm_max, xmm_max, xmm_tmp);
+    load_float_const(xmm_aux, 127.f);
+    vdivss(xmm_aux, xmm_aux, xmm_max);
+    vbroadcastss(vmm_mult, xmm_aux);
+
+    // Pass 2: quantize with rounding to nearest and saturation to s8.
+    k_loop(true, [&](bool is_tail) {
+        load_src(vmm_src, ptr[reg_src_aux], is_tail);
+        vmulps(vmm_src, vmm_src, vmm_mult);
+        vcvtps2dq(vmm_src, vmm_src);
+        if (is_tail)
+            vpmovsdb(ptr[reg_dst_aux] | kTail, vmm_src);
+        else
+            vpmovsdb(ptr[reg_dst_aux], vmm_src);
+    });
+
+    postamble();
+}
+
+status_t create_brgemm_matmul_quantize_a(
+        std::unique_ptr<jit_brgemm_matmul_quantize_a_t> &quant_ker,
+        const brgemm_matmul_conf_t *conf) {
+    if (!is_superset(conf->isa, avx512_core)) return status::unimplemented;
+    CHECK(safe_ptr_assign(
+            quant_ker, new jit_brgemm_matmul_quantize_a_impl_t(conf)));
+    return quant_ker->create_kernel();
+}
+
 status_t create_brgemm_matmul_copy_a(
         std::unique_ptr<jit_brgemm_matmul_copy_a_t> &copy_ker,
         const brgemm_matmul_conf_t *conf) {
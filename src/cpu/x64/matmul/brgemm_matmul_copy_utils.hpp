@@ -73,6 +73,25 @@ struct jit_brgemm_matmul_copy_a_t {
     const brgemm_matmul_conf_t *conf_;
 };
 
+// Quantizes one row of K floating-point source values to s8 with a
+// symmetric scale computed from the row's maximum absolute value.
+struct jit_brgemm_matmul_quantize_a_t {
+    struct ctx_t {
+        const void *src;
+        void *dst;
+        float *scale;
+    };
+
+    virtual void operator()(ctx_t *ctx) = 0;
+    virtual status_t create_kernel() = 0;
+
+    jit_brgemm_matmul_quantize_a_t(const brgemm_matmul_conf_t *conf)
+        : conf_(conf) {}
+    virtual ~jit_brgemm_matmul_quantize_a_t() {}
+
+    const brgemm_matmul_conf_t *conf_;
+};
+
 status_t create_brgemm_matmul_copy_b(
         std::unique_ptr<jit_brgemm_matmul_copy_b_t> &copy_ker,
         const brgemm_matmul_conf_t *conf);
@@ -81,6 +100,10 @@ status_t create_brgemm_matmul_copy_a(
         std::unique_ptr<jit_brgemm_matmul_copy_a_t> &copy_ker,
         const brgemm_matmul_conf_t *conf);
 
+status_t create_brgemm_matmul_quantize_a(
+        std::unique_ptr<jit_brgemm_matmul_quantize_a_t> &quant_ker,
+        const brgemm_matmul_conf_t *conf);
+
 } // namespace matmul
 } // namespace x64
 } // namespace cpu
@@ -1307,6 +1307,14 @@ void init_scratchpad(memory_tracking::registrar_t &scratchpad,
         scratchpad.book(key_brgemm_primitive_buffer,
                 bgmmc.nthr * bgmmc.buffer_c_per_thread_sz, default_data_align);
 
+    if (bgmmc.with_src_dyn_quant) {
+        const size_t rows = static_cast<size_t>(bgmmc.batch) * bgmmc.M;
+        scratchpad.book(key_brgemm_primitive_src_dyn_quant, rows * bgmmc.K,
+                types::data_type_size(s8), 64);
+        scratchpad.book(key_brgemm_primitive_src_dyn_quant_scales, rows,
+                types::data_type_size(f32));
+    }
+
     if (bgmmc.has_zero_point_a) {
         const auto num_elems = bgmmc.nthr * bgmmc.zp_a_comp_elems_per_thr;
         scratchpad.book(key_brgemm_primitive_zp_comp_a, num_elems,
@@ -180,6 +180,10 @@ struct brgemm_matmul_conf_t {
     bool is_runtime_M = false;
     bool is_runtime_N = false;
     bool is_runtime_K = false;
+    // Source is quantized to s8 with per-row scales at execution time;
+    // `orig_src_dt` keeps the data type of the user source tensor.
+    bool with_src_dyn_quant = false;
+    data_type_t orig_src_dt = data_type::undef;
     inline bool lda_big_pow2() const {
         const dim_t big_K_threshold = 4096;
         return !transposed_A && math::is_pow2(K) && K >= big_K_threshold;
@@ -94,6 +94,10 @@ graph::utils::optional_t<memory::desc> dnnl_backend::get_mem_desc(
 kernel_ptr large_partition_kernel_creator() {
     return std::make_shared<larger_partition_kernel_t>();
 }
+
+kernel_ptr dynamic_shape_kernel_creator(const FCreateKernel &kernel_creator) {
+    return std::make_shared<dynamic_shape_kernel_t>(kernel_creator);
+}
 } // namespace dnnl_impl
 
 // This function should be called by backend_registry_t
@@ -25,6 +25,8 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "common/stream.hpp"
+
 #include "graph/interface/backend.hpp"
 #include "graph/interface/c_types_map.hpp"
 #include "graph/interface/logical_tensor.hpp"
@@ -67,7 +69,14 @@ struct kernel_base_t {
     status_t execute(const stream_t *astream,
             const std::vector<tensor_t> &inputs,
             const std::vector<tensor_t> &outputs) {
-        return execute_impl(astream, inputs, outputs);
+        auto ret = execute_impl(astream, inputs, outputs);
+        if (ret != status::success) return ret;
+        // Kernels hand thread-local arguments and a scratchpad that lives
+        // for this call only to the primitives, so the primitives enqueued
+        // to a stream that defers host execution must complete here.
+        if (astream->defers_host_execution())
+            ret = const_cast<stream_t *>(astream)->wait();
+        return ret;
     }
 
 #ifdef DNNL_WITH_SYCL
@@ -101,6 +110,19 @@ struct kernel_base_t {
 
     virtual status_t prepare_inplace_pairs_impl() { return status::success; };
 
+    // Returns true if the kernel can be compiled once for the given logical
+    // tensors with unknown dimensions and take the concrete shapes at
+    // execution. Otherwise, such a partition is compiled for each set of
+    // concrete shapes by the dynamic shape kernel.
+    virtual bool supports_unknown_dims(const dnnl_partition_impl_t *part,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) const {
+        UNUSED(part);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        return false;
+    }
+
     // WA: Do not cache constant weight for SYCL CPU to workaround a segment
     // fault issue when releasing the cached buffer with sycl::free at the
     // program exits. Need to remove this check once the runtime issue is fixed.
@@ -124,6 +146,10 @@ using FCreateKernel = std::function<kernel_ptr(void)>;
 
 kernel_ptr large_partition_kernel_creator();
 
+// Wraps the kernel created by the given creator to be compiled at execution
+// time for each set of concrete shapes.
+kernel_ptr dynamic_shape_kernel_creator(const FCreateKernel &kernel_creator);
+
 class dnnl_backend : public backend_t {
     friend class dnnl_partition_impl_t;
 
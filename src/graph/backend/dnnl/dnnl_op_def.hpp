@@ -775,6 +775,45 @@ DNNL_GRAPH_OP_SCHEMA(dnnl_shuffle, 1,
                         executable_creator<shuffle_executable_t>)
                 .SET_ARG_INDICES_GETTER(shuffle_executable_t))
 
+DNNL_GRAPH_OP_SCHEMA(dnnl_topk, 1,
+        op_schema_t()
+                .set_num_inputs(1)
+                .set_num_outputs(3)
+                .set_input(0, "src")
+                .set_output(0, "dst")
+                .set_output(1, "indices")
+                .set_output(2, "scratchpad")
+                // Attributes inherited from TopK
+                .set_attr(op_attr::axis, false, attribute_kind::i, (int64_t)-1)
+                .set_attr(op_attr::k, true, attribute_kind::i)
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_topk_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_topk)
+                .SET_EXECUTABLE_CREATOR(executable_creator<topk_executable_t>)
+                .SET_ARG_INDICES_GETTER(topk_executable_t))
+
+DNNL_GRAPH_OP_SCHEMA(dnnl_embedding_bag, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::optional)
+                .set_num_inputs(std::set<size_t>({2, 3}))
+                .set_num_outputs(2)
+                .set_input(0, "src")
+                .set_input(1, "indices")
+                .set_input(2, "offsets")
+                .set_output(0, "dst")
+                .set_output(1, "scratchpad")
+                // Attributes inherited from EmbeddingBag
+                .set_attr(op_attr::mode, false, attribute_kind::s, "sum",
+                        {"sum", "mean"})
+                .SET_ATTR_IS_CONSTANT // used for constant prop and cache
+                // Analysis rules
+                .set_shape_inference_function(infer_embedding_bag_output_shape)
+                .SET_LAYOUT_PROPAGATOR(layout_propagator_for_embedding_bag)
+                .SET_EXECUTABLE_CREATOR(
+                        executable_creator<embedding_bag_executable_t>)
+                .SET_ARG_INDICES_GETTER(embedding_bag_executable_t))
+
 DNNL_GRAPH_OP_SCHEMA(dnnl_reduction, 1,
         op_schema_t()
                 .set_inputs_option(op_schema_t::param_num_option::variadic)
@@ -957,6 +996,7 @@ DNNL_GRAPH_OP_SCHEMA(dnnl_softmax, 1,
                 .SET_ATTR_IS_CONSTANT // used for constant prop and cache
                 .set_attr(op_attr::fusion_info_key, false, attribute_kind::i,
                         (int64_t)-1)
+                .set_attr(op_attr::src_scale, false, attribute_kind::f, 1.0f)
                 // Analysis rules
                 .set_shape_inference_function(infer_identity_output_shape)
                 .SET_LAYOUT_PROPAGATOR(layout_propagator_for_softmax)
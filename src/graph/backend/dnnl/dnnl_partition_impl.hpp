@@ -17,6 +17,7 @@
 #ifndef GRAPH_BACKEND_DNNL_DNNL_PARTITION_IMPL_HPP
 #define GRAPH_BACKEND_DNNL_DNNL_PARTITION_IMPL_HPP
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -191,8 +192,18 @@ public:
             kernel_creator = large_partition_kernel_creator;
         }
 
+        // Partitions with unknown input dimensions are compiled for the
+        // concrete shapes given at execution time.
+        const bool is_dynamic = std::any_of(inputs.begin(), inputs.end(),
+                [](const logical_tensor_t &lt) {
+                    return logical_tensor_wrapper_t(lt).is_shape_unknown();
+                });
+
         kernel_ptr kernel = kernel_creator();
         if (!kernel) return status::unimplemented;
+        if (is_dynamic
+                && !kernel->supports_unknown_dims(part.get(), inputs, outputs))
+            kernel = dynamic_shape_kernel_creator(kernel_creator);
 
         status_t ret;
 
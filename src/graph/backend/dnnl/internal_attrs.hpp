@@ -45,6 +45,7 @@ const op_attr_t with_runtime_dst_zps = 0x1000c;
 const op_attr_t is_bias_add = 0x1000d;
 const op_attr_t with_sum = 0x1000e;
 const op_attr_t keep_dst_layout = 0x1000f;
+const op_attr_t is_inplace = 0x10010;
 
 // int64_t
 const op_attr_t alg_kind = 0x10100;
@@ -56,6 +57,7 @@ const op_attr_t kind = 0x10204;
 
 // float
 const op_attr_t p = 0x10300;
+const op_attr_t src_scale = 0x10301;
 
 // vector of int64_t
 const op_attr_t dst_zps = 0x10400;
@@ -82,11 +84,13 @@ static inline std::string internal_attr2str(op_attr_t attr) {
         CASE(is_bias_add);
         CASE(with_sum);
         CASE(keep_dst_layout);
+        CASE(is_inplace);
         CASE(alg_kind);
         CASE(fusion_info_key);
         CASE(dw_type);
         CASE(kind);
         CASE(p);
+        CASE(src_scale);
         CASE(dst_zps);
         CASE(src_zps);
         CASE(permutation);
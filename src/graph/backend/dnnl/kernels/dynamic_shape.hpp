@@ -0,0 +1,300 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_DYNAMIC_SHAPE_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_DYNAMIC_SHAPE_HPP
+
+#include <algorithm>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/utils.hpp"
+
+#include "graph/interface/logical_tensor.hpp"
+#include "graph/interface/tensor.hpp"
+
+#include "graph/backend/dnnl/dnnl_backend.hpp"
+#include "graph/backend/dnnl/dnnl_partition_impl.hpp"
+#include "graph/backend/dnnl/passes/lower.hpp"
+#include "graph/backend/dnnl/subgraph.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// Kernel for the partitions compiled with unknown input dimensions. The
+// compilation validates the layouts of the partition ports and lowers the ops
+// with the unknown dimensions, so that an unsupported partition fails there.
+// The real kernel, created by the wrapped kernel creator, is compiled at the
+// first execution with a given set of input and output shapes and kept in a
+// per-shape cache of ONEDNN_GRAPH_DYNAMIC_SHAPE_CACHE_CAPACITY entries,
+// evicting the least recently used one. Concurrent first executions with the
+// same shapes compile the kernel once.
+class dynamic_shape_kernel_t : public kernel_base_t {
+public:
+    dynamic_shape_kernel_t(FCreateKernel kernel_creator)
+        : kernel_creator_(std::move(kernel_creator)) {}
+
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override {
+        p_engine_ = make_dnnl_engine(*g_engine);
+        g_engine_ = g_engine;
+        part_ = std::dynamic_pointer_cast<dnnl_partition_impl_t>(
+                part->clone());
+        CHECK(validate(inputs, outputs));
+        for (const auto &lt : inputs)
+            compiled_lts_[lt.id] = lt;
+        for (const auto &lt : outputs)
+            compiled_lts_[lt.id] = lt;
+        return status::success;
+    }
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override {
+        kernel_ptr kernel;
+        CHECK(get_or_compile_kernel(inputs, outputs, kernel));
+        return kernel->execute(g_stream, inputs, outputs);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    status_t sycl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override {
+        kernel_ptr kernel;
+        CHECK(get_or_compile_kernel(inputs, outputs, kernel));
+        return kernel->execute_sycl(
+                g_stream, inputs, outputs, sycl_deps, sycl_event);
+    }
+#endif
+
+private:
+    using key_t = std::vector<dim_t>;
+
+    struct result_t {
+        kernel_ptr kernel;
+        status_t status;
+    };
+
+    // The kernel of an entry is available once its compilation is completed.
+    // `owner` identifies the execution compiling it.
+    struct entry_t {
+        std::shared_future<result_t> result;
+        std::list<key_t>::iterator lru_pos;
+        const void *owner;
+    };
+
+    static int capacity() {
+        static const int val = getenv_int_user(
+                "GRAPH_DYNAMIC_SHAPE_CACHE_CAPACITY", 128);
+        return val;
+    }
+
+    // Checks the ports have known ranks and non-opaque layouts, as a layout id
+    // stands for a concrete shape, and lowers a copy of the ops with the
+    // unknown dimensions to check the backend supports them.
+    status_t validate(const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) const {
+        for (const auto &lt : inputs) {
+            const logical_tensor_wrapper_t ltw(lt);
+            if (ltw.ndims() == DNNL_GRAPH_UNKNOWN_NDIMS
+                    || ltw.is_data_type_undef() || ltw.is_layout_type_undef())
+                return status::invalid_arguments;
+            if (ltw.is_opaque() && ltw.is_shape_unknown())
+                return status::invalid_arguments;
+        }
+        for (const auto &lt : outputs) {
+            if (logical_tensor_wrapper_t(lt).is_opaque())
+                return status::unimplemented;
+        }
+
+        auto part = std::dynamic_pointer_cast<dnnl_partition_impl_t>(
+                part_->clone());
+        auto sg = std::make_shared<subgraph_t>(part->get_ops(), p_engine_,
+                part->get_fpmath_mode(), part->get_use_blocked_layout(), true);
+        sg->ins_ = inputs;
+        sg->outs_ = outputs;
+        auto bind = [](const std::vector<value_t *> &vals,
+                            const std::vector<logical_tensor_t> &lts) {
+            for (auto val : vals) {
+                const size_t id = val->get_logical_tensor().id;
+                auto it = std::find_if(lts.begin(), lts.end(),
+                        [id](const logical_tensor_t &lt) {
+                            return lt.id == id;
+                        });
+                if (it == lts.end()) return status::invalid_arguments;
+                val->set_logical_tensor(*it);
+            }
+            return status::success;
+        };
+        CHECK(bind(sg->get_input_values(), inputs));
+        CHECK(bind(sg->get_output_values(), outputs));
+        return lower_down(sg);
+    }
+
+    // Returns the logical tensor used at the compilation with the shape and
+    // the strides of the tensor given at the execution. Unknown strides are
+    // filled as the dense ones.
+    logical_tensor_t get_concrete_lt(const tensor_t &t) const {
+        const logical_tensor_t &exec_lt = t.get_logical_tensor();
+        auto it = compiled_lts_.find(exec_lt.id);
+        logical_tensor_t lt = it != compiled_lts_.end() ? it->second : exec_lt;
+        lt.ndims = exec_lt.ndims;
+        for (int d = 0; d < lt.ndims; ++d)
+            lt.dims[d] = exec_lt.dims[d];
+
+        bool strides_known = exec_lt.layout_type == layout_type::strided;
+        for (int d = 0; strides_known && d < lt.ndims; ++d)
+            strides_known = exec_lt.layout.strides[d] >= 0;
+        if (strides_known) {
+            lt.layout_type = layout_type::strided;
+            for (int d = 0; d < lt.ndims; ++d)
+                lt.layout.strides[d] = exec_lt.layout.strides[d];
+        } else if (exec_lt.layout_type == layout_type::opaque) {
+            lt.layout_type = layout_type::opaque;
+            lt.layout.layout_id = exec_lt.layout.layout_id;
+        } else {
+            lt.layout_type = layout_type::strided;
+            dim_t stride = 1;
+            for (int d = lt.ndims - 1; d >= 0; --d) {
+                lt.layout.strides[d] = stride;
+                stride *= std::max<dim_t>(lt.dims[d], 1);
+            }
+        }
+        return lt;
+    }
+
+    static void append_key(key_t &key, const logical_tensor_t &lt) {
+        key.push_back(lt.id);
+        key.push_back(lt.ndims);
+        key.push_back(static_cast<dim_t>(lt.layout_type));
+        for (int d = 0; d < lt.ndims; ++d) {
+            key.push_back(lt.dims[d]);
+            if (lt.layout_type == layout_type::strided)
+                key.push_back(lt.layout.strides[d]);
+        }
+        if (lt.layout_type == layout_type::opaque)
+            key.push_back(static_cast<dim_t>(lt.layout.layout_id));
+    }
+
+    status_t get_or_compile_kernel(const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs, kernel_ptr &kernel) {
+        std::vector<logical_tensor_t> in_lts, out_lts;
+        key_t key;
+        for (const auto &t : inputs) {
+            in_lts.push_back(get_concrete_lt(t));
+            append_key(key, in_lts.back());
+        }
+        for (const auto &t : outputs) {
+            out_lts.push_back(get_concrete_lt(t));
+            append_key(key, out_lts.back());
+        }
+
+        if (capacity() <= 0) {
+            const result_t res = compile_kernel(in_lts, out_lts);
+            kernel = res.kernel;
+            return res.status;
+        }
+
+        // The first execution with the shapes puts a pending entry into the
+        // cache and compiles the kernel, the others wait for the result.
+        std::shared_future<result_t> result;
+        std::promise<result_t> promise;
+        bool is_owner = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = kernels_.find(key);
+            if (it != kernels_.end()) {
+                lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+                result = it->second.result;
+            } else {
+                if ((int)kernels_.size() >= capacity()) {
+                    kernels_.erase(lru_.back());
+                    lru_.pop_back();
+                }
+                result = promise.get_future().share();
+                lru_.push_front(key);
+                kernels_.emplace(
+                        key, entry_t {result, lru_.begin(), &promise});
+                is_owner = true;
+            }
+        }
+
+        if (is_owner) {
+            const result_t res = compile_kernel(in_lts, out_lts);
+            promise.set_value(res);
+            if (res.status != status::success) {
+                // Failed shapes are not kept, so that the next execution
+                // with them reports the error again.
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = kernels_.find(key);
+                if (it != kernels_.end() && it->second.owner == &promise) {
+                    lru_.erase(it->second.lru_pos);
+                    kernels_.erase(it);
+                }
+            }
+        }
+
+        const result_t &res = result.get();
+        kernel = res.kernel;
+        return res.status;
+    }
+
+    result_t compile_kernel(const std::vector<logical_tensor_t> &in_lts,
+            const std::vector<logical_tensor_t> &out_lts) const {
+        // The compilation transforms the subgraph in the partition, so each
+        // shape gets its own copy.
+        auto part = std::dynamic_pointer_cast<dnnl_partition_impl_t>(
+                part_->clone());
+        kernel_ptr kernel = kernel_creator_();
+        if (!kernel) return {nullptr, status::unimplemented};
+        // The other executions waiting for the kernel need a result even if
+        // the primitive creation throws.
+        status_t st = status::success;
+        try {
+            st = kernel->compile(part.get(), g_engine_, in_lts, out_lts);
+        } catch (...) { st = status::unimplemented; }
+        if (st != status::success) return {nullptr, st};
+        return {kernel, status::success};
+    }
+
+    FCreateKernel kernel_creator_;
+    const engine_t *g_engine_ = nullptr;
+    std::shared_ptr<dnnl_partition_impl_t> part_;
+    std::unordered_map<size_t, logical_tensor_t> compiled_lts_;
+
+    std::mutex mutex_;
+    std::map<key_t, entry_t> kernels_;
+    std::list<key_t> lru_;
+};
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
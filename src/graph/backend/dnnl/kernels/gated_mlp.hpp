@@ -0,0 +1,584 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_GATED_MLP_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_GATED_MLP_HPP
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/bfloat16.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/float16.hpp"
+
+#include "graph/backend/dnnl/common.hpp"
+#include "graph/backend/dnnl/constant_cache.hpp"
+#include "graph/backend/dnnl/dnnl_partition_impl.hpp"
+#include "graph/backend/dnnl/scratchpad.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// Kernel for the gated feed-forward block of LLaMA-family models (SwiGLU):
+//
+//     h = silu(x * W1) * (x * W3)
+//     y = h * W2                      (optional)
+//
+// where silu(t) = t * sigmoid(t) comes as a Sigmoid and a Multiply.
+//
+// The gate projection applies silu as a swish post-op and writes it to the
+// left half of a [M, 2N] intermediate. The up projection multiplies it in as
+// a binary post-op and writes h to the right half, or to the output without
+// the down projection, which reads h from there.
+//
+// When both up-projections share x and their weights are constant, W1 and W3
+// are concatenated to one [K, 2N] weight and packed once into the constant
+// cache, so the up-projections are done by one matmul in one pass over x. A
+// post-op can't read the other half of the matmul output, so the gating is
+// then a vectorized pass over the intermediate, writing h over the
+// up-projection in its right half.
+struct gated_mlp_t : public kernel_base_t {
+public:
+    // Views a strided tensor as a matrix of its rows: the leading dims must
+    // collapse into one and the last dim must be dense.
+    static bool flatten_rows(
+            const logical_tensor_t &lt, dim_t &rows, dim_t &cols, dim_t &ld) {
+        if (lt.layout_type != layout_type::strided || lt.ndims < 1)
+            return false;
+        const int nd = lt.ndims;
+        const dim_t *strides = lt.layout.strides;
+        cols = lt.dims[nd - 1];
+        if (strides[nd - 1] != 1 && cols != 1) return false;
+        rows = 1;
+        for (int d = 0; d < nd - 1; ++d)
+            rows *= lt.dims[d];
+        ld = nd > 1 ? strides[nd - 2] : cols;
+        for (int d = 0; d < nd - 2; ++d) {
+            if (lt.dims[d] != 1
+                    && strides[d] != strides[d + 1] * lt.dims[d + 1])
+                return false;
+        }
+        return true;
+    }
+
+private:
+    allocator_t *g_alloc_ = nullptr;
+
+    dnnl::memory::data_type dt_ = dnnl::memory::data_type::undef;
+    dim_t M_ = 0, K_ = 0, N_ = 0;
+    size_t dt_size_ = 0;
+
+    // indices of the partition inputs
+    size_t x_idx_ = 0, x3_idx_ = 0, w1_idx_ = 0, w3_idx_ = 0, w2_idx_ = 0;
+
+    // up-projections, to the left (gate) and right (up) half of the
+    // intermediate. Without packing, silu is written to silu_md_ at its
+    // beginning and h to up_dst_md_.
+    bool packed_w13_ = false;
+    dnnl::memory::desc x_md_, x3_md_, w1_md_, w3_md_, w13_md_;
+    dnnl::memory::desc t_md_, t_half_md_, silu_md_, up_dst_md_;
+    size_t t_size_ = 0;
+    dnnl::matmul gate_mm_, up_mm_;
+    dnnl::reorder w1_to_plain_, w3_to_plain_, w13_pack_;
+    dnnl::memory::desc w13_plain_md_, w13_half_md_;
+
+    // down projection, reading h from the intermediate at h_offset_ bytes
+    bool with_down_ = false;
+    size_t h_offset_ = 0;
+    bool packed_w2_ = false;
+    dnnl::memory::desc w2_md_, w2_packed_md_;
+    dnnl::matmul down_mm_;
+    dnnl::reorder w2_pack_;
+    size_t w2_offset_ = 0; // in bytes, in the constant buffer
+
+    dnnl::memory::desc dst_md_;
+    dim_t dst_ld_ = 0;
+    size_t const_size_ = 0;
+
+    constant_cache_t::key_t constant_key_
+            = reinterpret_cast<constant_cache_t::key_t>(this);
+
+    static bool find_index(const std::vector<logical_tensor_t> &lts,
+            size_t id, size_t &idx) {
+        for (size_t i = 0; i < lts.size(); ++i) {
+            if (lts[i].id != id) continue;
+            idx = i;
+            return true;
+        }
+        return false;
+    }
+
+    static size_t in_id(const op_t *op, size_t offset) {
+        return op->get_input_value(offset)->get_logical_tensor().id;
+    }
+
+    static size_t out_id(const op_t *op) {
+        return op->get_output_value(0)->get_logical_tensor().id;
+    }
+
+    // Fills dense strides to an output logical tensor without a layout.
+    static void set_dense_strides(logical_tensor_t &lt) {
+        if (lt.layout_type != layout_type::any) return;
+        lt.layout_type = layout_type::strided;
+        dim_t stride = 1;
+        for (int d = lt.ndims - 1; d >= 0; --d) {
+            lt.layout.strides[d] = stride;
+            stride *= std::max<dim_t>(lt.dims[d], 1);
+        }
+    }
+
+    dnnl::memory::desc make_weights_md(
+            const op_t *matmul, const logical_tensor_t &lt) const {
+        dnnl::memory::desc md = make_dnnl_memory_desc(lt);
+        if (matmul->has_attr(op_attr::transpose_b)
+                && matmul->get_attr<bool>(op_attr::transpose_b))
+            md = transpose(md, 0, 1);
+        return md;
+    }
+
+    // exp(x) for x in [-87, 88] by the range reduction x = n * ln2 + r,
+    // |r| <= ln2 / 2, and a polynomial of r, in a form compilers vectorize.
+    static float exp_approx(float x) {
+        x = std::min(std::max(x, -87.f), 88.f);
+        const float fn = x * 1.44269504f;
+        const int n = static_cast<int>(fn + (fn < 0.f ? -0.5f : 0.5f));
+        const float r = x - static_cast<float>(n) * 0.693147181f;
+        // the Taylor series of exp(r) up to r^6 / 6!
+        float p = 1.f / 720;
+        p = p * r + 1.f / 120;
+        p = p * r + 1.f / 24;
+        p = p * r + 1.f / 6;
+        p = p * r + 1.f / 2;
+        p = p * r + 1.f;
+        p = p * r + 1.f;
+        return p * impl::utils::bit_cast<float>((n + 127) << 23);
+    }
+
+    static const float *as_f32(const float *src, float *buf, dim_t n) {
+        UNUSED(buf);
+        UNUSED(n);
+        return src;
+    }
+    static const float *as_f32(const bfloat16_t *src, float *buf, dim_t n) {
+        cvt_bfloat16_to_float(buf, src, n);
+        return buf;
+    }
+    static const float *as_f32(const float16_t *src, float *buf, dim_t n) {
+        cvt_float16_to_float(buf, src, n);
+        return buf;
+    }
+
+    static float *out_f32(float *dst, float *buf) {
+        UNUSED(buf);
+        return dst;
+    }
+    template <typename T>
+    static float *out_f32(T *dst, float *buf) {
+        UNUSED(dst);
+        return buf;
+    }
+
+    static void store_f32(float *dst, const float *src, dim_t n) {
+        UNUSED(dst);
+        UNUSED(src);
+        UNUSED(n);
+    }
+    static void store_f32(bfloat16_t *dst, const float *src, dim_t n) {
+        cvt_float_to_bfloat16(dst, src, n);
+    }
+    static void store_f32(float16_t *dst, const float *src, dim_t n) {
+        cvt_float_to_float16(dst, src, n);
+    }
+
+    // Gates the [M, 2N] output of the packed up-projection to h, in f32
+    // blocks of the rows. h may be the left half of the intermediate.
+    template <typename T>
+    void apply_gating(const char *t, char *h, dim_t h_ld) const {
+        constexpr dim_t block = 256;
+        const dim_t N = N_;
+        const dim_t nblocks = impl::utils::div_up(N, block);
+        const T *t_ptr = reinterpret_cast<const T *>(t);
+        T *h_ptr = reinterpret_cast<T *>(h);
+        parallel_nd(M_, nblocks, [&](dim_t m, dim_t b) {
+            float gate_buf[block], up_buf[block], out_buf[block];
+            const dim_t n0 = b * block;
+            const dim_t len = std::min(block, N - n0);
+            const T *row = t_ptr + m * 2 * N + n0;
+            const float *gate = as_f32(row, gate_buf, len);
+            const float *up = as_f32(row + N, up_buf, len);
+            T *dst = h_ptr + m * h_ld + n0;
+            float *out = out_f32(dst, out_buf);
+            PRAGMA_OMP_SIMD()
+            for (dim_t n = 0; n < len; ++n)
+                out[n] = gate[n] / (1.f + exp_approx(-gate[n])) * up[n];
+            store_f32(dst, out, len);
+        });
+    }
+
+    void pack_weights(const stream_t *g_stream, dnnl::stream &p_stream,
+            const std::vector<tensor_t> &inputs, char *buf) const {
+        if (packed_w13_) {
+            // W1 and W3 are first concatenated to a plain [K, 2N] weight.
+            temporary_scratchpad_t plain(
+                    w13_plain_md_.get_size(), p_engine_, *g_alloc_);
+            char *plain_buf = plain.get_buffer();
+            w1_to_plain_.execute(p_stream,
+                    {{DNNL_ARG_FROM,
+                             make_dnnl_memory(w1_md_, p_engine_,
+                                     inputs[w1_idx_].get_data_handle())},
+                            {DNNL_ARG_TO,
+                                    make_dnnl_memory(w13_half_md_, p_engine_,
+                                            plain_buf)}});
+            w3_to_plain_.execute(p_stream,
+                    {{DNNL_ARG_FROM,
+                             make_dnnl_memory(w3_md_, p_engine_,
+                                     inputs[w3_idx_].get_data_handle())},
+                            {DNNL_ARG_TO,
+                                    make_dnnl_memory(w13_half_md_, p_engine_,
+                                            plain_buf + N_ * dt_size_)}});
+            w13_pack_.execute(p_stream,
+                    {{DNNL_ARG_FROM,
+                             make_dnnl_memory(
+                                     w13_plain_md_, p_engine_, plain_buf)},
+                            {DNNL_ARG_TO,
+                                    make_dnnl_memory(
+                                            w13_md_, p_engine_, buf)}});
+            // the plain weight is released on return
+            if (g_stream->defers_host_execution()) p_stream.wait();
+        }
+        if (packed_w2_) {
+            w2_pack_.execute(p_stream,
+                    {{DNNL_ARG_FROM,
+                             make_dnnl_memory(w2_md_, p_engine_,
+                                     inputs[w2_idx_].get_data_handle())},
+                            {DNNL_ARG_TO,
+                                    make_dnnl_memory(w2_packed_md_, p_engine_,
+                                            buf + w2_offset_)}});
+        }
+    }
+
+public:
+    ~gated_mlp_t() override {
+        if (enabled_constant_cache() && const_size_ > 0) {
+            get_global_constant_cache().remove_if_exist(constant_key_);
+        }
+    }
+
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override {
+        p_engine_ = make_dnnl_engine(*g_engine);
+        g_alloc_ = reinterpret_cast<graph::allocator_t *>(
+                g_engine->get_allocator());
+        if (p_engine_.get_kind() != dnnl::engine::kind::cpu)
+            return status::unimplemented;
+
+        // Identify the ops of the block by the values connecting them.
+        const op_t *sigmoid = nullptr;
+        std::vector<const op_t *> matmuls, muls;
+        for (const auto &op : part->get_ops()) {
+            if (op->get_kind() == graph::op_kind::Sigmoid)
+                sigmoid = op.get();
+            else if (op->get_kind() == graph::op_kind::MatMul)
+                matmuls.emplace_back(op.get());
+            else if (op->get_kind() == graph::op_kind::Multiply)
+                muls.emplace_back(op.get());
+        }
+        if (!sigmoid || muls.size() != 2) return status::invalid_arguments;
+
+        const op_t *silu_mul = muls[0], *gate_mul = muls[1];
+        if (in_id(gate_mul, 0) == out_id(sigmoid)
+                || in_id(gate_mul, 1) == out_id(sigmoid))
+            std::swap(silu_mul, gate_mul);
+        const size_t up_out_id = in_id(gate_mul, 0) == out_id(silu_mul)
+                ? in_id(gate_mul, 1)
+                : in_id(gate_mul, 0);
+        const op_t *gate_mm = nullptr, *up_mm = nullptr, *down_mm = nullptr;
+        for (const op_t *mm : matmuls) {
+            if (out_id(mm) == in_id(sigmoid, 0))
+                gate_mm = mm;
+            else if (out_id(mm) == up_out_id)
+                up_mm = mm;
+            else if (in_id(mm, 0) == out_id(gate_mul))
+                down_mm = mm;
+        }
+        if (!gate_mm || !up_mm) return status::invalid_arguments;
+        with_down_ = down_mm != nullptr;
+
+        const auto &part_ins = part->get_inputs();
+        if (!find_index(part_ins, in_id(gate_mm, 0), x_idx_)
+                || !find_index(part_ins, in_id(up_mm, 0), x3_idx_)
+                || !find_index(part_ins, in_id(gate_mm, 1), w1_idx_)
+                || !find_index(part_ins, in_id(up_mm, 1), w3_idx_)
+                || (with_down_
+                        && !find_index(part_ins, in_id(down_mm, 1), w2_idx_)))
+            return status::invalid_arguments;
+        logical_tensor_t x_lt, x3_lt, w1_lt, w3_lt, w2_lt;
+        size_t given_idx = 0;
+        for (const auto &p : {std::make_pair(gate_mm, &x_lt),
+                     std::make_pair(up_mm, &x3_lt)}) {
+            if (!find_index(inputs, in_id(p.first, 0), given_idx))
+                return status::invalid_arguments;
+            *p.second = inputs[given_idx];
+        }
+        for (const auto &p : {std::make_pair(gate_mm, &w1_lt),
+                     std::make_pair(up_mm, &w3_lt),
+                     std::make_pair(down_mm, &w2_lt)}) {
+            if (!p.first) continue;
+            if (!find_index(inputs, in_id(p.first, 1), given_idx))
+                return status::invalid_arguments;
+            *p.second = inputs[given_idx];
+        }
+
+        dt_ = static_cast<dnnl::memory::data_type>(x_lt.data_type);
+        dt_size_ = logical_tensor_wrapper_t(x_lt).data_type_size();
+        if (x3_lt.data_type != x_lt.data_type
+                || w1_lt.data_type != x_lt.data_type
+                || w3_lt.data_type != x_lt.data_type
+                || outputs[0].data_type != x_lt.data_type)
+            return status::unimplemented;
+
+        dim_t x_ld = 0, x3_ld = 0, M3 = 0, K3 = 0;
+        if (!flatten_rows(x_lt, M_, K_, x_ld)
+                || !flatten_rows(x3_lt, M3, K3, x3_ld) || M3 != M_
+                || K3 != K_)
+            return status::unimplemented;
+        x_md_ = dnnl::memory::desc({M_, K_}, dt_, {x_ld, 1});
+        x3_md_ = dnnl::memory::desc({M_, K_}, dt_, {x3_ld, 1});
+
+        w1_md_ = make_weights_md(gate_mm, w1_lt);
+        w3_md_ = make_weights_md(up_mm, w3_lt);
+        if (w1_md_.get_ndims() != 2 || w1_md_.get_dims() != w3_md_.get_dims()
+                || w1_md_.get_dims()[0] != K_)
+            return status::unimplemented;
+        N_ = w1_md_.get_dims()[1];
+
+        auto &dst_lt = const_cast<logical_tensor_t &>(outputs[0]);
+        set_dense_strides(dst_lt);
+        dim_t dst_rows = 0, dst_cols = 0;
+        if (!flatten_rows(dst_lt, dst_rows, dst_cols, dst_ld_)
+                || dst_rows != M_)
+            return status::unimplemented;
+        if (!with_down_ && dst_cols != N_) return status::unimplemented;
+        dst_md_ = dnnl::memory::desc({M_, dst_cols}, dt_, {dst_ld_, 1});
+
+        dnnl::primitive_attr attr;
+        attr.set_fpmath_mode(
+                static_cast<dnnl::fpmath_mode>(part->get_fpmath_mode()));
+
+        // intermediate [M, 2N] and its halves with the leading dim 2N
+        t_md_ = dnnl::memory::desc({M_, 2 * N_}, dt_, {2 * N_, 1});
+        t_half_md_ = dnnl::memory::desc({M_, N_}, dt_, {2 * N_, 1});
+        h_offset_ = N_ * dt_size_;
+
+        packed_w13_ = enabled_constant_cache() && x_idx_ == x3_idx_
+                && logical_tensor_wrapper_t(w1_lt).is_constant()
+                && logical_tensor_wrapper_t(w3_lt).is_constant();
+        if (packed_w13_) {
+            dnnl::memory::desc w13_any_md(
+                    {K_, 2 * N_}, dt_, dnnl::memory::format_tag::any);
+            dnnl::matmul::primitive_desc pd(
+                    p_engine_, x_md_, w13_any_md, t_md_, attr);
+            up_mm_ = dnnl::matmul(pd);
+            w13_md_ = pd.weights_desc();
+            w13_plain_md_ = dnnl::memory::desc({K_, 2 * N_}, dt_, {2 * N_, 1});
+            w13_half_md_ = dnnl::memory::desc({K_, N_}, dt_, {2 * N_, 1});
+            w1_to_plain_ = dnnl::reorder(dnnl::reorder::primitive_desc(
+                    p_engine_, w1_md_, p_engine_, w13_half_md_));
+            w3_to_plain_ = dnnl::reorder(dnnl::reorder::primitive_desc(
+                    p_engine_, w3_md_, p_engine_, w13_half_md_));
+            w13_pack_ = dnnl::reorder(dnnl::reorder::primitive_desc(
+                    p_engine_, w13_plain_md_, p_engine_, w13_md_));
+            const_size_ = w13_md_.get_size();
+            t_size_ = t_md_.get_size();
+        } else {
+            // The binary post-op reads silu at the offset of the element it
+            // writes, so silu is laid out as the destination of h.
+            silu_md_ = with_down_ ? t_half_md_
+                                  : dnnl::memory::desc(
+                                          {M_, N_}, dt_, {dst_ld_, 1});
+            up_dst_md_ = with_down_ ? t_half_md_ : dst_md_;
+            t_size_ = with_down_ ? t_md_.get_size() : silu_md_.get_size();
+
+            dnnl::post_ops gate_ops, up_ops;
+            gate_ops.append_eltwise(dnnl::algorithm::eltwise_swish, 1.f, 0.f);
+            up_ops.append_binary(dnnl::algorithm::binary_mul, silu_md_);
+            dnnl::primitive_attr gate_attr = attr, up_attr = attr;
+            gate_attr.set_post_ops(gate_ops);
+            up_attr.set_post_ops(up_ops);
+            gate_mm_ = dnnl::matmul(dnnl::matmul::primitive_desc(
+                    p_engine_, x_md_, w1_md_, silu_md_, gate_attr));
+            up_mm_ = dnnl::matmul(dnnl::matmul::primitive_desc(
+                    p_engine_, x3_md_, w3_md_, up_dst_md_, up_attr));
+        }
+
+        if (with_down_) {
+            if (w2_lt.data_type != x_lt.data_type)
+                return status::unimplemented;
+            w2_md_ = make_weights_md(down_mm, w2_lt);
+            if (w2_md_.get_ndims() != 2 || w2_md_.get_dims()[0] != N_
+                    || w2_md_.get_dims()[1] != dst_cols)
+                return status::unimplemented;
+            packed_w2_ = enabled_constant_cache()
+                    && logical_tensor_wrapper_t(w2_lt).is_constant();
+            const dnnl::memory::desc w2_md
+                    = packed_w2_ ? to_format_any(w2_md_) : w2_md_;
+            dnnl::matmul::primitive_desc pd(
+                    p_engine_, t_half_md_, w2_md, dst_md_, attr);
+            down_mm_ = dnnl::matmul(pd);
+            if (packed_w2_) {
+                w2_packed_md_ = pd.weights_desc();
+                w2_pack_ = dnnl::reorder(dnnl::reorder::primitive_desc(
+                        p_engine_, w2_md_, p_engine_, w2_packed_md_));
+                // keep the packed W2 aligned behind the packed W13
+                const size_t align = 64;
+                w2_offset_ = (const_size_ + align - 1) / align * align;
+                const_size_ = w2_offset_ + w2_packed_md_.get_size();
+            }
+        }
+
+        return status::success;
+    }
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override {
+        dnnl::stream p_stream = make_dnnl_stream(p_engine_, *g_stream);
+        char *dst = static_cast<char *>(outputs[0].get_data_handle());
+
+        temporary_scratchpad_t scratchpad(t_size_, p_engine_, *g_alloc_);
+        assertm(scratchpad.size() >= t_size_, "no enough scratchpad memory");
+        char *t = scratchpad.get_buffer();
+
+        const char *packed = nullptr;
+        constant_cache_t::cached_t c_buffer;
+        if (const_size_ > 0) {
+            std::promise<constant_cache_t::cached_t> c_promise;
+            constant_cache_t::value_t cached_value
+                    = get_global_constant_cache().get_or_add(
+                            constant_key_, c_promise.get_future());
+            if (cached_value.valid()) {
+                c_buffer = cached_value.get();
+            } else {
+                c_buffer = std::make_shared<constant_buffer_t>(
+                        const_size_, p_engine_, g_alloc_);
+                pack_weights(
+                        g_stream, p_stream, inputs, c_buffer->data<char>());
+                c_promise.set_value(c_buffer);
+            }
+            packed = c_buffer->data<char>();
+        }
+
+        auto x_mem = make_dnnl_memory(
+                x_md_, p_engine_, inputs[x_idx_].get_data_handle());
+        if (packed_w13_) {
+            auto w13_mem = make_dnnl_memory(
+                    w13_md_, p_engine_, const_cast<char *>(packed));
+            up_mm_.execute(p_stream,
+                    {{DNNL_ARG_SRC, x_mem}, {DNNL_ARG_WEIGHTS, w13_mem},
+                            {DNNL_ARG_DST,
+                                    make_dnnl_memory(t_md_, p_engine_, t)}});
+
+            // The gating reads the up-projections on the host, which a
+            // stream deferring host execution has not run yet.
+            if (g_stream->defers_host_execution()) p_stream.wait();
+            char *h = with_down_ ? t + h_offset_ : dst;
+            const dim_t h_ld = with_down_ ? 2 * N_ : dst_ld_;
+            switch (dt_) {
+                case dnnl::memory::data_type::f32:
+                    apply_gating<float>(t, h, h_ld);
+                    break;
+                case dnnl::memory::data_type::bf16:
+                    apply_gating<bfloat16_t>(t, h, h_ld);
+                    break;
+                case dnnl::memory::data_type::f16:
+                    apply_gating<float16_t>(t, h, h_ld);
+                    break;
+                default: return status::unimplemented;
+            }
+        } else {
+            auto silu_mem = make_dnnl_memory(silu_md_, p_engine_, t);
+            gate_mm_.execute(p_stream,
+                    {{DNNL_ARG_SRC, x_mem},
+                            {DNNL_ARG_WEIGHTS,
+                                    make_dnnl_memory(w1_md_, p_engine_,
+                                            inputs[w1_idx_].get_data_handle())},
+                            {DNNL_ARG_DST, silu_mem}});
+            up_mm_.execute(p_stream,
+                    {{DNNL_ARG_SRC,
+                             make_dnnl_memory(x3_md_, p_engine_,
+                                     inputs[x3_idx_].get_data_handle())},
+                            {DNNL_ARG_WEIGHTS,
+                                    make_dnnl_memory(w3_md_, p_engine_,
+                                            inputs[w3_idx_].get_data_handle())},
+                            {DNNL_ARG_DST,
+                                    make_dnnl_memory(up_dst_md_, p_engine_,
+                                            with_down_ ? t + h_offset_ : dst)},
+                            {DNNL_ARG_ATTR_MULTIPLE_POST_OP(0)
+                                            | DNNL_ARG_SRC_1,
+                                    silu_mem}});
+        }
+
+        if (with_down_) {
+            auto w2_mem = packed_w2_
+                    ? make_dnnl_memory(w2_packed_md_, p_engine_,
+                            const_cast<char *>(packed) + w2_offset_)
+                    : make_dnnl_memory(w2_md_, p_engine_,
+                            inputs[w2_idx_].get_data_handle());
+            down_mm_.execute(p_stream,
+                    {{DNNL_ARG_SRC,
+                             make_dnnl_memory(
+                                     t_half_md_, p_engine_, t + h_offset_)},
+                            {DNNL_ARG_WEIGHTS, w2_mem},
+                            {DNNL_ARG_DST,
+                                    make_dnnl_memory(
+                                            dst_md_, p_engine_, dst)}});
+        }
+
+        // The intermediate is released on return, before a stream deferring
+        // host execution would run the primitives reading it.
+        if (g_stream->defers_host_execution()) p_stream.wait();
+        return status::success;
+    }
+
+#ifdef DNNL_WITH_SYCL
+    status_t sycl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override {
+        UNUSED(g_stream);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        UNUSED(sycl_deps);
+        UNUSED(sycl_event);
+        return status::unimplemented;
+    }
+#endif
+};
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -273,6 +273,12 @@ public:
             mem_offkey.first.set_data_handle(
                     var_grantor.get(mem_offkey.second));
         }
+
+        for (auto &mem_view : res->get_mems_use_views()) {
+            char *base = static_cast<char *>(
+                    mem_view.second.base_.get_data_handle());
+            mem_view.first.set_data_handle(base + mem_view.second.offset_);
+        }
     }
 
     status_t execute_impl(const stream_t *g_stream,
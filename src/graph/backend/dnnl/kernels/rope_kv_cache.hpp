@@ -0,0 +1,571 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_ROPE_KV_CACHE_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_ROPE_KV_CACHE_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/bfloat16.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/float16.hpp"
+
+#include "graph/interface/graph.hpp"
+
+#include "graph/backend/dnnl/common.hpp"
+#include "graph/backend/dnnl/dnnl_partition_impl.hpp"
+#include "graph/backend/dnnl/kernels/matmul.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace dnnl_impl {
+
+// Kernel for the projection part of an autoregressive decoder layer:
+//
+//     [MatMul -> [BiasAdd] ->] [RotaryEmbedding ->] [Concat(cache, *)]
+//
+// The MatMul (compiled as a float matmul kernel on its own sub-partition)
+// writes the new rows directly to their place in the Concat output, i.e. at
+// the offset of the past rows along the concatenation axis, and the rotary
+// embedding is applied in place to the just computed rows, one head at a time
+// with vectorized loops. The past rows are copied to the Concat output only
+// when the past and the present cache tensors do not share the buffer, so a
+// preallocated cache that is passed as both is appended to without touching
+// its content.
+//
+// The length of the past cache is taken from the tensor given at execution,
+// so the partition may be compiled with this length unknown and serve every
+// position of a preallocated cache of known strides.
+struct rope_kv_cache_t : public kernel_base_t {
+private:
+    // Strided description of the tensor in the rotary embedding.
+    struct view_t {
+        std::vector<dim_t> dims;
+        std::vector<dim_t> strides;
+    };
+
+    const engine_t *g_engine_ = nullptr;
+
+    // matmul part
+    kernel_ptr matmul_kernel_;
+    std::vector<size_t> matmul_input_idx_;
+    logical_tensor_t matmul_dst_lt_;
+
+    // rotary embedding part
+    bool with_rope_ = false;
+    bool interleaved_ = false;
+    size_t rope_src_idx_ = 0, cos_idx_ = 0, sin_idx_ = 0;
+    view_t rope_src_, rope_dst_, cos_, sin_;
+    dim_t head_size_ = 0;
+    data_type_t rope_dt_ = graph::data_type::undef;
+
+    // concat part
+    bool with_concat_ = false;
+    int axis_ = 0;
+    size_t past_idx_ = 0;
+    dim_t new_rows_ = 0;
+    size_t dt_size_ = 0;
+    logical_tensor_t dst_lt_;
+    // The copy of the past rows for the length known at compilation, if any.
+    dim_t compiled_past_len_ = DNNL_GRAPH_UNKNOWN_DIM;
+    dnnl::memory::desc past_md_, past_in_dst_md_;
+    dnnl::reorder past_copy_;
+
+    static view_t make_view(const logical_tensor_t &lt) {
+        const logical_tensor_wrapper_t ltw(lt);
+        return {ltw.vdims(), ltw.vstrides()};
+    }
+
+    // Fills dense strides to a logical tensor without a layout or with
+    // unknown strides.
+    static void set_dense_strides(logical_tensor_t &lt) {
+        bool strides_known = lt.layout_type == layout_type::strided;
+        for (int d = 0; strides_known && d < lt.ndims; ++d)
+            strides_known = lt.layout.strides[d] >= 0;
+        if (strides_known || lt.layout_type == layout_type::opaque) return;
+        lt.layout_type = layout_type::strided;
+        dim_t stride = 1;
+        for (int d = lt.ndims - 1; d >= 0; --d) {
+            lt.layout.strides[d] = stride;
+            stride *= std::max<dim_t>(lt.dims[d], 1);
+        }
+    }
+
+    static bool find_index(const std::vector<logical_tensor_t> &lts,
+            size_t id, size_t &idx) {
+        for (size_t i = 0; i < lts.size(); ++i) {
+            if (lts[i].id != id) continue;
+            idx = i;
+            return true;
+        }
+        return false;
+    }
+
+    // Checks the cos/sin tensor is (1, ..., 1, S, D/2) with dense rows.
+    static bool is_rope_table_ok(const logical_tensor_t &lt, dim_t S) {
+        const logical_tensor_wrapper_t ltw(lt);
+        if (!ltw.is_strided() || ltw.ndims() < 2) return false;
+        const auto dims = ltw.vdims();
+        for (int d = 0; d < ltw.ndims() - 2; ++d)
+            if (dims[d] != 1) return false;
+        return dims[ltw.ndims() - 2] == S
+                && ltw.vstrides()[ltw.ndims() - 1] == 1;
+    }
+
+    // Helpers to process the rows of any supported data type in f32. A f32
+    // row is used in place, the others are converted to and from `buf`.
+    static const float *as_f32(const float *row, float *buf, dim_t n) {
+        UNUSED(buf);
+        UNUSED(n);
+        return row;
+    }
+    static const float *as_f32(const bfloat16_t *row, float *buf, dim_t n) {
+        cvt_bfloat16_to_float(buf, row, n);
+        return buf;
+    }
+    static const float *as_f32(const float16_t *row, float *buf, dim_t n) {
+        cvt_float16_to_float(buf, row, n);
+        return buf;
+    }
+
+    static float *load_head(
+            const float *src, float *dst, float *buf, dim_t n) {
+        UNUSED(buf);
+        if (src != dst) std::memcpy(dst, src, n * sizeof(float));
+        return dst;
+    }
+    static float *load_head(
+            const bfloat16_t *src, bfloat16_t *dst, float *buf, dim_t n) {
+        UNUSED(dst);
+        cvt_bfloat16_to_float(buf, src, n);
+        return buf;
+    }
+    static float *load_head(
+            const float16_t *src, float16_t *dst, float *buf, dim_t n) {
+        UNUSED(dst);
+        cvt_float16_to_float(buf, src, n);
+        return buf;
+    }
+
+    static void store_head(float *dst, const float *head, dim_t n) {
+        UNUSED(dst);
+        UNUSED(head);
+        UNUSED(n);
+    }
+    static void store_head(bfloat16_t *dst, const float *head, dim_t n) {
+        cvt_float_to_bfloat16(dst, head, n);
+    }
+    static void store_head(float16_t *dst, const float *head, dim_t n) {
+        cvt_float_to_float16(dst, head, n);
+    }
+
+    // Rotates the channel pairs of one head in place:
+    //     x0' = x0 * cos - x1 * sin, x1' = x1 * cos + x0 * sin.
+    void rotate_head(float *x, const float *cos, const float *sin) const {
+        const dim_t half = head_size_ / 2;
+        if (interleaved_) {
+            PRAGMA_OMP_SIMD()
+            for (dim_t i = 0; i < half; ++i) {
+                const float x0 = x[2 * i], x1 = x[2 * i + 1];
+                x[2 * i] = x0 * cos[i] - x1 * sin[i];
+                x[2 * i + 1] = x1 * cos[i] + x0 * sin[i];
+            }
+        } else {
+            float *x_hi = x + half;
+            PRAGMA_OMP_SIMD()
+            for (dim_t i = 0; i < half; ++i) {
+                const float x0 = x[i], x1 = x_hi[i];
+                x[i] = x0 * cos[i] - x1 * sin[i];
+                x_hi[i] = x1 * cos[i] + x0 * sin[i];
+            }
+        }
+    }
+
+    template <typename T>
+    void apply_rope(const void *src, void *dst, const void *cos,
+            const void *sin) const {
+        const int nd = static_cast<int>(rope_dst_.dims.size());
+        const dim_t C = rope_dst_.dims[nd - 1];
+        const dim_t S = rope_dst_.dims[nd - 2];
+        dim_t outer = 1;
+        for (int d = 0; d < nd - 2; ++d)
+            outer *= rope_dst_.dims[d];
+        const dim_t H = C / head_size_;
+        const dim_t half = head_size_ / 2;
+        const dim_t cos_s_stride = cos_.strides[cos_.strides.size() - 2];
+        const dim_t sin_s_stride = sin_.strides[sin_.strides.size() - 2];
+
+        const T *src_ptr = static_cast<const T *>(src);
+        T *dst_ptr = static_cast<T *>(dst);
+        const T *cos_ptr = static_cast<const T *>(cos);
+        const T *sin_ptr = static_cast<const T *>(sin);
+
+        // The table rows are converted once for all the heads of a row.
+        parallel(0, [&](const int ithr, const int nthr) {
+            dim_t start = 0, end = 0;
+            balance211(outer * S, nthr, ithr, start, end);
+            std::vector<float> head_buf(head_size_), cos_buf(half),
+                    sin_buf(half);
+            for (dim_t os = start; os < end; ++os) {
+                dim_t o = os / S;
+                const dim_t s = os % S;
+                dim_t src_off = s * rope_src_.strides[nd - 2];
+                dim_t dst_off = s * rope_dst_.strides[nd - 2];
+                for (int d = nd - 3; d >= 0; --d) {
+                    const dim_t idx = o % rope_dst_.dims[d];
+                    o /= rope_dst_.dims[d];
+                    src_off += idx * rope_src_.strides[d];
+                    dst_off += idx * rope_dst_.strides[d];
+                }
+                const float *c = as_f32(
+                        cos_ptr + s * cos_s_stride, cos_buf.data(), half);
+                const float *sn = as_f32(
+                        sin_ptr + s * sin_s_stride, sin_buf.data(), half);
+                for (dim_t h = 0; h < H; ++h) {
+                    T *y = dst_ptr + dst_off + h * head_size_;
+                    float *x = load_head(src_ptr + src_off + h * head_size_, y,
+                            head_buf.data(), head_size_);
+                    rotate_head(x, c, sn);
+                    store_head(y, x, head_size_);
+                }
+            }
+        });
+    }
+
+    // Copies the past rows to the output unless the past tensor is already
+    // the beginning of the output buffer.
+    status_t copy_past(dnnl::stream &p_stream, const tensor_t &past,
+            void *dst, dim_t past_len) const {
+        const bool is_compiled = past_len == compiled_past_len_;
+        dnnl::memory::desc past_md = past_md_, past_in_dst_md = past_in_dst_md_;
+        if (!is_compiled) {
+            logical_tensor_t past_lt = past.get_logical_tensor();
+            set_dense_strides(past_lt);
+            past_md = make_dnnl_memory_desc(past_lt);
+            logical_tensor_t past_in_dst_lt = dst_lt_;
+            past_in_dst_lt.dims[axis_] = past_len;
+            past_in_dst_md = make_dnnl_memory_desc(past_in_dst_lt);
+        }
+
+        void *past_ptr = past.get_data_handle();
+        if (past_ptr == dst) {
+            // A preallocated cache passed as both the past and the present
+            // tensor already holds the past rows. Any other layout of the
+            // past rows would make the copy read the memory it writes.
+            return past_md == past_in_dst_md ? status::success
+                                             : status::invalid_arguments;
+        }
+
+        dnnl::reorder copy = is_compiled
+                ? past_copy_
+                : dnnl::reorder(dnnl::reorder::primitive_desc(
+                        p_engine_, past_md, p_engine_, past_in_dst_md));
+        auto src_mem = make_dnnl_memory(past_md, p_engine_, past_ptr);
+        auto dst_mem = make_dnnl_memory(past_in_dst_md, p_engine_, dst);
+        copy.execute(p_stream,
+                {{DNNL_ARG_FROM, src_mem}, {DNNL_ARG_TO, dst_mem}});
+        return status::success;
+    }
+
+    static const op_t *find_op(
+            const dnnl_partition_impl_t *part, op_kind_t kind) {
+        for (const auto &op : part->get_ops())
+            if (op->get_kind() == kind) return op.get();
+        return nullptr;
+    }
+
+public:
+    // Only the length of the past cache may be unknown, with the output laid
+    // out in a buffer of known strides, e.g. a preallocated cache.
+    bool supports_unknown_dims(const dnnl_partition_impl_t *part,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) const override {
+        const op_t *concat_op = find_op(part, graph::op_kind::Concat);
+        if (concat_op == nullptr || outputs.size() != 1) return false;
+        const logical_tensor_t &dst_lt = outputs[0];
+        const auto past_id
+                = concat_op->get_input_value(0)->get_logical_tensor().id;
+        const logical_tensor_t new_lt
+                = concat_op->get_input_value(1)->get_logical_tensor();
+
+        int64_t axis = concat_op->get_attr<int64_t>(op_attr::axis);
+        if (axis < 0) axis += dst_lt.ndims;
+        if (axis < 0 || axis >= dst_lt.ndims || new_lt.ndims != dst_lt.ndims
+                || new_lt.dims[axis] < 0)
+            return false;
+
+        for (const auto &lt : inputs)
+            for (int d = 0; d < lt.ndims; ++d)
+                if (lt.dims[d] < 0 && !(lt.id == past_id && d == axis))
+                    return false;
+        if (dst_lt.layout_type != layout_type::strided) return false;
+        for (int d = 0; d < dst_lt.ndims; ++d)
+            if ((dst_lt.dims[d] < 0 && d != axis)
+                    || dst_lt.layout.strides[d] < 0)
+                return false;
+        return true;
+    }
+
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override {
+        p_engine_ = make_dnnl_engine(*g_engine);
+        g_engine_ = g_engine;
+        if (p_engine_.get_kind() != dnnl::engine::kind::cpu)
+            return status::unimplemented;
+
+        const auto &part_ins = part->get_inputs();
+        std::vector<std::shared_ptr<op_t>> matmul_ops;
+        const op_t *rope_op = nullptr, *concat_op = nullptr;
+        for (const auto &op : part->get_ops()) {
+            if (op->get_kind() == graph::op_kind::RotaryEmbedding)
+                rope_op = op.get();
+            else if (op->get_kind() == graph::op_kind::Concat)
+                concat_op = op.get();
+            else
+                matmul_ops.emplace_back(op);
+        }
+        with_rope_ = rope_op != nullptr;
+        with_concat_ = concat_op != nullptr;
+
+        // The partition output is the output of the last op of the chain.
+        assertm(outputs.size() == 1, "expect single output");
+        auto &dst_lt = const_cast<logical_tensor_t &>(outputs[0]);
+        set_dense_strides(dst_lt);
+        if (!logical_tensor_wrapper_t(dst_lt).is_strided())
+            return status::unimplemented;
+        dt_size_ = logical_tensor_wrapper_t(dst_lt).data_type_size();
+        dst_lt_ = dst_lt;
+
+        // The tensor receiving the new rows: either the whole output or its
+        // part behind the past rows along the concatenation axis.
+        logical_tensor_t new_rows_lt = dst_lt;
+        if (with_concat_) {
+            const auto past_id
+                    = concat_op->get_input_value(0)->get_logical_tensor().id;
+            if (!find_index(part_ins, past_id, past_idx_))
+                return status::invalid_arguments;
+            size_t past_given_idx = 0;
+            if (!find_index(inputs, past_id, past_given_idx))
+                return status::invalid_arguments;
+            const logical_tensor_t &past_lt = inputs[past_given_idx];
+            if (!logical_tensor_wrapper_t(past_lt).is_strided())
+                return status::unimplemented;
+
+            int64_t axis = concat_op->get_attr<int64_t>(op_attr::axis);
+            if (axis < 0) axis += dst_lt.ndims;
+            if (axis < 0 || axis >= dst_lt.ndims
+                    || past_lt.ndims != dst_lt.ndims)
+                return status::invalid_arguments;
+            axis_ = static_cast<int>(axis);
+
+            const logical_tensor_t new_lt
+                    = concat_op->get_input_value(1)->get_logical_tensor();
+            new_rows_ = new_lt.ndims == dst_lt.ndims && new_lt.dims[axis_] >= 0
+                    ? new_lt.dims[axis_]
+                    : dst_lt.dims[axis_] - past_lt.dims[axis_];
+            if (new_rows_ < 0) return status::invalid_arguments;
+            new_rows_lt.dims[axis_] = new_rows_;
+
+            // The copy of the past rows is prepared only for a known length.
+            compiled_past_len_ = past_lt.dims[axis_];
+            if (compiled_past_len_ >= 0) {
+                past_md_ = make_dnnl_memory_desc(past_lt);
+                logical_tensor_t past_in_dst_lt = dst_lt;
+                past_in_dst_lt.dims[axis_] = compiled_past_len_;
+                past_in_dst_md_ = make_dnnl_memory_desc(past_in_dst_lt);
+                past_copy_ = dnnl::reorder(dnnl::reorder::primitive_desc(
+                        p_engine_, past_md_, p_engine_, past_in_dst_md_));
+            }
+        }
+
+        if (with_rope_) {
+            const auto src_id
+                    = rope_op->get_input_value(0)->get_logical_tensor().id;
+            const auto cos_id
+                    = rope_op->get_input_value(1)->get_logical_tensor().id;
+            const auto sin_id
+                    = rope_op->get_input_value(2)->get_logical_tensor().id;
+            if (!find_index(part_ins, cos_id, cos_idx_)
+                    || !find_index(part_ins, sin_id, sin_idx_))
+                return status::invalid_arguments;
+            size_t cos_given_idx = 0, sin_given_idx = 0;
+            if (!find_index(inputs, cos_id, cos_given_idx)
+                    || !find_index(inputs, sin_id, sin_given_idx))
+                return status::invalid_arguments;
+            const logical_tensor_t &cos_lt = inputs[cos_given_idx];
+            const logical_tensor_t &sin_lt = inputs[sin_given_idx];
+
+            interleaved_ = rope_op->has_attr(op_attr::mode)
+                    && rope_op->get_attr<std::string>(op_attr::mode)
+                            == "interleaved";
+            rope_dt_ = new_rows_lt.data_type;
+
+            const int nd = new_rows_lt.ndims;
+            if (nd < 2) return status::invalid_arguments;
+            const dim_t S = new_rows_lt.dims[nd - 2];
+            const dim_t C = new_rows_lt.dims[nd - 1];
+            if (!is_rope_table_ok(cos_lt, S) || !is_rope_table_ok(sin_lt, S))
+                return status::unimplemented;
+            head_size_ = 2 * cos_lt.dims[cos_lt.ndims - 1];
+            if (head_size_ == 0 || C % head_size_ != 0
+                    || sin_lt.dims[sin_lt.ndims - 1] * 2 != head_size_)
+                return status::invalid_arguments;
+            cos_ = make_view(cos_lt);
+            sin_ = make_view(sin_lt);
+            rope_dst_ = make_view(new_rows_lt);
+            if (rope_dst_.strides[nd - 1] != 1) return status::unimplemented;
+
+            if (matmul_ops.empty()) {
+                // Standalone rotary embedding reads its own input.
+                if (!find_index(part_ins, src_id, rope_src_idx_))
+                    return status::invalid_arguments;
+                size_t src_given_idx = 0;
+                if (!find_index(inputs, src_id, src_given_idx))
+                    return status::invalid_arguments;
+                const logical_tensor_t &src_lt = inputs[src_given_idx];
+                if (!logical_tensor_wrapper_t(src_lt).is_strided())
+                    return status::unimplemented;
+                rope_src_ = make_view(src_lt);
+                if (rope_src_.strides[nd - 1] != 1)
+                    return status::unimplemented;
+            } else {
+                // Applied in place to the output of the matmul.
+                rope_src_ = rope_dst_;
+            }
+        }
+
+        if (!matmul_ops.empty()) {
+            // Compile the matmul part on its own, with its output bound to
+            // the rows of the final destination.
+            auto sub_part = std::make_shared<dnnl_partition_impl_t>(
+                    part->get_engine_kind(), part->get_fpmath_mode(),
+                    part->get_kind());
+            for (const auto &op : graph_t::deep_copy(matmul_ops))
+                sub_part->add_op(op);
+            sub_part->init_inputs_outputs();
+
+            const auto &sub_ins = sub_part->get_inputs();
+            const auto &sub_outs = sub_part->get_outputs();
+            if (sub_outs.size() != 1) return status::unimplemented;
+
+            std::vector<logical_tensor_t> sub_given_ins;
+            for (const auto &lt : sub_ins) {
+                size_t idx = 0;
+                if (!find_index(part_ins, lt.id, idx))
+                    return status::invalid_arguments;
+                matmul_input_idx_.push_back(idx);
+                size_t given_idx = 0;
+                if (!find_index(inputs, lt.id, given_idx))
+                    return status::invalid_arguments;
+                sub_given_ins.push_back(inputs[given_idx]);
+            }
+            matmul_dst_lt_ = new_rows_lt;
+            matmul_dst_lt_.id = sub_outs[0].id;
+
+            matmul_kernel_ = std::make_shared<float_matmul>();
+            CHECK(matmul_kernel_->compile(
+                    sub_part.get(), g_engine, sub_given_ins, {matmul_dst_lt_}));
+        }
+
+        return status::success;
+    }
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override {
+        dnnl::stream p_stream = make_dnnl_stream(p_engine_, *g_stream);
+        char *dst = static_cast<char *>(outputs[0].get_data_handle());
+        char *new_rows = dst;
+
+        if (with_concat_) {
+            // The position of the new rows comes from the given past cache.
+            const dim_t past_len
+                    = inputs[past_idx_].get_logical_tensor().dims[axis_];
+            const dim_t dst_len = outputs[0].get_logical_tensor().dims[axis_];
+            if (past_len < 0
+                    || (dst_len >= 0 && dst_len != past_len + new_rows_))
+                return status::invalid_arguments;
+            new_rows += static_cast<size_t>(
+                                past_len * dst_lt_.layout.strides[axis_])
+                    * dt_size_;
+            CHECK(copy_past(p_stream, inputs[past_idx_], dst, past_len));
+        }
+
+        if (matmul_kernel_) {
+            std::vector<tensor_t> matmul_ins;
+            matmul_ins.reserve(matmul_input_idx_.size());
+            for (size_t idx : matmul_input_idx_)
+                matmul_ins.emplace_back(inputs[idx]);
+            std::vector<tensor_t> matmul_outs {
+                    tensor_t(matmul_dst_lt_, g_engine_, new_rows)};
+            CHECK(matmul_kernel_->execute(g_stream, matmul_ins, matmul_outs));
+        }
+
+        if (with_rope_) {
+            // The matmul kernel has completed: a kernel waits for its
+            // primitives on a stream that defers host execution.
+            const void *src = matmul_kernel_
+                    ? new_rows
+                    : inputs[rope_src_idx_].get_data_handle();
+            const void *cos = inputs[cos_idx_].get_data_handle();
+            const void *sin = inputs[sin_idx_].get_data_handle();
+            switch (rope_dt_) {
+                case graph::data_type::f32:
+                    apply_rope<float>(src, new_rows, cos, sin);
+                    break;
+                case graph::data_type::bf16:
+                    apply_rope<bfloat16_t>(src, new_rows, cos, sin);
+                    break;
+                case graph::data_type::f16:
+                    apply_rope<float16_t>(src, new_rows, cos, sin);
+                    break;
+                default: return status::unimplemented;
+            }
+        }
+
+        return status::success;
+    }
+
+#ifdef DNNL_WITH_SYCL
+    status_t sycl_execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override {
+        UNUSED(g_stream);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        UNUSED(sycl_deps);
+        UNUSED(sycl_event);
+        return status::unimplemented;
+    }
+#endif
+};
+
+} // namespace dnnl_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -426,6 +426,53 @@ status_t layout_propagator_for_shuffle(op_ptr &op, const dnnl::engine &p_engine,
     return status;
 }
 
+status_t layout_propagator_for_topk(op_ptr &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache,
+        subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd
+            = topk_executable_t::create_desc(op, p_engine, mgr, pd_cache);
+
+    value_ptr src = op->get_input_value(0);
+    assertm(!ltw(src->get_logical_tensor()).is_any(),
+            "topk's src can't be any layout");
+
+    insert_reorder_after(
+            op, 0, pd.dst_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_output_value(0), pd.dst_desc());
+    if (status != status::success) return status;
+
+    insert_reorder_after(
+            op, 1, pd.indices_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_output_value(1), pd.indices_desc());
+    if (status != status::success) return status;
+
+    value_ptr scratchpad_val = op->get_output_value(2);
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
+status_t layout_propagator_for_embedding_bag(op_ptr &op,
+        const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+        pd_cache_t &pd_cache, subgraph_rewriter_t &rewriter) {
+    status_t status = status::success;
+    const auto &pd = embedding_bag_executable_t::create_desc(
+            op, p_engine, mgr, pd_cache);
+
+    value_ptr src = op->get_input_value(0);
+    assertm(!ltw(src->get_logical_tensor()).is_any(),
+            "embedding_bag's src can't be any layout");
+
+    insert_reorder_after(
+            op, 0, pd.dst_desc(), p_engine, mgr, pd_cache, rewriter);
+    status = fill_layout_info(op->get_output_value(0), pd.dst_desc());
+    if (status != status::success) return status;
+
+    value_ptr scratchpad_val = op->get_output_value(1);
+    status = fill_layout_info(scratchpad_val, pd.scratchpad_desc());
+    return status;
+}
+
 status_t layout_propagator_for_matmul(op_ptr &op, const dnnl::engine &p_engine,
         fusion_info_mgr_t &mgr, pd_cache_t &pd_cache,
         subgraph_rewriter_t &rewriter) {
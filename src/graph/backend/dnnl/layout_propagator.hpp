@@ -60,6 +60,8 @@ DECLARE_LAYOUT_PROPAGATOR(eltwise_bwd);
 DECLARE_LAYOUT_PROPAGATOR(binary);
 DECLARE_LAYOUT_PROPAGATOR(concat);
 DECLARE_LAYOUT_PROPAGATOR(shuffle);
+DECLARE_LAYOUT_PROPAGATOR(topk);
+DECLARE_LAYOUT_PROPAGATOR(embedding_bag);
 DECLARE_LAYOUT_PROPAGATOR(matmul);
 DECLARE_LAYOUT_PROPAGATOR(pool);
 DECLARE_LAYOUT_PROPAGATOR(pool_bwd);
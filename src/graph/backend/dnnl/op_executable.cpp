@@ -1304,6 +1304,11 @@ softmax_executable_t::desc_t softmax_executable_t::create_desc(
     }
     prm_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
 
+    // scales of a dequantize folded into the softmax source
+    if (op->has_attr(op_attr::src_scale)
+            && op->get_attr<float>(op_attr::src_scale) != 1.f)
+        prm_attr.set_softmax_pre_ops(op->get_attr<float>(op_attr::src_scale));
+
     auto src = make_dnnl_memory_desc(
             op->get_input_value(0)->get_logical_tensor());
     auto dst = make_dnnl_memory_desc(
@@ -1411,6 +1416,78 @@ shuffle_executable_t::desc_t shuffle_executable_t::create_desc(
     return {pd, false};
 }
 
+topk_executable_t::desc_t topk_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    if (pd_cache.find(op.get()) != pd_cache.end()) {
+        auto pd = graph::utils::any_cast<dnnl::topk::primitive_desc>(
+                pd_cache.at(op.get()));
+        return {pd, true};
+    }
+
+    auto src = make_dnnl_memory_desc(
+            op->get_input_value(0)->get_logical_tensor());
+    auto dst = make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor());
+    auto indices = make_dnnl_memory_desc(
+            op->get_output_value(1)->get_logical_tensor());
+    dst = to_format_any(dst);
+    indices = to_format_any(indices);
+
+    int axis = static_cast<int>(op->get_attr<int64_t>(op_attr::axis));
+    if (axis < 0) axis += src.get_ndims();
+
+    dnnl::primitive_attr prm_attr;
+    prm_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+
+    dnnl::topk::primitive_desc pd(
+            p_engine, src, dst, indices, axis, prm_attr);
+
+    pd_cache.insert({op.get(), pd});
+
+    return {pd, false};
+}
+
+embedding_bag_executable_t::desc_t embedding_bag_executable_t::create_desc(
+        std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+        fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+    if (pd_cache.find(op.get()) != pd_cache.end()) {
+        auto pd = graph::utils::any_cast<dnnl::embedding_bag::primitive_desc>(
+                pd_cache.at(op.get()));
+        return {pd, true};
+    }
+
+    auto src = make_dnnl_memory_desc(
+            op->get_input_value(0)->get_logical_tensor());
+    auto indices = make_dnnl_memory_desc(
+            op->get_input_value(1)->get_logical_tensor());
+    auto dst = make_dnnl_memory_desc(
+            op->get_output_value(0)->get_logical_tensor());
+    dst = to_format_any(dst);
+
+    const auto alg = op->get_attr<std::string>(op_attr::mode) == "mean"
+            ? dnnl::algorithm::reduction_mean
+            : dnnl::algorithm::reduction_sum;
+
+    dnnl::primitive_attr prm_attr;
+    prm_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+
+    dnnl::embedding_bag::primitive_desc pd;
+    if (op->num_inputs() > 2) {
+        auto offsets = make_dnnl_memory_desc(
+                op->get_input_value(2)->get_logical_tensor());
+        pd = dnnl::embedding_bag::primitive_desc(
+                p_engine, alg, src, indices, offsets, dst, prm_attr);
+    } else {
+        pd = dnnl::embedding_bag::primitive_desc(
+                p_engine, alg, src, indices, dst, prm_attr);
+    }
+
+    pd_cache.insert({op.get(), pd});
+
+    return {pd, false};
+}
+
 reduction_executable_t::desc_t reduction_executable_t::create_desc(
         std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
         fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
@@ -1837,6 +1914,35 @@ arg_indices_t shuffle_executable_t::get_arg_indices(
     return get_arg_indices_for_siso_op(op, mgr);
 }
 
+arg_indices_t topk_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(op);
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+
+    arg_indices.insert({DNNL_ARG_SRC, indices_t {input, 0}});
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, 0}});
+    arg_indices.insert({DNNL_ARG_DST_1, indices_t {output, 1}});
+    arg_indices.insert({DNNL_ARG_SCRATCHPAD, indices_t {output, 2}});
+
+    return arg_indices;
+}
+
+arg_indices_t embedding_bag_executable_t::get_arg_indices(
+        const op_t *op, fusion_info_mgr_t &mgr) {
+    UNUSED(mgr);
+    arg_indices_t arg_indices;
+
+    arg_indices.insert({DNNL_ARG_SRC, indices_t {input, 0}});
+    arg_indices.insert({DNNL_ARG_SRC_1, indices_t {input, 1}});
+    if (op->num_inputs() > 2)
+        arg_indices.insert({DNNL_ARG_SRC_2, indices_t {input, 2}});
+    arg_indices.insert({DNNL_ARG_DST, indices_t {output, 0}});
+    arg_indices.insert({DNNL_ARG_SCRATCHPAD, indices_t {output, 1}});
+
+    return arg_indices;
+}
+
 arg_indices_t reduction_executable_t::get_arg_indices(
         const op_t *op, fusion_info_mgr_t &mgr) {
     return get_arg_indices_for_siso_op(op, mgr);
@@ -749,12 +749,25 @@ struct concat_executable_t : public op_executable_t {
 
     concat_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
             fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+        // The inputs have been written into the output buffer by their
+        // producers, see memory_planner_t::prepare_concat_views()
+        if (op->has_attr(op_attr::is_inplace)
+                && op->get_attr<bool>(op_attr::is_inplace)) {
+            is_dummy_ = true;
+            return;
+        }
+
         auto desc = create_desc(op, p_engine, mgr, pd_cache);
         prim_ = dnnl::concat(desc);
     }
 
     void execute(const stream &stream,
             const std::unordered_map<int, memory> &args) const override {
+        if (is_dummy_) {
+            dummy_impl_.execute(stream, args);
+            return;
+        }
+
         prim_.execute(stream, args);
     }
 
@@ -762,6 +775,8 @@ struct concat_executable_t : public op_executable_t {
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
             const std::vector<::sycl::event> &deps = {}) const override {
+        if (is_dummy_) { return dummy_impl_.execute_sycl(stream, args, deps); }
+
         auto e = dnnl::sycl_interop::execute(prim_, stream, args, deps);
         if (stream.get_engine().get_kind() == engine::kind::cpu) e.wait();
         return e;
@@ -770,6 +785,8 @@ struct concat_executable_t : public op_executable_t {
 
 private:
     dnnl::concat prim_;
+    bool is_dummy_ {false};
+    dummy_impl_t dummy_impl_;
 };
 
 struct shuffle_executable_t : public op_executable_t {
@@ -802,6 +819,65 @@ private:
     dnnl::shuffle_forward prim_;
 };
 
+struct topk_executable_t : public op_executable_t {
+    DECLARE_DESC_CLASS_AND_CREATOR(dnnl::topk::primitive_desc);
+    DECLARE_ARG_INDICES_GETTER;
+
+    topk_executable_t(std::shared_ptr<op_t> &op, const dnnl::engine &p_engine,
+            fusion_info_mgr_t &mgr, pd_cache_t &pd_cache) {
+        auto desc = create_desc(op, p_engine, mgr, pd_cache);
+        prim_ = dnnl::topk(desc);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override {
+        prim_.execute(stream, args);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        auto e = dnnl::sycl_interop::execute(prim_, stream, args, deps);
+        if (stream.get_engine().get_kind() == engine::kind::cpu) e.wait();
+        return e;
+    }
+#endif
+
+private:
+    dnnl::topk prim_;
+};
+
+struct embedding_bag_executable_t : public op_executable_t {
+    DECLARE_DESC_CLASS_AND_CREATOR(dnnl::embedding_bag::primitive_desc);
+    DECLARE_ARG_INDICES_GETTER;
+
+    embedding_bag_executable_t(std::shared_ptr<op_t> &op,
+            const dnnl::engine &p_engine, fusion_info_mgr_t &mgr,
+            pd_cache_t &pd_cache) {
+        auto desc = create_desc(op, p_engine, mgr, pd_cache);
+        prim_ = dnnl::embedding_bag(desc);
+    }
+
+    void execute(const stream &stream,
+            const std::unordered_map<int, memory> &args) const override {
+        prim_.execute(stream, args);
+    }
+
+#ifdef DNNL_WITH_SYCL
+    ::sycl::event execute_sycl(const stream &stream,
+            const std::unordered_map<int, memory> &args,
+            const std::vector<::sycl::event> &deps = {}) const override {
+        auto e = dnnl::sycl_interop::execute(prim_, stream, args, deps);
+        if (stream.get_engine().get_kind() == engine::kind::cpu) e.wait();
+        return e;
+    }
+#endif
+
+private:
+    dnnl::embedding_bag prim_;
+};
+
 struct pool_executable_t : public op_executable_t {
     DECLARE_DESC_CLASS_AND_CREATOR(dnnl::pooling_forward::primitive_desc);
     DECLARE_ARG_INDICES_GETTER;
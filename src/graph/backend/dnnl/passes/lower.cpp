@@ -669,6 +669,8 @@ static const std::unordered_map<graph::op_kind_t, handler_func> handler_table {
         ITEM(TypeCast, typecast_handler),
         ITEM(Reciprocal, reciprocal_handler),
         ITEM(Concat, common_handler<op_kind::kDnnl_concat>),
+        ITEM(TopK, common_handler<op_kind::kDnnl_topk>),
+        ITEM(EmbeddingBag, common_handler<op_kind::kDnnl_embedding_bag>),
         ITEM(SquaredDifference, squared_difference_handler),
         // utility
         ITEM(Wildcard, dummy_handler),
@@ -204,6 +204,15 @@ std::shared_ptr<execution_args_set_t> execution_args_set_t::clone() const {
                 mem_offkey.second);
     }
 
+    ret->mems_use_views_.reserve(mems_use_views_.size());
+    for (const auto &mem_view : mems_use_views_) {
+        const auto &base = mem_view.second.base_;
+        mem_view_t view {ret->value_mem_map_.at(find_val(base)),
+                mem_view.second.offset_};
+        ret->mems_use_views_.emplace_back(
+                ret->value_mem_map_.at(find_val(mem_view.first)), view);
+    }
+
     ret->topo_ordered_exec_args_.reserve(topo_ordered_exec_args_.size());
     for (const auto &args : topo_ordered_exec_args_) {
         std::unordered_map<int, memory> new_args;
@@ -223,6 +232,7 @@ void execution_args_set_t::clear() {
     mems_use_external_outputs_.clear();
     mems_use_internal_temporary_.clear();
     mems_use_internal_persistent_.clear();
+    mems_use_views_.clear();
     value_mem_map_.clear();
     topo_ordered_exec_args_.clear();
 }
@@ -296,6 +306,120 @@ std::vector<const value_t *> alias_analyzer_t::get_all_aliases(
     return ret;
 }
 
+// Check if the sub-memory view of the concat output has the same physical
+// layout as the concat input, so that the input producer can write into the
+// view directly. Strides of the dimensions of size 1 are ignored since they
+// don't take part in the addressing.
+static bool is_same_layout_as_view(
+        const memory::desc &in_md, const memory::desc &view_md) {
+    using fmt_kind = memory::format_kind;
+    if (in_md.get_format_kind() != fmt_kind::blocked
+            || view_md.get_format_kind() != fmt_kind::blocked)
+        return false;
+
+    const auto &dims = in_md.get_dims();
+    if (in_md.get_data_type() != view_md.get_data_type()
+            || dims != view_md.get_dims()
+            || in_md.get_padded_dims() != view_md.get_padded_dims()
+            || in_md.get_inner_blks() != view_md.get_inner_blks()
+            || in_md.get_inner_idxs() != view_md.get_inner_idxs())
+        return false;
+
+    const auto &in_strides = in_md.get_strides();
+    const auto &view_strides = view_md.get_strides();
+    for (size_t d = 0; d < dims.size(); ++d) {
+        if (dims[d] != 1 && in_strides[d] != view_strides[d]) return false;
+    }
+    return true;
+}
+
+// Find the concat ops whose inputs can be written by their producers directly
+// into the corresponding parts of the concat output buffer. Each input of such
+// concat becomes a view of the output buffer at a fixed offset, and the concat
+// op is marked as inplace so it will not copy any data at execution. This is
+// possible when all the dimensions outer to the concat axis in the output
+// layout are 1, for example concat along the batch axis, or concat along the
+// channel axis with batch 1 for plain and blocked formats as long as the
+// offsets are on the block boundaries.
+status_t memory_planner_t::prepare_concat_views(
+        std::shared_ptr<subgraph_t> &sg, bool enable_views) {
+    // Views are set by the pointer arithmetic on the data handles, which only
+    // applies to CPU memory
+    const bool views_allowed = enable_views
+            && sg->p_engine_->get_kind() == dnnl::engine::kind::cpu;
+
+    auto sg_outs = sg->get_output_values();
+    auto can_be_view = [&](const value_t *val) {
+        if (!val->has_producer()
+                || val->get_producer().get_kind() == op_kind::dnnl_concat)
+            return false;
+        if (val->get_consumers().size() != 1) return false;
+        if (std::find(sg_outs.begin(), sg_outs.end(), val) != sg_outs.end())
+            return false;
+        // constant values are cached out of the output buffer
+        const op_t &producer = val->get_producer();
+        if (producer.has_attr(op_attr::is_constant)
+                && producer.get_attr<bool>(op_attr::is_constant))
+            return false;
+        if (logical_tensor_wrapper_t(val->get_logical_tensor()).property_type()
+                == property_type::constant)
+            return false;
+        return alias_analyzer_.get_all_aliases(val).empty();
+    };
+
+    for (auto &cur_op : sg->get_ops()) {
+        if (cur_op->get_kind() != op_kind::dnnl_concat) continue;
+        cur_op->set_attr<bool>(op_attr::is_inplace, false);
+        if (!views_allowed) continue;
+
+        // constant concat output is cached, and fused scales and zero points
+        // need the computation of concat
+        if (cur_op->has_attr(op_attr::is_constant)
+                && cur_op->get_attr<bool>(op_attr::is_constant))
+            continue;
+        if (cur_op->has_attr(op_attr::fusion_info_key)
+                && cur_op->get_attr<int64_t>(op_attr::fusion_info_key) != -1)
+            continue;
+
+        const value_t *out_val = cur_op->get_output_value(0).get();
+        const auto dst_md
+                = make_dnnl_memory_desc(out_val->get_logical_tensor());
+        const auto res = utils::try_reverse_axis(
+                cur_op->get_attr<int64_t>(op_attr::axis), dst_md.get_ndims());
+        if (!res.first) continue;
+        const auto axis = static_cast<size_t>(res.second);
+
+        std::vector<std::pair<const value_t *, size_t>> views;
+        memory::dims offsets(dst_md.get_ndims(), 0);
+        for (const auto &in_val : cur_op->get_input_values()) {
+            if (!can_be_view(in_val.get())) break;
+
+            const auto in_md
+                    = make_dnnl_memory_desc(in_val->get_logical_tensor());
+            const auto &in_dims = in_md.get_dims();
+            dnnl_memory_desc_t c_view_md = nullptr;
+            if (dnnl_memory_desc_create_submemory(&c_view_md, dst_md.get(),
+                        in_dims.data(), offsets.data())
+                    != dnnl_success)
+                break;
+            const memory::desc view_md(c_view_md);
+            if (!is_same_layout_as_view(in_md, view_md)) break;
+
+            const size_t offset = view_md.get_submemory_offset()
+                    * memory::data_type_size(dst_md.get_data_type());
+            views.emplace_back(in_val.get(), offset);
+            offsets[axis] += in_dims[axis];
+        }
+        if (views.size() != cur_op->num_inputs()) continue;
+
+        for (const auto &view : views) {
+            views_.insert({view.first, {out_val, view.second}});
+        }
+        cur_op->set_attr<bool>(op_attr::is_inplace, true);
+    }
+    return status::success;
+}
+
 // Assign partition's input edges to user given external inputs buffer. Those
 // external inputs buffers may be used by other partition (which is under the
 // control of user), so we can't reuse them.
@@ -390,6 +514,11 @@ status_t memory_planner_t::assign_external_outputs_buffer(
                             continue;
                         q.push(in_val.get());
                     }
+
+                    // push the concat input views to queue for next visit
+                    for (const auto &view : views_) {
+                        if (view.second.first == cur_val) q.push(view.first);
+                    }
                 }
             }
         }
@@ -490,7 +619,7 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
                         = temporary_buffer_ref_count[info.index_] == 1;
                 if (reuse_in_buffer) {
                     value_t *out = op->get_output_value(pair.out_idx_).get();
-                    if (!buffer_assignments_.count(out)) {
+                    if (!buffer_assignments_.count(out) && !views_.count(out)) {
                         buffer_assignments_.insert(std::make_pair(out, info));
                         temporary_buffer_ref_count[info.index_]
                                 += edge_ref_count.at(out);
@@ -504,6 +633,31 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
             // already assigned buffer, skip it
             if (buffer_assignments_.count(out.get())) continue;
 
+            // a view of concat output shares the concat output buffer, which
+            // is allocated when the first view is produced and is held until
+            // both the views and the concat output are not used anymore
+            if (views_.count(out.get())) {
+                const value_t *base = views_.at(out.get()).first;
+                if (!buffer_assignments_.count(base)) {
+                    size_t idx = temporary_buffer_assigner_.request(
+                            make_dnnl_memory_desc(base->get_logical_tensor())
+                                    .get_size());
+                    buffer_assignments_.insert(std::make_pair(
+                            base, assign_info_t(internal_temporary, idx)));
+                    size_t ref_count
+                            = edge_ref_count.at(const_cast<value_t *>(base));
+                    for (const auto &view : views_) {
+                        if (view.second.first != base) continue;
+                        ref_count += edge_ref_count.at(
+                                const_cast<value_t *>(view.first));
+                    }
+                    temporary_buffer_ref_count[idx] = ref_count;
+                }
+                assign_info_t info = buffer_assignments_.at(base);
+                buffer_assignments_.insert(std::make_pair(out.get(), info));
+                continue;
+            }
+
             // this output need a new buffer, record it
             auto lt = out->get_logical_tensor();
             size_t idx = temporary_buffer_assigner_.request(
@@ -555,6 +709,8 @@ status_t memory_planner_t::prepare_subgraph_inplace_pairs(
         for (auto &out_val : out_vals) {
             auto out_buf = buffer_assignments_.at(out_val.get());
             if (out_buf.kind_ != external_output) continue;
+            // only a part of the external output buffer
+            if (views_.count(out_val.get())) continue;
             logical_tensor_t out_lt = sg->outs_[out_buf.index_];
             logical_tensor_t in_lt = zero_logical_tensor();
 
@@ -686,6 +842,8 @@ status_t memory_planner_t::prepare_execution_args_set(
     status_t ret;
 
     auto classify_mem = [&, this](const dnnl::memory &mem, const value_t *val) {
+        // the data handle of a view is derived from its base memory
+        if (views_.count(val)) return;
         const assign_info_t &info = buffer_assignments_.at(val);
         switch (info.kind_) {
             case external_input:
@@ -730,6 +888,16 @@ status_t memory_planner_t::prepare_execution_args_set(
     });
     if (ret != status::success) return ret;
 
+    for (const auto &view : views_) {
+        dnnl::memory mem, base;
+        if (!exec_args_set_.find_value_mem_map(
+                    const_cast<value_t *>(view.first), mem)
+                || !exec_args_set_.find_value_mem_map(
+                        const_cast<value_t *>(view.second.first), base))
+            return status::invalid_arguments;
+        exec_args_set_.add_mem_use_view({mem, {base, view.second.second}});
+    }
+
     // construct the dnnl execution args for each op
     ret = topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
         const op_schema_t *opm
@@ -782,6 +950,7 @@ status_t memory_planner_t::prepare_execution_args_set(
 // - Count the reference count of each edges. the reference count will be used
 //   during assign temporary buffer to determine which edge's buffer can be
 //   reused since it ref count reduce to zero.
+// - Plan the inputs of concat ops as views of the concat output buffer.
 // - Assign external user given inputs/outputs buffer to corresponding edges
 // - Assign internal allocated temporary buffer to corresponding edges.
 // - Assign internal allocated persistent buffer to corresponding edges.
@@ -823,6 +992,10 @@ status_t memory_planner_t::run(std::shared_ptr<subgraph_t> &sg) {
         }
     }
 
+    // Find the concat inputs which can be planned as views of concat output
+    ret = prepare_concat_views(sg, enable_memory_sharing);
+    if (ret != status::success) return ret;
+
     // Assign external_input buffers to subgraph's inputs and their alias
     ret = assign_external_inputs_buffer(sg, inputs);
     if (ret != status::success) return ret;
@@ -45,6 +45,14 @@ namespace dnnl_impl {
 // multi-threads, each thread should have a replica.
 class execution_args_set_t {
 public:
+    // The memory of a sub-buffer view points to the data handle of the base
+    // memory plus the offset in bytes, so it must be updated after all the
+    // other memory objects.
+    struct mem_view_t {
+        dnnl::memory base_;
+        size_t offset_;
+    };
+
     execution_args_set_t() = default;
 
     execution_args_set_t(const execution_args_set_t &) = delete;
@@ -86,6 +94,11 @@ public:
         return mems_use_internal_persistent_;
     }
 
+    const std::vector<std::pair<dnnl::memory, mem_view_t>> &
+    get_mems_use_views() const {
+        return mems_use_views_;
+    }
+
     // adders
     void add_exec_args(const exec_args &args) {
         topo_ordered_exec_args_.emplace_back(args);
@@ -115,6 +128,11 @@ public:
         mems_use_internal_persistent_.emplace_back(mem_offkey);
     }
 
+    void add_mem_use_view(
+            const std::pair<dnnl::memory, mem_view_t> &mem_view) {
+        mems_use_views_.emplace_back(mem_view);
+    }
+
     // finders
     bool find_value_mem_map(value_t *key, memory &mem) const {
         auto pos = value_mem_map_.find(key);
@@ -136,6 +154,8 @@ private:
     // memory <-> offset key of used underlying buffer in the internal
     // persistent registry
     std::vector<std::pair<dnnl::memory, size_t>> mems_use_internal_persistent_;
+    // memory <-> base memory and offset of the buffer it is a view of
+    std::vector<std::pair<dnnl::memory, mem_view_t>> mems_use_views_;
     // value pointer -> memory
     std::unordered_map<value_t *, memory> value_mem_map_;
     // execution args for each op in the subgraph
@@ -281,6 +301,9 @@ private:
 //   Take this subgraph 't1 -> op1 -> t2 -> op2 -> t3 -> op3 -> t4-> op4 -> t5'
 //   as an example: when writing data to t4, t2 is not used any more, so they
 //   have disjoint live range and we can make them share same buffer.
+// - Concat sharing. Let the producers of concat inputs write directly into the
+//   corresponding part of the concat output buffer, so the concat doesn't need
+//   to copy any data. See prepare_concat_views() for the conditions.
 //
 // The following internal env vars can be used to control the memory planning:
 // - _ONEDNN_GRAPH_ENABLE_MEM_REUSE
@@ -385,8 +408,12 @@ private:
         temporary_registry_.clear();
         external_inputs_live_range_.clear();
         inplace_pairs_.clear();
+        views_.clear();
     }
 
+    status_t prepare_concat_views(
+            std::shared_ptr<subgraph_t> &sg, bool enable_views);
+
     status_t assign_external_inputs_buffer(std::shared_ptr<subgraph_t> &sg,
             const std::vector<logical_tensor_t> &inputs);
 
@@ -422,6 +449,9 @@ private:
     std::unordered_map<const assign_info_t *, time_bound_t>
             external_inputs_live_range_;
     std::vector<inplace_pair_t> inplace_pairs_;
+    // concat input value -> concat output value and offset in bytes
+    std::unordered_map<const value_t *, std::pair<const value_t *, size_t>>
+            views_;
 };
 
 } // namespace dnnl_impl
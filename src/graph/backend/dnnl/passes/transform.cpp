@@ -1954,6 +1954,62 @@ status_t fuse_post_typecast_to_softmax_or_layernorm(
     return status::success;
 }
 
+status_t fold_src_scales_into_softmax_or_layernorm(
+        std::shared_ptr<subgraph_t> &sg) {
+    std::vector<op_t *> scales_ops;
+    for (const auto &cur_op : sg->get_ops()) {
+        if (cur_op->get_kind() != op_kind::dnnl_mul_scales
+                || cur_op->has_attr(op_attr::with_runtime_scales))
+            continue;
+        const auto &scales
+                = cur_op->get_attr<std::vector<float>>(op_attr::scales);
+        if (scales.size() != 1 || scales[0] == 0.f) continue;
+        const auto in_lt = cur_op->get_input_value(0)->get_logical_tensor();
+        if (!impl::utils::one_of(ltw(in_lt).data_type(),
+                    impl::data_type::u8, impl::data_type::s8))
+            continue;
+        auto out = cur_op->get_output_value(0);
+        if (out->get_consumers().size() != 1
+                || out->get_consumers()[0].get_offset() != 0)
+            continue;
+        auto &next_op = out->get_consumers()[0].get_op();
+        if (next_op.get_kind() == op_kind::dnnl_layernorm) {
+            // mean and variance would be computed on unscaled data, and a
+            // negative scale flips the sign of the normalized data
+            if (!next_op.has_attr(op_attr::keep_stats)
+                    || next_op.get_attr<bool>(op_attr::keep_stats)
+                    || scales[0] < 0.f)
+                continue;
+        } else if (next_op.get_kind() != op_kind::dnnl_softmax) {
+            continue;
+        }
+        scales_ops.emplace_back(cur_op.get());
+    }
+
+    subgraph_rewriter_t rewriter(sg);
+    for (auto &scales_op : scales_ops) {
+        const float s = scales_op->get_attr<std::vector<float>>(
+                op_attr::scales)[0];
+        auto &next_op = scales_op->get_output_value(0)
+                                ->get_consumers()[0]
+                                .get_op();
+        if (next_op.get_kind() == op_kind::dnnl_softmax) {
+            float src_scale = s;
+            if (next_op.has_attr(op_attr::src_scale))
+                src_scale *= next_op.get_attr<float>(op_attr::src_scale);
+            next_op.set_attr<float>(op_attr::src_scale, src_scale);
+        } else {
+            const float epsilon = next_op.has_attr(op_attr::epsilon)
+                    ? next_op.get_attr<float>(op_attr::epsilon)
+                    : 1e-5f;
+            next_op.set_attr<float>(op_attr::epsilon, epsilon / (s * s));
+        }
+        rewriter.fuse_op_to_successor(scales_op->shared_from_this());
+    }
+    rewriter.run();
+    return status::success;
+}
+
 status_t fuse_reciprocal_mul_to_div(std::shared_ptr<subgraph_t> &sg) {
     /* transformation below graphs
     Case 1:
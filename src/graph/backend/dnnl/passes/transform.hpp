@@ -115,6 +115,18 @@ status_t fuse_post_typecast_to_matmul_or_conv(std::shared_ptr<subgraph_t> &sg);
 status_t fuse_post_typecast_to_softmax_or_layernorm(
         std::shared_ptr<subgraph_t> &sg);
 
+/// fold the per-tensor scales of a preceding dequantize into int8 softmax or
+/// layernorm: softmax(s * x) takes s as the source pre-op scale, and
+/// layernorm(s * x) equals layernorm(x) with epsilon divided by s^2 for s > 0
+///
+///          | (u8/s8)          -->             | (u8/s8)
+///      mul_scales                     softmax/layernorm
+///          | (f32)                            |
+///   softmax/layernorm
+///          |
+status_t fold_src_scales_into_softmax_or_layernorm(
+        std::shared_ptr<subgraph_t> &sg);
+
 status_t batchnorm_bwd_canonicalization(std::shared_ptr<subgraph_t> &sg);
 
 /// translate the subgraph containing chain of Adds into dnnl_sum
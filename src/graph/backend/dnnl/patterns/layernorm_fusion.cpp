@@ -110,6 +110,52 @@ DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, layernorm_post_ops_fusion_cpu)
             return std::make_shared<layernorm_fwd_t>();
         });
 
+/*
+               |
+           Dequantize
+               |
+           layernorm
+               |
+          [Quantize]*
+               |
+*/
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, int8_layernorm_fusion_cpu)
+        .set_priority(8.3f)
+        .set_kind(graph::partition_kind_t::misc_quantized_post_ops)
+        .set_engine_kind(engine_kind::cpu)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *pdequant
+                            = pgraph->append_op(graph::op_kind::Dequantize);
+                    pdequant->append_decision_function(
+                            check_qtype_equal_to_per_tensor);
+                    pdequant->append_decision_function(check_zps_values<0>);
+                    pm::pb_op_t *layernorm_base
+                            = pgraph->append_op(graph::op_kind::LayerNorm,
+                                    in_edges_t {in_edge(0, pdequant, 0)});
+                    layernorm_base->append_decision_function(
+                            check_input_dtype_from_offset<impl::data_type::f32,
+                                    1>);
+                    // the dequantize scales are folded into epsilon, which
+                    // does not hold for the mean and variance outputs
+                    layernorm_base->append_decision_function([](op_t *op) {
+                        return op->has_attr(op_attr::keep_stats)
+                                && !op->get_attr<bool>(op_attr::keep_stats);
+                    });
+
+                    auto pquantize_graph = std::make_shared<pb_graph_t>();
+                    pm::pb_op_t *pquantize = pquantize_graph->append_op(
+                            graph::op_kind::Quantize);
+                    pquantize->append_decision_function(check_zps_values<0>);
+                    pquantize_graph->create_input_port(0, pquantize, 0);
+                    pquantize_graph->create_output_port(0, pquantize, 0);
+                    pgraph->append_optional(pquantize_graph,
+                            in_edges_t {in_edge(0, layernorm_base, 0)});
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<layernorm_fwd_t>();
+        });
+
 DNNL_BACKEND_REGISTER_PATTERN_DEF_END
 
 } // namespace pattern
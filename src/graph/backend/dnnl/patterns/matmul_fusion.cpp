@@ -14,8 +14,10 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include "graph/backend/dnnl/kernels/gated_mlp.hpp"
 #include "graph/backend/dnnl/kernels/large_partition.hpp"
 #include "graph/backend/dnnl/kernels/matmul.hpp"
+#include "graph/backend/dnnl/kernels/rope_kv_cache.hpp"
 #include "graph/backend/dnnl/patterns/fusions.hpp"
 #include "graph/backend/dnnl/patterns/pattern_matcher_pass.hpp"
 #include "graph/backend/dnnl/patterns/utils.hpp"
@@ -33,6 +35,70 @@ using in_edges_t = pm::in_edges_t;
 using pb_graph_t = pm::pb_graph_t;
 using FCreatePattern = graph::pass::FCreatePattern;
 
+namespace {
+// Appends the optional bias and the chain of unary and binary post-ops of the
+// matmul fed by an embedding bag.
+void append_embedding_bag_matmul_post_ops(
+        const std::shared_ptr<pb_graph_t> &pgraph, pm::pb_op_t *pmatmul) {
+    auto popt_bias = optional_bias_add(pgraph, pmatmul, false);
+
+    auto alt_graph = std::make_shared<pb_graph_t>();
+    auto palt = alt_graph->append_alternation(get_unary_binary_ops());
+    palt->allow_internal_inputs();
+    alt_graph->create_input_port(0, palt, 0);
+    alt_graph->create_output_port(0, palt, 0);
+
+    pgraph->append_repetition(alt_graph, {0, 0}, 0, MAX_REPETITION,
+            in_edges_t {in_edge(0, popt_bias, 0)});
+}
+
+// Checks the gated MLP kernel can view a tensor as a matrix of its rows. The
+// shapes and strides unknown in the graph are checked at compilation.
+bool check_gated_mlp_rows(const logical_tensor_t &lt) {
+    const logical_tensor_wrapper_t ltw(lt);
+    if (ltw.is_opaque()) return false;
+    if (!ltw.is_strided() || ltw.is_shape_unknown() || ltw.is_stride_unknown())
+        return true;
+    dim_t rows = 0, cols = 0, ld = 0;
+    return gated_mlp_t::flatten_rows(lt, rows, cols, ld);
+}
+
+// Checks the matmul of a gated MLP projects the rows of its source by a 2D
+// weight to an output of the same floating point data type.
+bool check_gated_mlp_matmul(op_t *op) {
+    if (op->num_inputs() != 2) return false;
+    if (op->has_attr(op_attr::transpose_a)
+            && op->get_attr<bool>(op_attr::transpose_a))
+        return false;
+    const logical_tensor_t &src = op->get_input_value(0)->get_logical_tensor();
+    const logical_tensor_t &wei = op->get_input_value(1)->get_logical_tensor();
+    const logical_tensor_t &dst
+            = op->get_output_value(0)->get_logical_tensor();
+    if (wei.ndims != DNNL_GRAPH_UNKNOWN_NDIMS && wei.ndims != 2) return false;
+    if (!check_gated_mlp_rows(src) || !check_gated_mlp_rows(dst)) return false;
+    return src.data_type == wei.data_type && dst.data_type == src.data_type
+            && impl::utils::one_of(src.data_type, graph::data_type::f32,
+                    graph::data_type::bf16, graph::data_type::f16);
+}
+
+// Checks the Sigmoid and the Multiply ops of the gating keep the data type and
+// the shape, so that the gate and up projections have the same shape as h.
+bool check_gated_mlp_gating(op_t *op) {
+    const auto dst_lt = op->get_output_value(0)->get_logical_tensor();
+    if (!check_gated_mlp_rows(dst_lt)) return false;
+    const logical_tensor_wrapper_t dst_ltw(dst_lt);
+    for (size_t i = 0; i < op->num_inputs(); ++i) {
+        const auto src_lt = op->get_input_value(i)->get_logical_tensor();
+        const logical_tensor_wrapper_t src_ltw(src_lt);
+        if (src_ltw.data_type() != dst_ltw.data_type()) return false;
+        if (src_ltw.is_shape_unknown() || dst_ltw.is_shape_unknown())
+            continue;
+        if (src_ltw.vdims() != dst_ltw.vdims()) return false;
+    }
+    return true;
+}
+} // namespace
+
 DNNL_BACKEND_REGISTER_PATTERN_DEF_BEGIN(matmul_fusion)
 
 DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, matmul_post_ops_chain_fusion)
@@ -176,6 +242,167 @@ DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(
             return std::make_shared<float_matmul>();
         });
 
+/*
+Projections of an autoregressive decoder layer: the matmul output optionally
+goes through the rotary position embedding and is appended to the KV cache
+along the sequence axis, i.e. it is the last input of a two-input Concat whose
+first input is the past cache.
+
+    MatMul -> [BiasAdd] -> [RotaryEmbedding] -> [Concat(past, *)]
+
+At least one of RotaryEmbedding and Concat is required.
+*/
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, matmul_rope_kv_cache_fusion)
+        .set_priority(10.6f)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::matmul_post_ops)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *pmatmul
+                            = pgraph->append_op(graph::op_kind::MatMul);
+                    auto popt_bias = optional_bias_add(pgraph, pmatmul, false);
+                    pm::pb_op_t *prope
+                            = pgraph->append_op(graph::op_kind::RotaryEmbedding,
+                                    in_edges_t {in_edge(0, popt_bias, 0)});
+
+                    // Optional KV cache append
+                    auto popt_concat_graph = std::make_shared<pb_graph_t>();
+                    pm::pb_op_t *pconcat = popt_concat_graph->append_op(
+                            graph::op_kind::Concat);
+                    pconcat->append_decision_function(check_input_num<2>);
+                    popt_concat_graph->create_input_port(0, pconcat, 1);
+                    popt_concat_graph->create_output_port(0, pconcat, 0);
+                    pgraph->append_optional(popt_concat_graph,
+                            in_edges_t {in_edge(0, prope, 0)});
+                })
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *pmatmul
+                            = pgraph->append_op(graph::op_kind::MatMul);
+                    auto popt_bias = optional_bias_add(pgraph, pmatmul, false);
+                    pm::pb_op_t *pconcat
+                            = pgraph->append_op(graph::op_kind::Concat,
+                                    in_edges_t {in_edge(1, popt_bias, 0)});
+                    pconcat->append_decision_function(check_input_num<2>);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<rope_kv_cache_t>();
+        });
+
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, rope_kv_cache_fusion)
+        .set_priority(8.1f)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::misc_post_ops)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *prope = pgraph->append_op(
+                            graph::op_kind::RotaryEmbedding);
+                    pm::pb_op_t *pconcat
+                            = pgraph->append_op(graph::op_kind::Concat,
+                                    in_edges_t {in_edge(1, prope, 0)});
+                    pconcat->append_decision_function(check_input_num<2>);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<rope_kv_cache_t>();
+        });
+
+/*
+Gated MLP (SwiGLU) of LLaMA-family models, with the optional down projection:
+
+      [x]  [W1]
+        \  /
+        MatMul                [x]  [W3]
+        |    \                  \  /
+        |   Sigmoid             MatMul
+        \    /                   /
+       Multiply                 /
+             \                /
+                  Multiply   [W2]
+                        \    /
+                        MatMul (optional)
+                          |
+
+The two up-projections are expected to share x, which allows the kernel to
+compute them with one matmul over the concatenated weights.
+*/
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, gated_mlp_fusion)
+        .set_priority(10.4f)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *pgate = pgraph->append_op(
+                            graph::op_kind::MatMul);
+                    pgate->append_decision_function(check_gated_mlp_matmul);
+                    pm::pb_op_t *psigmoid
+                            = pgraph->append_op(graph::op_kind::Sigmoid,
+                                    in_edges_t {in_edge(0, pgate, 0)});
+                    psigmoid->append_decision_function(
+                            check_gated_mlp_gating);
+                    pm::pb_op_t *psilu = pgraph->append_op(
+                            graph::op_kind::Multiply,
+                            in_edges_t {in_edge(0, pgate, 0),
+                                    in_edge(1, psigmoid, 0)});
+                    psilu->append_decision_function(check_gated_mlp_gating);
+
+                    pm::pb_op_t *pup
+                            = pgraph->append_op(graph::op_kind::MatMul);
+                    pup->append_decision_function(check_gated_mlp_matmul);
+                    pm::pb_op_t *pgate_mul = pgraph->append_op(
+                            graph::op_kind::Multiply,
+                            in_edges_t {in_edge(0, psilu, 0),
+                                    in_edge(1, pup, 0)});
+                    pgate_mul->append_decision_function(
+                            check_gated_mlp_gating);
+
+                    // Optional down projection
+                    auto popt_graph = std::make_shared<pb_graph_t>();
+                    pm::pb_op_t *pdown
+                            = popt_graph->append_op(graph::op_kind::MatMul);
+                    pdown->append_decision_function(check_gated_mlp_matmul);
+                    popt_graph->create_input_port(0, pdown, 0);
+                    popt_graph->create_output_port(0, pdown, 0);
+                    pgraph->append_optional(
+                            popt_graph, in_edges_t {in_edge(0, pgate_mul, 0)});
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<gated_mlp_t>();
+        });
+
+/*
+Sparse features of recommendation models: the pooled embeddings feed either
+input of the feature interaction matmul, so the pooling and the matmul are
+compiled into one partition and the pooled embeddings stay in the
+partition's internal memory.
+
+    EmbeddingBag -> MatMul -> [BiasAdd] -> [Unary | Binary]*
+*/
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, embedding_bag_matmul_fusion)
+        .set_priority(10.6f)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::matmul_post_ops)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *pbag
+                            = pgraph->append_op(graph::op_kind::EmbeddingBag);
+                    pm::pb_op_t *pmatmul
+                            = pgraph->append_op(graph::op_kind::MatMul,
+                                    in_edges_t {in_edge(0, pbag, 0)});
+                    append_embedding_bag_matmul_post_ops(pgraph, pmatmul);
+                })
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *pbag
+                            = pgraph->append_op(graph::op_kind::EmbeddingBag);
+                    pm::pb_op_t *pmatmul
+                            = pgraph->append_op(graph::op_kind::MatMul,
+                                    in_edges_t {in_edge(1, pbag, 0)});
+                    append_embedding_bag_matmul_post_ops(pgraph, pmatmul);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
 /*
 MatMul: Currently DNNL Backend doesn't support Reorder with zero points
 (used in weight u8->s8) on GPU, while CPU supports.
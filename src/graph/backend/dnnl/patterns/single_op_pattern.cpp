@@ -230,6 +230,45 @@ DNNL_BACKEND_SINGLE_OP_TRANSFORM(
         dync_dequant_pass, DynamicDequantize, quantize_dequantize_t)
 DNNL_BACKEND_SINGLE_OP_TRANSFORM(reorder_pass, Reorder, float_reorder)
 
+// the rotary embedding is computed on the host.
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, rotary_embedding_pass)
+        .set_priority(DEFAULT_P)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::misc_post_ops)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pgraph->append_op(graph::op_kind::RotaryEmbedding);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<rope_kv_cache_t>();
+        });
+
+// the top-k primitive is implemented on CPU only.
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, topk_pass)
+        .set_priority(DEFAULT_P)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::misc_post_ops)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pgraph->append_op(graph::op_kind::TopK);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
+// the embedding bag primitive is implemented on CPU only.
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, embedding_bag_pass)
+        .set_priority(DEFAULT_P)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::misc_post_ops)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pgraph->append_op(graph::op_kind::EmbeddingBag);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<larger_partition_kernel_t>();
+        });
+
 // if op is interpolate, need to filter out attrs not supported by dnnl
 #define INTERPOLATE_ATTR_CHECK() \
     append_decision_function([](op_t *graph_op) -> bool { \
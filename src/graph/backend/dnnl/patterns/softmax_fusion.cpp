@@ -80,6 +80,19 @@ void make_softmax_post_ops_pattern(const std::shared_ptr<pb_graph_t> &pgraph) {
     pgraph->append_optional(alt_tc_q, in_edges_t {in_edge(0, prep, 0)});
 }
 
+// Dequantize with per-tensor scales and zero zps is folded into the int8
+// softmax primitive as src scales.
+void make_int8_softmax_pattern(const std::shared_ptr<pb_graph_t> &pgraph) {
+    pm::pb_op_t *pdequant = pgraph->append_op(graph::op_kind::Dequantize);
+    pdequant->append_decision_function(check_qtype_equal_to_per_tensor);
+    pdequant->append_decision_function(check_zps_values<0>);
+    pm::pb_op_t *softmax_base = pgraph->append_op(
+            graph::op_kind::SoftMax, in_edges_t {in_edge(0, pdequant, 0)});
+
+    auto alt_tc_q = make_typecast_quantize_alt();
+    pgraph->append_optional(alt_tc_q, in_edges_t {in_edge(0, softmax_base, 0)});
+}
+
 void make_softmax_tc_q_pattern(const std::shared_ptr<pb_graph_t> &pgraph) {
     pm::pb_op_t *softmax_base = pgraph->append_op(graph::op_kind::SoftMax);
 
@@ -101,6 +114,15 @@ DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, softmax_post_ops_fusion_cpu)
             return std::make_shared<softmax_fwd_t>();
         });
 
+DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, int8_softmax_fusion_cpu)
+        .set_priority(8.3f)
+        .set_engine_kind(engine_kind::cpu)
+        .set_kind(partition_kind_t::misc_quantized_post_ops)
+        .set_attr<FCreatePattern>("FCreatePattern", make_int8_softmax_pattern)
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<softmax_fwd_t>();
+        });
+
 DNNL_BACKEND_REGISTER_PATTERN_MATCHER_PASS(dnnl, softmax_tc_q_fusion)
         .set_priority(8.2f)
         .set_kind(partition_kind_t::misc_post_ops)
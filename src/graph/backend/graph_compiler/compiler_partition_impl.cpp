@@ -14,8 +14,13 @@
  * limitations under the License.
  *******************************************************************************/
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -23,7 +28,9 @@
 #include "compiler/config/context.hpp"
 #include "compiler/ir/graph/driver.hpp"
 #include "compiler/ir/graph/dynamic_utils.hpp"
+#include "compiler/ir/graph/pass/graph_constant_cache.hpp"
 #include "compiler/ir/graph/pass/pass.hpp"
+#include "compiler/jit/module_cache.hpp"
 #include "compiler_partition_impl.hpp"
 
 #include "common/rw_mutex.hpp"
@@ -119,11 +126,14 @@ graph::status_t compiler_partition_impl_t::infer_shape(
     return ret;
 }
 
-graph::status_t compiler_partition_impl_t::compile(
-        graph::compiled_partition_t *compiled_partition,
+graph::status_t compiler_partition_impl_t::compile_jit_func(
         const std::vector<graph::logical_tensor_t> &inputs,
         const std::vector<graph::logical_tensor_t> &outputs,
-        const graph::engine_t *aengine) const {
+        const graph::engine_t *aengine,
+        std::shared_ptr<gc::jit_function_t> &fptr,
+        std::shared_ptr<compiler_graph_engine_t> &graph_engine,
+        std::vector<gc::runtime::dynamic_tensor_t> &dyn_inputs,
+        std::vector<gc::runtime::dynamic_tensor_t> &dyn_outputs) const {
     try {
         graph::status_t res = status::success;
         // here we call infer_shape since logical tensor info
@@ -143,7 +153,6 @@ graph::status_t compiler_partition_impl_t::compile(
         if (res != status::success) { return res; }
 
         std::lock_guard<std::mutex> lck(mtx_);
-        std::vector<gc::runtime::dynamic_tensor_t> dyn_inputs, dyn_outputs;
         std::unordered_map<size_t, gc::sc_op_ptr> inputs_map, outputs_map;
         std::vector<gc::sc_op_ptr> sc_inputs;
         compiler_graph_impl_t sub_graph;
@@ -207,6 +216,10 @@ graph::status_t compiler_partition_impl_t::compile(
             gc::sc_op_ptr ret;
             ret = sub_graph.make_backend_op(cur_op, producer_lt, consumer_lt);
             if (!ret) { return impl::status::unimplemented; }
+            // record the original op to map the traces back to it
+            ret->attrs_.set(gc::op_attr_key::graph_op_ids,
+                    op_t::kind2str(cur_op->get_kind()) + ":"
+                            + std::to_string(cur_op->get_id()));
             // translate output value
             for (size_t i = 0; i < cur_op->get_output_values().size(); i++) {
                 auto &out_value = cur_op->get_output_values()[i];
@@ -256,7 +269,6 @@ graph::status_t compiler_partition_impl_t::compile(
                 "Graph compiler backend only supports cpu engine");
         gc::context_ptr ctx;
         ctx = gc::get_default_context();
-        std::shared_ptr<compiler_graph_engine_t> graph_engine;
         {
             std::lock_guard<std::mutex> lock(global_mutex);
             auto iter = engine_map.find(aengine);
@@ -277,37 +289,90 @@ graph::status_t compiler_partition_impl_t::compile(
 
         ctx->engine_ = static_cast<gc::runtime::engine_t *>(graph_engine.get());
 
-        gc::graph_driver(backend_graph_obj, 28, 10, ctx);
-
-        std::vector<gc::sc_op_ptr> args;
+        // look up the persistent JIT module cache with the graph before any
+        // graph passes, so that a hit skips the whole compilation
+        std::vector<gc::sc_op_ptr> orig_args;
         for (auto &out_lt : outputs) {
-            for (const auto &op : backend_graph_obj.get_output_ops()) {
-                if (op->attrs_.get<size_t>("unique_id")
-                        == outputs_map[out_lt.id]->attrs_.get<size_t>(
-                                "unique_id")) {
-                    args.push_back(op);
-                    break;
-                }
-            }
+            orig_args.push_back(outputs_map[out_lt.id]);
         }
         for (auto &in_lt : inputs) {
-            for (const auto &op : backend_graph_obj.get_input_ops()) {
-                if (op->attrs_.get<size_t>("unique_id")
-                        == inputs_map[in_lt.id]->attrs_.get<size_t>(
-                                "unique_id")) {
-                    args.push_back(op);
-                    break;
+            orig_args.push_back(inputs_map[in_lt.id]);
+        }
+        std::string cache_key = gc::module_cache::make_cache_key(
+                backend_graph_obj, orig_args, ctx);
+        auto jit_engine = gc::jit_engine_t::make(ctx);
+        fptr = nullptr;
+        if (!cache_key.empty()) {
+            fptr = jit_engine->load_cached_entry_func(cache_key);
+        }
+
+        if (!fptr) {
+            // the modules of the same partition get the same constant inputs,
+            // so that they may reuse the constants folded by each other
+            if (this->id_ != std::numeric_limits<size_t>::max()) {
+                backend_graph_obj.attrs_[gc::attr_keys::shared_const_scope]
+                        = this->id_;
+            }
+            gc::graph_driver(backend_graph_obj, 28, 10, ctx);
+
+            std::vector<gc::sc_op_ptr> args;
+            for (auto &out_lt : outputs) {
+                for (const auto &op : backend_graph_obj.get_output_ops()) {
+                    if (op->attrs_.get<size_t>("unique_id")
+                            == outputs_map[out_lt.id]->attrs_.get<size_t>(
+                                    "unique_id")) {
+                        args.push_back(op);
+                        break;
+                    }
+                }
+            }
+            for (auto &in_lt : inputs) {
+                for (const auto &op : backend_graph_obj.get_input_ops()) {
+                    if (op->attrs_.get<size_t>("unique_id")
+                            == inputs_map[in_lt.id]->attrs_.get<size_t>(
+                                    "unique_id")) {
+                        args.push_back(op);
+                        break;
+                    }
                 }
             }
+            gc::ir_module_ptr ir_mod
+                    = gc::lower_graph(ctx, backend_graph_obj, args);
+            if (!cache_key.empty()) {
+                ir_mod->attr_[gc::ir_module_t::attr_key_t::JIT_CACHE_KEY]
+                        = cache_key;
+            }
+            fptr = jit_engine->get_entry_func(ir_mod, true);
         }
-        gc::ir_module_ptr ir_mod
-                = gc::lower_graph(ctx, backend_graph_obj, args);
+        return res;
+    } catch (...) { return graph::status::unimplemented; }
+}
 
-        std::shared_ptr<gc::jit_function_t> fptr
-                = gc::jit_engine_t::make(ctx)->get_entry_func(ir_mod, true);
+graph::status_t compiler_partition_impl_t::compile(
+        graph::compiled_partition_t *compiled_partition,
+        const std::vector<graph::logical_tensor_t> &inputs,
+        const std::vector<graph::logical_tensor_t> &outputs,
+        const graph::engine_t *aengine) const {
+    std::shared_ptr<gc::jit_function_t> fptr;
+    std::shared_ptr<compiler_graph_engine_t> graph_engine;
+    std::vector<gc::runtime::dynamic_tensor_t> dyn_inputs, dyn_outputs;
+    graph::status_t res = compile_jit_func(inputs, outputs, aengine, fptr,
+            graph_engine, dyn_inputs, dyn_outputs);
+    if (res != status::success) { return res; }
+    try {
+        std::shared_ptr<shape_specializer_t> specializer;
+        auto limit = gc::utils::compiler_configs_t::get()
+                             .dynamic_specialize_limit_;
+        if (!dyn_inputs.empty() && limit > 0) {
+            specializer = std::make_shared<shape_specializer_t>(
+                    std::static_pointer_cast<const compiler_partition_impl_t>(
+                            clone()),
+                    aengine, static_cast<size_t>(limit));
+        }
         auto pimpl = std::make_shared<compiler_compiled_partition_impl_t>(
                 *aengine, inputs, outputs, fptr, graph_engine,
-                std::move(dyn_inputs), std::move(dyn_outputs));
+                std::move(dyn_inputs), std::move(dyn_outputs),
+                std::move(specializer));
         compiled_partition->init(pimpl);
         return res;
     } catch (...) { return graph::status::unimplemented; }
@@ -329,6 +394,163 @@ bool compiler_partition_impl_t::is_initialized() const {
     return is_init_;
 }
 
+namespace {
+// runs the jobs submitted from all partitions in a single background thread,
+// in the order of submission
+class background_compiler_t {
+public:
+    static background_compiler_t &get() {
+        static background_compiler_t instance;
+        return instance;
+    }
+
+    void submit(std::function<void()> &&job) {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (stopped_) { return; }
+        jobs_.emplace_back(std::move(job));
+        if (!thread_.joinable()) {
+            thread_ = std::thread(&background_compiler_t::run, this);
+        }
+        cv_.notify_one();
+    }
+
+    ~background_compiler_t() {
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            stopped_ = true;
+            jobs_.clear();
+        }
+        cv_.notify_one();
+        if (thread_.joinable()) { thread_.join(); }
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(lock_);
+                cv_.wait(lock, [this]() { return stopped_ || !jobs_.empty(); });
+                if (stopped_) { return; }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    std::thread thread_;
+    bool stopped_ = false;
+};
+} // namespace
+
+shape_specializer_t::shape_specializer_t(
+        std::shared_ptr<const compiler_partition_impl_t> partition,
+        const graph::engine_t *aengine, size_t limit)
+    : partition_(std::move(partition))
+    , engine_(aengine)
+    , limit_(limit)
+    , kernels_(std::make_shared<kernel_map_t>()) {}
+
+shape_specializer_t::shape_key_t shape_specializer_t::make_key(
+        const std::vector<graph::tensor_t> &inputs,
+        const std::vector<graph::tensor_t> &outputs) {
+    // the static kernel is compiled for the layouts as well as the shapes, so
+    // they are all a part of the key
+    shape_key_t key;
+    auto append_key = [&key](const std::vector<graph::tensor_t> &tensors) {
+        for (auto &tsr : tensors) {
+            auto &lt = tsr.get_logical_tensor();
+            key.emplace_back(lt.ndims);
+            key.insert(key.end(), lt.dims, lt.dims + lt.ndims);
+            key.emplace_back(static_cast<int64_t>(lt.layout_type));
+            if (lt.layout_type == graph::layout_type::strided) {
+                key.insert(key.end(), lt.layout.strides,
+                        lt.layout.strides + lt.ndims);
+            } else if (lt.layout_type == graph::layout_type::opaque) {
+                key.emplace_back(static_cast<int64_t>(lt.layout.layout_id));
+            }
+        }
+    };
+    append_key(inputs);
+    append_key(outputs);
+    return key;
+}
+
+std::shared_ptr<gc::jit_function_t> shape_specializer_t::get(
+        const std::vector<graph::tensor_t> &inputs,
+        const std::vector<graph::tensor_t> &outputs) const {
+    auto kernels = std::atomic_load(&kernels_);
+    auto itr = kernels->find(make_key(inputs, outputs));
+    return itr != kernels->end() ? itr->second : nullptr;
+}
+
+std::shared_ptr<gc::jit_function_t> shape_specializer_t::get_or_request(
+        const std::vector<graph::tensor_t> &inputs,
+        const std::vector<graph::tensor_t> &outputs) {
+    auto key = make_key(inputs, outputs);
+    auto kernels = std::atomic_load(&kernels_);
+    auto itr = kernels->find(key);
+    if (itr != kernels->end()) { return itr->second; }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    if (cancelled_ || requested_.size() >= limit_ || requested_.count(key)) {
+        return nullptr;
+    }
+    requested_.insert(key);
+    std::vector<graph::logical_tensor_t> in_lts, out_lts;
+    for (auto &tsr : inputs) {
+        in_lts.emplace_back(tsr.get_logical_tensor());
+    }
+    for (auto &tsr : outputs) {
+        out_lts.emplace_back(tsr.get_logical_tensor());
+    }
+    std::weak_ptr<shape_specializer_t> weak_this = shared_from_this();
+    background_compiler_t::get().submit([weak_this, key, in_lts, out_lts]() {
+        if (auto ths = weak_this.lock()) { ths->compile(key, in_lts, out_lts); }
+    });
+    return nullptr;
+}
+
+void shape_specializer_t::compile(const shape_key_t &key,
+        const std::vector<graph::logical_tensor_t> &inputs,
+        const std::vector<graph::logical_tensor_t> &outputs) {
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (cancelled_) { return; }
+        running_ = true;
+    }
+    std::shared_ptr<gc::jit_function_t> fptr;
+    std::shared_ptr<compiler_graph_engine_t> graph_engine;
+    std::vector<gc::runtime::dynamic_tensor_t> dyn_inputs, dyn_outputs;
+    if (partition_->compile_jit_func(inputs, outputs, engine_, fptr,
+                graph_engine, dyn_inputs, dyn_outputs)
+                    != status::success
+            || !dyn_inputs.empty()) {
+        // keep the failed shapes in the table, so that they run the dynamic
+        // kernel without being requested again
+        fptr = nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto kernels = std::make_shared<kernel_map_t>(*kernels_);
+        (*kernels)[key] = fptr;
+        std::atomic_store(&kernels_,
+                std::shared_ptr<const kernel_map_t>(std::move(kernels)));
+        running_ = false;
+    }
+    cv_.notify_all();
+}
+
+void shape_specializer_t::cancel() {
+    std::unique_lock<std::mutex> lock(lock_);
+    cancelled_ = true;
+    cv_.wait(lock, [this]() { return !running_; });
+}
+
 compiler_compiled_partition_impl_t::compiler_compiled_partition_impl_t(
         const graph::engine_t &engine,
         const std::vector<graph::logical_tensor_t> &inputs,
@@ -337,18 +559,26 @@ compiler_compiled_partition_impl_t::compiler_compiled_partition_impl_t(
         const std::shared_ptr<graph::compiler_impl::compiler_graph_engine_t>
                 &graph_engine,
         std::vector<gc::runtime::dynamic_tensor_t> &&dyn_inputs,
-        std::vector<gc::runtime::dynamic_tensor_t> &&dyn_outputs)
+        std::vector<gc::runtime::dynamic_tensor_t> &&dyn_outputs,
+        std::shared_ptr<shape_specializer_t> &&specializer)
     : graph::compiled_partition_impl_t(engine, inputs, outputs, {})
     , jit_func_(jit_func)
     , graph_engine_(graph_engine)
     , dyn_inputs_(std::move(dyn_inputs))
-    , dyn_outputs_(std::move(dyn_outputs)) {
+    , dyn_outputs_(std::move(dyn_outputs))
+    , specializer_(std::move(specializer)) {
     std::lock_guard<std::mutex> lock(global_mutex);
     partition_count_map[graph_engine_]++;
     graph_engine_->allocator_->retain();
 }
 
 compiler_compiled_partition_impl_t::~compiler_compiled_partition_impl_t() {
+    // the running compilation uses the engine, so it should be finished
+    // before the engine may be released
+    if (specializer_) {
+        specializer_->cancel();
+        specializer_ = nullptr;
+    }
     std::lock_guard<std::mutex> lock(global_mutex);
     auto itr = partition_count_map.find(graph_engine_);
     if (itr != partition_count_map.end()) {
@@ -368,6 +598,12 @@ compiler_compiled_partition_impl_t::~compiler_compiled_partition_impl_t() {
     graph_engine_->allocator_->release();
 }
 
+bool compiler_compiled_partition_impl_t::is_specialized(
+        const std::vector<graph::tensor_t> &inputs,
+        const std::vector<graph::tensor_t> &outputs) const {
+    return specializer_ && specializer_->get(inputs, outputs) != nullptr;
+}
+
 graph::status_t compiler_compiled_partition_impl_t::execute(
         const graph::stream_t *astream,
         const std::vector<graph::tensor_t> &inputs,
@@ -375,6 +611,19 @@ graph::status_t compiler_compiled_partition_impl_t::execute(
     // set backend runtime stream
     compiler_graph_stream_t backend_stream {graph_engine_.get(), astream};
     std::vector<gc::generic_val> generic_args;
+    if (specializer_) {
+        if (auto static_func = specializer_->get_or_request(inputs, outputs)) {
+            generic_args.reserve(inputs.size() + outputs.size());
+            for (auto out_tensor : outputs) {
+                generic_args.emplace_back(out_tensor.get_data_handle());
+            }
+            for (auto in_tensor : inputs) {
+                generic_args.emplace_back(in_tensor.get_data_handle());
+            }
+            static_func->call_generic(&backend_stream, generic_args.data());
+            return status::success;
+        }
+    }
     if (dyn_inputs_.empty()) {
         generic_args.reserve(inputs.size() + outputs.size());
         for (auto out_tensor : outputs) {
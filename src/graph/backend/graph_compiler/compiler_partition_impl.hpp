@@ -17,8 +17,12 @@
 #define BACKEND_GRAPH_COMPILER_COMPILER_PARTITION_IMPL_HPP
 
 #include <cassert>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "compiler/ir/graph/lowering.hpp"
@@ -27,6 +31,7 @@
 #include "graph/interface/partition.hpp"
 #include "runtime/dynamic_dispatch/dynamic_tensor.hpp"
 #include "runtime/memorypool.hpp"
+#include "util/hash_utils.hpp"
 
 #include "compiler_allocator.hpp"
 #include "compiler_backend.hpp"
@@ -64,6 +69,18 @@ public:
             const std::vector<graph::logical_tensor_t> &outputs,
             const graph::engine_t *aengine) const override;
 
+    // Compiles the partition for the given inputs and outputs into a JIT
+    // function. If the shapes are dynamic, the dynamic tensors of the inputs
+    // and outputs are returned in dyn_inputs and dyn_outputs
+    graph::status_t compile_jit_func(
+            const std::vector<graph::logical_tensor_t> &inputs,
+            const std::vector<graph::logical_tensor_t> &outputs,
+            const graph::engine_t *aengine,
+            std::shared_ptr<gc::jit_function_t> &fptr,
+            std::shared_ptr<compiler_graph_engine_t> &graph_engine,
+            std::vector<gc::runtime::dynamic_tensor_t> &dyn_inputs,
+            std::vector<gc::runtime::dynamic_tensor_t> &dyn_outputs) const;
+
     const graph::backend_t *get_assigned_backend() const override {
         return &compiler_backend_t::get_singleton();
     }
@@ -116,6 +133,59 @@ protected:
     mutable std::mutex mtx_;
     std::string pname_;
 };
+
+/**
+ * Compiles static shape kernels of a dynamic partition for the input shapes
+ * met in execution. A kernel is compiled in a background thread when its
+ * shapes are first met, and the partition runs the dynamic kernel until the
+ * static one is ready. At most `limit` shapes are compiled for a partition.
+ * */
+class shape_specializer_t
+    : public std::enable_shared_from_this<shape_specializer_t> {
+public:
+    shape_specializer_t(
+            std::shared_ptr<const compiler_partition_impl_t> partition,
+            const graph::engine_t *aengine, size_t limit);
+
+    // Gets the static kernel for the shapes of the tensors. If it is not
+    // compiled yet, requests compiling it and returns null
+    std::shared_ptr<gc::jit_function_t> get_or_request(
+            const std::vector<graph::tensor_t> &inputs,
+            const std::vector<graph::tensor_t> &outputs);
+
+    // Gets the static kernel for the shapes of the tensors without requesting
+    // it, null if it is not ready
+    std::shared_ptr<gc::jit_function_t> get(
+            const std::vector<graph::tensor_t> &inputs,
+            const std::vector<graph::tensor_t> &outputs) const;
+
+    // Drops the pending requests and waits for the running compilation
+    void cancel();
+
+private:
+    using shape_key_t = std::vector<int64_t>;
+    using kernel_map_t = std::unordered_map<shape_key_t,
+            std::shared_ptr<gc::jit_function_t>>;
+    static shape_key_t make_key(const std::vector<graph::tensor_t> &inputs,
+            const std::vector<graph::tensor_t> &outputs);
+    void compile(const shape_key_t &key,
+            const std::vector<graph::logical_tensor_t> &inputs,
+            const std::vector<graph::logical_tensor_t> &outputs);
+
+    std::shared_ptr<const compiler_partition_impl_t> partition_;
+    const graph::engine_t *engine_;
+    size_t limit_;
+    // the compiled kernels, null for the shapes failed to compile. It is
+    // replaced as a whole when a kernel is added, so that it can be read
+    // without locking
+    std::shared_ptr<const kernel_map_t> kernels_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::unordered_set<shape_key_t> requested_;
+    bool running_ = false;
+    bool cancelled_ = false;
+};
+
 class compiler_compiled_partition_impl_t : public compiled_partition_impl_t {
 public:
     compiler_compiled_partition_impl_t(const graph::engine_t &engine,
@@ -125,12 +195,18 @@ public:
             const std::shared_ptr<graph::compiler_impl::compiler_graph_engine_t>
                     &graph_engine,
             std::vector<gc::runtime::dynamic_tensor_t> &&dyn_inputs,
-            std::vector<gc::runtime::dynamic_tensor_t> &&dyn_outputs);
+            std::vector<gc::runtime::dynamic_tensor_t> &&dyn_outputs,
+            std::shared_ptr<shape_specializer_t> &&specializer = nullptr);
     virtual ~compiler_compiled_partition_impl_t();
     graph::status_t execute(const graph::stream_t *astream,
             const std::vector<graph::tensor_t> &inputs,
             const std::vector<graph::tensor_t> &outputs) override;
 
+    // Returns whether the static kernel for the shapes of the tensors is
+    // ready, for testing
+    bool is_specialized(const std::vector<graph::tensor_t> &inputs,
+            const std::vector<graph::tensor_t> &outputs) const;
+
 #ifdef DNNL_WITH_SYCL
     status_t execute_sycl(const stream_t *astream,
             const std::vector<tensor_t> &inputs,
@@ -146,6 +222,8 @@ private:
     std::shared_ptr<graph::compiler_impl::compiler_graph_engine_t>
             graph_engine_;
     std::vector<gc::runtime::dynamic_tensor_t> dyn_inputs_, dyn_outputs_;
+    // null if the partition is static or the specialization is disabled
+    std::shared_ptr<shape_specializer_t> specializer_;
 };
 
 } // namespace compiler_impl
@@ -37,6 +37,15 @@ public:
     virtual func_c operator()(func_c f) = 0;
     virtual ~function_pass_t() = default;
     virtual const char *get_name() const { return nullptr; }
+    /**
+     * Returns true if the pass can run on different functions of a module in
+     * different threads at the same time. Such a pass should not keep states
+     * across functions in the pass object and should not change the IR nodes
+     * shared by the functions, e.g. the module variables and their temp data.
+     * It should not depend on the runtime config either, e.g. the number of
+     * threads, which is not the same in the worker threads
+     * */
+    virtual bool is_thread_safe() const { return false; }
 #ifndef NDEBUG
     virtual void get_dependency_info(tir_pass_dependency_t &out) const;
 #endif
@@ -86,6 +86,8 @@ create_default_graph_flow(const context_ptr &ctx) {
             elemwise_dimension_alignment, {}, pass_type::pre_tune, true));
     pre_tune_passes.push_back(create_graph_pass("shape_relationship_binding",
             shape_relationship_binding, {}, pass_type::pre_tune, true));
+    pre_tune_passes.push_back(create_graph_pass("tune_op_configs",
+            tune_op_configs, {}, pass_type::pre_tune, true));
 
     // ------------------ post_tune -------------------------------------------
     post_tune_passes.push_back(create_graph_pass("const_folding",
@@ -212,6 +212,10 @@ constexpr const char *not_redundant = "temp.not_redundant";
 // Fusible op marked inplace_optimized will be directly inplaced and will not
 // call compute_block
 constexpr const char *inplace_optimized = "temp.inplace_optimized";
+// std::string. The comma-separated kinds and IDs of the ops in the user graph
+// which this op is converted from, e.g. "MatMul:3,ReLU:4". Used to map the
+// traces back to the user graph
+constexpr const char *graph_op_ids = "temp.graph_op_ids";
 // binary/ternary elementwise op layout propagation source input index.
 constexpr const char *layout_input_index = "layout_input_index";
 }; // namespace op_attr_key
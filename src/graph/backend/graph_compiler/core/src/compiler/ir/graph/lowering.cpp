@@ -53,6 +53,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <util/scoped_timer.hpp>
+#include <util/string_utils.hpp>
 
 namespace dnnl {
 namespace impl {
@@ -406,6 +407,10 @@ struct general_lower_params_t {
     int &global_tensor_counter;
     bool is_graph_dynamic;
     std::unordered_set<sc_dim> external_dyn_vars;
+    // the folded global tensors found in the shared constant cache
+    std::vector<std::shared_ptr<cached_const_graph_tensor>> shared_consts;
+    // if all of the folded global tensors are in the shared constant cache
+    bool all_consts_shared;
 };
 
 expr get_or_create_tensor(general_lower_params_t &gp, const graph_tensor_ptr &t,
@@ -561,7 +566,12 @@ expr get_or_create_tensor(general_lower_params_t &gp, const graph_tensor_ptr &t,
                                     tsr.checked_as<tensor>()->dims_,
                                     tsr.checked_as<tensor>()->strides_,
                                     linkage::private_global, &def_node));
-                    if (cached) { tsr->attr()["shared_const"] = cached; }
+                    if (cached) {
+                        tsr->attr()["shared_const"] = cached;
+                        gp.shared_consts.emplace_back(cached);
+                    } else {
+                        gp.all_consts_shared = false;
+                    }
                     // global tensor does not need cached dynamic var
                     tsr->attr_->set("temp.dyn_placeholder", expr());
                     if (auto const_node
@@ -919,6 +929,53 @@ void create_op_tensors(general_lower_params_t &gp, std::vector<expr> &ins,
     }
 }
 
+// marks the function with the ops in the user graph which the node is lowered
+// from and the bytes of its tensor arguments, so that the traces of the
+// function can be mapped back to the user graph
+static void mark_graph_op_info(const sc_op_ptr &node, const func_t &func) {
+    std::vector<std::string> ids;
+    auto add_ids = [&ids](const sc_op_ptr &op) {
+        auto op_ids = op->attrs_.get_or_null<std::string>(
+                op_attr_key::graph_op_ids);
+        if (!op_ids) { return; }
+        for (auto &id : utils::string_split(*op_ids, ",")) {
+            if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+                ids.emplace_back(id);
+            }
+        }
+    };
+    add_ids(node);
+    if (auto mixed_op = node->dyn_cast<mixed_fuse_op_t>()) {
+        for (auto &op : mixed_op->sub_graph_.ops_) {
+            add_ids(op);
+        }
+    } else if (auto fused_op = node->dyn_cast<fused_op_t>()) {
+        for (auto &op : fused_op->main_op_.ops_) {
+            add_ids(op);
+        }
+        if (fused_op->mgr_) {
+            for (auto &op : fused_op->mgr_->get_graph().ops_) {
+                add_ids(op);
+            }
+        }
+    }
+    if (!ids.empty()) {
+        std::string graph_ops = ids[0];
+        for (size_t i = 1; i < ids.size(); i++) {
+            graph_ops += "," + ids[i];
+        }
+        func->attr()[function_attrs::graph_op_ids] = graph_ops;
+    }
+    int64_t bytes = 0;
+    for (auto *tsrs : {&node->get_inputs(), &node->get_outputs()}) {
+        for (auto &tsr : *tsrs) {
+            if (tsr->details_.is_dynamic()) { return; }
+            bytes += tsr->details_.get_blocking_byte_size();
+        }
+    }
+    func->attr()[function_attrs::arg_bytes] = bytes;
+}
+
 static void create_dispatch_funcs_by_keys(const context_ptr &ctx,
         ir_module_ptr &ret_mod, const std::string &table_name,
         const sc_op_ptr &node, const op_dispatch_key_base_t *key,
@@ -934,6 +991,7 @@ static void create_dispatch_funcs_by_keys(const context_ptr &ctx,
         func->attr().set(attr_keys::always_trans, true);
         func->name_ += "_" + std::to_string(dyn_idx);
         func->decl_->name_ = func->name_;
+        mark_graph_op_info(node, func);
         if (!dyn_idx) {
             // mark the first function as prototype.
             op_dispatch_kernel[node->logical_op_id_]->attr().set(
@@ -1134,7 +1192,7 @@ ir_module_ptr lower_graph(context_ptr ctx, sc_graph_t &graph,
             && !graph.attrs_.get_or_else("temp.force_static", false);
     general_lower_params_t gp {ret_mod, ltsr_rtsr, graph, func_body, init_body,
             tensor_counter, global_tensor_counter, is_graph_dynamic,
-            external_dyn_vars};
+            external_dyn_vars, {}, true};
     // the set of dynamic var defined in func body.(dynamic reshape)
     std::unordered_set<expr> dyn_var_set;
     // record the node, index is op id.
@@ -1265,6 +1323,7 @@ ir_module_ptr lower_graph(context_ptr ctx, sc_graph_t &graph,
                     }
                     ret_mod->merge(*mod);
                     auto callee = mod->get_entry_func();
+                    mark_graph_op_info(node, callee);
                     if (graph.is_dynamic()) {
                         // don't use is_graph_dynamic here.
                         callee->attr().set(attr_keys::always_trans, true);
@@ -1336,6 +1395,19 @@ ir_module_ptr lower_graph(context_ptr ctx, sc_graph_t &graph,
         expr is_init_var = ret_mod->make_global_var(datatypes::boolean,
                 "is_init", linkage::private_global,
                 graph.attrs_.get_or_else("folded_input", false));
+        if (!gp.shared_consts.empty()) {
+            // the JIT module records which scope folded the shared tensors.
+            // It may skip folding if all of the tensors are already folded by
+            // other modules of the same scope
+            size_t const_scope = graph.attrs_.get_or_else(
+                    attr_keys::shared_const_scope, size_t(0));
+            if (const_scope && gp.all_consts_shared) {
+                is_init_var->attr()[attr_keys::shared_const_scope]
+                        = const_scope;
+            }
+            is_init_var->attr()[attr_keys::shared_const_guard]
+                    = gp.shared_consts;
+        }
         init_body->seq_.emplace_back(
                 builder::make_assign_unattached(is_init_var, true));
         func_t init_func = builder::make_func(
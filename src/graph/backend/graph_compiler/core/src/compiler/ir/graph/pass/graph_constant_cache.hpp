@@ -17,6 +17,8 @@
 #ifndef GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_IR_GRAPH_PASS_GRAPH_CONSTANT_CACHE_HPP
 #define GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_IR_GRAPH_PASS_GRAPH_CONSTANT_CACHE_HPP
 
+#include <atomic>
+#include <list>
 #include <memory>
 #include <compiler/ir/statics_table.hpp>
 #include <unordered_map>
@@ -61,24 +63,75 @@ struct cached_const_graph_tensor {
     size_t size_;
     graph_weak_ptr_map::iterator graph_iter_;
     tensor_id_map::iterator id_iter_;
-    std::shared_ptr<const_graph_tensor_cache> cache_owner_;
+    // held weakly, because the cache may hold the tensor in its LRU list
+    std::weak_ptr<const_graph_tensor_cache> cache_owner_;
     const std::shared_ptr<bool> deletion_flag_;
     // the base pointer of buf_. buf_ may be cut from a larger buffer buf_base_.
     std::shared_ptr<void> buf_base_;
+    // the attr_keys::shared_const_scope of the graph whose module last folded
+    // the data in buf_, or 0 if no module of a scoped graph did. It is set when
+    // the module finishes its first run, so that the modules compiled later
+    // from the graphs of the same scope can skip folding the tensor
+    std::atomic<size_t> init_scope_;
+    // the position in the LRU list of the cache, if the cache is configured to
+    // keep the tensors no longer used by any module. Protected by the lock of
+    // the cache
+    std::list<std::shared_ptr<cached_const_graph_tensor>>::iterator lru_iter_;
+    bool in_lru_ = false;
     cached_const_graph_tensor(const std::shared_ptr<sc_graph_t> &dep,
             size_t buf_size,
             const std::shared_ptr<const_graph_tensor_cache> &owner)
         : dependency_ {dep}
         , size_ {buf_size}
         , cache_owner_ {owner}
-        , deletion_flag_ {std::make_shared<bool>(false)} {}
+        , deletion_flag_ {std::make_shared<bool>(false)}
+        , init_scope_ {0} {}
     ~cached_const_graph_tensor();
 };
 
+// the statistics of the process-wide cache of the folded constant tensors
+struct const_cache_stats_t {
+    // the number of the alive cached tensors
+    size_t num_tensors_ = 0;
+    // the bytes of the buffers that the cache would release by evicting the
+    // tensors used by no module. A buffer may be shared by several tensors and
+    // is only counted if none of them is used
+    size_t unused_bytes_ = 0;
+    // the number of times an existing tensor is shared by a new module
+    size_t hits_ = 0;
+    // the number of unused tensors freed for exceeding the capacity
+    size_t evictions_ = 0;
+};
+
+SC_INTERNAL_API const_cache_stats_t get_const_cache_stats();
+
+// frees the least recently used tensors which are used by no module, until
+// their total size is within compiler_configs_t::const_cache_capacity_. If
+// cache is null, trims the process-wide cache
+SC_INTERNAL_API void trim_const_cache(
+        const std::shared_ptr<const_graph_tensor_cache> &cache = nullptr);
+
 namespace op_attr_key {
 constexpr const char *const_input_cache = "temp.const_input_cache";
 }
 
+namespace attr_keys {
+// the attr of a graph, a non-zero size_t. The cached tensors are keyed by the
+// ids of the constant inputs and the ops computing them, not by the contents
+// of the inputs. The graphs of the same scope promise to get the same
+// contents for the same input ids, so that their modules may reuse the
+// tensors folded by each other without folding again. It is also set on the
+// "is_init" global var of the lowered graph, if all of its folded constants
+// are in the shared cache
+constexpr const char *shared_const_scope = "shared_const_scope";
+// the attr on the "is_init" global var of a lowered graph with folded
+// constants in the shared cache. The value is the vector of the cached
+// tensors. If the var also has a scope, all of the folded constants are in the
+// cache, and if all of them are folded by the modules of the same scope, the
+// JIT module sets the var and skips folding
+constexpr const char *shared_const_guard = "shared_const_guard";
+} // namespace attr_keys
+
 } // namespace gc
 } // namespace graph
 } // namespace impl
@@ -25,6 +25,7 @@
 #include <compiler/ir/statics_table.hpp>
 #include <ops/fusible/memory_movement.hpp>
 #include <unordered_map>
+#include <util/utils.hpp>
 
 SC_MODULE(graph.pass.const_input_fold);
 
@@ -97,6 +98,13 @@ struct const_graph_tensor_cache {
     tensor_id_map from_tensor_id_;
     graph_weak_ptr_map from_dep_graph_;
     shared_global_data_allocator_t alloca_;
+    // the tensors from the most recently to the least recently used. Only
+    // tracked when compiler_configs_t::const_cache_capacity_ is not 0. The list
+    // holds a reference to each tensor, so that the tensors used by no module
+    // are kept for the modules compiled later until evicted
+    std::list<std::shared_ptr<cached_const_graph_tensor>> lru_;
+    size_t hits_ = 0;
+    size_t evictions_ = 0;
 
     std::shared_ptr<cached_const_graph_tensor> add_tensor(
             const std::shared_ptr<sc_graph_t> &dep_graph, size_t buf_size,
@@ -105,7 +113,13 @@ struct const_graph_tensor_cache {
         auto itr = from_dep_graph_.find(dep_graph);
         if (itr != from_dep_graph_.end()) {
             auto ret = itr->second.v_.lock();
-            if (ret) { return ret; }
+            if (ret) {
+                hits_++;
+                if (ret->in_lru_) {
+                    lru_.splice(lru_.begin(), lru_, ret->lru_iter_);
+                }
+                return ret;
+            }
             // the weakptr expired. mark the key as deleted.
             *itr->second.deletion_flag_ = true;
             from_dep_graph_.erase(itr);
@@ -131,9 +145,94 @@ struct const_graph_tensor_cache {
         auto id_iter = from_tensor_id_.insert(std::make_pair(hash, ret));
         ret->graph_iter_ = graph_iter.first;
         ret->id_iter_ = id_iter.first;
+        if (utils::compiler_configs_t::get().const_cache_capacity_) {
+            lru_.emplace_front(ret);
+            ret->lru_iter_ = lru_.begin();
+            ret->in_lru_ = true;
+        }
+        return ret;
+    }
+
+    // the size of the buffer a tensor takes in the shared global data
+    static size_t padded_size(const cached_const_graph_tensor &v) {
+        return utils::divide_and_ceil(v.size_, 64) * 64;
+    }
+
+    // the tensors referenced only by lru_, which are cut from the same buffer
+    struct unused_buffer_t {
+        std::vector<std::list<
+                std::shared_ptr<cached_const_graph_tensor>>::iterator>
+                tensors_;
+        size_t bytes_ = 0;
+        // if all of the tensors cut from the buffer are unused, so that
+        // evicting them releases the buffer
+        bool releasable() const {
+            auto &base = (*tensors_.front())->buf_base_;
+            return !base || size_t(base.use_count()) == tensors_.size();
+        }
+    };
+
+    // groups the tensors referenced only by lru_ by their buffers, and gives
+    // the buffers from the one holding the least recently used tensor. The
+    // tensors not allocated yet are grouped each on its own. Should be called
+    // with lock_ held
+    std::vector<unused_buffer_t> unused_buffers() {
+        std::vector<unused_buffer_t> ret;
+        std::unordered_map<void *, size_t> buf_idx;
+        for (auto itr = lru_.end(); itr != lru_.begin();) {
+            --itr;
+            if (itr->use_count() != 1) { continue; }
+            auto &v = **itr;
+            void *key = v.buf_base_ ? v.buf_base_.get() : &v;
+            auto idx_itr = buf_idx.insert(std::make_pair(key, ret.size()));
+            if (idx_itr.second) { ret.emplace_back(); }
+            auto &buf = ret[idx_itr.first->second];
+            buf.tensors_.emplace_back(itr);
+            if (v.buf_base_) { buf.bytes_ += padded_size(v); }
+        }
+        return ret;
+    }
+
+    // the total size of the buffers that evicting the tensors referenced only
+    // by lru_ would release. Should be called with lock_ held
+    size_t unused_bytes() {
+        size_t ret = 0;
+        for (auto &buf : unused_buffers()) {
+            if (buf.releasable()) { ret += buf.bytes_; }
+        }
         return ret;
     }
 
+    void trim() {
+        std::vector<std::shared_ptr<cached_const_graph_tensor>> evicted;
+        {
+            std::lock_guard<std::mutex> guard {lock_};
+            if (lru_.empty()) { return; }
+            size_t capacity
+                    = utils::compiler_configs_t::get().const_cache_capacity_;
+            auto buffers = unused_buffers();
+            size_t unused = 0;
+            for (auto &buf : buffers) {
+                if (buf.releasable()) { unused += buf.bytes_; }
+            }
+            // evicting the tensors of a buffer still used by other tensors
+            // would release no memory, so only whole buffers are evicted
+            for (auto &buf : buffers) {
+                if (unused <= capacity) { break; }
+                if (!buf.releasable()) { continue; }
+                unused -= buf.bytes_;
+                for (auto &itr : buf.tensors_) {
+                    (*itr)->in_lru_ = false;
+                    evicted.emplace_back(std::move(*itr));
+                    lru_.erase(itr);
+                    evictions_++;
+                }
+            }
+        }
+        // the evicted tensors are destroyed here out of lock_, because their
+        // destructors will call remove()
+    }
+
     void remove(cached_const_graph_tensor &v) {
         std::lock_guard<std::mutex> guard {lock_};
         /* need to check if the key in the map is already deleted. Consider the
@@ -169,7 +268,25 @@ static std::shared_ptr<const_graph_tensor_cache> get_cache() {
 }
 
 cached_const_graph_tensor::~cached_const_graph_tensor() {
-    cache_owner_->remove(*this);
+    // the cache may be already destroyed at exit
+    if (auto owner = cache_owner_.lock()) { owner->remove(*this); }
+}
+
+const_cache_stats_t get_const_cache_stats() {
+    auto cache = get_cache();
+    std::lock_guard<std::mutex> guard {cache->lock_};
+    const_cache_stats_t ret;
+    for (auto &kv : cache->from_tensor_id_) {
+        if (!kv.second.expired()) { ret.num_tensors_++; }
+    }
+    ret.unused_bytes_ = cache->unused_bytes();
+    ret.hits_ = cache->hits_;
+    ret.evictions_ = cache->evictions_;
+    return ret;
+}
+
+void trim_const_cache(const std::shared_ptr<const_graph_tensor_cache> &cache) {
+    (cache ? cache : get_cache())->trim();
 }
 
 static std::atomic<size_t> internal_tensor_id = {0xfffff000};
@@ -382,6 +499,7 @@ SC_INTERNAL_API void graph_constant_input_folding(
             op->attrs_[op_attr_key::const_input_cache] = std::move(results);
         }
         get_cache()->alloca_.alloc(caches, existing_data_vec, ctx->engine_);
+        get_cache()->trim();
     }
 }
 } // namespace gc
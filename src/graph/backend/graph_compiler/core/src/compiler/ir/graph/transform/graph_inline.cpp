@@ -100,6 +100,13 @@ static void do_inline_graph(
             if (op->isa<op_traits::configurable_t>() && need_tuning) {
                 (*tunable_op_map)[corresponding_node].push_back(op);
             }
+            // the decomposed ops come from the same ops in the user graph
+            if (cur_node->attrs_.has_key(op_attr_key::graph_op_ids)
+                    && !op->attrs_.has_key(op_attr_key::graph_op_ids)) {
+                op->attrs_.set(op_attr_key::graph_op_ids,
+                        cur_node->attrs_.get<std::string>(
+                                op_attr_key::graph_op_ids));
+            }
             op->set_owner_graph(&full_graph);
             full_graph.ops_.emplace_back(op);
             op->set_owner_graph(&full_graph);
@@ -79,6 +79,14 @@ SC_INTERNAL_API void global_reschedule(
 SC_INTERNAL_API void inplace_transform(
         sc_graph_t &graph, const context_ptr &ctx = get_default_context());
 
+/**
+ * Sets the configs of the tunable ops from the persistent tuning database,
+ * and measures the candidate configs of the ops missing in the database when
+ * tuning is enabled. See tuning_db_t
+ * */
+SC_INTERNAL_API void tune_op_configs(
+        sc_graph_t &graph, const context_ptr &ctx = get_default_context());
+
 SC_INTERNAL_API void div_bcast_transform(
         sc_graph_t &graph, const context_ptr &ctx = get_default_context());
 
@@ -0,0 +1,302 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../driver.hpp"
+#include "../lowering.hpp"
+#include "../pass/pass.hpp"
+#include "../tunable_op.hpp"
+#include "../tuning_db.hpp"
+#include "transform.hpp"
+#include <compiler/ir/statics_table.hpp>
+#include <compiler/jit/jit.hpp>
+#include <runtime/generic_val.hpp>
+#include <util/bf16.hpp>
+#include <util/utils.hpp>
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace gc {
+
+SC_MODULE(graph.tune_op_configs)
+
+// the number of timed runs of a config. The shortest one is taken
+static constexpr int num_timed_runs = 5;
+
+// fills a buffer with small values, which are exact in all the data types
+static void fill_buffer(aligned_buffer_t &buf, sc_data_type_t dtype) {
+    auto value_of = [](size_t i) { return static_cast<int>(i * 7 % 11) - 5; };
+    if (dtype == datatypes::f32) {
+        auto p = reinterpret_cast<float *>(buf.data_);
+        for (size_t i = 0; i < buf.size_ / sizeof(float); i++) {
+            p[i] = value_of(i) / 8.f;
+        }
+    } else if (dtype == datatypes::bf16) {
+        auto p = reinterpret_cast<bf16_t *>(buf.data_);
+        for (size_t i = 0; i < buf.size_ / sizeof(bf16_t); i++) {
+            p[i] = bf16_t(value_of(i) / 8.f);
+        }
+    } else if (dtype == datatypes::s32) {
+        auto p = reinterpret_cast<int32_t *>(buf.data_);
+        for (size_t i = 0; i < buf.size_ / sizeof(int32_t); i++) {
+            p[i] = value_of(i);
+        }
+    } else if (dtype == datatypes::s8) {
+        auto p = reinterpret_cast<int8_t *>(buf.data_);
+        for (size_t i = 0; i < buf.size_; i++) {
+            p[i] = static_cast<int8_t>(value_of(i));
+        }
+    } else if (dtype == datatypes::u8) {
+        auto p = reinterpret_cast<uint8_t *>(buf.data_);
+        for (size_t i = 0; i < buf.size_; i++) {
+            p[i] = static_cast<uint8_t>(value_of(i) + 5);
+        }
+    } else {
+        memset(buf.data_, 0, buf.size_);
+    }
+}
+
+// checks if the results of a config are close to the reference results. The
+// configs may accumulate in different orders, so floating point results are
+// compared with a tolerance
+static bool is_result_close(const aligned_buffer_t &buf,
+        const aligned_buffer_t &ref, sc_data_type_t dtype) {
+    if (buf.size_ != ref.size_) { return false; }
+    auto check = [](float v, float r, float rtol) {
+        return std::abs(v - r) <= rtol * (1.f + std::abs(r));
+    };
+    if (dtype == datatypes::f32) {
+        auto p = reinterpret_cast<const float *>(buf.data_);
+        auto q = reinterpret_cast<const float *>(ref.data_);
+        for (size_t i = 0; i < buf.size_ / sizeof(float); i++) {
+            if (!check(p[i], q[i], 1e-3f)) { return false; }
+        }
+        return true;
+    } else if (dtype == datatypes::bf16) {
+        auto p = reinterpret_cast<const bf16_t *>(buf.data_);
+        auto q = reinterpret_cast<const bf16_t *>(ref.data_);
+        for (size_t i = 0; i < buf.size_ / sizeof(bf16_t); i++) {
+            if (!check(p[i], q[i], 2e-2f)) { return false; }
+        }
+        return true;
+    }
+    return memcmp(buf.data_, ref.data_, buf.size_) == 0;
+}
+
+namespace {
+/**
+ * Measures a tunable op with different configs. Each config is compiled in a
+ * graph holding a copy of the op only, with plain inputs and outputs. The
+ * constant inputs of the op are kept constant in the graph, so that their
+ * preprocessing is done in the first run and is not timed. The results of
+ * each config are checked against the results of the first measured config.
+ * */
+struct op_timer_t {
+    sc_op_ptr op_;
+    context_ptr ctx_;
+    std::vector<aligned_buffer_t> inputs_;
+    std::vector<aligned_buffer_t> ref_outputs_;
+    std::vector<sc_data_type_t> out_dtypes_;
+
+    op_timer_t(const sc_op_ptr &op, const context_ptr &ctx)
+        : op_(op), ctx_(ctx) {}
+
+    // returns the time of a run in microseconds, or a negative value if the
+    // config fails to compile or gives different results
+    double measure(const config_ptr &cfg) {
+        try {
+            return do_measure(cfg);
+        } catch (const std::exception &e) {
+            SC_MODULE_INFO << "Skip a config of " << op_->op_name_ << ": "
+                           << e.what();
+            return -1;
+        }
+    }
+
+private:
+    double do_measure(const config_ptr &cfg) {
+        sc_graph_t graph;
+        for (auto &kv : op_->get_owner_graph().attrs_.as_map()) {
+            if (!utils::string_startswith(kv.first, "temp.")) {
+                graph.attrs_[kv.first] = kv.second;
+            }
+        }
+        graph.attrs_[sc_graph_t::attr_key_t::is_input_plain] = true;
+        graph.attrs_[sc_graph_t::attr_key_t::is_output_plain] = true;
+        std::vector<sc_op_ptr> in_ops;
+        std::vector<graph_tensor_ptr> ins, outs;
+        for (auto &in : op_->get_inputs()) {
+            any_map_t attrs;
+            if (in->producer_owner_->attrs_.get_or_else(
+                        "constant", const_kind::not_const)
+                    != const_kind::not_const) {
+                attrs.set("constant", const_kind::local_const);
+            }
+            in_ops.emplace_back(graph.make_input(
+                    {std::make_shared<graph_tensor>(nullptr, in->details_)},
+                    attrs));
+            ins.emplace_back(in_ops.back()->get_outputs()[0]);
+        }
+        for (auto &out : op_->get_outputs()) {
+            outs.emplace_back(
+                    std::make_shared<graph_tensor>(nullptr, out->details_));
+        }
+        auto new_op = op_->dyn_cast<op_traits::copyable_t>()->copy(
+                ins, outs, graph);
+        new_op->stc_cast<tunable_op_t>()->set_config(cfg);
+        auto out_op = graph.make_output(new_op->get_outputs());
+        graph_driver(graph, ctx_);
+
+        std::vector<sc_op_ptr> args {out_op};
+        args.insert(args.end(), in_ops.begin(), in_ops.end());
+        auto mod = lower_graph(ctx_, graph, args);
+        auto fptr = jit_engine_t::make(ctx_)->get_entry_func(mod, true);
+
+        bool is_ref = inputs_.empty();
+        if (is_ref) {
+            for (auto &in_op : in_ops) {
+                auto &details = in_op->get_outputs()[0]->details_;
+                inputs_.emplace_back(
+                        details.get_blocking_byte_size(), ctx_->engine_);
+                fill_buffer(inputs_.back(), details.dtype_);
+            }
+        } else {
+            for (size_t i = 0; i < in_ops.size(); i++) {
+                auto &details = in_ops[i]->get_outputs()[0]->details_;
+                if (details.get_blocking_byte_size() != inputs_[i].size_) {
+                    return -1;
+                }
+            }
+        }
+        std::vector<aligned_buffer_t> outputs;
+        std::vector<generic_val> generic_args;
+        for (auto &out : out_op->get_inputs()) {
+            outputs.emplace_back(
+                    out->details_.get_blocking_byte_size(), ctx_->engine_);
+            if (is_ref) { out_dtypes_.emplace_back(out->details_.dtype_); }
+            generic_args.emplace_back(outputs.back().data_);
+        }
+        for (auto &in : inputs_) {
+            generic_args.emplace_back(in.data_);
+        }
+
+        // the first run also folds the constant inputs
+        fptr->call_generic_default(generic_args.data());
+        if (is_ref) {
+            ref_outputs_ = std::move(outputs);
+        } else {
+            if (outputs.size() != ref_outputs_.size()) { return -1; }
+            for (size_t i = 0; i < outputs.size(); i++) {
+                if (!is_result_close(
+                            outputs[i], ref_outputs_[i], out_dtypes_[i])) {
+                    SC_MODULE_INFO << "Skip a config of " << op_->op_name_
+                                   << ": results mismatch";
+                    return -1;
+                }
+            }
+        }
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < num_timed_runs; i++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            fptr->call_generic_default(generic_args.data());
+            auto end = std::chrono::high_resolution_clock::now();
+            best = std::min(best,
+                    std::chrono::duration<double, std::micro>(end - start)
+                            .count());
+        }
+        return best;
+    }
+};
+} // namespace
+
+// measures the default config and at most trials - 1 candidates evenly
+// sampled from the tuning candidates of the op. Returns the fastest config,
+// or null if the default config cannot be measured
+static config_ptr tune_op(const sc_op_ptr &op, const config_ptr &default_cfg,
+        int trials, const context_ptr &ctx) {
+    auto tun = op->stc_cast<tunable_op_t>();
+    auto gen = tun->create_generator();
+    std::vector<config_ptr> candidates;
+    for (auto &cfg : tun->get_tuning_candidates(ctx)) {
+        if (gen->is_valid_config(ctx, cfg.data_.get())) {
+            candidates.emplace_back(cfg);
+        }
+    }
+    size_t num_samples = std::min(
+            candidates.size(), static_cast<size_t>(std::max(trials - 1, 0)));
+
+    op_timer_t timer(op, ctx);
+    double best_time = timer.measure(default_cfg);
+    if (best_time < 0) { return config_ptr(); }
+    config_ptr best_cfg = default_cfg;
+    SC_MODULE_INFO << "Tuning " << op->op_name_ << " with " << num_samples
+                   << " of " << candidates.size()
+                   << " candidates, default config: " << best_time << " us";
+    for (size_t i = 0; i < num_samples; i++) {
+        auto &cfg = candidates[i * candidates.size() / num_samples];
+        double t = timer.measure(cfg);
+        if (t >= 0 && t < best_time) {
+            best_time = t;
+            best_cfg = cfg;
+        }
+    }
+    SC_MODULE_INFO << "Tuned " << op->op_name_ << ": " << best_time
+                   << " us, config: " << serialize_tuning_config(best_cfg);
+    return best_cfg;
+}
+
+void tune_op_configs(sc_graph_t &graph, const context_ptr &ctx) {
+    auto db = tuning_db_t::get();
+    if (!db || graph.is_dynamic()) { return; }
+    int trials = utils::compiler_configs_t::get().tuning_trials_;
+    // the ops will not be changed in the loop, tuning only compiles other
+    // graphs
+    for (size_t i = 0; i < graph.ops_.size(); i++) {
+        auto op = graph.ops_[i];
+        auto tun = op->dyn_cast<tunable_op_t>();
+        // keep the configs set by users
+        if (!tun || op->is_removed_ || op->is_dynamic()
+                || tun->get_config().data_) {
+            continue;
+        }
+        auto key = make_tuning_key(*op, ctx);
+        auto default_cfg = tun->get_default_config(ctx);
+        config_ptr cfg;
+        if (db->lookup(key, default_cfg, cfg)
+                && tun->create_generator()->is_valid_config(
+                        ctx, cfg.data_.get())) {
+            tun->set_config(cfg);
+            continue;
+        }
+        if (trials <= 0) { continue; }
+        cfg = tune_op(op, default_cfg, trials, ctx);
+        if (!cfg.data_) { continue; }
+        tun->set_config(cfg);
+        db->store(key, cfg);
+    }
+}
+
+} // namespace gc
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
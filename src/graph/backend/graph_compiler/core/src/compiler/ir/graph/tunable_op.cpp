@@ -226,6 +226,10 @@ config_ptr_vec tunable_op_t::get_dynamic_config_candidates(
     return dyn_config_candidates_;
 }
 
+config_ptr_vec tunable_op_t::get_tuning_candidates(const context_ptr &ctx) {
+    return create_generator()->get_tuning_candidates(ctx);
+}
+
 impl_kind_map tunable_op_t::convert_config_candidates_to_impl_map(
         const config_ptr_vec &configs) {
     if (configs.empty()) { return impl_kind_map(); }
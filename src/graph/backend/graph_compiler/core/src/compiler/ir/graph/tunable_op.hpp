@@ -80,6 +80,9 @@ public:
             const context_ptr &ctx) override;
     impl_kind_map convert_config_candidates_to_impl_map(
             const config_ptr_vec &configs) override;
+    // Gets the configs to measure in tuning, see
+    // body_generator_base_t::get_tuning_candidates
+    config_ptr_vec get_tuning_candidates(const context_ptr &ctx);
 
     virtual body_generator_ptr create_generator() = 0;
 
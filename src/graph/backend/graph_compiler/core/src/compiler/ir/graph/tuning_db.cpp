@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "tuning_db.hpp"
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "pass/pass.hpp"
+#include <runtime/config.hpp>
+#include <util/reflection.hpp>
+#include <util/string_utils.hpp>
+#include <util/utils.hpp>
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace gc {
+
+SC_MODULE(graph.tuning_db)
+
+tuning_db_t::tuning_db_t(const std::string &path) : path_(path) {
+    std::ifstream ifs(path_);
+    std::string line;
+    while (std::getline(ifs, line)) {
+        auto pos = line.find('\t');
+        if (pos == std::string::npos || pos == 0) { continue; }
+        entries_[line.substr(0, pos)] = line.substr(pos + 1);
+    }
+    SC_MODULE_INFO << "Loaded " << entries_.size() << " entries from "
+                   << path_;
+}
+
+std::shared_ptr<tuning_db_t> tuning_db_t::get() {
+    static std::mutex global_lock;
+    static std::shared_ptr<tuning_db_t> db;
+    const auto &path = utils::compiler_configs_t::get().tuning_db_path_;
+    std::lock_guard<std::mutex> guard(global_lock);
+    if (path.empty()) { return nullptr; }
+    // reload if the path is changed
+    if (!db || db->get_path() != path) {
+        db = std::make_shared<tuning_db_t>(path);
+    }
+    return db;
+}
+
+std::string serialize_tuning_config(const config_ptr &cfg) {
+    if (!cfg.vtable_) { return std::string(); }
+    std::stringstream ss;
+    ss << cfg.vtable_->name_ << ':';
+    bool first = true;
+    for (auto &field : cfg.vtable_->fields_) {
+        if (field->type_.base_ != reflection::basic_type::t_int32_t
+                || field->type_.array_depth_ != 0) {
+            return std::string();
+        }
+        int32_t v;
+        field->read(cfg.data_.get(), &v);
+        if (!first) { ss << ','; }
+        ss << field->name_ << '=' << v;
+        first = false;
+    }
+    return ss.str();
+}
+
+bool tuning_db_t::lookup(const std::string &key, const config_ptr &default_cfg,
+        config_ptr &out) const {
+    std::string value;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto itr = entries_.find(key);
+        if (itr == entries_.end()) { return false; }
+        value = itr->second;
+    }
+    auto &meta = default_cfg.vtable_;
+    if (!meta) { return false; }
+    auto pos = value.find(':');
+    if (pos == std::string::npos || value.substr(0, pos) != meta->name_) {
+        return false;
+    }
+    auto obj = meta->make_instance();
+    // start from the default config and override the stored fields
+    for (auto &field : meta->fields_) {
+        if (field->type_.base_ != reflection::basic_type::t_int32_t
+                || field->type_.array_depth_ != 0) {
+            return false;
+        }
+        int32_t v;
+        field->read(default_cfg.data_.get(), &v);
+        field->write(obj.get(), &v);
+    }
+    for (auto &kv : utils::string_split(value.substr(pos + 1), ",")) {
+        auto eq = kv.find('=');
+        if (eq == std::string::npos) { return false; }
+        auto itr = meta->field_map_.find(kv.substr(0, eq));
+        if (itr == meta->field_map_.end()) { return false; }
+        int32_t v;
+        try {
+            v = std::stoi(kv.substr(eq + 1));
+        } catch (const std::exception &) { return false; }
+        itr->second->write(obj.get(), &v);
+    }
+    out = std::move(obj);
+    return true;
+}
+
+void tuning_db_t::store(const std::string &key, const config_ptr &cfg) {
+    auto value = serialize_tuning_config(cfg);
+    if (value.empty()) { return; }
+    std::lock_guard<std::mutex> guard(lock_);
+    entries_[key] = value;
+    // appending a single line keeps the entries written by other processes
+    std::ofstream ofs(path_, std::ios::app);
+    if (!ofs) {
+        SC_MODULE_WARN << "Cannot write to the tuning database " << path_;
+        return;
+    }
+    ofs << key << '\t' << value << '\n';
+}
+
+size_t tuning_db_t::size() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return entries_.size();
+}
+
+static void print_tensors(
+        std::ostream &os, const std::vector<graph_tensor_ptr> &tensors) {
+    for (auto &t : tensors) {
+        os << t->details_.dtype_
+           << utils::print_vector(t->details_.get_plain_dims()) << '@'
+           << t->details_.get_format() << ';';
+    }
+}
+
+std::string make_tuning_key(const sc_op &op, const context_ptr &ctx) {
+    std::stringstream ss;
+    ss << op.op_name_ << " in:";
+    print_tensors(ss, op.get_inputs());
+    ss << " out:";
+    print_tensors(ss, op.get_outputs());
+    ss << " const:";
+    for (auto &in : op.get_inputs()) {
+        ss << in->producer_owner_->attrs_.get_or_else(
+                "constant", const_kind::not_const);
+    }
+    // covers the op attributes
+    ss << " hash:" << std::hex << op.hash_contents() << std::dec;
+    ss << " threads:" << runtime_config_t::get().get_num_threads();
+    const auto &cpu = ctx->machine_.cpu_flags_;
+    ss << " isa:" << cpu.max_simd_bits << ',' << ctx->use_amx() << ','
+       << static_cast<int>(cpu.family) << ','
+       << static_cast<int>(cpu.model);
+    return ss.str();
+}
+
+} // namespace gc
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_IR_GRAPH_TUNING_DB_HPP
+#define GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_IR_GRAPH_TUNING_DB_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "graph.hpp"
+#include <ops/body_generator.hpp>
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace gc {
+
+/**
+ * The persistent database of tuned template configs. When the environment
+ * variable ONEDNN_EXPERIMENTAL_GRAPH_COMPILER_TUNING_DB is set, the
+ * tune_op_configs graph pass looks up the config of each tunable op in the
+ * database file before falling back to the default config, and appends the
+ * best config it has measured for the ops missing in the database.
+ *
+ * The file is plain text with one entry per line: the key of the op, a tab,
+ * and the serialized config. When a key appears more than once, the last
+ * entry wins. Only configs whose fields are all int32 can be stored.
+ * */
+class SC_INTERNAL_API tuning_db_t {
+public:
+    // loads the database from a file. A missing file is an empty database
+    explicit tuning_db_t(const std::string &path);
+
+    /**
+     * Gets the database at the path in the compiler configs.
+     * @return the database, or null if the tuning database is disabled
+     * */
+    static std::shared_ptr<tuning_db_t> get();
+
+    /**
+     * Looks up the config for a key.
+     * @param key the key made by make_tuning_key
+     * @param default_cfg the default config of the op. It decides the type
+     *  of the returned config and the values of the fields missing in the
+     *  entry
+     * @param out the config found in the database
+     * @return true if an entry of the same config type is found
+     * */
+    bool lookup(const std::string &key, const config_ptr &default_cfg,
+            config_ptr &out) const;
+
+    // stores the config for a key, both in memory and in the file
+    void store(const std::string &key, const config_ptr &cfg);
+
+    size_t size() const;
+
+    const std::string &get_path() const { return path_; }
+
+private:
+    std::string path_;
+    mutable std::mutex lock_;
+    std::unordered_map<std::string, std::string> entries_;
+};
+
+/**
+ * Makes the database key of a tunable op. The key covers the op name, the
+ * dtypes, shapes and formats of the op's inputs and outputs, the op
+ * attributes, the constant-ness of the inputs, the number of threads and the
+ * target ISA.
+ * */
+SC_INTERNAL_API std::string make_tuning_key(
+        const sc_op &op, const context_ptr &ctx);
+
+/**
+ * Serializes a config in "class:field=value,..." form.
+ * @return the serialized config, or an empty string if the config has fields
+ *  of types other than int32
+ * */
+SC_INTERNAL_API std::string serialize_tuning_config(const config_ptr &cfg);
+
+} // namespace gc
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -74,6 +74,9 @@ public:
         // bool, default=false. whether the addresses of global tensors and
         // variables will be hardcoded in the JIT'd code
         static constexpr const char *STATIC_GLOBALS = "static_globals";
+        // string, the key of the module in the persistent JIT module cache.
+        // If set, the JIT may store the compiled module in the cache
+        static constexpr const char *JIT_CACHE_KEY = "jit_cache_key";
     };
 
     context_ptr ctx_;
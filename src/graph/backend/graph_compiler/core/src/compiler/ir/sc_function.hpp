@@ -65,6 +65,12 @@ constexpr const char *top_level = "top_level";
 // the pair holds the indices of input tensor args of this function, which this
 // output tensor can share buffer with.
 constexpr const char *inplace_hint = "inplace_hint";
+// std::string, the ops in the user graph which the function is lowered from.
+// See op_attr_key::graph_op_ids
+constexpr const char *graph_op_ids = "graph_op_ids";
+// int64_t, the total bytes of the tensor arguments of the function. 0 if
+// unknown
+constexpr const char *arg_bytes = "arg_bytes";
 
 } // namespace function_attrs
 
@@ -73,6 +73,10 @@ constexpr const char *parallel_merge_loop_granularity
 // data dependency first when enable this flag.
 constexpr const char *no_post_barrier = "no_post_barrier";
 
+// Boolean. If true, the iterations of the parallel for_loop_node_t are
+// independent and can be stolen by idle threads at runtime
+constexpr const char *parallel_work_stealing = "parallel_work_stealing";
+
 // Bound_axis. Give the hint of axis binding for loop
 constexpr const char *loop_axis_hint = "loop_axis_hint";
 
@@ -36,6 +36,13 @@ func_c sequential_function_pass_t::operator()(func_c f) {
     return f;
 }
 
+bool sequential_function_pass_t::is_thread_safe() const {
+    for (auto &p : passes_) {
+        if (!p->is_thread_safe()) { return false; }
+    }
+    return true;
+}
+
 } // namespace gc
 } // namespace graph
 } // namespace impl
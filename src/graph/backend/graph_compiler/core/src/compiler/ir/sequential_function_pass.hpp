@@ -32,6 +32,7 @@ public:
     sequential_function_pass_t(std::vector<function_pass_ptr> &&passes);
     sequential_function_pass_t(sequential_function_pass_t &&other);
     func_c operator()(func_c f) override;
+    bool is_thread_safe() const override;
     template <typename... Args>
     sequential_function_pass_t(Args &&...args) {
         utils::args_to_vector<function_pass_ptr>(passes_, std::move(args)...);
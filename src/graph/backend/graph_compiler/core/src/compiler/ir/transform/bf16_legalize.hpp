@@ -89,6 +89,7 @@ public:
     bf16_legalizer_t(context_ptr ctx = get_default_context())
         : ctx_(std::move(ctx)) {}
     func_c operator()(func_c f) override;
+    bool is_thread_safe() const override { return true; }
     stmt_c operator()(stmt_c f);
     expr_c operator()(expr_c f);
     SC_DECL_PASS_INFO_FUNC();
@@ -111,6 +112,7 @@ class bf16_eliminator_t : public function_pass_t {
 public:
     bf16_eliminator_t(context_ptr ctx) : ctx_(std::move(ctx)) {}
     func_c operator()(func_c f) override;
+    bool is_thread_safe() const override { return true; }
     stmt_c operator()(stmt_c f);
     expr_c operator()(expr_c f);
     SC_DECL_PASS_INFO_FUNC();
@@ -268,6 +268,17 @@ class closurize_cpu_impl_t : public closurize_impl_t {
         return seq;
     }
 
+    stmt_c visit(for_loop_c v) override {
+        auto ret = closurize_impl_t::visit(v);
+        if (v->kind_ == for_type::PARALLEL && v->attr_
+                && v->attr_->get_or_else(
+                        stmt_attr_key::parallel_work_stealing, false)) {
+            get_last_parallel_call_flag()
+                    |= runtime::thread_pool_flags::THREAD_POOL_WORK_STEALING;
+        }
+        return ret;
+    }
+
 public:
     using closurize_impl_t::dispatch;
 
@@ -321,6 +332,9 @@ public:
             auto &the_flag = get_last_parallel_call_flag();
             the_flag |= runtime::thread_pool_flags::THREAD_POOL_RUN_IDLE_FUNC;
             the_flag |= runtime::thread_pool_flags::THREAD_POOL_DISABLE_ROLLING;
+            // the idle function expects the static job dispatching
+            the_flag &= ~uint64_t(
+                    runtime::thread_pool_flags::THREAD_POOL_WORK_STEALING);
         }
         if (f == the_last_op_ && !out_calls.empty()) {
             // try to remove the last barrier
@@ -44,7 +44,15 @@ public:
                                 function_attrs::low_level, false))) {
             return v;
         }
-        func_id = register_traced_func(v->name_);
+        std::string graph_ops;
+        int64_t arg_bytes = 0;
+        if (v->attr_) {
+            graph_ops = v->attr_->get_or_else(
+                    function_attrs::graph_op_ids, std::string());
+            arg_bytes = v->attr_->get_or_else(
+                    function_attrs::arg_bytes, INT64_C(0));
+        }
+        func_id = register_traced_func(v->name_, graph_ops, arg_bytes);
         auto oldbody = v->body_;
         assert(oldbody.isa<stmts>());
         const auto &seq = oldbody.static_as<stmts>()->seq_;
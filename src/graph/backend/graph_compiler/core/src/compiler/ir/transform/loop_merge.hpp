@@ -31,6 +31,7 @@ namespace gc {
 class loop_merger_t : public function_pass_t {
 public:
     func_c operator()(func_c f) override;
+    bool is_thread_safe() const override { return true; }
     expr_c operator()(expr_c f);
     stmt_c operator()(stmt_c f);
     SC_DECL_PASS_INFO_FUNC();
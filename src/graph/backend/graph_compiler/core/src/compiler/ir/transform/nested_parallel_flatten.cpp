@@ -29,6 +29,7 @@
 #include <runtime/config.hpp>
 #include <unordered_map>
 #include <util/any_map.hpp>
+#include <util/utils.hpp>
 
 namespace dnnl {
 namespace impl {
@@ -57,6 +58,8 @@ class nested_parallel_flatten_impl_t : public ir_visitor_t {
     std::vector<parallel_info_t> info_;
     std::vector<stmt> *top_level_parallel_seq_ = nullptr;
     int runtime_threads_ = runtime_config_t::get().get_num_threads();
+    bool work_stealing_
+            = utils::compiler_configs_t::get().parallel_work_stealing_;
     int count_ = 0;
     int var_count_ = 0;
     int for_count_ = 0;
@@ -364,6 +367,20 @@ void work() {
                     top_level_parallel_seq_ = nullptr;
                     auto ret = ir_visitor_t::visit(v);
                     info_.pop_back();
+                    // the iterations are independent without barriers, so
+                    // they can be stolen by idle threads if the loop is not
+                    // known to be balanced
+                    if (work_stealing_
+                            && !(v->attr_
+                                    && v->attr_->get_or_else(
+                                            stmt_attr_key::
+                                                    parallel_loop_balanced,
+                                            false))) {
+                        auto newloop = ret->remake();
+                        newloop->attr()[stmt_attr_key::parallel_work_stealing]
+                                = true;
+                        return newloop;
+                    }
                     return ret;
                 }
 
@@ -36,6 +36,7 @@ public:
     bool skip_rename_;
     ir_simplifier_t(bool skip_rename) : skip_rename_(skip_rename) {}
     func_c operator()(func_c f) override;
+    bool is_thread_safe() const override { return true; }
     stmt_c operator()(stmt_c f) const;
     SC_DECL_PASS_INFO_FUNC();
 };
@@ -16,12 +16,14 @@
 
 #include "util_module_passes.hpp"
 #include <chrono>
+#include <exception>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 #include "pass_manager.hpp"
 #include "visitor.hpp"
+#include <util/parallel.hpp>
 #include <util/scoped_timer.hpp>
 #include <util/utils.hpp>
 
@@ -78,7 +80,26 @@ module_function_pass_t::module_function_pass_t(function_pass_ptr impl)
 
 const_ir_module_ptr module_function_pass_t::operator()(const_ir_module_ptr m) {
     auto ret = m->copy();
-    ret->run_pass(*impl_);
+    int threads = utils::compiler_configs_t::get().compile_threads_;
+    auto &funcs = ret->get_contents();
+    if (threads <= 1 || funcs.size() <= 1 || !impl_->is_thread_safe()) {
+        ret->run_pass(*impl_);
+        return ret;
+    }
+    // the exceptions can't escape from the worker threads. Rethrow the first
+    // one in the current thread
+    std::vector<std::exception_ptr> errors(funcs.size());
+    utils::parallel(
+            [&](int64_t i, int64_t) {
+                try {
+                    funcs[i] = std::const_pointer_cast<func_base>(
+                            (*impl_)(funcs[i]));
+                } catch (...) { errors[i] = std::current_exception(); }
+            },
+            0, funcs.size(), 1, threads);
+    for (auto &e : errors) {
+        if (e) { std::rethrow_exception(e); }
+    }
     return ret;
 }
 const_ir_module_ptr dispatch_module_on_visitor(
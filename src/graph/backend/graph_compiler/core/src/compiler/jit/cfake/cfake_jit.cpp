@@ -25,6 +25,7 @@
 #include <string.h>
 #include <compiler/codegen/codegen_c.hpp>
 #include <compiler/jit/jit.hpp>
+#include <compiler/jit/module_cache.hpp>
 #include <compiler/jit/symbol_resolver.hpp>
 #include <runtime/config.hpp>
 #include <runtime/env_vars.hpp>
@@ -62,6 +63,12 @@ std::shared_ptr<jit_module> cfake_jit::make_jit_module(
     throw std::runtime_error("make_jit_module().");
 }
 
+std::shared_ptr<jit_function_t> cfake_jit::load_cached_entry_func(
+        const std::string &key) {
+    // fix-me: (win32)
+    return nullptr;
+}
+
 void *cfake_jit_module_t::get_address_of_symbol(const std::string &name) {
     // fix-me: (win32)
     throw std::runtime_error("get_address_of_symbol().");
@@ -97,6 +104,49 @@ static const std::string &get_include_path() {
     return path;
 }
 
+// dlopen a compiled module, binds the runtime functions and runs __sc_init__
+// on the module data
+static void *open_compiled_module(
+        const std::string &path, statics_table_t &globals) {
+    void *compiled_module = dlopen(path.c_str(), RTLD_LAZY);
+    if (!compiled_module) {
+        std::ostringstream os;
+        os << "dlopen: " << dlerror();
+        throw std::runtime_error(os.str());
+    }
+    for (auto &kv : get_runtime_function_map()) {
+        void **ptr = reinterpret_cast<void **>(
+                dlsym(compiled_module, (kv.first + "_fptr").c_str()));
+        if (ptr) { *ptr = kv.second; }
+    }
+    typedef void (*init_func_t)(void *ctx, void *mod);
+    auto init_func = reinterpret_cast<init_func_t>(
+            dlsym(compiled_module, "__sc_init__"));
+    if (init_func) { init_func(nullptr, globals.data_.data_); }
+    return compiled_module;
+}
+
+// stores the compiled module and the module data before __sc_init__ in the
+// persistent module cache
+static void store_to_module_cache(const std::string &key,
+        const std::string &so_path, const statics_table_t &init_globals,
+        const module_cache::entry_meta_t &meta) {
+    auto base_path = module_cache::get_entry_path(key);
+    if (!module_cache::copy_file(so_path, base_path + ".so")) {
+        SC_MODULE_WARN << "Cannot write the JIT module cache: " << base_path;
+        return;
+    }
+    auto data_path = base_path + ".data";
+    auto tmp_data_path = module_cache::get_temp_path_for(data_path);
+    init_globals.save_to_file(tmp_data_path);
+    if (rename(tmp_data_path.c_str(), data_path.c_str()) != 0) {
+        unlink(tmp_data_path.c_str());
+        SC_MODULE_WARN << "Cannot write the JIT module cache: " << data_path;
+        return;
+    }
+    module_cache::store_entry_meta(key, meta);
+}
+
 std::shared_ptr<jit_module> cfake_jit::make_jit_module(
         const std::string &inpath, const std::string &outpath,
         statics_table_t &&globals, bool has_generic_wrapper,
@@ -164,21 +214,7 @@ std::shared_ptr<jit_module> cfake_jit::make_jit_module(
             os << "c compiler returns non-zero code: " << exit_status;
             throw std::runtime_error(os.str());
         }
-        compiled_module = dlopen(outpath.c_str(), RTLD_LAZY);
-        if (!compiled_module) {
-            std::ostringstream os;
-            os << "dlopen: " << dlerror();
-            throw std::runtime_error(os.str());
-        }
-        for (auto &kv : get_runtime_function_map()) {
-            void **ptr = reinterpret_cast<void **>(
-                    dlsym(compiled_module, (kv.first + "_fptr").c_str()));
-            if (ptr) { *ptr = kv.second; }
-        }
-        typedef void (*init_func_t)(void *ctx, void *mod);
-        auto init_func = reinterpret_cast<init_func_t>(
-                dlsym(compiled_module, "__sc_init__"));
-        if (init_func) { init_func(nullptr, globals.data_.data_); }
+        compiled_module = open_compiled_module(outpath, globals);
     } else {
         // If we call 'unlink', it will overwrite errno.
         const int fork_errno = errno;
@@ -254,12 +290,69 @@ std::shared_ptr<jit_module> cfake_jit::make_jit_module(
             managed_thread_pool, ptr_optional_dump);
     of.close();
 
+    std::string cache_key = module->attr_.get_or_else(
+            ir_module_t::attr_key_t::JIT_CACHE_KEY, std::string());
+    if (!module->get_entry_func() || !generate_wrapper
+            || module->attr_.get_or_else(
+                    ir_module_t::attr_key_t::STATIC_GLOBALS, false)) {
+        cache_key.clear();
+    }
+    // the module data is modified by __sc_init__, so keep a copy before it
+    // for the persistent cache
+    std::unique_ptr<statics_table_t> init_globals;
+    if (!cache_key.empty()) {
+        init_globals = utils::make_unique<statics_table_t>(attr_table.copy());
+    }
+
     auto ret = make_jit_module(inpath, outpath, std::move(attr_table),
             generate_wrapper, managed_thread_pool);
     ret->postprocess(new_mod);
+    if (!cache_key.empty() && module_cache::is_module_cacheable(*ret)) {
+        module_cache::entry_meta_t meta;
+        meta.entry_name_ = module->get_entry_func()->name_;
+        meta.managed_thread_pool_ = managed_thread_pool;
+        meta.generic_wrapper_ = generate_wrapper;
+        try {
+            store_to_module_cache(cache_key, outpath, *init_globals, meta);
+        } catch (const std::exception &e) {
+            SC_MODULE_WARN << "Cannot write the JIT module cache: "
+                           << e.what();
+        }
+    }
     return ret;
 }
 
+std::shared_ptr<jit_function_t> cfake_jit::load_cached_entry_func(
+        const std::string &key) {
+    module_cache::entry_meta_t meta;
+    if (key.empty() || !module_cache::load_entry_meta(key, meta)
+            || !meta.generic_wrapper_) {
+        return nullptr;
+    }
+    auto base_path = module_cache::get_entry_path(key);
+    // load a private copy of the shared object, so that it can be unlinked
+    // with the module like a freshly compiled one
+    const auto &tmpdir = utils::compiler_configs_t::get_temp_dir_path();
+    std::string outpath = tmpdir + "/cfake_jit_module-"
+            + utils::get_unique_name_for_file() + ".so";
+    try {
+        auto globals = statics_table_t::load_from_file(base_path + ".data");
+        if (!module_cache::copy_file(base_path + ".so", outpath)) {
+            return nullptr;
+        }
+        void *compiled_module = open_compiled_module(outpath, globals);
+        auto ret = std::shared_ptr<cfake_jit_module_t>(
+                new cfake_jit_module_t(compiled_module, std::string(),
+                        outpath, std::move(globals), true,
+                        meta.managed_thread_pool_));
+        return ret->get_function(meta.entry_name_);
+    } catch (const std::exception &e) {
+        unlink(outpath.c_str());
+        SC_MODULE_WARN << "Cannot load the JIT module cache: " << e.what();
+        return nullptr;
+    }
+}
+
 void *cfake_jit_module_t::get_address_of_symbol(const std::string &name) {
     void *global_var = globals_.get_or_null(name);
     if (global_var) { return global_var; }
@@ -81,6 +81,8 @@ public:
             c_generator_optional_out_t *optional_out = nullptr);
     std::shared_ptr<jit_module> make_jit_module(
             const_ir_module_ptr module, bool generate_wrapper) override;
+    std::shared_ptr<jit_function_t> load_cached_entry_func(
+            const std::string &key) override;
     std::shared_ptr<jit_module> make_jit_module(const std::string &inpath,
             const std::string &outpath, statics_table_t &&globals,
             bool has_generic_wrapper, bool managed_thread_pool) const;
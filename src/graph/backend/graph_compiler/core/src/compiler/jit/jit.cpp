@@ -21,6 +21,7 @@
 #if defined(SC_LLVM_BACKEND)
 #include "llvm/llvm_jit.hpp"
 #endif
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <stdio.h>
@@ -28,7 +29,9 @@
 #include "xbyak/xbyak_jit.hpp"
 #endif
 #include <compiler/ir/graph/dynamic_utils.hpp>
+#include <compiler/ir/graph/pass/graph_constant_cache.hpp>
 #include <compiler/ir/pass/ir_copy.hpp>
+#include <compiler/ir/transform/module_globals_resolve.hpp>
 #include <runtime/config.hpp>
 #include <runtime/managed_thread_pool.hpp>
 #include <runtime/microkernel/cpu/brgemm_range_handle.hpp>
@@ -133,6 +136,59 @@ void jit_module::postprocess(const const_ir_module_ptr &ir_mod) {
                           })
                           .get_or_else(nullptr);
         if (pcache) { shared_globals_.emplace_back(*pcache); }
+        if (!v->var_.isa<var>() || !v->var_->attr_) { continue; }
+        auto guard = v->var_->attr_->get_or_null<std::vector<cache_t>>(
+                attr_keys::shared_const_guard);
+        auto scope = v->var_->attr_->get_or_null<size_t>(
+                attr_keys::shared_const_scope);
+        auto offset = v->var_->attr_->get_or_null<size_t>(
+                attr_keys::module_global_offset);
+        if (!guard || !offset) { continue; }
+        bool *is_init = reinterpret_cast<bool *>(
+                static_cast<char *>(globals_.data_.data_) + *offset);
+        if (*is_init) { continue; }
+        // a module without a scope folds the tensors with its own inputs, and
+        // then marks them folded by no scope
+        size_t the_scope = scope ? *scope : 0;
+        bool all_initialized = the_scope
+                && std::all_of(guard->begin(), guard->end(),
+                        [the_scope](const cache_t &c) {
+                            return c->init_scope_.load() == the_scope;
+                        });
+        if (all_initialized) {
+            // the tensors are already folded by other modules of the same
+            // scope, skip folding
+            *is_init = true;
+        } else {
+            shared_const_guards_.push_back({is_init, the_scope, *guard});
+        }
+    }
+    if (!shared_const_guards_.empty()) { shared_consts_synced_ = false; }
+}
+
+void jit_module::do_sync_shared_consts() {
+    bool all_synced = true;
+    for (auto &guard : shared_const_guards_) {
+        if (!*guard.is_init_) {
+            all_synced = false;
+            continue;
+        }
+        for (auto &c : guard.tensors_) {
+            c->init_scope_.store(guard.scope_, std::memory_order_release);
+        }
+    }
+    if (all_synced) {
+        shared_consts_synced_.store(true, std::memory_order_release);
+    }
+}
+
+jit_module::~jit_module() {
+    if (!shared_globals_.empty()) {
+        // keep the owner alive, the module may be released at exit
+        auto cache = shared_globals_.front()->cache_owner_.lock();
+        shared_globals_.clear();
+        shared_const_guards_.clear();
+        if (cache) { trim_const_cache(cache); }
     }
 }
 void jit_module::update_op_dispatch_table(const const_ir_module_ptr &ir_mod) {
@@ -307,6 +363,7 @@ class injected_general_jit_function_t : public general_jit_function_t {
         thread_pool_caller_t<thread_pool_init>::call(
                 f, stream, module_data, args);
         after_kernel_run()
+        module_->sync_shared_consts();
     }
 
 public:
@@ -329,6 +386,7 @@ void general_jit_function_t::call_generic(
     before_kernel_run();
     f(stream, module_data, args);
     after_kernel_run();
+    module_->sync_shared_consts();
 }
 
 std::shared_ptr<jit_function_t> general_jit_function_t::make(
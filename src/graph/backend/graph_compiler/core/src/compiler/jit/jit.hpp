@@ -17,6 +17,7 @@
 #ifndef GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_JIT_JIT_HPP
 #define GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_JIT_JIT_HPP
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -115,6 +116,17 @@ public:
     // whether to use managed thread pool
     bool managed_thread_pool_;
     std::vector<std::shared_ptr<cached_const_graph_tensor>> shared_globals_;
+    // the "is_init" flag in globals_ of a graph whose folded constants are all
+    // in the shared constant cache, with the scope of the graph and the cached
+    // tensors it guards
+    struct shared_const_guard_t {
+        bool *is_init_;
+        size_t scope_;
+        std::vector<std::shared_ptr<cached_const_graph_tensor>> tensors_;
+    };
+    std::vector<shared_const_guard_t> shared_const_guards_;
+    // if all guarded cached tensors are marked initialized
+    std::atomic<bool> shared_consts_synced_ {true};
     jit_module(bool managed_thread_pool);
     jit_module(statics_table_t &&globals, bool managed_thread_pool);
     virtual void *get_address_of_symbol(const std::string &name) = 0;
@@ -126,8 +138,15 @@ public:
         return std::vector<std::string>();
     }
 
-    virtual ~jit_module() = default;
+    virtual ~jit_module();
     void postprocess(const const_ir_module_ptr &ir_mod);
+    // marks the cached tensors guarded by the "is_init" flags initialized
+    // after the module has folded them. Called after running the module
+    void sync_shared_consts() {
+        if (!shared_consts_synced_.load(std::memory_order_acquire)) {
+            do_sync_shared_consts();
+        }
+    }
 
 protected:
     // update runtime data with same lifetime as jit module like kerenl
@@ -136,6 +155,7 @@ protected:
     virtual void update_runtime_data(const const_ir_module_ptr &ir_mod);
     // child function in update_runtime_data.
     void update_op_dispatch_table(const const_ir_module_ptr &ir_mod);
+    void do_sync_shared_consts();
 };
 
 class SC_INTERNAL_API general_jit_function_t : public jit_function_t {
@@ -194,6 +214,20 @@ public:
      * */
     std::shared_ptr<jit_function_t> get_entry_func(
             const ir_module_ptr &m, bool generic = true);
+
+    /**
+     * Loads the entry function of a module from the persistent JIT module
+     * cache. The module should have been stored by an earlier compilation of
+     * an ir_module_t with attr JIT_CACHE_KEY set to the same key.
+     * @param key the cache key made by module_cache::make_cache_key
+     * @return the executable entry function with a generic wrapper, or null
+     *  if there is no usable cache entry or the JIT does not support the
+     *  persistent cache
+     * */
+    virtual std::shared_ptr<jit_function_t> load_cached_entry_func(
+            const std::string &key) {
+        return nullptr;
+    }
     virtual ~jit_engine_t() = default;
 
     static std::unique_ptr<jit_engine_t> make(const context_ptr &ctx);
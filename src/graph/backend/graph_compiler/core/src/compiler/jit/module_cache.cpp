@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "module_cache.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdio.h>
+#include "jit.hpp"
+#include <compiler/ir/graph/pass/pass.hpp>
+#include <oneapi/dnnl/dnnl_version.h>
+#include <runtime/config.hpp>
+#include <runtime/env_vars.hpp>
+#include <util/file.hpp>
+#include <util/hash_utils.hpp>
+#include <util/utils.hpp>
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace gc {
+namespace module_cache {
+
+// bump this when the layout of the entry files changes
+static constexpr const char *cache_magic = "SC_JIT_MODULE_CACHE_V1";
+
+const std::string &get_cache_dir() {
+    return utils::compiler_configs_t::get().jit_cache_dir_;
+}
+
+static void print_flags(std::ostream &os, const scflags_t &f) {
+    os << "flags:" << static_cast<int>(f.jit_kind_) << ','
+       << f.backend_opt_level << ',' << f.tensor_inplace_ << ','
+       << f.bf16_fast_trunc_ << ',' << f.const_share_ << ',' << f.trace_
+       << ',' << f.dead_write_elimination_ << ',' << f.buffer_schedule_
+       << ',' << static_cast<int>(f.brgemm_backend_) << ','
+       << f.kernel_optim_ << ',' << f.index2var_ << ',' << f.tensor2var_
+       << ',' << f.ssa_passes_ << ',' << f.brgemm_use_amx_ << ','
+       << f.prefetch_ << ',' << f.mixed_fusion_ << ',' << f.use_cost_model_
+       << ',' << f.debug_info_ << ',' << f.jit_support_amx_intrinsics_ << ','
+       << f.concat_optimization_ << '\n';
+}
+
+static void print_machine(
+        std::ostream &os, const runtime::target_machine_t &tm) {
+    const auto &cpu = tm.cpu_flags_;
+    os << "machine:" << cpu.max_simd_bits << ':';
+    // the ISA flags and the cpu family/model/step are contiguous byte-sized
+    // fields
+    auto begin = reinterpret_cast<const uint8_t *>(&cpu.fMMX);
+    auto end = reinterpret_cast<const uint8_t *>(&cpu.step) + 1;
+    for (auto p = begin; p != end; ++p) {
+        os << static_cast<int>(*p);
+    }
+    for (size_t i = 0; i < cpu.dataCacheLevels_; i++) {
+        os << ',' << cpu.dataCacheSize_[i];
+    }
+    os << '\n';
+}
+
+std::string make_cache_key(const sc_graph_t &graph,
+        const std::vector<sc_op_ptr> &args, const context_ptr &ctx) {
+    if (get_cache_dir().empty() || graph.is_dynamic()) { return std::string(); }
+    std::stringstream ss;
+    ss << cache_magic << '\n';
+    ss << "version:" << DNNL_VERSION_MAJOR << '.' << DNNL_VERSION_MINOR << '.'
+       << DNNL_VERSION_PATCH << '-' << DNNL_VERSION_HASH << '\n';
+    print_flags(ss, ctx->flags_);
+    print_machine(ss, ctx->machine_);
+    auto &rt_cfg = runtime_config_t::get();
+    ss << "runtime:" << rt_cfg.get_num_threads() << ','
+       << rt_cfg.managed_thread_pool_ << ','
+       << static_cast<int>(rt_cfg.trace_mode_) << '\n';
+
+    // the printed graph below covers the structure, dtypes, shapes and
+    // strides. The content hash covers formats and the op attributes
+    size_t attr_seed = 0;
+    for (auto &kv : graph.attrs_.as_map()) {
+        if (utils::string_startswith(kv.first, "temp.")) { continue; }
+        if (kv.second.empty()) { continue; }
+        size_t h = std::hash<std::string>()(kv.first);
+        hash_combine_stable(h, kv.second.hash());
+        attr_seed ^= h;
+    }
+    ss << "contents:" << std::hex << graph.hash_contents() << ',' << attr_seed
+       << std::dec << '\n';
+    ss << "args:";
+    for (auto &arg : args) {
+        auto itr = std::find(graph.ops_.begin(), graph.ops_.end(), arg);
+        if (itr == graph.ops_.end()) { return std::string(); }
+        ss << std::distance(graph.ops_.begin(), itr) << ',';
+    }
+    ss << '\n';
+    print_graph(graph, ss, /*print_shape*/ true, /*print_attr*/ false,
+            /*print_name*/ false, /*print_stride*/ true);
+    return ss.str();
+}
+
+bool is_module_cacheable(const jit_module &mod) {
+    return mod.op_tables_.empty() && mod.brg_handles_.empty()
+            && mod.shared_globals_.empty();
+}
+
+std::string get_entry_path(const std::string &key) {
+    std::stringstream ss;
+    ss << get_cache_dir() << "/sc_module_" << std::hex
+       << std::hash<std::string>()(key);
+    return ss.str();
+}
+
+std::string get_temp_path_for(const std::string &path) {
+    return path + '.' + utils::get_unique_name_for_file() + ".tmp";
+}
+
+bool load_entry_meta(const std::string &key, entry_meta_t &meta) {
+    std::ifstream ifs(get_entry_path(key) + ".meta");
+    if (!ifs) { return false; }
+    std::string magic;
+    std::getline(ifs, magic);
+    if (magic != cache_magic) { return false; }
+    std::getline(ifs, meta.entry_name_);
+    int managed_thread_pool = 0, generic_wrapper = 0;
+    ifs >> managed_thread_pool >> generic_wrapper;
+    // skip the line break after the flags
+    ifs.get();
+    if (!ifs || meta.entry_name_.empty()) { return false; }
+    meta.managed_thread_pool_ = managed_thread_pool;
+    meta.generic_wrapper_ = generic_wrapper;
+    std::string stored_key {std::istreambuf_iterator<char>(ifs),
+            std::istreambuf_iterator<char>()};
+    return stored_key == key;
+}
+
+void store_entry_meta(const std::string &key, const entry_meta_t &meta) {
+    auto path = get_entry_path(key) + ".meta";
+    auto tmp_path = get_temp_path_for(path);
+    {
+        std::ofstream ofs;
+        utils::open_file_for_write(ofs, tmp_path);
+        ofs << cache_magic << '\n'
+            << meta.entry_name_ << '\n'
+            << meta.managed_thread_pool_ << ' ' << meta.generic_wrapper_
+            << '\n'
+            << key;
+    }
+    if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+        remove(tmp_path.c_str());
+    }
+}
+
+bool copy_file(const std::string &src, const std::string &dst) {
+    std::ifstream ifs(src, std::ios::binary);
+    if (!ifs) { return false; }
+    auto tmp_path = get_temp_path_for(dst);
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary);
+        if (!ofs) { return false; }
+        ofs << ifs.rdbuf();
+        if (!ofs) {
+            ofs.close();
+            remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    if (rename(tmp_path.c_str(), dst.c_str()) != 0) {
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace module_cache
+} // namespace gc
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
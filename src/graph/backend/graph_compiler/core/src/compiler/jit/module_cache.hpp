@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_JIT_MODULE_CACHE_HPP
+#define GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_COMPILER_JIT_MODULE_CACHE_HPP
+
+#include <string>
+#include <vector>
+#include <compiler/config/context.hpp>
+#include <compiler/ir/graph/graph.hpp>
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace gc {
+
+class jit_module;
+
+/**
+ * The persistent JIT module cache. When the environment variable
+ * ONEDNN_EXPERIMENTAL_GRAPH_COMPILER_JIT_CACHE_DIR is set, the JIT engines
+ * which support it store the compiled code, the initial contents of the
+ * module data buffer and the entry function name of a module in that
+ * directory, so that a later process compiling the same graph on the same
+ * target machine can skip graph passes, lowering and codegen.
+ *
+ * An entry is found by a hash of the cache key, and the full key text is
+ * stored with the entry and compared on load to rule out hash collisions.
+ * */
+namespace module_cache {
+
+// the metadata of a cache entry
+struct entry_meta_t {
+    // the name of the entry function of the module
+    std::string entry_name_;
+    // whether the module uses managed thread pool
+    bool managed_thread_pool_ = false;
+    // whether the module has generic wrappers for the functions
+    bool generic_wrapper_ = false;
+};
+
+// Gets the cache directory. Empty if the persistent cache is disabled
+SC_INTERNAL_API const std::string &get_cache_dir();
+
+/**
+ * Makes the cache key for lowering a graph with the given args and context.
+ * The key covers the graph structure, shapes, formats and op attributes, the
+ * order of the args, the compiler flags, the target machine and the library
+ * version.
+ * @param graph the graph before any graph passes
+ * @param args the input and output ops of the graph, in the order of the
+ *  arguments of the entry function
+ * @param ctx the context to compile the graph
+ * @return the key, or an empty string if the cache is disabled or the graph
+ *  cannot be cached (e.g. it has dynamic shapes)
+ * */
+SC_INTERNAL_API std::string make_cache_key(const sc_graph_t &graph,
+        const std::vector<sc_op_ptr> &args, const context_ptr &ctx);
+
+/**
+ * Checks if a JIT module can be restored from the persistent cache: modules
+ * holding runtime data built from the IR module (dispatch tables, brgemm
+ * range handles, shared constant tensors) cannot be cached
+ * */
+SC_INTERNAL_API bool is_module_cacheable(const jit_module &mod);
+
+// Gets the base path (without extension) of the entry files of a key
+SC_INTERNAL_API std::string get_entry_path(const std::string &key);
+
+/**
+ * Loads and checks the metadata of the entry for a key.
+ * @return true if the entry exists and was stored with exactly the same key
+ * */
+SC_INTERNAL_API bool load_entry_meta(
+        const std::string &key, entry_meta_t &meta);
+
+/**
+ * Stores the metadata of the entry for a key. This should be the last file
+ * written for an entry, since its presence marks the entry as complete
+ * */
+SC_INTERNAL_API void store_entry_meta(
+        const std::string &key, const entry_meta_t &meta);
+
+/**
+ * Copies a file. The destination is written to a temp file first and then
+ * renamed, so that concurrent readers never see a partial file.
+ * @return true on success
+ * */
+SC_INTERNAL_API bool copy_file(
+        const std::string &src, const std::string &dst);
+
+// Gets a unique temp file path next to a file, for replacing it by rename
+SC_INTERNAL_API std::string get_temp_path_for(const std::string &path);
+
+} // namespace module_cache
+} // namespace gc
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -104,6 +104,15 @@ struct body_generator_base_t {
         return config_ptr_vec();
     }
 
+    /**
+     * Returns the configs to be measured when tuning the op with static
+     * shapes. The configs should be valid for `generate` on the shapes of the
+     * generator. By default, it is the same as the dynamic config candidates
+     * */
+    virtual config_ptr_vec get_tuning_candidates(const context_ptr &ctx) const {
+        return get_dynamic_config_candidates(ctx);
+    }
+
     virtual std::vector<uint64_t> convert_config_to_keys(
             const config_ptr &config) const {
         throw std::runtime_error("Unimplement");
@@ -30,6 +30,27 @@ namespace graph {
 namespace gc {
 namespace ops {
 
+// Returns the number of the batch dims of A right before the matrix dims, over
+// which B of the same rank is broadcast, while the other batch dims match,
+// e.g. the query heads sharing a key/value head in multi-query or grouped-query
+// attention: [..., G, M, K] x [..., 1, K, N]. Such dims can be folded into M.
+static size_t get_foldable_bcast_dims(
+        const sc_dims &A_dims, const sc_dims &B_dims) {
+    if (A_dims.size() < 3 || A_dims.size() != B_dims.size()) return 0;
+    for (size_t i = 0; i < A_dims.size(); ++i) {
+        if (A_dims[i] <= 0 || B_dims[i] <= 0) return 0;
+    }
+    int d = static_cast<int>(A_dims.size()) - 3;
+    size_t num_bcast = 0;
+    for (; d >= 0 && B_dims[d] == 1 && A_dims[d] != 1; --d) {
+        ++num_bcast;
+    }
+    for (; d >= 0; --d) {
+        if (A_dims[d] != B_dims[d]) return 0;
+    }
+    return num_bcast;
+}
+
 matmul_op::matmul_op(const std::vector<graph_tensor_ptr> &ins,
         const std::vector<graph_tensor_ptr> &outs, const any_map_t &attrs) {
     COMPILE_ASSERT((ins.size() == 2 || ins.size() == 3),
@@ -45,10 +66,12 @@ matmul_op::matmul_op(const std::vector<graph_tensor_ptr> &ins,
     bool is_int8 = utils::is_one_of(
             ins[0]->details_.dtype_, datatypes::u8, datatypes::s8);
     bool is_bf16 = ins[0]->details_.dtype_ == datatypes::bf16;
-    sc_dims expected_out_shape
-            = {merge_vec(matmul_core_op_t::get_batch_dims_impl(A_dims, B_dims),
-                    {A_dims[A_dims.size() - (trans_a ? 1 : 2)],
-                            B_dims[B_dims.size() - (trans_b ? 2 : 1)]})};
+    sc_dims batch_dims = get_foldable_bcast_dims(A_dims, B_dims)
+            ? sc_dims {A_dims.begin(), A_dims.end() - 2}
+            : matmul_core_op_t::get_batch_dims_impl(A_dims, B_dims);
+    sc_dims expected_out_shape = {merge_vec(batch_dims,
+            {A_dims[A_dims.size() - (trans_a ? 1 : 2)],
+                    B_dims[B_dims.size() - (trans_b ? 2 : 1)]})};
     if (outs.empty()) {
         info_.outputs_.emplace_back(std::make_shared<graph_tensor>(this,
                 sc_data_format_t(), expected_out_shape,
@@ -147,6 +170,7 @@ void matmul_op::get_graph_impl(std::shared_ptr<sc_graph_t> &graph) {
     // to meet more possibilities of M_block or N_block
     sc_dims trans0_plain_dims = trans0->details_.get_plain_dims(),
             trans1_plain_dims = trans1->details_.get_plain_dims();
+    size_t num_folded_dims = 0;
     if (!is_dynamic()) {
         // check Nd*2d cases
         if (trans0_plain_dims.size() > 2 && trans1_plain_dims.size() == 2) {
@@ -160,6 +184,36 @@ void matmul_op::get_graph_impl(std::shared_ptr<sc_graph_t> &graph) {
                     {{"shape", reshape_dest}, {"format", sc_data_format_t()}});
             trans0 = reshape_node->get_outputs()[0];
         }
+        // check Nd*Nd cases with B broadcast over the trailing batch dims of
+        // A, e.g. a key/value head shared by a group of query heads. These
+        // dims are folded into M, so that every tile of B is reused by the
+        // whole group while it is hot in cache.
+        num_folded_dims
+                = get_foldable_bcast_dims(trans0_plain_dims, trans1_plain_dims);
+        if (num_folded_dims) {
+            const size_t num_kept_dims
+                    = trans0_plain_dims.size() - 2 - num_folded_dims;
+            sc_dims A_dest {trans0_plain_dims.begin(),
+                    trans0_plain_dims.begin() + num_kept_dims};
+            A_dest.emplace_back(math_utils::get_dims_product(
+                    sc_dims {trans0_plain_dims.begin() + num_kept_dims,
+                            trans0_plain_dims.end() - 1}));
+            A_dest.emplace_back(trans0_plain_dims.back());
+            auto A_view = graph->make("tensor_view", {trans0},
+                    {graph_tensor::make(A_dest, sc_data_format_t(),
+                            trans0->details_.dtype_)},
+                    {{"shape", A_dest}, {"format", sc_data_format_t()}});
+            trans0 = A_view->get_outputs()[0];
+            sc_dims B_dest {trans1_plain_dims.begin(),
+                    trans1_plain_dims.begin() + num_kept_dims};
+            B_dest.insert(B_dest.end(), trans1_plain_dims.end() - 2,
+                    trans1_plain_dims.end());
+            auto B_view = graph->make("tensor_view", {trans1},
+                    {graph_tensor::make(B_dest, sc_data_format_t(),
+                            trans1->details_.dtype_)},
+                    {{"shape", B_dest}, {"format", sc_data_format_t()}});
+            trans1 = B_view->get_outputs()[0];
+        }
         // check 2d*Nd cases
         if (trans0_plain_dims.size() == 2 && trans1_plain_dims.size() > 2) {
             sc_dims reshape_dest
@@ -220,6 +274,16 @@ void matmul_op::get_graph_impl(std::shared_ptr<sc_graph_t> &graph) {
                             matmul->get_outputs()[0]->details_.dtype_)},
                     {{"shape", reshape_dest}, {"format", sc_data_format_t()}});
         }
+        // Nd*Nd cases with the broadcast dims folded into M
+        if (num_folded_dims) {
+            sc_dims reshape_dest
+                    = {trans0_plain_dims.begin(), trans0_plain_dims.end() - 1};
+            reshape_dest.emplace_back(trans1_plain_dims.back());
+            matmul = graph->make("tensor_view", {matmul->get_outputs()[0]},
+                    {graph_tensor::make(reshape_dest, sc_data_format_t(),
+                            matmul->get_outputs()[0]->details_.dtype_)},
+                    {{"shape", reshape_dest}, {"format", sc_data_format_t()}});
+        }
         // 2d*Nd cases
         if (trans0_plain_dims.size() == 2 && trans1_plain_dims.size() > 2) {
             sc_dims reshape_dest
@@ -349,6 +349,37 @@ config_ptr gen_conv_fwd_t::get_default_config(context_ptr ctx) const {
   return std::move(ret);
 }
 
+gen_conv_fwd_t::config_ptr_vec gen_conv_fwd_t::get_tuning_candidates(
+  const context_ptr &ctx) const {
+  config_ptr_vec ret;
+  // conv1d and inverse filter override the blockings of the default config
+  if (use_conv1d || inverse_filter_) { return ret; }
+  auto default_cfg = get_default_config(ctx);
+  const conv_fwd_config_t &dcfg
+    = *default_cfg.unchecked_get_as<conv_fwd_config_t>();
+  // vary the channel blockings and the loop schedule around the default
+  // config, keeping the default tiles and threads
+  auto K_block_list = utils::get_blocks(oc_, 16, 256);
+  auto C_block_list = utils::get_blocks(ic_, 16, 256);
+  for (auto K_block : K_block_list) {
+    for (auto C_block : C_block_list) {
+      for (int loop_sched = 0; loop_sched < 4; loop_sched++) {
+        conv_fwd_config_t cfg = dcfg;
+        cfg.K_block = K_block;
+        cfg.C_block = C_block;
+        cfg.loop_sched = loop_sched;
+        validate_conv_fwd_default_config(ctx, cfg);
+        if (cfg.K_block == dcfg.K_block && cfg.C_block == dcfg.C_block
+          && cfg.loop_sched == dcfg.loop_sched) {
+          continue;
+        }
+        ret.emplace_back(reflection::general_object_t::make(cfg));
+      }
+    }
+  }
+  return ret;
+}
+
 gen_conv_fwd_t::gen_conv_fwd_t(sc_op *owner, const sc_dims &stride,
   const sc_dims &dilation, const sc_dims &pads_begin,
   std::vector<logical_tensor_t> &&ins, std::vector<logical_tensor_t> &&outs)
@@ -121,6 +121,8 @@ public:
     const std::vector<expr> &outputs,
     std::vector<for_loop> &loops) const override;
   config_ptr get_default_config(context_ptr ctx) const override;
+  config_ptr_vec get_tuning_candidates(
+    const context_ptr &ctx) const override;
 
   void schedule_loops(context_ptr ctx, const conv_fwd_config_t &config,
     stmt body, std::vector<for_loop> &fors) const override;
@@ -41,6 +41,13 @@ const char *env_names[] = {
         DEF_ENV(C_INCLUDE),
         DEF_ENV(TRACE_INIT_CAP),
         DEF_ENV(MANAGED_THREAD_POOL),
+        DEF_ENV(JIT_CACHE_DIR),
+        DEF_ENV(TUNING_DB),
+        DEF_ENV(TUNING_TRIALS),
+        DEF_ENV(DYNAMIC_SPECIALIZE),
+        DEF_ENV(WORK_STEALING),
+        DEF_ENV(COMPILE_THREADS),
+        DEF_ENV(CONST_CACHE_CAPACITY),
 };
 
 namespace utils {
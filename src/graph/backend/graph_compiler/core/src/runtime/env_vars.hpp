@@ -34,6 +34,13 @@ enum key {
     SC_C_INCLUDE,
     SC_TRACE_INIT_CAP,
     SC_MANAGED_THREAD_POOL,
+    SC_JIT_CACHE_DIR,
+    SC_TUNING_DB,
+    SC_TUNING_TRIALS,
+    SC_DYNAMIC_SPECIALIZE,
+    SC_WORK_STEALING,
+    SC_COMPILE_THREADS,
+    SC_CONST_CACHE_CAPACITY,
     NUM_KEYS
 };
 } // namespace env_key
@@ -45,6 +45,12 @@
 using namespace dnnl::impl::graph::gc;
 using runtime::thread_manager;
 static void do_dispatch(thread_manager *s, int tid);
+
+// packs the begin and end job ids of a range in work-stealing mode
+static uint64_t pack_range(uint64_t begin, uint64_t end) {
+    return (end << 32) | begin;
+}
+
 namespace dnnl {
 namespace impl {
 namespace graph {
@@ -83,6 +89,33 @@ void thread_manager::thread_pool_state::reset_scoreboard() {
     remaining.store(num_threads - 1, std::memory_order_release);
 }
 
+// gets the begin job id and the number of jobs of a thread, using balance211
+static void get_static_range(size_t num_jobs, size_t num_threads, size_t tid,
+        size_t &my_begin, size_t &cur_jobs) {
+    size_t my_jobs = utils::divide_and_ceil(num_jobs, num_threads);
+    assert(my_jobs > 0);
+    size_t my_jobs_2 = my_jobs - 1;
+    size_t the_tid = num_jobs - my_jobs_2 * num_threads;
+    cur_jobs = tid < the_tid ? my_jobs : my_jobs_2;
+    my_begin = tid <= the_tid ? tid * my_jobs
+                              : the_tid * my_jobs + (tid - the_tid) * my_jobs_2;
+}
+
+void thread_manager::thread_pool_state::reset_steal_ranges(uint64_t num_jobs) {
+    if (steal_ranges_capacity < num_threads) {
+        steal_ranges.reset(new std::atomic<uint64_t>[static_cast<size_t>(
+                num_threads) * steal_range_stride]);
+        steal_ranges_capacity = num_threads;
+    }
+    for (int tid = 0; tid < num_threads; tid++) {
+        size_t my_begin, cur_jobs;
+        get_static_range(num_jobs, num_threads, tid, my_begin, cur_jobs);
+        steal_ranges[tid * steal_range_stride].store(
+                pack_range(my_begin, my_begin + cur_jobs),
+                std::memory_order_relaxed);
+    }
+}
+
 #ifdef SC_KERNEL_PROFILE
 static std::atomic<int> instances {0};
 #endif
@@ -246,6 +279,97 @@ static thread_manager *get_current_active_thr_mgr() {
 #endif
 }
 
+#ifdef SC_KERNEL_PROFILE
+static void make_trace_steal(int in_or_out, int count) {
+    if (sc_is_trace_enabled()) { sc_make_trace_kernel(5, in_or_out, count); }
+}
+#else
+#define make_trace_steal(v, count) SC_UNUSED(count)
+#endif
+
+// the number of chunks a thread splits its range into in work-stealing mode.
+// The thread pops one chunk at a time, so that the rest can be stolen
+constexpr uint64_t steal_chunks_per_range = 8;
+
+static void run_jobs(thread_manager *s, uint64_t begin, uint64_t end) {
+    auto &task = s->state.task;
+    for (uint64_t jid = begin; jid < end; jid++) {
+        task.pfunc(task.stream, task.module_env, task.begin + jid * task.step,
+                task.args);
+    }
+}
+
+// pops a chunk of jobs from the front of the range owned by the thread
+static bool pop_jobs(std::atomic<uint64_t> &range, uint64_t chunk,
+        uint64_t &begin, uint64_t &end) {
+    uint64_t r = range.load(std::memory_order_relaxed);
+    for (;;) {
+        uint64_t b = r & 0xffffffff;
+        uint64_t e = r >> 32;
+        if (b >= e) { return false; }
+        uint64_t new_b = std::min(b + chunk, e);
+        if (range.compare_exchange_weak(
+                    r, pack_range(new_b, e), std::memory_order_relaxed)) {
+            begin = b;
+            end = new_b;
+            return true;
+        }
+    }
+}
+
+// steals the back half of the jobs from the range of another thread
+static bool steal_jobs(
+        std::atomic<uint64_t> &range, uint64_t &begin, uint64_t &end) {
+    uint64_t r = range.load(std::memory_order_relaxed);
+    for (;;) {
+        uint64_t b = r & 0xffffffff;
+        uint64_t e = r >> 32;
+        if (b >= e) { return false; }
+        uint64_t new_e = e - (e - b + 1) / 2;
+        if (range.compare_exchange_weak(
+                    r, pack_range(b, new_e), std::memory_order_relaxed)) {
+            begin = new_e;
+            end = e;
+            return true;
+        }
+    }
+}
+
+// runs the jobs in the thread's own range, and then steals the remaining jobs
+// of other threads. A stolen range is published as the thread's own range, so
+// that it can be stolen again. Each job is run exactly once, because the
+// ranges are only shrunk by CAS and every job id belongs to at most one range
+static void do_dispatch_stealing(thread_manager *s, int tid) {
+    auto &state = s->state;
+    auto ranges = state.steal_ranges.get();
+    const int stride = thread_manager::thread_pool_state::steal_range_stride;
+    auto &my_range = ranges[tid * stride];
+    uint64_t r = my_range.load(std::memory_order_relaxed);
+    uint64_t chunk = utils::divide_and_ceil(
+            (r >> 32) - (r & 0xffffffff), steal_chunks_per_range);
+    int num_steals = 0;
+    for (;;) {
+        uint64_t begin, end;
+        while (pop_jobs(my_range, std::max(chunk, UINT64_C(1)), begin, end)) {
+            run_jobs(s, begin, end);
+        }
+        bool stolen = false;
+        for (int i = 1; i < state.num_threads; i++) {
+            int victim = (tid + i) % state.num_threads;
+            if (steal_jobs(ranges[victim * stride], begin, end)) {
+                stolen = true;
+                break;
+            }
+        }
+        if (!stolen) { break; }
+        if (num_steals == 0) { make_trace_steal(0, 0); }
+        num_steals++;
+        chunk = utils::divide_and_ceil(end - begin, steal_chunks_per_range);
+        my_range.store(pack_range(begin, end), std::memory_order_relaxed);
+    }
+    if (num_steals) { make_trace_steal(1, num_steals); }
+}
+
 // using balance211 to dispatch the workloads
 static void do_dispatch(thread_manager *s, int tid) {
     size_t end = s->state.task.end;
@@ -258,14 +382,14 @@ static void do_dispatch(thread_manager *s, int tid) {
                 begin + step * tid, s->state.task.args);
         return;
     }
-    size_t my_jobs = utils::divide_and_ceil(num_jobs, s->state.num_threads);
-    assert(my_jobs > 0);
-    size_t my_jobs_2 = my_jobs - 1;
-    size_t the_tid = num_jobs - my_jobs_2 * s->state.num_threads;
-    size_t cur_jobs = (size_t)tid < the_tid ? my_jobs : my_jobs_2;
-    size_t my_begin = (size_t)tid <= the_tid
-            ? tid * my_jobs
-            : the_tid * my_jobs + (tid - the_tid) * my_jobs_2;
+    if (s->state.execution_flags
+            & runtime::thread_pool_flags::THREAD_POOL_WORK_STEALING) {
+        do_dispatch_stealing(s, tid);
+        return;
+    }
+    size_t my_begin, cur_jobs;
+    runtime::get_static_range(
+            num_jobs, s->state.num_threads, tid, my_begin, cur_jobs);
     my_begin = my_begin * step + begin;
     bool disable_rolling = s->state.execution_flags
             & runtime::thread_pool_flags::THREAD_POOL_DISABLE_ROLLING;
@@ -285,6 +409,19 @@ void sc_parallel_call_managed(
     runtime::thread_local_buffer_t::tls_buffer_.additional_->is_main_thread_
             = true;
     thread_manager *stream = get_current_active_thr_mgr();
+    if (execution_flags
+            & runtime::thread_pool_flags::THREAD_POOL_WORK_STEALING) {
+        uint64_t num_jobs = utils::divide_and_ceil(
+                uint64_t(end - begin), uint64_t(step));
+        // the job ids should fit in the packed ranges
+        if (num_jobs > UINT32_MAX) {
+            execution_flags
+                    &= ~uint64_t(runtime::thread_pool_flags::
+                                    THREAD_POOL_WORK_STEALING);
+        } else {
+            stream->state.reset_steal_ranges(num_jobs);
+        }
+    }
     stream->state.execution_flags = execution_flags;
     stream->state.reset_scoreboard();
     stream->state.task = thread_manager::thread_pool_state::task_type {
@@ -17,6 +17,7 @@
 #ifndef GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_RUNTIME_MANAGED_THREAD_POOL_HPP
 #define GRAPH_BACKEND_GRAPH_COMPILER_CORE_SRC_RUNTIME_MANAGED_THREAD_POOL_HPP
 #include <atomic>
+#include <memory>
 #include <runtime/context.hpp>
 
 namespace dnnl {
@@ -47,8 +48,17 @@ struct thread_manager {
 
         alignas(64) std::atomic<int> remaining;
 
+        // the remaining job range of each thread in work-stealing mode. The
+        // range of thread `tid` is at `steal_ranges[tid * steal_range_stride]`
+        // and packs the begin and end job ids in the lower and higher 32 bits
+        static constexpr int steal_range_stride = 64 / sizeof(uint64_t);
+        std::unique_ptr<std::atomic<uint64_t>[]> steal_ranges;
+        int steal_ranges_capacity = 0;
+
         void wait_all();
         void reset_scoreboard();
+        // splits the jobs of the current task to the steal_ranges of threads
+        void reset_steal_ranges(uint64_t num_jobs);
     } state;
 #ifdef SC_KERNEL_PROFILE
     int instance_id_;
@@ -31,6 +31,9 @@ constexpr int THREAD_POOL_RUN_IDLE_FUNC = 1;
 constexpr int THREAD_POOL_DISABLE_ROLLING = 1 << 1;
 // set when this parallel-for is the last one in the whole kernel
 constexpr int THREAD_POOL_EXIT = 1 << 2;
+// set when the iterations of this parallel-for are independent and idle
+// threads can steal them from other threads
+constexpr int THREAD_POOL_WORK_STEALING = 1 << 3;
 } // namespace thread_pool_flags
 
 } // namespace runtime
@@ -14,11 +14,13 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include "config.hpp"
 #include <runtime/logging.hpp>
@@ -42,17 +44,105 @@ namespace gc {
 
 SC_MODULE(runtime.trace);
 
+struct traced_func_info_t {
+    std::string graph_ops_;
+    int64_t arg_bytes_;
+};
+
 static struct trace_env_t {
     std::mutex name_lock_;
     std::vector<std::string> names_ {
-            "brgemm", "list_brgemm", "barrier", "barrier_internal", "prefetch"};
+            "brgemm", "list_brgemm", "barrier", "barrier_internal", "prefetch",
+            "work_steal"};
+    // the graph ops and argument bytes of the traced functions lowered from
+    // the graph, indexed by the function IDs
+    std::unordered_map<int, traced_func_info_t> infos_;
 } env;
 
 namespace runtime {
 
+struct op_profile_t {
+    int64_t calls_ = 0;
+    // the execution time in nanoseconds, summed over the threads
+    int64_t time_ns_ = 0;
+};
+
+// sums up the execution time of each traced function in the traces
+static std::vector<op_profile_t> make_op_profile(
+        const std::list<thread_local_buffer_t *> &tls_buffers) {
+    std::vector<op_profile_t> ret(env.names_.size());
+    std::vector<std::vector<int64_t>> begin_ticks(env.names_.size());
+    for (auto *tlb : tls_buffers) {
+        for (auto &ticks : begin_ticks) {
+            ticks.clear();
+        }
+        for (auto &v : tlb->additional_->trace_.trace_logs_) {
+            if (v.func_id_ >= ret.size()) { continue; }
+            auto &ticks = begin_ticks[v.func_id_];
+            if (!v.in_or_out_) {
+                ticks.emplace_back(v.tick_);
+            } else if (!ticks.empty()) {
+                ret[v.func_id_].calls_++;
+                ret[v.func_id_].time_ns_ += v.tick_ - ticks.back();
+                ticks.pop_back();
+            }
+        }
+    }
+    return ret;
+}
+
+static void write_json_op_profile(
+        FILE *outf, const std::vector<op_profile_t> &profile) {
+    fputs(R"("opProfile": [
+)",
+            outf);
+    bool first = true;
+    for (size_t i = 0; i < profile.size(); i++) {
+        auto &prof = profile[i];
+        if (!prof.calls_) { continue; }
+        auto itr = env.infos_.find(i);
+        const char *graph_ops
+                = itr == env.infos_.end() ? "" : itr->second.graph_ops_.c_str();
+        int64_t bytes = itr == env.infos_.end() ? 0 : itr->second.arg_bytes_;
+        // bytes per nanosecond is GB/s
+        double bandwidth = prof.time_ns_
+                ? double(bytes) * prof.calls_ / prof.time_ns_
+                : 0.0;
+        fprintf(outf,
+                R"(%c{"name":"%s@%zu", "graph_ops":"%s", "calls":%ld, "time_ms":%lf, "bytes":%ld, "bandwidth_GBps":%lf}
+)",
+                first ? ' ' : ',', env.names_[i].c_str(), i, graph_ops,
+                (long)prof.calls_, prof.time_ns_ / 1e6, (long)bytes, // NOLINT
+                bandwidth);
+        first = false;
+    }
+    fputs("],\n", outf);
+}
+
+static void log_op_profile(const std::vector<op_profile_t> &profile) {
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < profile.size(); i++) {
+        if (profile[i].calls_ && env.infos_.find(i) != env.infos_.end()) {
+            ids.emplace_back(i);
+        }
+    }
+    std::sort(ids.begin(), ids.end(), [&profile](size_t a, size_t b) {
+        return profile[a].time_ns_ > profile[b].time_ns_;
+    });
+    for (auto i : ids) {
+        auto &info = env.infos_[i];
+        SC_MODULE_INFO << env.names_[i] << " (" << info.graph_ops_
+                       << "): calls=" << profile[i].calls_
+                       << ", time=" << profile[i].time_ns_ / 1e6
+                       << "ms, bytes=" << info.arg_bytes_;
+    }
+}
+
 static void write_json_traces(FILE *outf,
         const std::list<thread_local_buffer_t *> &tls_buffers, int64_t min_val,
         size_t trace_size, bool main_thread_found) {
+    auto profile = make_op_profile(tls_buffers);
+    log_op_profile(profile);
     fputs(R"({
 "traceEvents": [
 )",
@@ -67,19 +157,25 @@ static void write_json_traces(FILE *outf,
             }
         }
         for (auto &v : tlb->additional_->trace_.trace_logs_) {
+            auto itr = env.infos_.find(v.func_id_);
             fprintf(outf,
-                    R"({"pid":1, "tid":%zu, "ts":%lf, "ph":"%c", "name":"%s@%d", "args":{"flop":%d}, "cat":"call" }%c
+                    R"({"pid":1, "tid":%zu, "ts":%lf, "ph":"%c", "name":"%s@%d", "args":{"flop":%d, "graph_ops":"%s"}, "cat":"call" }%c
 )",
                     (size_t)tlb->additional_->linear_thread_id_,
                     (v.tick_ - min_val) / 1000.0, v.in_or_out_ ? 'E' : 'B',
                     env.names_[v.func_id_].c_str(), v.func_id_, v.arg_,
+                    itr == env.infos_.end() ? ""
+                                            : itr->second.graph_ops_.c_str(),
                     i == trace_size - 1 ? ' ' : ',');
             i++;
         }
         tlb->additional_->trace_.trace_logs_.clear();
     }
     fputs(R"(],
-"sc_version": "0.0.0"
+)",
+            outf);
+    write_json_op_profile(outf, profile);
+    fputs(R"("sc_version": "0.0.0"
 }
 )",
             outf);
@@ -157,10 +253,26 @@ SC_INTERNAL_API void generate_trace_file() {
     dnnl::impl::graph::gc::release_runtime_memory(nullptr);
 }
 
-int register_traced_func(const std::string &name) {
+int register_traced_func(const std::string &name,
+        const std::string &graph_ops, int64_t arg_bytes) {
     std::lock_guard<std::mutex> guard(env.name_lock_);
     env.names_.emplace_back(name);
-    return env.names_.size() - 1;
+    int id = env.names_.size() - 1;
+    if (!graph_ops.empty() || arg_bytes) {
+        env.infos_[id] = traced_func_info_t {graph_ops, arg_bytes};
+    }
+    return id;
+}
+
+// gets the graph ops and argument bytes of a traced function. Returns false if
+// they are not registered
+bool get_traced_func_info(int id, std::string &graph_ops, int64_t &arg_bytes) {
+    std::lock_guard<std::mutex> guard(env.name_lock_);
+    auto itr = env.infos_.find(id);
+    if (itr == env.infos_.end()) { return false; }
+    graph_ops = itr->second.graph_ops_;
+    arg_bytes = itr->second.arg_bytes_;
+    return true;
 }
 
 int get_last_trace_func_id() {
@@ -41,7 +41,17 @@ struct trace_manager_t {
 void write_traces(const std::list<thread_local_buffer_t *> &tls_buffers);
 
 } // namespace runtime
-int register_traced_func(const std::string &name);
+
+/**
+ * Registers a traced function and gets its ID in the traces
+ * @param name the function name
+ * @param graph_ops the ops in the user graph which the function is lowered
+ * from. Can be empty
+ * @param arg_bytes the total bytes of the tensor arguments of the function. 0
+ * if unknown
+ * */
+int register_traced_func(const std::string &name,
+        const std::string &graph_ops = std::string(), int64_t arg_bytes = 0);
 } // namespace gc
 } // namespace graph
 } // namespace impl
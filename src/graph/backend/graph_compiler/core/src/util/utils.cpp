@@ -131,6 +131,17 @@ static void parse_value(const char *name, T &v) {
 using namespace env_key;
 compiler_configs_t::compiler_configs_t() {
     dump_gen_code_ = utils::getenv_string(env_names[SC_DUMP_GENCODE]);
+    jit_cache_dir_ = utils::getenv_string(env_names[SC_JIT_CACHE_DIR]);
+    tuning_db_path_ = utils::getenv_string(env_names[SC_TUNING_DB]);
+    tuning_trials_ = utils::getenv_int(env_names[SC_TUNING_TRIALS], 0);
+    dynamic_specialize_limit_
+            = utils::getenv_int(env_names[SC_DYNAMIC_SPECIALIZE], 0);
+    parallel_work_stealing_ = utils::getenv_int(env_names[SC_WORK_STEALING], 0);
+    compile_threads_ = utils::getenv_int(env_names[SC_COMPILE_THREADS], 1);
+    int const_cache_mb
+            = utils::getenv_int(env_names[SC_CONST_CACHE_CAPACITY], 0);
+    const_cache_capacity_
+            = const_cache_mb > 0 ? size_t(const_cache_mb) * 1024 * 1024 : 0;
     print_pass_result_ = utils::getenv_int(env_names[SC_PRINT_PASS_RESULT], 0);
 
     if (temp_dir_.empty()) {
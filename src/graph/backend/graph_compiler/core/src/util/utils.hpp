@@ -205,6 +205,25 @@ SC_INTERNAL_API std::string get_dyn_lib_path(void *addr);
 struct SC_INTERNAL_API compiler_configs_t {
     bool print_gen_code_;
     std::string dump_gen_code_;
+    // the directory of the persistent JIT module cache. Empty if disabled
+    std::string jit_cache_dir_;
+    // the file of the persistent template config database. Empty if disabled
+    std::string tuning_db_path_;
+    // the max number of configs to measure for each op missing in the
+    // database. If 0, the database is only consulted
+    int tuning_trials_ = 0;
+    // the max number of input shapes of a dynamic partition to compile static
+    // kernels for in background. If 0, only the dynamic kernel is used
+    int dynamic_specialize_limit_ = 0;
+    // if true, the parallel-fors which are not flattened and not known to be
+    // balanced are executed in work-stealing mode by the managed thread pool
+    bool parallel_work_stealing_ = false;
+    // the number of threads to run the thread-safe function passes on the
+    // functions of a module
+    int compile_threads_ = 1;
+    // the max bytes of the folded constants kept in the shared constant cache
+    // after no compiled module uses them. If 0, they are freed at once
+    size_t const_cache_capacity_ = 0;
     std::string jit_cc_options_;
     std::vector<std::string> cpu_jit_flags_;
     bool xbyak_jit_save_obj_ = false;
@@ -88,6 +88,27 @@ bool check_select(op_t *op) {
     return false;
 }
 
+// Checks the key/value input of an attention matmul is shared by several query
+// heads, as in multi-query and grouped-query attention: it has the rank of the
+// query and size 1 on the head dims right before the matrix dims, over which
+// it is broadcast, e.g. [N, H_kv, 1, S, D] for a query of [N, H_kv, G, S, D].
+bool check_shared_kv_heads(op_t *op) {
+    if (op->num_inputs() != 2) return false;
+    const logical_tensor_t &q = op->get_input_value(0)->get_logical_tensor();
+    const logical_tensor_t &kv = op->get_input_value(1)->get_logical_tensor();
+    if (q.ndims < 3 || q.ndims != kv.ndims) return false;
+    bool shared = false;
+    int d = q.ndims - 3;
+    for (; d >= 0 && kv.dims[d] == 1 && q.dims[d] != 1; --d) {
+        shared = true;
+    }
+    if (!shared) return false;
+    for (; d >= 0; --d) {
+        if (kv.dims[d] != q.dims[d]) return false;
+    }
+    return true;
+}
+
 } // namespace pass
 } // namespace compiler_impl
 } // namespace graph
@@ -83,6 +83,44 @@ pm::alternation_t *create_alternative_mul_subgraph(
     return mul_subgraph;
 }
 
+// Multi-query / grouped-query attention, in which every key/value head is
+// shared by a group of query heads and is broadcast to them by the MatMuls.
+void create_shared_kv_mha_pattern(
+        const std::shared_ptr<pb_graph_t> &pgraph, bool is_bf16) {
+    auto check_dtype = is_bf16 ? check_input_dtype<graph::data_type::bf16>
+                               : check_input_dtype<graph::data_type::f32>;
+    auto matmul_qk = pgraph->append_op(graph::op_kind::MatMul);
+    matmul_qk->append_decision_function(check_dtype);
+    matmul_qk->append_decision_function(check_shared_kv_heads);
+    auto fscore_scale = pgraph->append_alternation(
+            {graph::op_kind::Divide, graph::op_kind::Multiply},
+            {in_edge(0, matmul_qk, 0)});
+
+    auto optional_mask_subgraph = std::make_shared<pb_graph_t>();
+    auto fscore_add = optional_mask_subgraph->append_op(graph::op_kind::Add);
+    optional_mask_subgraph->create_input_port(0, fscore_add, 0);
+    optional_mask_subgraph->create_output_port(0, fscore_add, 0);
+    auto optional_mask = pgraph->append_optional(
+            optional_mask_subgraph, {in_edge(0, fscore_scale, 0)});
+
+    auto softmax = pgraph->append_op(
+            graph::op_kind::SoftMax, {in_edge(0, optional_mask, 0)});
+    auto matmul_v = pgraph->append_op(
+            graph::op_kind::MatMul, {in_edge(0, softmax, 0)});
+    matmul_v->append_decision_function(check_dtype);
+    matmul_v->append_decision_function(check_shared_kv_heads);
+
+    auto optional_transpose = create_append_transpose_repetition_subgraph(
+            pgraph, matmul_v, 0, 2);
+    auto optional_reshape_subgraph = std::make_shared<pb_graph_t>();
+    auto optional_reshape = optional_reshape_subgraph->append_alternation(
+            {graph::op_kind::Reorder, graph::op_kind::StaticReshape});
+    optional_reshape_subgraph->create_input_port(0, optional_reshape, 0);
+    optional_reshape_subgraph->create_output_port(0, optional_reshape, 0);
+    pgraph->append_optional(
+            optional_reshape_subgraph, {in_edge(0, optional_transpose, 0)});
+}
+
 COMPILER_BACKEND_REGISTER_PASSES_DEF_BEGIN(fp32_mha_pattern)
 // fp32 MHA pattern
 /*
@@ -723,6 +761,39 @@ COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(
                     pgraph->append_op(
                             graph::op_kind::MatMul, {in_edge(0, softmax, 0)});
                 });
+
+// fp32 multi-query / grouped-query attention pattern
+/*
+   (f32)[Query]    [Key](f32)
+               \     /
+                MatMul  [fscore scale](f32)
+                  \    /
+[Attention Mask] Div|Mul
+               \   /
+                 Add (optional)
+                  |
+               Softmax  [Value](f32)
+                     \     /
+                      MatMul
+                         |
+                   Transpose (optional)
+                         |
+              Reorder|StaticReshape (optional)
+                         |
+                      [output](f32)
+
+Key and value have size 1 on the head dims that they share among the query
+heads, e.g. [N, H_kv, 1, S, D] for a query of [N, H_kv, G, S, D]. The MatMuls
+fold the query heads of a group into their rows, so every key/value tile is
+reused by the whole group while it is hot in cache.
+*/
+COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(compiler, fp32_gqa_pattern)
+        .set_priority(5.1f) // higher priority than mha patterns
+        .set_kind(graph::partition_kind_t::mha)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    create_shared_kv_mha_pattern(pgraph, false);
+                });
 COMPILER_BACKEND_REGISTER_PASSES_DEF_END
 
 COMPILER_BACKEND_REGISTER_PASSES_DEF_BEGIN(bf16_mha_pattern)
@@ -1122,6 +1193,39 @@ COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(
                     pgraph->append_op(graph::op_kind::SoftMax,
                             {in_edge(0, fscore_add, 0)});
                 });
+
+// bf16 multi-query / grouped-query attention pattern
+/*
+   (bf16)[Query]    [Key](bf16)
+               \     /
+                MatMul  [fscore scale](bf16)
+                  \    /
+[Attention Mask] Div|Mul
+               \   /
+                 Add (optional)
+                  |
+               Softmax  [Value](bf16)
+                     \     /
+                      MatMul
+                         |
+                   Transpose (optional)
+                         |
+              Reorder|StaticReshape (optional)
+                         |
+                      [output](bf16)
+
+Key and value have size 1 on the head dims that they share among the query
+heads, e.g. [N, H_kv, 1, S, D] for a query of [N, H_kv, G, S, D]. The MatMuls
+fold the query heads of a group into their rows, so every key/value tile is
+reused by the whole group while it is hot in cache.
+*/
+COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(compiler, bf16_gqa_pattern)
+        .set_priority(5.1f) // higher priority than mha patterns
+        .set_kind(graph::partition_kind_t::mha)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    create_shared_kv_mha_pattern(pgraph, true);
+                });
 COMPILER_BACKEND_REGISTER_PASSES_DEF_END
 
 COMPILER_BACKEND_REGISTER_PASSES_DEF_BEGIN(int8_mha_pattern)
@@ -95,6 +95,31 @@ std::pair<pm::pb_node_t *, pm::pb_node_t *> single_layer_mlp(
     return std::make_pair(layer_input, layer_output);
 }
 
+// gated mlp (SwiGLU) with the optional down projection, silu is decomposed to
+// Sigmoid and Multiply
+void gated_mlp(const std::shared_ptr<pb_graph_t> &pgraph, bool is_bf16) {
+    auto check_dtype = is_bf16 ? check_input_dtype<graph::data_type::bf16>
+                               : check_input_dtype<graph::data_type::f32>;
+    auto matmul_gate = pgraph->append_op(graph::op_kind::MatMul);
+    matmul_gate->append_decision_function(check_dtype);
+    auto sigmoid = pgraph->append_op(
+            graph::op_kind::Sigmoid, {in_edge(0, matmul_gate, 0)});
+    auto silu = pgraph->append_op(graph::op_kind::Multiply,
+            {in_edge(0, matmul_gate, 0), in_edge(1, sigmoid, 0)});
+    auto matmul_up = pgraph->append_op(graph::op_kind::MatMul);
+    matmul_up->append_decision_function(check_dtype);
+    auto gate = pgraph->append_op(graph::op_kind::Multiply,
+            {in_edge(0, silu, 0), in_edge(1, matmul_up, 0)});
+
+    /* optional down projection */
+    auto down_subgraph = std::make_shared<pb_graph_t>();
+    auto matmul_down = down_subgraph->append_op(graph::op_kind::MatMul);
+    matmul_down->append_decision_function(check_dtype);
+    down_subgraph->create_input_port(0, matmul_down, 0);
+    down_subgraph->create_output_port(0, matmul_down, 0);
+    pgraph->append_optional(down_subgraph, {in_edge(0, gate, 0)});
+}
+
 pm::pb_node_t *weight_grad_alternation_unit(
         const std::shared_ptr<pb_graph_t> &pgraph, pm::pb_op_t *activation) {
     /* Create 2 subgraph for alternation */
@@ -353,6 +378,32 @@ COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(
                             last_layer, {in_edge(0, repetition, 0)});
                 });
 
+/*
+gated mlp (SwiGLU) of LLaMA-family models. The up projections share the
+input, so the mixed partition merges them horizontally and fuses the gating.
+  [IN0](f32) [IN1](f32)
+        \      /
+         MatMul              [IN0](f32) [IN2](f32)
+         |    \                    \      /
+         |   Sigmoid                MatMul
+          \   /                       /
+         Multiply                    /
+               \                    /
+                     Multiply   [IN3](f32)
+                          \      /
+                           MatMul (optional)
+                             |
+                         [OUT0](f32)
+*/
+COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(
+        compiler, fp32_gated_mlp_pattern)
+        .set_priority(5.2f)
+        .set_kind(graph::partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    gated_mlp(pgraph, false);
+                });
+
 /*
 mlp residual graph, having an extra edge from LayerNorm to Add.
 [IN0](fp32)   [IN1](fp32)
@@ -909,6 +960,32 @@ COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(
                             last_layer, {in_edge(0, repetition, 0)});
                 });
 /*
+gated mlp (SwiGLU) of LLaMA-family models. The up projections share the
+input, so the mixed partition merges them horizontally and fuses the gating.
+  [IN0](bf16) [IN1](bf16)
+        \      /
+         MatMul              [IN0](bf16) [IN2](bf16)
+         |    \                    \      /
+         |   Sigmoid                MatMul
+          \   /                       /
+         Multiply                    /
+               \                    /
+                     Multiply   [IN3](bf16)
+                          \      /
+                           MatMul (optional)
+                             |
+                         [OUT0](bf16)
+*/
+COMPILER_BACKEND_REGISTER_TRANSFORMATION_PASS(
+        compiler, bf16_gated_mlp_pattern)
+        .set_priority(5.2f)
+        .set_kind(graph::partition_kind_t::mlp)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    gated_mlp(pgraph, true);
+                });
+
+/*
 mlp residual graph, having an extra edge from LayerNorm to Add.
 [IN0](bf16)   [IN1](bf16)
        \      /
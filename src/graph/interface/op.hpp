@@ -299,6 +299,7 @@ public:
             CASE(axis);
             CASE(begin_norm_axis);
             CASE(groups);
+            CASE(k);
             CASE(axes);
             CASE(dilations);
             CASE(weights_shape);
@@ -369,6 +370,7 @@ public:
             CASE(DynamicQuantize);
             CASE(Elu);
             CASE(EluBackward);
+            CASE(EmbeddingBag);
             CASE(End);
             CASE(Exp);
             CASE(GELU);
@@ -408,6 +410,7 @@ public:
             CASE(ReLU);
             CASE(ReLUBackward);
             CASE(Reorder);
+            CASE(RotaryEmbedding);
             CASE(Round);
             CASE(Select);
             CASE(Sigmoid);
@@ -425,6 +428,7 @@ public:
             CASE(Subtract);
             CASE(Tanh);
             CASE(TanhBackward);
+            CASE(TopK);
             CASE(TypeCast);
             CASE(Wildcard);
             CASE(LastSymbol);
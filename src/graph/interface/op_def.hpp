@@ -387,6 +387,23 @@ DNNL_GRAPH_OP_SCHEMA(EluBackward, 1,
                         "T", {data_type::f32, data_type::bf16, data_type::f16})
                 .set_shape_inference_function(infer_identity_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(EmbeddingBag, 1,
+        op_schema_t()
+                .set_inputs_option(op_schema_t::param_num_option::optional)
+                .set_num_inputs(std::set<size_t>({2, 3}))
+                .set_num_outputs(1)
+                .set_input(0, "src", "T1")
+                .set_input(1, "indices", "T2")
+                .set_input(2, "offsets", "T2")
+                .set_output(0, "dst", "T1")
+                .set_attr(op_attr::mode, false, attribute_kind::s, "sum",
+                        {"sum", "mean"})
+                .set_type_constraints(
+                        "T1", {data_type::f32, data_type::bf16, data_type::f16})
+                .set_type_constraints("T2", {data_type::s32})
+                .set_shape_inference_function(
+                        infer_embedding_bag_output_shape))
+
 DNNL_GRAPH_OP_SCHEMA(End, 1,
         op_schema_t()
                 .set_num_inputs(1)
@@ -1088,6 +1105,20 @@ DNNL_GRAPH_OP_SCHEMA(TanhBackward, 1,
                         "T", {data_type::f32, data_type::bf16, data_type::f16})
                 .set_shape_inference_function(infer_identity_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(TopK, 1,
+        op_schema_t()
+                .set_num_inputs(1)
+                .set_num_outputs(2)
+                .set_input(0, "src", "T1")
+                .set_output(0, "dst", "T1")
+                .set_output(1, "indices", "T2")
+                .set_attr(op_attr::axis, false, attribute_kind::i, (int64_t)-1)
+                .set_attr(op_attr::k, true, attribute_kind::i)
+                .set_type_constraints(
+                        "T1", {data_type::f32, data_type::bf16, data_type::f16})
+                .set_type_constraints("T2", {data_type::s32})
+                .set_shape_inference_function(infer_topk_output_shape))
+
 DNNL_GRAPH_OP_SCHEMA(Wildcard, 1,
         op_schema_t()
                 .set_inputs_option(op_schema_t::param_num_option::variadic)
@@ -1142,6 +1173,20 @@ DNNL_GRAPH_OP_SCHEMA(Reorder, 1,
                         "T", {data_type::f32, data_type::bf16, data_type::f16})
                 .set_shape_inference_function(infer_identity_output_shape))
 
+DNNL_GRAPH_OP_SCHEMA(RotaryEmbedding, 1,
+        op_schema_t()
+                .set_num_inputs(3)
+                .set_num_outputs(1)
+                .set_input(0, "src", "T")
+                .set_input(1, "cos", "T")
+                .set_input(2, "sin", "T")
+                .set_output(0, "dst", "T")
+                .set_attr(op_attr::mode, false, attribute_kind::s, "half",
+                        {"half", "interleaved"})
+                .set_type_constraints(
+                        "T", {data_type::f32, data_type::bf16, data_type::f16})
+                .set_shape_inference_function(infer_identity_output_shape))
+
 DNNL_GRAPH_OP_SCHEMA(TypeCast, 1,
         op_schema_t()
                 .set_num_inputs(1)
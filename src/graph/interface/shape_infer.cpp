@@ -1061,6 +1061,59 @@ status_t infer_norm_bprop_output_shape(op_t *n,
             n, inputs, outputs, identity_shapes_pos);
 }
 
+status_t infer_topk_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto in0 = logical_tensor_wrapper_t(inputs[0]);
+    auto out_dims = in0.vdims();
+    const auto ndims = static_cast<int64_t>(out_dims.size());
+
+    int64_t axis = n->get_attr<int64_t>(op_attr::axis);
+    if (axis < -ndims || axis >= ndims) return status::invalid_shape;
+    if (axis < 0) axis += ndims;
+
+    const int64_t k = n->get_attr<int64_t>(op_attr::k);
+    const dim_t axis_size = out_dims[static_cast<size_t>(axis)];
+    if (k <= 0 || (axis_size != DNNL_GRAPH_UNKNOWN_DIM && k > axis_size))
+        return status::invalid_shape;
+    out_dims[static_cast<size_t>(axis)] = k;
+
+    // The values and the indices have the same shape. The backend ops may
+    // have more outputs, e.g. the scratchpad.
+    for (size_t i = 0; i < 2; ++i) {
+        auto out = logical_tensor_wrapper_t(outputs[i]);
+        // check if partial set shape aligns with inferred shape
+        if (out.ndims() != -1 && !validate(out_dims, out.vdims()))
+            return status::invalid_shape;
+        set_shape_and_strides(*outputs[i], out_dims);
+    }
+    return status::success;
+}
+
+status_t infer_embedding_bag_output_shape(op_t *n,
+        std::vector<logical_tensor_t *> &inputs,
+        std::vector<logical_tensor_t *> &outputs) {
+    auto src = logical_tensor_wrapper_t(inputs[0]);
+    auto indices = logical_tensor_wrapper_t(inputs[1]);
+    if (src.ndims() != 2 || indices.ndims() != 1) return status::invalid_shape;
+
+    // Without offsets, each index makes a bag.
+    dim_t nbags = indices.dims()[0];
+    if (inputs.size() > 2) {
+        auto offsets = logical_tensor_wrapper_t(inputs[2]);
+        if (offsets.ndims() != 1) return status::invalid_shape;
+        nbags = offsets.dims()[0];
+    }
+    const dims out_dims {nbags, src.dims()[1]};
+
+    auto out0 = logical_tensor_wrapper_t(outputs[0]);
+    // check if partial set shape aligns with inferred shape
+    if (out0.ndims() != -1 && !validate(out_dims, out0.vdims()))
+        return status::invalid_shape;
+    set_shape_and_strides(*outputs[0], out_dims);
+    return status::success;
+}
+
 status_t infer_select_output_shape(op_t *n,
         std::vector<logical_tensor_t *> &inputs,
         std::vector<logical_tensor_t *> &outputs) {
@@ -1,5 +1,5 @@
 /*******************************************************************************
-* Copyright 2022 Intel Corporation
+* Copyright 2022-2023 Intel Corporation
 *
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
@@ -17,6 +17,8 @@
 #ifndef GRAPH_UTILS_ALLOCATOR_HPP
 #define GRAPH_UTILS_ALLOCATOR_HPP
 
+#include "common/utils.hpp"
+
 #include "graph/utils/utils.hpp"
 
 #ifdef DNNL_WITH_SYCL
@@ -28,30 +30,19 @@ namespace impl {
 namespace graph {
 namespace utils {
 
-/// Default allocator for CPU
+/// Default allocator for CPU. Goes through the library host allocator so
+/// that graph buffers (e.g. constant cache) follow dnnl_set_host_allocator()
+/// and ONEDNN_HOST_ALLOCATOR settings.
 class cpu_allocator_t {
 public:
     constexpr static size_t DEFAULT_ALIGNMENT = 64;
 
     static void *malloc(size_t size, size_t alignment) {
-        void *ptr = nullptr;
         const size_t align = alignment == 0 ? DEFAULT_ALIGNMENT : alignment;
-#ifdef _WIN32
-        ptr = _aligned_malloc(size, align);
-        int rc = ((ptr) ? 0 : errno);
-#else
-        int rc = ::posix_memalign(&ptr, align, size);
-#endif /* _WIN32 */
-        return (rc == 0) ? ptr : nullptr;
+        return dnnl::impl::malloc(size, static_cast<int>(align));
     }
 
-    static void free(void *p) {
-#ifdef _WIN32
-        _aligned_free((void *)p);
-#else
-        ::free((void *)p);
-#endif /* _WIN32 */
-    }
+    static void free(void *p) { dnnl::impl::free(p); }
 };
 
 #ifdef DNNL_WITH_SYCL
@@ -313,6 +313,7 @@ dnnl::graph::op::kind opstr2kind(const std::string &kind) {
             {"DynamicQuantize", dnnl::graph::op::kind::DynamicQuantize},
             {"Elu", dnnl::graph::op::kind::Elu},
             {"EluBackward", dnnl::graph::op::kind::EluBackward},
+            {"EmbeddingBag", dnnl::graph::op::kind::EmbeddingBag},
             {"End", dnnl::graph::op::kind::End},
             {"Exp", dnnl::graph::op::kind::Exp},
             {"GELU", dnnl::graph::op::kind::GELU},
@@ -352,6 +353,7 @@ dnnl::graph::op::kind opstr2kind(const std::string &kind) {
             {"ReLU", dnnl::graph::op::kind::ReLU},
             {"ReLUBackward", dnnl::graph::op::kind::ReLUBackward},
             {"Reorder", dnnl::graph::op::kind::Reorder},
+            {"RotaryEmbedding", dnnl::graph::op::kind::RotaryEmbedding},
             {"Round", dnnl::graph::op::kind::Round},
             {"Select", dnnl::graph::op::kind::Select},
             {"Sigmoid", dnnl::graph::op::kind::Sigmoid},
@@ -369,6 +371,7 @@ dnnl::graph::op::kind opstr2kind(const std::string &kind) {
             {"Subtract", dnnl::graph::op::kind::Subtract},
             {"Tanh", dnnl::graph::op::kind::Tanh},
             {"TanhBackward", dnnl::graph::op::kind::TanhBackward},
+            {"TopK", dnnl::graph::op::kind::TopK},
             {"TypeCast", dnnl::graph::op::kind::TypeCast},
             {"Wildcard", dnnl::graph::op::kind::Wildcard}};
     const auto it = op_map.find(kind);
@@ -399,6 +402,7 @@ dnnl::graph::op::attr attrstr2kind(const std::string &attr_name) {
             {"axis", dnnl::graph::op::attr::axis},
             {"begin_norm_axis", dnnl::graph::op::attr::begin_norm_axis},
             {"groups", dnnl::graph::op::attr::groups},
+            {"k", dnnl::graph::op::attr::k},
             // int64_t vector attributes. The value of these attributes can be a
             // vector of int64 numbers.
             {"axes", dnnl::graph::op::attr::axes},
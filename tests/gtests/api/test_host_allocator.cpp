@@ -0,0 +1,111 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+namespace {
+
+std::atomic<int> n_allocations {0};
+std::atomic<int> n_deallocations {0};
+
+void *counting_allocate(size_t size, size_t alignment) {
+    n_allocations++;
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void *ptr = nullptr;
+    return ::posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void counting_deallocate(void *ptr) {
+    n_deallocations++;
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    ::free(ptr);
+#endif
+}
+
+} // namespace
+
+TEST(host_allocator_test_t, InvalidArguments) {
+    ASSERT_EQ(set_host_allocator(counting_allocate, nullptr),
+            status::invalid_arguments);
+    ASSERT_EQ(set_host_allocator(nullptr, counting_deallocate),
+            status::invalid_arguments);
+}
+
+TEST(host_allocator_test_t, MemoryUsesUserAllocator) {
+    SKIP_IF(engine::get_count(engine::kind::cpu) == 0,
+            "Engine is not found.");
+    SKIP_IF(is_sycl_engine(engine::kind::cpu),
+            "SYCL memory is allocated by SYCL runtime.");
+
+    engine eng(engine::kind::cpu, 0);
+    memory::desc md({16, 16}, memory::data_type::f32, memory::format_tag::ab);
+
+    ASSERT_EQ(set_host_allocator(counting_allocate, counting_deallocate),
+            status::success);
+    const int allocations_before = n_allocations;
+    const int deallocations_before = n_deallocations;
+    {
+        memory mem(md, eng);
+        ASSERT_NE(mem.get_data_handle(), nullptr);
+        ASSERT_GT(n_allocations, allocations_before);
+    }
+    ASSERT_GT(n_deallocations, deallocations_before);
+    ASSERT_EQ(set_host_allocator(nullptr, nullptr), status::success);
+}
+
+TEST(host_allocator_test_t, MemoryIsReleasedByItsAllocator) {
+    SKIP_IF(engine::get_count(engine::kind::cpu) == 0,
+            "Engine is not found.");
+    SKIP_IF(is_sycl_engine(engine::kind::cpu),
+            "SYCL memory is allocated by SYCL runtime.");
+
+    engine eng(engine::kind::cpu, 0);
+    memory::desc md({16, 16}, memory::data_type::f32, memory::format_tag::ab);
+
+    // Memory allocated before the user allocator is set doesn't reach it.
+    std::unique_ptr<memory> sys_mem(new memory(md, eng));
+    ASSERT_EQ(set_host_allocator(counting_allocate, counting_deallocate),
+            status::success);
+    const int deallocations_before = n_deallocations;
+    std::unique_ptr<memory> user_mem(new memory(md, eng));
+    sys_mem.reset();
+    ASSERT_EQ(n_deallocations, deallocations_before);
+
+    // Memory allocated by the user allocator goes back to it after a reset.
+    ASSERT_EQ(set_host_allocator(nullptr, nullptr), status::success);
+    user_mem.reset();
+    ASSERT_GT(n_deallocations, deallocations_before);
+}
+
+} // namespace dnnl
@@ -20,6 +20,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include <tuple>
+#include <vector>
 
 namespace dnnl {
 
@@ -30,7 +31,7 @@ static bool are_valid_flags(
     if (engine_kind == dnnl_gpu && (stream_flags & dnnl_stream_out_of_order))
         ok = false;
 #endif
-#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     if (engine_kind == dnnl_cpu && (stream_flags & dnnl_stream_out_of_order))
         ok = false;
 #endif
@@ -137,6 +138,149 @@ TEST(stream_test_c_t, GetStream) {
 }
 #endif
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+TEST(stream_test_cpp_t, OutOfOrderDependencies) {
+    engine eng(engine::kind::cpu, 0);
+    SKIP_IF(!are_valid_flags(dnnl_cpu, dnnl_stream_out_of_order),
+            "Incompatible stream flags.");
+    stream s(eng, stream::flags::out_of_order);
+
+    const memory::dim n = 1024;
+    memory::desc md({n}, memory::data_type::f32, memory::format_tag::a);
+    auto linear = [&](float alpha, float beta) {
+        auto pd = eltwise_forward::primitive_desc(eng, prop_kind::forward,
+                algorithm::eltwise_linear, md, md, alpha, beta);
+        return eltwise_forward(pd);
+    };
+
+    memory a(md, eng), b(md, eng), c(md, eng), d(md, eng);
+    auto *a_ptr = static_cast<float *>(a.get_data_handle());
+    auto *d_ptr = static_cast<float *>(d.get_data_handle());
+    for (memory::dim i = 0; i < n; i++) {
+        a_ptr[i] = 1.f;
+        d_ptr[i] = 5.f;
+    }
+
+    // b = 2 * a; c = b + 1; a = c * 3 (write-after-read on a);
+    // d = d - 5 is independent of the chain.
+    auto mul2 = linear(2.f, 0.f);
+    auto add1 = linear(1.f, 1.f);
+    auto mul3 = linear(3.f, 0.f);
+    auto sub5 = linear(1.f, -5.f);
+    mul2.execute(s, {{DNNL_ARG_SRC, a}, {DNNL_ARG_DST, b}});
+    add1.execute(s, {{DNNL_ARG_SRC, b}, {DNNL_ARG_DST, c}});
+    mul3.execute(s, {{DNNL_ARG_SRC, c}, {DNNL_ARG_DST, a}});
+    sub5.execute(s, {{DNNL_ARG_SRC, d}, {DNNL_ARG_DST, d}});
+    s.wait();
+
+    const auto *b_ptr = static_cast<const float *>(b.get_data_handle());
+    const auto *c_ptr = static_cast<const float *>(c.get_data_handle());
+    for (memory::dim i = 0; i < n; i++) {
+        ASSERT_EQ(b_ptr[i], 2.f);
+        ASSERT_EQ(c_ptr[i], 3.f);
+        ASSERT_EQ(a_ptr[i], 9.f);
+        ASSERT_EQ(d_ptr[i], 0.f);
+    }
+}
+
+TEST(stream_test_cpp_t, OutOfOrderKeepsSubmittedHandles) {
+    engine eng(engine::kind::cpu, 0);
+    SKIP_IF(!are_valid_flags(dnnl_cpu, dnnl_stream_out_of_order),
+            "Incompatible stream flags.");
+    stream s(eng, stream::flags::out_of_order);
+
+    const memory::dim n = 1024;
+    memory::desc md({n}, memory::data_type::f32, memory::format_tag::a);
+    auto pd = eltwise_forward::primitive_desc(eng, prop_kind::forward,
+            algorithm::eltwise_linear, md, md, 2.f, 0.f);
+    auto mul2 = eltwise_forward(pd);
+
+    std::vector<float> src(n, 1.f), dst0(n, 0.f), dst1(n, 0.f);
+    memory a(md, eng, src.data()), b(md, eng, dst0.data());
+
+    // The primitive writes to the buffer set at submission even if the
+    // handle is changed before the primitive is executed.
+    mul2.execute(s, {{DNNL_ARG_SRC, a}, {DNNL_ARG_DST, b}});
+    b.set_data_handle(dst1.data());
+    s.wait();
+
+    for (memory::dim i = 0; i < n; i++) {
+        ASSERT_EQ(dst0[i], 2.f);
+        ASSERT_EQ(dst1[i], 0.f);
+    }
+}
+
+TEST(stream_test_cpp_t, OutOfOrderGemmConvolution) {
+    engine eng(engine::kind::cpu, 0);
+    SKIP_IF(!are_valid_flags(dnnl_cpu, dnnl_stream_out_of_order),
+            "Incompatible stream flags.");
+    stream s(eng, stream::flags::out_of_order);
+    stream s_ref(eng);
+
+    // Plain layouts make the library pick a gemm-based convolution, which
+    // keeps its scratchpad in a per-thread global buffer by default.
+    const memory::dim mb = 2, c = 16, hw = 14;
+    memory::desc data_md({mb, c, hw, hw}, memory::data_type::f32,
+            memory::format_tag::nchw);
+    memory::desc wei_md(
+            {c, c, 3, 3}, memory::data_type::f32, memory::format_tag::oihw);
+    auto pd = convolution_forward::primitive_desc(eng, prop_kind::forward,
+            algorithm::convolution_direct, data_md, wei_md, data_md,
+            {1, 1}, {1, 1}, {1, 1});
+    auto conv = convolution_forward(pd);
+
+    auto fill = [](memory &m, int mod) {
+        auto *ptr = static_cast<float *>(m.get_data_handle());
+        const size_t nelems = m.get_desc().get_size() / sizeof(float);
+        for (size_t i = 0; i < nelems; i++)
+            ptr[i] = (float)((int)(i % mod) - mod / 2);
+    };
+    memory wei(wei_md, eng);
+    fill(wei, 5);
+
+    // Independent convolutions run concurrently, the last one depends on
+    // the first one.
+    const int n = 4;
+    std::vector<memory> src, dst, dst_ref;
+    for (int i = 0; i < n; i++) {
+        src.emplace_back(data_md, eng);
+        dst.emplace_back(data_md, eng);
+        dst_ref.emplace_back(data_md, eng);
+        fill(src.back(), 7 + i);
+    }
+    memory chained(data_md, eng), chained_ref(data_md, eng);
+
+    for (int i = 0; i < n; i++)
+        conv.execute(s,
+                {{DNNL_ARG_SRC, src[i]}, {DNNL_ARG_WEIGHTS, wei},
+                        {DNNL_ARG_DST, dst[i]}});
+    conv.execute(s,
+            {{DNNL_ARG_SRC, dst[0]}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_DST, chained}});
+    s.wait();
+
+    for (int i = 0; i < n; i++)
+        conv.execute(s_ref,
+                {{DNNL_ARG_SRC, src[i]}, {DNNL_ARG_WEIGHTS, wei},
+                        {DNNL_ARG_DST, dst_ref[i]}});
+    conv.execute(s_ref,
+            {{DNNL_ARG_SRC, dst_ref[0]}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_DST, chained_ref}});
+    s_ref.wait();
+
+    auto check = [](const memory &m, const memory &m_ref) {
+        const auto *ptr = static_cast<const float *>(m.get_data_handle());
+        const auto *ref = static_cast<const float *>(m_ref.get_data_handle());
+        const size_t nelems = m.get_desc().get_size() / sizeof(float);
+        for (size_t i = 0; i < nelems; i++)
+            ASSERT_EQ(ptr[i], ref[i]);
+    };
+    for (int i = 0; i < n; i++)
+        check(dst[i], dst_ref[i]);
+    check(chained, chained_ref);
+}
+#endif
+
 namespace {
 struct print_to_string_param_name_t {
     template <class ParamType>
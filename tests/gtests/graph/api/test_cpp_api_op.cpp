@@ -55,6 +55,7 @@ TEST(APIOp, CreateAllOps) {
             op::kind::DynamicQuantize,
             op::kind::Elu,
             op::kind::EluBackward,
+            op::kind::EmbeddingBag,
             op::kind::End,
             op::kind::Exp,
             op::kind::GELU,
@@ -113,6 +114,8 @@ TEST(APIOp, CreateAllOps) {
             op::kind::HardSigmoidBackward,
             op::kind::Select,
             op::kind::Pow,
+            op::kind::RotaryEmbedding,
+            op::kind::TopK,
     };
     // clang-format on
 
@@ -14,6 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "interface/partition.hpp"
@@ -114,6 +117,144 @@ TEST(CompiledPartition, Relu) {
     }
 }
 
+TEST(CompiledPartition, ReluDynamicShape) {
+    graph::engine_t *eng = get_engine();
+
+    graph::op_t relu_op(graph::op_kind::ReLU, "relu");
+
+    const graph::logical_tensor_t lt_in = utils::logical_tensor_init(
+            /* tid= */ 1, {-1, 1, 3, 3}, graph::data_type::f32);
+    const graph::logical_tensor_t lt_out
+            = utils::logical_tensor_init(/* tid= */ 2, {-1, 1, 3, 3},
+                    graph::data_type::f32, graph::layout_type::any);
+
+    relu_op.add_input(lt_in);
+    relu_op.add_output(lt_out);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&relu_op);
+    g.finalize();
+    run_all_passes(g);
+
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> lt_inputs {&lt_in};
+    std::vector<const graph::logical_tensor_t *> lt_outputs {&lt_out};
+    ASSERT_EQ(p.compile(&cp, lt_inputs, lt_outputs, eng),
+            graph::status::success);
+
+    graph::stream_t *strm = get_stream();
+    // Execute with different batch sizes, and the first one again to hit the
+    // per-shape cache.
+    for (graph::dim_t mb : {2, 5, 2}) {
+        const size_t nelems = static_cast<size_t>(mb) * 9;
+        test::vector<float> data_in(nelems);
+        test::vector<float> data_out(nelems);
+        for (size_t i = 0; i < nelems; i++) {
+            data_in[i] = static_cast<float>(i) - static_cast<float>(nelems / 2);
+        }
+
+        const graph::logical_tensor_t exec_lt_in = utils::logical_tensor_init(
+                /* tid= */ 1, {mb, 1, 3, 3}, graph::data_type::f32);
+        const graph::logical_tensor_t exec_lt_out = utils::logical_tensor_init(
+                /* tid= */ 2, {mb, 1, 3, 3}, graph::data_type::f32);
+        graph::tensor_t t_in(exec_lt_in, eng, data_in.data()),
+                t_out(exec_lt_out, eng, data_out.data());
+
+        EXPECT_SUCCESS(cp.execute(strm, {t_in}, {t_out}));
+        strm->wait();
+
+        for (size_t i = 0; i < nelems; i++) {
+            ASSERT_FLOAT_EQ(std::max(data_in[i], 0.f), data_out[i]);
+        }
+    }
+}
+
+TEST(CompiledPartition, ReluDynamicShapeConcurrentFirstExecution) {
+    graph::engine_t *eng = get_engine();
+
+    graph::op_t relu_op(graph::op_kind::ReLU, "relu");
+
+    const graph::logical_tensor_t lt_in = utils::logical_tensor_init(
+            /* tid= */ 1, {-1, 1, 3, 3}, graph::data_type::f32);
+    const graph::logical_tensor_t lt_out
+            = utils::logical_tensor_init(/* tid= */ 2, {-1, 1, 3, 3},
+                    graph::data_type::f32, graph::layout_type::any);
+
+    relu_op.add_input(lt_in);
+    relu_op.add_output(lt_out);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&relu_op);
+    g.finalize();
+    run_all_passes(g);
+
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    graph::partition_t p;
+    p.init(part);
+    graph::compiled_partition_t cp(p);
+
+    // A rank unknown at the compilation can't be executed and is rejected
+    // there.
+    const graph::logical_tensor_t lt_in_any_rank
+            = utils::logical_tensor_init(/* tid= */ 1, graph::data_type::f32,
+                    graph::layout_type::strided);
+    std::vector<const graph::logical_tensor_t *> lt_bad_inputs {
+            &lt_in_any_rank};
+    std::vector<const graph::logical_tensor_t *> lt_outputs {&lt_out};
+    graph::compiled_partition_t bad_cp(p);
+    ASSERT_NE(p.compile(&bad_cp, lt_bad_inputs, lt_outputs, eng),
+            graph::status::success);
+
+    std::vector<const graph::logical_tensor_t *> lt_inputs {&lt_in};
+    ASSERT_EQ(p.compile(&cp, lt_inputs, lt_outputs, eng),
+            graph::status::success);
+
+    // The threads executing with the same new shape at once share one
+    // compilation of the kernel.
+    const graph::dim_t mb = 3;
+    const size_t nelems = static_cast<size_t>(mb) * 9;
+    test::vector<float> data_in(nelems);
+    for (size_t i = 0; i < nelems; i++) {
+        data_in[i] = static_cast<float>(i) - static_cast<float>(nelems / 2);
+    }
+    const graph::logical_tensor_t exec_lt_in = utils::logical_tensor_init(
+            /* tid= */ 1, {mb, 1, 3, 3}, graph::data_type::f32);
+    const graph::logical_tensor_t exec_lt_out = utils::logical_tensor_init(
+            /* tid= */ 2, {mb, 1, 3, 3}, graph::data_type::f32);
+
+    const int nthr = 4;
+    std::vector<test::vector<float>> data_out(
+            nthr, test::vector<float>(nelems));
+    std::vector<graph::status_t> statuses(nthr, graph::status::success);
+    graph::stream_t *strm = get_stream();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < nthr; t++) {
+        workers.emplace_back([&, t]() {
+            graph::tensor_t t_in(exec_lt_in, eng, data_in.data()),
+                    t_out(exec_lt_out, eng, data_out[t].data());
+            statuses[t] = cp.execute(strm, {t_in}, {t_out});
+        });
+    }
+    for (auto &w : workers)
+        w.join();
+    strm->wait();
+
+    for (int t = 0; t < nthr; t++) {
+        ASSERT_EQ(statuses[t], graph::status::success);
+        for (size_t i = 0; i < nelems; i++) {
+            ASSERT_FLOAT_EQ(std::max(data_in[i], 0.f), data_out[t][i]);
+        }
+    }
+}
+
 TEST(CompiledPartition, SearchRequiredInputsOutputs) {
     graph::engine_t *eng = get_engine();
 
@@ -19,6 +19,12 @@
 
 #include "gtest/gtest.h"
 
+#include "backend/dnnl/passes/layout_propagation.hpp"
+#include "backend/dnnl/passes/lower.hpp"
+#include "backend/dnnl/passes/memory_planning.hpp"
+#include "backend/dnnl/passes/utils.hpp"
+#include "backend/dnnl/subgraph.hpp"
+
 #include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
 #include "graph/unit/unit_test_common.hpp"
 #include "graph/unit/utils.hpp"
@@ -155,7 +161,10 @@ INSTANTIATE_TEST_SUITE_P(Execute, concat_t,
                         {1, 2, 2, 2}, {1, 2, 2, 2}, {1, 2, 2, 4}, 3, false},
                 // 4D, axis = -1
                 concat_params_t {
-                        {1, 2, 2, 2}, {1, 2, 2, 2}, {1, 2, 2, 4}, -1, false}));
+                        {1, 2, 2, 2}, {1, 2, 2, 2}, {1, 2, 2, 4}, -1, false},
+                // 4D, axis = 2, different sizes on concat axis
+                concat_params_t {
+                        {1, 3, 2, 5}, {1, 3, 4, 5}, {1, 3, 6, 5}, 2, false}));
 
 TEST(Compile, ConcatWithMoreInputs) {
     size_t num_inputs = 64;
@@ -417,3 +426,112 @@ TEST(Execute, ConcatEmptyInput) {
             graph::status::success);
     strm->wait();
 }
+
+TEST(Execute, ConcatInputsAsViewsOfOutput) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "Concat views are supported on CPU only.");
+
+    // 4D concat runs in acdb, so the plain inputs are reordered by ops of
+    // the partition, which write into the output directly when the batch
+    // is 1.
+    std::vector<graph::dim_t> src0_dims {1, 3, 2, 5},
+            src1_dims {1, 3, 4, 5}, dst_dims {1, 3, 6, 5};
+    const int64_t axis = 2;
+
+    graph::op_t concat_op(graph::op_kind::Concat, "concat");
+    concat_op.set_attr<int64_t>(graph::op_attr::axis, axis);
+    auto src0_lt = utils::logical_tensor_init(
+            0, src0_dims, graph::data_type::f32, graph::layout_type::strided);
+    auto src1_lt = utils::logical_tensor_init(
+            1, src1_dims, graph::data_type::f32, graph::layout_type::strided);
+    auto dst_lt = utils::logical_tensor_init(
+            2, dst_dims, graph::data_type::f32, graph::layout_type::strided);
+    concat_op.add_input(src0_lt);
+    concat_op.add_input(src1_lt);
+    concat_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&concat_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("concat_pass");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+
+    // The concat of the planned subgraph doesn't copy anything.
+    dnnl::engine p_eng = graph::dnnl_impl::make_dnnl_engine(*eng);
+    auto subgraph = std::make_shared<graph::dnnl_impl::subgraph_t>(
+            part->get_ops(), p_eng, graph::fpmath_mode::strict, false, true);
+    ASSERT_EQ(graph::dnnl_impl::set_given_inputs_outputs(
+                      subgraph, {src0_lt, src1_lt}, {dst_lt}),
+            graph::status::success);
+    graph::dnnl_impl::memory_planner_t memory_planner;
+    graph::dnnl_impl::subgraph_visualizer_t vis(
+            part->id(), [](const graph::value_t *val) {
+                (void)val;
+                return std::string();
+            });
+    graph::dnnl_impl::pass_pipeline_t pipeline(vis, true, false);
+    pipeline.add_pass(graph::dnnl_impl::lower_down, "lower_down");
+    pipeline.add_pass(
+            graph::dnnl_impl::layout_propagation, "layout_propagation");
+    pipeline.add_pass(
+            [&](std::shared_ptr<graph::dnnl_impl::subgraph_t> &sg) {
+                return memory_planner.run(sg);
+            },
+            "memory_plan");
+    ASSERT_EQ(pipeline.run(subgraph), graph::status::success);
+
+    size_t num_concats = 0;
+    for (const auto &op : subgraph->get_ops()) {
+        if (op->get_kind() != graph::dnnl_impl::op_kind::dnnl_concat)
+            continue;
+        ++num_concats;
+        ASSERT_TRUE(op->get_attr<bool>(graph::dnnl_impl::op_attr::is_inplace));
+        for (const auto &in_val : op->get_input_values())
+            ASSERT_EQ(in_val->get_producer().get_kind(),
+                    graph::dnnl_impl::op_kind::dnnl_reorder);
+    }
+    ASSERT_EQ(num_concats, 1U);
+    ASSERT_EQ(memory_planner.get_exec_args_set().get_mems_use_views().size(),
+            2U);
+
+    // The partition computes the same values through the views.
+    graph::partition_t p;
+    p.init(part);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {&src0_lt, &src1_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    test::vector<float> src0_data(product(src0_dims));
+    test::vector<float> src1_data(product(src1_dims));
+    test::vector<float> dst_data(product(dst_dims), 0.f);
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> f32_distribution(0.0f, 1.0f);
+    std::generate(src0_data.begin(), src0_data.end(),
+            [&]() { return f32_distribution(generator); });
+    std::generate(src1_data.begin(), src1_data.end(),
+            [&]() { return f32_distribution(generator); });
+
+    graph::tensor_t src0_ts(src0_lt, eng, src0_data.data());
+    graph::tensor_t src1_ts(src1_lt, eng, src1_data.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst_data.data());
+    graph::stream_t *strm = get_stream();
+    ASSERT_EQ(cp.execute(strm, {src0_ts, src1_ts}, {dst_ts}),
+            graph::status::success);
+    strm->wait();
+
+    const graph::dim_t C = dst_dims[1], H = dst_dims[2], W = dst_dims[3];
+    const graph::dim_t H0 = src0_dims[2], H1 = src1_dims[2];
+    for (graph::dim_t c = 0; c < C; ++c)
+        for (graph::dim_t h = 0; h < H; ++h)
+            for (graph::dim_t w = 0; w < W; ++w) {
+                const float ref = h < H0
+                        ? src0_data[(c * H0 + h) * W + w]
+                        : src1_data[(c * H1 + h - H0) * W + w];
+                ASSERT_FLOAT_EQ(dst_data[(c * H + h) * W + w], ref);
+            }
+}
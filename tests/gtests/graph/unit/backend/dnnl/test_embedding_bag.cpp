@@ -0,0 +1,201 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+namespace {
+
+// Reference embedding bag of a dense (N, C) table. Without offsets, each index
+// makes a bag.
+void ref_embedding_bag(const std::vector<float> &src,
+        const std::vector<int32_t> &indices,
+        const std::vector<int32_t> &offsets, std::vector<float> &dst, size_t C,
+        bool mean) {
+    const size_t nbags = offsets.empty() ? indices.size() : offsets.size();
+    for (size_t b = 0; b < nbags; ++b) {
+        const size_t begin = offsets.empty() ? b : offsets[b];
+        const size_t end = offsets.empty()
+                ? b + 1
+                : (b + 1 < nbags ? offsets[b + 1] : indices.size());
+        for (size_t c = 0; c < C; ++c) {
+            float acc = 0.f;
+            for (size_t j = begin; j < end; ++j)
+                acc += src[indices[j] * C + c];
+            if (mean && end > begin) acc /= static_cast<float>(end - begin);
+            dst[b * C + c] = acc;
+        }
+    }
+}
+
+} // namespace
+
+TEST(Execute, EmbeddingBagMean) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "EmbeddingBag is supported on CPU only.");
+
+    const graph::dim_t N = 50, C = 37;
+    // The third bag is empty.
+    std::vector<int32_t> indices {3, 7, 7, 49, 0, 12, 5};
+    std::vector<int32_t> offsets {0, 2, 4, 4};
+    const graph::dim_t nindices = static_cast<graph::dim_t>(indices.size());
+    const graph::dim_t nbags = static_cast<graph::dim_t>(offsets.size());
+    std::vector<float> src(N * C), dst(nbags * C), ref(nbags * C);
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::generate(src.begin(), src.end(),
+            [&]() { return distribution(generator); });
+
+    graph::op_t bag_op(graph::op_kind::EmbeddingBag, "embedding_bag");
+    bag_op.set_attr<std::string>(graph::op_attr::mode, "mean");
+
+    auto src_lt = utils::logical_tensor_init(0, {N, C}, graph::data_type::f32);
+    auto indices_lt
+            = utils::logical_tensor_init(1, {nindices}, graph::data_type::s32);
+    auto offsets_lt
+            = utils::logical_tensor_init(2, {nbags}, graph::data_type::s32);
+    auto dst_lt
+            = utils::logical_tensor_init(3, {nbags, C}, graph::data_type::f32);
+    bag_op.add_input(src_lt);
+    bag_op.add_input(indices_lt);
+    bag_op.add_input(offsets_lt);
+    bag_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&bag_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("embedding_bag_pass");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &indices_lt, &offsets_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t src_ts(src_lt, eng, src.data());
+    graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+    graph::tensor_t offsets_ts(offsets_lt, eng, offsets.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+    ASSERT_EQ(cp.execute(strm, {src_ts, indices_ts, offsets_ts}, {dst_ts}),
+            graph::status::success);
+    strm->wait();
+
+    ref_embedding_bag(src, indices, offsets, ref, C, true);
+    for (size_t i = 0; i < dst.size(); ++i)
+        ASSERT_NEAR(dst[i], ref[i], 1e-5f);
+}
+
+TEST(Execute, EmbeddingBagMatmulFusion) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "EmbeddingBag is supported on CPU only.");
+
+    const graph::dim_t N = 20, C = 16, O = 8;
+    std::vector<int32_t> indices {1, 4, 19, 4, 0, 9};
+    std::vector<int32_t> offsets {0, 3, 5};
+    const graph::dim_t nindices = static_cast<graph::dim_t>(indices.size());
+    const graph::dim_t nbags = static_cast<graph::dim_t>(offsets.size());
+    std::vector<float> src(N * C), wei(C * O), dst(nbags * O);
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::generate(src.begin(), src.end(),
+            [&]() { return distribution(generator); });
+    std::generate(wei.begin(), wei.end(),
+            [&]() { return distribution(generator); });
+
+    graph::op_t bag_op(0, graph::op_kind::EmbeddingBag, "embedding_bag");
+    graph::op_t matmul_op(1, graph::op_kind::MatMul, "matmul");
+    graph::op_t relu_op(2, graph::op_kind::ReLU, "relu");
+
+    auto src_lt = utils::logical_tensor_init(0, {N, C}, graph::data_type::f32);
+    auto indices_lt
+            = utils::logical_tensor_init(1, {nindices}, graph::data_type::s32);
+    auto offsets_lt
+            = utils::logical_tensor_init(2, {nbags}, graph::data_type::s32);
+    auto bag_dst_lt
+            = utils::logical_tensor_init(3, {nbags, C}, graph::data_type::f32);
+    auto wei_lt = utils::logical_tensor_init(4, {C, O}, graph::data_type::f32);
+    auto mm_dst_lt
+            = utils::logical_tensor_init(5, {nbags, O}, graph::data_type::f32);
+    auto dst_lt
+            = utils::logical_tensor_init(6, {nbags, O}, graph::data_type::f32);
+
+    bag_op.add_input(src_lt);
+    bag_op.add_input(indices_lt);
+    bag_op.add_input(offsets_lt);
+    bag_op.add_output(bag_dst_lt);
+    matmul_op.add_input(bag_dst_lt);
+    matmul_op.add_input(wei_lt);
+    matmul_op.add_output(mm_dst_lt);
+    relu_op.add_input(mm_dst_lt);
+    relu_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&bag_op);
+    g.add_op(&matmul_op);
+    g.add_op(&relu_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass
+            = get_pass("embedding_bag_matmul_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    ASSERT_EQ(g.get_partitions()[0]->get_ops().size(), 3U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &indices_lt, &offsets_lt, &wei_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t src_ts(src_lt, eng, src.data());
+    graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+    graph::tensor_t offsets_ts(offsets_lt, eng, offsets.data());
+    graph::tensor_t wei_ts(wei_lt, eng, wei.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+    ASSERT_EQ(cp.execute(strm, {src_ts, indices_ts, offsets_ts, wei_ts},
+                      {dst_ts}),
+            graph::status::success);
+    strm->wait();
+
+    std::vector<float> bag(nbags * C);
+    ref_embedding_bag(src, indices, offsets, bag, C, false);
+    for (graph::dim_t b = 0; b < nbags; ++b)
+        for (graph::dim_t o = 0; o < O; ++o) {
+            float acc = 0.f;
+            for (graph::dim_t c = 0; c < C; ++c)
+                acc += bag[b * C + c] * wei[c * O + o];
+            ASSERT_NEAR(dst[b * O + o], std::max(acc, 0.f), 1e-4f);
+        }
+}
@@ -0,0 +1,245 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "common/bfloat16.hpp"
+#include "common/float16.hpp"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+namespace {
+
+// Reference dense (M, K) x (K, N) matmul.
+std::vector<float> ref_matmul(const std::vector<float> &src,
+        const std::vector<float> &wei, size_t M, size_t K, size_t N) {
+    std::vector<float> dst(M * N, 0.f);
+    for (size_t m = 0; m < M; ++m)
+        for (size_t n = 0; n < N; ++n)
+            for (size_t k = 0; k < K; ++k)
+                dst[m * N + n] += src[m * K + k] * wei[k * N + n];
+    return dst;
+}
+
+// Rounds the data to the data type in place and returns it in the memory
+// format of the data type.
+std::vector<char> to_dt(std::vector<float> &v, graph::data_type_t dt) {
+    if (dt == graph::data_type::f32) {
+        std::vector<char> bytes(v.size() * sizeof(float));
+        std::memcpy(bytes.data(), v.data(), bytes.size());
+        return bytes;
+    }
+    std::vector<char> bytes(v.size() * sizeof(uint16_t));
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (dt == graph::data_type::bf16) {
+            const dnnl::impl::bfloat16_t b = v[i];
+            v[i] = b;
+            std::memcpy(bytes.data() + i * sizeof(b), &b, sizeof(b));
+        } else {
+            const dnnl::impl::float16_t h = v[i];
+            v[i] = h;
+            std::memcpy(bytes.data() + i * sizeof(h), &h, sizeof(h));
+        }
+    }
+    return bytes;
+}
+
+float from_dt(
+        const std::vector<char> &bytes, size_t i, graph::data_type_t dt) {
+    if (dt == graph::data_type::bf16) {
+        dnnl::impl::bfloat16_t b;
+        std::memcpy(&b, bytes.data() + i * sizeof(b), sizeof(b));
+        return b;
+    }
+    if (dt == graph::data_type::f16) {
+        dnnl::impl::float16_t h;
+        std::memcpy(&h, bytes.data() + i * sizeof(h), sizeof(h));
+        return h;
+    }
+    float f;
+    std::memcpy(&f, bytes.data() + i * sizeof(f), sizeof(f));
+    return f;
+}
+
+// Builds, compiles and executes silu(x * W1) * (x * W3) [* W2] and checks the
+// result against the reference. The executions after the first one reuse the
+// weights packed to the constant cache, if any.
+void run_gated_mlp(bool with_down, bool constant_weights, int num_execs,
+        graph::data_type_t dt = graph::data_type::f32) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+
+    const graph::dim_t B = 2, S = 3, K = 16, N = 24, O = 8;
+    const graph::dim_t M = B * S;
+    std::vector<float> src(M * K), w1(K * N), w3(K * N), w2(N * O);
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    for (auto *v : {&src, &w1, &w3, &w2})
+        std::generate(v->begin(), v->end(),
+                [&]() { return distribution(generator); });
+    std::vector<char> src_data = to_dt(src, dt), w1_data = to_dt(w1, dt),
+                      w3_data = to_dt(w3, dt), w2_data = to_dt(w2, dt);
+
+    graph::op_t gate_op(0, graph::op_kind::MatMul, "gate");
+    graph::op_t sigmoid_op(1, graph::op_kind::Sigmoid, "sigmoid");
+    graph::op_t silu_op(2, graph::op_kind::Multiply, "silu");
+    graph::op_t up_op(3, graph::op_kind::MatMul, "up");
+    graph::op_t mul_op(4, graph::op_kind::Multiply, "mul");
+    graph::op_t down_op(5, graph::op_kind::MatMul, "down");
+
+    auto src_lt = utils::logical_tensor_init(0, {B, S, K}, dt);
+    auto w1_lt = utils::logical_tensor_init(1, {K, N}, dt);
+    auto w3_lt = utils::logical_tensor_init(2, {K, N}, dt);
+    auto w2_lt = utils::logical_tensor_init(3, {N, O}, dt);
+    if (constant_weights) {
+        w1_lt.property = graph::property_type::constant;
+        w3_lt.property = graph::property_type::constant;
+        w2_lt.property = graph::property_type::constant;
+    }
+    auto gate_dst_lt = utils::logical_tensor_init(4, {B, S, N}, dt);
+    auto sigmoid_dst_lt = utils::logical_tensor_init(5, {B, S, N}, dt);
+    auto silu_dst_lt = utils::logical_tensor_init(6, {B, S, N}, dt);
+    auto up_dst_lt = utils::logical_tensor_init(7, {B, S, N}, dt);
+    auto mul_dst_lt = utils::logical_tensor_init(8, {B, S, N}, dt);
+    auto down_dst_lt = utils::logical_tensor_init(9, {B, S, O}, dt);
+
+    gate_op.add_input(src_lt);
+    gate_op.add_input(w1_lt);
+    gate_op.add_output(gate_dst_lt);
+    sigmoid_op.add_input(gate_dst_lt);
+    sigmoid_op.add_output(sigmoid_dst_lt);
+    silu_op.add_input(gate_dst_lt);
+    silu_op.add_input(sigmoid_dst_lt);
+    silu_op.add_output(silu_dst_lt);
+    up_op.add_input(src_lt);
+    up_op.add_input(w3_lt);
+    up_op.add_output(up_dst_lt);
+    mul_op.add_input(silu_dst_lt);
+    mul_op.add_input(up_dst_lt);
+    mul_op.add_output(mul_dst_lt);
+    down_op.add_input(mul_dst_lt);
+    down_op.add_input(w2_lt);
+    down_op.add_output(down_dst_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&gate_op);
+    g.add_op(&sigmoid_op);
+    g.add_op(&silu_op);
+    g.add_op(&up_op);
+    g.add_op(&mul_op);
+    if (with_down) g.add_op(&down_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("gated_mlp_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    ASSERT_EQ(g.get_partitions()[0]->get_ops().size(), with_down ? 6U : 5U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    const graph::logical_tensor_t &dst_lt
+            = with_down ? down_dst_lt : mul_dst_lt;
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &w1_lt, &w3_lt};
+    if (with_down) inputs.emplace_back(&w2_lt);
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    std::vector<graph::tensor_t> ins;
+    for (const auto &lt : p.get_inputs()) {
+        void *handle = nullptr;
+        switch (lt.id) {
+            case 0: handle = src_data.data(); break;
+            case 1: handle = w1_data.data(); break;
+            case 2: handle = w3_data.data(); break;
+            case 3: handle = w2_data.data(); break;
+            default: FAIL() << "unexpected input";
+        }
+        for (const auto *given : inputs)
+            if (given->id == lt.id) ins.emplace_back(*given, eng, handle);
+    }
+
+    std::vector<float> h = ref_matmul(src, w1, M, K, N);
+    const std::vector<float> up = ref_matmul(src, w3, M, K, N);
+    for (size_t i = 0; i < h.size(); ++i)
+        h[i] = h[i] / (1.f + std::exp(-h[i])) * up[i];
+    const std::vector<float> ref = with_down ? ref_matmul(h, w2, M, N, O) : h;
+
+    // the low precision results are rounded at the intermediates
+    const float tol = dt == graph::data_type::f32
+            ? 1e-4f
+            : (dt == graph::data_type::bf16 ? 5e-2f : 5e-3f);
+    for (int i = 0; i < num_execs; ++i) {
+        std::vector<char> dst(
+                ref.size() * (dt == graph::data_type::f32 ? 4 : 2), 0);
+        graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+        ASSERT_EQ(cp.execute(strm, ins, {dst_ts}), graph::status::success);
+        strm->wait();
+        for (size_t j = 0; j < ref.size(); ++j)
+            ASSERT_NEAR(from_dt(dst, j, dt), ref[j],
+                    tol * std::max(1.f, std::fabs(ref[j])));
+    }
+}
+
+} // namespace
+
+TEST(Execute, GatedMlpConstantWeights) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "Gated MLP fusion is supported on CPU only.");
+    run_gated_mlp(true, true, 2);
+}
+
+TEST(Execute, GatedMlpWithoutDownProjection) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "Gated MLP fusion is supported on CPU only.");
+    run_gated_mlp(false, false, 1);
+}
+
+TEST(Execute, GatedMlpNonConstantWeights) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "Gated MLP fusion is supported on CPU only.");
+    run_gated_mlp(true, false, 2);
+}
+
+TEST(Execute, GatedMlpBf16) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "Gated MLP fusion is supported on CPU only.");
+    SKIP_IF(dnnl_get_effective_cpu_isa() < dnnl_cpu_isa_avx512_core,
+            "Skip bf16 tests for systems that do not support avx512_core.");
+    run_gated_mlp(true, true, 2, graph::data_type::bf16);
+    run_gated_mlp(true, false, 1, graph::data_type::bf16);
+    run_gated_mlp(false, false, 1, graph::data_type::bf16);
+}
+
+TEST(Execute, GatedMlpF16) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "Gated MLP fusion is supported on CPU only.");
+    SKIP_IF(dnnl_get_effective_cpu_isa() < dnnl_cpu_isa_avx512_core_fp16,
+            "Skip f16 tests for systems that do not support "
+            "avx512_core_fp16.");
+    run_gated_mlp(true, true, 2, graph::data_type::f16);
+    run_gated_mlp(false, false, 1, graph::data_type::f16);
+}
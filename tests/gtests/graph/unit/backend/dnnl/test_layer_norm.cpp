@@ -472,3 +472,120 @@ TEST(ExecuteSubgraphInt8, LayernormTypecastQuant) {
         ASSERT_FLOAT_EQ(ref_data[i], dst_data[i]);
     }
 }
+
+namespace {
+void test_dequant_layernorm_quant(float dq_scale) {
+    graph::engine_t *engine = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(engine->kind() == graph::engine_kind::gpu,
+            "Skip for GPU - not supported yet");
+
+    std::vector<int64_t> layernorm_shape {2, 4, 32};
+    std::vector<int64_t> scale_lt_shape {32};
+    std::vector<int64_t> shift_lt_shape {32};
+    test::vector<int8_t> src_data(product(layernorm_shape));
+    test::vector<float> scale(product(scale_lt_shape));
+    test::vector<float> shift(product(shift_lt_shape));
+
+    // random seed = 7
+    std::default_random_engine generator(7);
+    std::uniform_int_distribution<int> src_distribution(-64, 64);
+    std::uniform_real_distribution<float> ss_distribution(-1.f, 1.f);
+    std::generate(src_data.begin(), src_data.end(),
+            [&]() { return static_cast<int8_t>(src_distribution(generator)); });
+    std::generate(scale.begin(), scale.end(),
+            [&]() { return ss_distribution(generator); });
+    std::generate(shift.begin(), shift.end(),
+            [&]() { return ss_distribution(generator); });
+
+    graph::op_t dequantize(0, graph::op_kind::Dequantize, "dequantize");
+    dequantize.set_attr<std::vector<float>>(graph::op_attr::scales, {dq_scale});
+    dequantize.set_attr<std::vector<int64_t>>(graph::op_attr::zps, {0});
+    dequantize.set_attr<std::string>(graph::op_attr::qtype, "per_tensor");
+    graph::op_t layernorm_op(1, graph::op_kind::LayerNorm, "layernorm");
+    layernorm_op.set_attr<float>(graph::op_attr::epsilon, 1e-5f);
+    layernorm_op.set_attr<bool>(graph::op_attr::keep_stats, false); //inference
+    graph::op_t quantize(2, graph::op_kind::Quantize, "quantize");
+    quantize.set_attr<std::vector<float>>(graph::op_attr::scales, {0.03f});
+    quantize.set_attr<std::vector<int64_t>>(graph::op_attr::zps, {0});
+    quantize.set_attr<std::string>(graph::op_attr::qtype, "per_tensor");
+
+    // prepare logical tensor
+    graph::logical_tensor_t src = utils::logical_tensor_init(
+            0, layernorm_shape, graph::data_type::s8);
+    graph::logical_tensor_t dq_dst = utils::logical_tensor_init(
+            1, layernorm_shape, graph::data_type::f32);
+    graph::logical_tensor_t scale_lt = utils::logical_tensor_init(
+            2, scale_lt_shape, graph::data_type::f32);
+    graph::logical_tensor_t shift_lt = utils::logical_tensor_init(
+            3, shift_lt_shape, graph::data_type::f32);
+    graph::logical_tensor_t layernorm_dst = utils::logical_tensor_init(
+            4, layernorm_shape, graph::data_type::f32);
+    graph::logical_tensor_t quant_dst = utils::logical_tensor_init(
+            5, layernorm_shape, graph::data_type::s8);
+
+    dequantize.add_input(src);
+    dequantize.add_output(dq_dst);
+    layernorm_op.add_input(dq_dst);
+    layernorm_op.add_input(scale_lt);
+    layernorm_op.add_input(shift_lt);
+    layernorm_op.add_output(layernorm_dst);
+    quantize.add_input(layernorm_dst);
+    quantize.add_output(quant_dst);
+
+    graph::graph_t g(engine->kind());
+    ASSERT_EQ(g.add_op(&dequantize), graph::status::success);
+    ASSERT_EQ(g.add_op(&layernorm_op), graph::status::success);
+    ASSERT_EQ(g.add_op(&quantize), graph::status::success);
+    ASSERT_EQ(g.finalize(), graph::status::success);
+
+    graph::pass::pass_base_ptr apass = get_pass("int8_layernorm_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+    ASSERT_EQ(part->get_ops().size(), 3U);
+
+    // compile
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> lt_ins {
+            &src, &scale_lt, &shift_lt};
+    std::vector<const graph::logical_tensor_t *> lt_outs {&quant_dst};
+
+    ASSERT_EQ(p.compile(&cp, lt_ins, lt_outs, engine), graph::status::success);
+
+    test::vector<int8_t> dst_data(product(layernorm_shape));
+    test::vector<int8_t> ref_data(product(layernorm_shape));
+
+    graph::tensor_t src_ts(src, engine, src_data.data());
+    graph::tensor_t scale_ts(scale_lt, engine, scale.data());
+    graph::tensor_t shift_ts(shift_lt, engine, shift.data());
+    graph::tensor_t dst_ts(quant_dst, engine, dst_data.data());
+    graph::tensor_t ref_ts(quant_dst, engine, ref_data.data());
+
+    ASSERT_EQ(run_graph(g, {src_ts, scale_ts, shift_ts}, {ref_ts}, *engine,
+                      *strm),
+            graph::status::success);
+    ASSERT_EQ(cp.execute(strm, {src_ts, scale_ts, shift_ts}, {dst_ts}),
+            graph::status::success);
+    strm->wait();
+    // the fused kernel may round differently at quantization boundaries
+    for (size_t i = 0; i < ref_data.size(); ++i) {
+        ASSERT_LE(std::abs(static_cast<int>(ref_data[i])
+                          - static_cast<int>(dst_data[i])),
+                1);
+    }
+}
+} // namespace
+
+TEST(ExecuteSubgraphInt8, DequantLayernormQuant) {
+    test_dequant_layernorm_quant(0.05f);
+}
+
+TEST(ExecuteSubgraphInt8, DequantLayernormQuantNegativeScale) {
+    // layernorm(s * x) = -layernorm(x) for s < 0, so the scale is not folded
+    test_dequant_layernorm_quant(-0.05f);
+}
@@ -0,0 +1,430 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+namespace {
+
+// Reference rotary embedding of a dense (rows, C) tensor with heads of D
+// channels, the rows of cos/sin being the positions.
+void ref_rope(const std::vector<float> &src, std::vector<float> &dst,
+        const std::vector<float> &cos, const std::vector<float> &sin,
+        size_t rows, size_t C, size_t D, bool interleaved) {
+    const size_t half = D / 2;
+    for (size_t r = 0; r < rows; ++r)
+        for (size_t h = 0; h < C / D; ++h)
+            for (size_t i = 0; i < half; ++i) {
+                const size_t i0 = r * C + h * D + (interleaved ? 2 * i : i);
+                const size_t i1 = i0 + (interleaved ? 1 : half);
+                const float c = cos[r * half + i], s = sin[r * half + i];
+                dst[i0] = src[i0] * c - src[i1] * s;
+                dst[i1] = src[i1] * c + src[i0] * s;
+            }
+}
+
+void fill_rope_table(std::vector<float> &cos, std::vector<float> &sin,
+        size_t S, size_t half, size_t start_pos) {
+    for (size_t s = 0; s < S; ++s)
+        for (size_t i = 0; i < half; ++i) {
+            const float theta = static_cast<float>(start_pos + s)
+                    * std::pow(10000.f, -2.f * i / (2 * half));
+            cos[s * half + i] = std::cos(theta);
+            sin[s * half + i] = std::sin(theta);
+        }
+}
+
+} // namespace
+
+TEST(Execute, RotaryEmbeddingInterleaved) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "RotaryEmbedding is supported on CPU only.");
+
+    const size_t B = 2, S = 3, H = 2, D = 8;
+    std::vector<float> src(B * S * H * D), dst(src.size()), ref(src.size());
+    std::vector<float> cos(S * D / 2), sin(S * D / 2);
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::generate(src.begin(), src.end(),
+            [&]() { return distribution(generator); });
+    fill_rope_table(cos, sin, S, D / 2, 0);
+
+    graph::op_t rope_op(graph::op_kind::RotaryEmbedding, "rope");
+    rope_op.set_attr<std::string>(graph::op_attr::mode, "interleaved");
+
+    auto src_lt = utils::logical_tensor_init(0,
+            {(graph::dim_t)B, (graph::dim_t)S, (graph::dim_t)(H * D)},
+            graph::data_type::f32);
+    auto cos_lt = utils::logical_tensor_init(
+            1, {(graph::dim_t)S, (graph::dim_t)(D / 2)}, graph::data_type::f32);
+    auto sin_lt = utils::logical_tensor_init(
+            2, {(graph::dim_t)S, (graph::dim_t)(D / 2)}, graph::data_type::f32);
+    auto dst_lt = utils::logical_tensor_init(3,
+            {(graph::dim_t)B, (graph::dim_t)S, (graph::dim_t)(H * D)},
+            graph::data_type::f32);
+    rope_op.add_input(src_lt);
+    rope_op.add_input(cos_lt);
+    rope_op.add_input(sin_lt);
+    rope_op.add_output(dst_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&rope_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("rotary_embedding_pass");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &cos_lt, &sin_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&dst_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t src_ts(src_lt, eng, src.data());
+    graph::tensor_t cos_ts(cos_lt, eng, cos.data());
+    graph::tensor_t sin_ts(sin_lt, eng, sin.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+    ASSERT_EQ(cp.execute(strm, {src_ts, cos_ts, sin_ts}, {dst_ts}),
+            graph::status::success);
+    strm->wait();
+
+    // The table rows are the positions, the same for every batch.
+    for (size_t b = 0; b < B; ++b) {
+        std::vector<float> src_b(src.begin() + b * S * H * D,
+                src.begin() + (b + 1) * S * H * D);
+        std::vector<float> ref_b(src_b.size());
+        ref_rope(src_b, ref_b, cos, sin, S, H * D, D, true);
+        std::copy(ref_b.begin(), ref_b.end(), ref.begin() + b * S * H * D);
+    }
+    for (size_t i = 0; i < dst.size(); ++i)
+        ASSERT_NEAR(dst[i], ref[i], 1e-5f);
+}
+
+TEST(Execute, MatmulRopeKvCacheAppendInPlace) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "RotaryEmbedding is supported on CPU only.");
+
+    // A cache of max_len positions with past_len of them filled, appended
+    // with S new positions of H heads of D channels.
+    const graph::dim_t max_len = 8, past_len = 3, S = 2, K = 16, H = 2, D = 4;
+    const graph::dim_t C = H * D;
+    std::vector<float> src(S * K), wei(K * C), cos(S * D / 2), sin(S * D / 2);
+    std::vector<float> cache(max_len * C);
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::generate(src.begin(), src.end(),
+            [&]() { return distribution(generator); });
+    std::generate(wei.begin(), wei.end(),
+            [&]() { return distribution(generator); });
+    std::generate(cache.begin(), cache.end(),
+            [&]() { return distribution(generator); });
+    fill_rope_table(cos, sin, S, D / 2, past_len);
+    const std::vector<float> cache_orig = cache;
+
+    graph::op_t matmul_op(0, graph::op_kind::MatMul, "matmul");
+    graph::op_t rope_op(1, graph::op_kind::RotaryEmbedding, "rope");
+    graph::op_t concat_op(2, graph::op_kind::Concat, "concat");
+    concat_op.set_attr<int64_t>(graph::op_attr::axis, 1);
+
+    auto src_lt = utils::logical_tensor_init(
+            0, {1, S, K}, graph::data_type::f32);
+    auto wei_lt = utils::logical_tensor_init(1, {K, C}, graph::data_type::f32);
+    auto mm_dst_lt = utils::logical_tensor_init(
+            2, {1, S, C}, graph::data_type::f32);
+    auto cos_lt = utils::logical_tensor_init(
+            3, {S, D / 2}, graph::data_type::f32);
+    auto sin_lt = utils::logical_tensor_init(
+            4, {S, D / 2}, graph::data_type::f32);
+    auto rope_dst_lt = utils::logical_tensor_init(
+            5, {1, S, C}, graph::data_type::f32);
+    // The past and the present cache are views of the same buffer.
+    auto past_lt = utils::logical_tensor_init(6, {1, past_len, C},
+            {max_len * C, C, 1}, graph::data_type::f32);
+    auto present_lt = utils::logical_tensor_init(7, {1, past_len + S, C},
+            {max_len * C, C, 1}, graph::data_type::f32);
+
+    matmul_op.add_input(src_lt);
+    matmul_op.add_input(wei_lt);
+    matmul_op.add_output(mm_dst_lt);
+    rope_op.add_input(mm_dst_lt);
+    rope_op.add_input(cos_lt);
+    rope_op.add_input(sin_lt);
+    rope_op.add_output(rope_dst_lt);
+    concat_op.add_input(past_lt);
+    concat_op.add_input(rope_dst_lt);
+    concat_op.add_output(present_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&matmul_op);
+    g.add_op(&rope_op);
+    g.add_op(&concat_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("matmul_rope_kv_cache_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    ASSERT_EQ(g.get_partitions()[0]->get_ops().size(), 3U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &wei_lt, &cos_lt, &sin_lt, &past_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&present_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    std::vector<graph::tensor_t> ins;
+    for (const auto &lt : p.get_inputs()) {
+        void *handle = nullptr;
+        switch (lt.id) {
+            case 0: handle = src.data(); break;
+            case 1: handle = wei.data(); break;
+            case 3: handle = cos.data(); break;
+            case 4: handle = sin.data(); break;
+            case 6: handle = cache.data(); break;
+            default: FAIL() << "unexpected input";
+        }
+        for (const auto *given : inputs)
+            if (given->id == lt.id) ins.emplace_back(*given, eng, handle);
+    }
+    graph::tensor_t present_ts(present_lt, eng, cache.data());
+    ASSERT_EQ(cp.execute(strm, ins, {present_ts}), graph::status::success);
+    strm->wait();
+
+    std::vector<float> mm(S * C, 0.f), ref(S * C);
+    for (graph::dim_t m = 0; m < S; ++m)
+        for (graph::dim_t n = 0; n < C; ++n)
+            for (graph::dim_t k = 0; k < K; ++k)
+                mm[m * C + n] += src[m * K + k] * wei[k * C + n];
+    ref_rope(mm, ref, cos, sin, S, C, D, false);
+
+    for (graph::dim_t i = 0; i < max_len * C; ++i) {
+        const graph::dim_t pos = i / C;
+        if (pos >= past_len && pos < past_len + S)
+            ASSERT_NEAR(cache[i], ref[i - past_len * C], 1e-4f);
+        else
+            ASSERT_EQ(cache[i], cache_orig[i]);
+    }
+}
+
+TEST(Execute, MatmulRopeKvCacheUnknownPastLength) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "RotaryEmbedding is supported on CPU only.");
+
+    // One partition compiled without the length of the past cache appends
+    // to a preallocated cache of max_len positions step by step.
+    const graph::dim_t max_len = 8, S = 2, K = 16, H = 2, D = 4;
+    const graph::dim_t C = H * D;
+    std::vector<float> src(S * K), wei(K * C), cos(S * D / 2), sin(S * D / 2);
+    std::vector<float> cache(max_len * C);
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::generate(wei.begin(), wei.end(),
+            [&]() { return distribution(generator); });
+    std::generate(cache.begin(), cache.end(),
+            [&]() { return distribution(generator); });
+
+    graph::op_t matmul_op(0, graph::op_kind::MatMul, "matmul");
+    graph::op_t rope_op(1, graph::op_kind::RotaryEmbedding, "rope");
+    graph::op_t concat_op(2, graph::op_kind::Concat, "concat");
+    concat_op.set_attr<int64_t>(graph::op_attr::axis, 1);
+
+    auto src_lt = utils::logical_tensor_init(
+            0, {1, S, K}, graph::data_type::f32);
+    auto wei_lt = utils::logical_tensor_init(1, {K, C}, graph::data_type::f32);
+    auto mm_dst_lt = utils::logical_tensor_init(
+            2, {1, S, C}, graph::data_type::f32);
+    auto cos_lt = utils::logical_tensor_init(
+            3, {S, D / 2}, graph::data_type::f32);
+    auto sin_lt = utils::logical_tensor_init(
+            4, {S, D / 2}, graph::data_type::f32);
+    auto rope_dst_lt = utils::logical_tensor_init(
+            5, {1, S, C}, graph::data_type::f32);
+    auto past_lt = utils::logical_tensor_init(
+            6, {1, -1, C}, {max_len * C, C, 1}, graph::data_type::f32);
+    auto present_lt = utils::logical_tensor_init(
+            7, {1, -1, C}, {max_len * C, C, 1}, graph::data_type::f32);
+
+    matmul_op.add_input(src_lt);
+    matmul_op.add_input(wei_lt);
+    matmul_op.add_output(mm_dst_lt);
+    rope_op.add_input(mm_dst_lt);
+    rope_op.add_input(cos_lt);
+    rope_op.add_input(sin_lt);
+    rope_op.add_output(rope_dst_lt);
+    concat_op.add_input(past_lt);
+    concat_op.add_input(rope_dst_lt);
+    concat_op.add_output(present_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&matmul_op);
+    g.add_op(&rope_op);
+    g.add_op(&concat_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("matmul_rope_kv_cache_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &wei_lt, &cos_lt, &sin_lt, &past_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&present_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    for (graph::dim_t past_len : {3, 5}) {
+        std::generate(src.begin(), src.end(),
+                [&]() { return distribution(generator); });
+        fill_rope_table(cos, sin, S, D / 2, past_len);
+        const std::vector<float> cache_orig = cache;
+
+        auto past_rt_lt = utils::logical_tensor_init(6, {1, past_len, C},
+                {max_len * C, C, 1}, graph::data_type::f32);
+        auto present_rt_lt = utils::logical_tensor_init(7,
+                {1, past_len + S, C}, {max_len * C, C, 1},
+                graph::data_type::f32);
+        std::vector<graph::tensor_t> ins;
+        for (const auto &lt : p.get_inputs()) {
+            switch (lt.id) {
+                case 0: ins.emplace_back(src_lt, eng, src.data()); break;
+                case 1: ins.emplace_back(wei_lt, eng, wei.data()); break;
+                case 3: ins.emplace_back(cos_lt, eng, cos.data()); break;
+                case 4: ins.emplace_back(sin_lt, eng, sin.data()); break;
+                case 6: ins.emplace_back(past_rt_lt, eng, cache.data()); break;
+                default: FAIL() << "unexpected input";
+            }
+        }
+        graph::tensor_t present_ts(present_rt_lt, eng, cache.data());
+        ASSERT_EQ(cp.execute(strm, ins, {present_ts}), graph::status::success);
+        strm->wait();
+
+        std::vector<float> mm(S * C, 0.f), ref(S * C);
+        for (graph::dim_t m = 0; m < S; ++m)
+            for (graph::dim_t n = 0; n < C; ++n)
+                for (graph::dim_t k = 0; k < K; ++k)
+                    mm[m * C + n] += src[m * K + k] * wei[k * C + n];
+        ref_rope(mm, ref, cos, sin, S, C, D, false);
+
+        for (graph::dim_t i = 0; i < max_len * C; ++i) {
+            const graph::dim_t pos = i / C;
+            if (pos >= past_len && pos < past_len + S)
+                ASSERT_NEAR(cache[i], ref[i - past_len * C], 1e-4f);
+            else
+                ASSERT_EQ(cache[i], cache_orig[i]);
+        }
+    }
+}
+
+TEST(Execute, MatmulRopeKvCacheAliasedPastLayoutMismatch) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "RotaryEmbedding is supported on CPU only.");
+
+    // The past tensor shares the buffer of the present cache but not its
+    // layout, so the past rows can't be copied in place.
+    const graph::dim_t max_len = 8, past_len = 3, S = 2, K = 16, H = 2, D = 4;
+    const graph::dim_t C = H * D;
+    std::vector<float> src(S * K, 1.f), wei(K * C, 1.f), cos(S * D / 2),
+            sin(S * D / 2);
+    std::vector<float> cache(max_len * C, 0.f);
+    fill_rope_table(cos, sin, S, D / 2, past_len);
+
+    graph::op_t matmul_op(0, graph::op_kind::MatMul, "matmul");
+    graph::op_t rope_op(1, graph::op_kind::RotaryEmbedding, "rope");
+    graph::op_t concat_op(2, graph::op_kind::Concat, "concat");
+    concat_op.set_attr<int64_t>(graph::op_attr::axis, 1);
+
+    auto src_lt = utils::logical_tensor_init(
+            0, {1, S, K}, graph::data_type::f32);
+    auto wei_lt = utils::logical_tensor_init(1, {K, C}, graph::data_type::f32);
+    auto mm_dst_lt = utils::logical_tensor_init(
+            2, {1, S, C}, graph::data_type::f32);
+    auto cos_lt = utils::logical_tensor_init(
+            3, {S, D / 2}, graph::data_type::f32);
+    auto sin_lt = utils::logical_tensor_init(
+            4, {S, D / 2}, graph::data_type::f32);
+    auto rope_dst_lt = utils::logical_tensor_init(
+            5, {1, S, C}, graph::data_type::f32);
+    auto past_lt = utils::logical_tensor_init(6, {1, past_len, C},
+            {past_len * C, 1, past_len}, graph::data_type::f32);
+    auto present_lt = utils::logical_tensor_init(7, {1, past_len + S, C},
+            {max_len * C, C, 1}, graph::data_type::f32);
+
+    matmul_op.add_input(src_lt);
+    matmul_op.add_input(wei_lt);
+    matmul_op.add_output(mm_dst_lt);
+    rope_op.add_input(mm_dst_lt);
+    rope_op.add_input(cos_lt);
+    rope_op.add_input(sin_lt);
+    rope_op.add_output(rope_dst_lt);
+    concat_op.add_input(past_lt);
+    concat_op.add_input(rope_dst_lt);
+    concat_op.add_output(present_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&matmul_op);
+    g.add_op(&rope_op);
+    g.add_op(&concat_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("matmul_rope_kv_cache_fusion");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {
+            &src_lt, &wei_lt, &cos_lt, &sin_lt, &past_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {&present_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    std::vector<graph::tensor_t> ins;
+    for (const auto &lt : p.get_inputs()) {
+        switch (lt.id) {
+            case 0: ins.emplace_back(src_lt, eng, src.data()); break;
+            case 1: ins.emplace_back(wei_lt, eng, wei.data()); break;
+            case 3: ins.emplace_back(cos_lt, eng, cos.data()); break;
+            case 4: ins.emplace_back(sin_lt, eng, sin.data()); break;
+            case 6: ins.emplace_back(past_lt, eng, cache.data()); break;
+            default: FAIL() << "unexpected input";
+        }
+    }
+    graph::tensor_t present_ts(present_lt, eng, cache.data());
+    ASSERT_EQ(cp.execute(strm, ins, {present_ts}),
+            graph::status::invalid_arguments);
+}
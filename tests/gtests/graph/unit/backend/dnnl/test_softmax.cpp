@@ -441,6 +441,90 @@ TEST(ExecuteSubgraphInt8, SoftmaxTypecastQuant) {
     }
 }
 
+TEST(ExecuteSubgraphInt8, DequantSoftmaxQuant) {
+    graph::engine_t *engine = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(engine->kind() == graph::engine_kind::gpu,
+            "Skip for GPU - not supported yet");
+
+    std::vector<int64_t> softmax_shape {2, 4, 16};
+    test::vector<int8_t> src_data(product(softmax_shape));
+
+    // random seed = 7
+    std::default_random_engine generator(7);
+    std::uniform_int_distribution<int> src_distribution(-64, 64);
+    std::generate(src_data.begin(), src_data.end(),
+            [&]() { return static_cast<int8_t>(src_distribution(generator)); });
+
+    graph::op_t dequantize(0, graph::op_kind::Dequantize, "dequantize");
+    dequantize.set_attr<std::vector<float>>(graph::op_attr::scales, {0.05f});
+    dequantize.set_attr<std::vector<int64_t>>(graph::op_attr::zps, {0});
+    dequantize.set_attr<std::string>(graph::op_attr::qtype, "per_tensor");
+    graph::op_t softmax_op(1, graph::op_kind::SoftMax, "softmax");
+    softmax_op.set_attr<int64_t>(graph::op_attr::axis, 2);
+    graph::op_t quantize(2, graph::op_kind::Quantize, "quantize");
+    quantize.set_attr<std::vector<float>>(graph::op_attr::scales, {0.004f});
+    quantize.set_attr<std::vector<int64_t>>(graph::op_attr::zps, {0});
+    quantize.set_attr<std::string>(graph::op_attr::qtype, "per_tensor");
+
+    // prepare logical tensor
+    graph::logical_tensor_t src = utils::logical_tensor_init(
+            0, softmax_shape, graph::data_type::s8);
+    graph::logical_tensor_t dq_dst = utils::logical_tensor_init(
+            1, softmax_shape, graph::data_type::f32);
+    graph::logical_tensor_t softmax_dst = utils::logical_tensor_init(
+            2, softmax_shape, graph::data_type::f32);
+    graph::logical_tensor_t quant_dst = utils::logical_tensor_init(
+            3, softmax_shape, graph::data_type::u8);
+
+    dequantize.add_input(src);
+    dequantize.add_output(dq_dst);
+    softmax_op.add_input(dq_dst);
+    softmax_op.add_output(softmax_dst);
+    quantize.add_input(softmax_dst);
+    quantize.add_output(quant_dst);
+
+    graph::graph_t g(engine->kind());
+    ASSERT_EQ(g.add_op(&dequantize), graph::status::success);
+    ASSERT_EQ(g.add_op(&softmax_op), graph::status::success);
+    ASSERT_EQ(g.add_op(&quantize), graph::status::success);
+    ASSERT_EQ(g.finalize(), graph::status::success);
+
+    graph::pass::pass_base_ptr apass = get_pass("int8_softmax_fusion_cpu");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+    auto part = g.get_partitions()[0];
+    ASSERT_EQ(part->get_ops().size(), 3U);
+
+    // compile
+    graph::partition_t p;
+    p.init(part);
+
+    graph::compiled_partition_t cp(p);
+
+    std::vector<const graph::logical_tensor_t *> lt_ins {&src};
+    std::vector<const graph::logical_tensor_t *> lt_outs {&quant_dst};
+
+    ASSERT_EQ(p.compile(&cp, lt_ins, lt_outs, engine), graph::status::success);
+
+    test::vector<uint8_t> dst_data(product(softmax_shape));
+    test::vector<uint8_t> ref_data(product(softmax_shape));
+    graph::tensor_t src_ts(src, engine, src_data.data());
+    graph::tensor_t dst_ts(quant_dst, engine, dst_data.data());
+    graph::tensor_t ref_ts(quant_dst, engine, ref_data.data());
+
+    ASSERT_EQ(run_graph(g, {src_ts}, {ref_ts}, *engine, *strm),
+            graph::status::success);
+    ASSERT_EQ(cp.execute(strm, {src_ts}, {dst_ts}), graph::status::success);
+    strm->wait();
+    // the fused kernel may round differently at quantization boundaries
+    for (size_t i = 0; i < ref_data.size(); ++i) {
+        ASSERT_LE(std::abs(static_cast<int>(ref_data[i])
+                          - static_cast<int>(dst_data[i])),
+                1);
+    }
+}
+
 TEST(Compile, SoftmaxAdd) {
     graph::engine_t *engine = get_engine();
     graph::stream_t *strm = get_stream();
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/dnnl/dnnl_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+TEST(Execute, TopKLastAxis) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "TopK is supported on CPU only.");
+
+    const graph::dim_t rows = 3, C = 200, K = 5;
+    std::vector<float> src(rows * C), dst(rows * K);
+    std::vector<int32_t> indices(rows * K);
+    std::default_random_engine generator(7);
+    std::uniform_int_distribution<int> distribution(-20, 20);
+    std::generate(src.begin(), src.end(),
+            [&]() { return static_cast<float>(distribution(generator)); });
+
+    graph::op_t topk_op(graph::op_kind::TopK, "topk");
+    topk_op.set_attr<int64_t>(graph::op_attr::axis, -1);
+    topk_op.set_attr<int64_t>(graph::op_attr::k, K);
+
+    auto src_lt = utils::logical_tensor_init(
+            0, {rows, C}, graph::data_type::f32);
+    auto dst_lt = utils::logical_tensor_init(
+            1, {rows, K}, graph::data_type::f32);
+    auto indices_lt = utils::logical_tensor_init(
+            2, {rows, K}, graph::data_type::s32);
+    topk_op.add_input(src_lt);
+    topk_op.add_output(dst_lt);
+    topk_op.add_output(indices_lt);
+
+    graph::graph_t g(eng->kind());
+    g.add_op(&topk_op);
+    g.finalize();
+
+    graph::pass::pass_base_ptr apass = get_pass("topk_pass");
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    graph::compiled_partition_t cp(p);
+    std::vector<const graph::logical_tensor_t *> inputs {&src_lt};
+    std::vector<const graph::logical_tensor_t *> outputs {
+            &dst_lt, &indices_lt};
+    ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+    graph::tensor_t src_ts(src_lt, eng, src.data());
+    graph::tensor_t dst_ts(dst_lt, eng, dst.data());
+    graph::tensor_t indices_ts(indices_lt, eng, indices.data());
+    ASSERT_EQ(cp.execute(strm, {src_ts}, {dst_ts, indices_ts}),
+            graph::status::success);
+    strm->wait();
+
+    // The larger values go first, the equal ones in the order of the indices.
+    std::vector<int32_t> order(C);
+    for (graph::dim_t r = 0; r < rows; ++r) {
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+            return src[r * C + a] > src[r * C + b];
+        });
+        for (graph::dim_t j = 0; j < K; ++j) {
+            ASSERT_EQ(indices[r * K + j], order[j]);
+            ASSERT_EQ(dst[r * K + j], src[r * C + order[j]]);
+        }
+    }
+}
@@ -550,3 +550,87 @@ TEST(GCCore_batch_matmul_test, TestBatchGemmFWDBERTu8s8_V2) {
                     datatypes::u8, datatypes::s8, false},
             cfg_fwd);
 }
+
+// Checks the matmul op with B broadcast over the trailing batch dims of A,
+// which the lowering folds into M, against the reference. B is given as
+// [..., N, K] if trans_b.
+static void check_folded_bcast_matmul(const sc_dims &A_dims,
+        const sc_dims &B_dims, bool trans_b, bool with_bias) {
+    BUILTIN_REQUIRE_AVX512();
+    const size_t ndims = A_dims.size();
+    const int M = A_dims[ndims - 2];
+    const int K = A_dims[ndims - 1];
+    const int N = B_dims[ndims - (trans_b ? 2 : 1)];
+    const sc_dims batch_dims {A_dims.begin(), A_dims.end() - 2};
+    sc_dims out_dims = batch_dims;
+    out_dims.insert(out_dims.end(), {M, N});
+
+    sc_graph_t graph;
+    auto data = graph.make_input({graph_tensor::make(A_dims)});
+    auto weight = graph.make_input({graph_tensor::make(B_dims)});
+    std::vector<graph_tensor_ptr> ins {
+            data->get_outputs()[0], weight->get_outputs()[0]};
+    std::vector<sc_op_ptr> args {data, weight};
+    if (with_bias) {
+        auto bias = graph.make_input({graph_tensor::make({N})});
+        ins.emplace_back(bias->get_outputs()[0]);
+        args.emplace_back(bias);
+    }
+    auto matmul = graph.make("matmul", ins, {}, {{"transpose_b", trans_b}});
+    EXPECT_EQ(matmul->get_outputs()[0]->details_.get_plain_dims(), out_dims);
+    auto output = graph.make_output(matmul->get_outputs());
+    args.insert(args.begin(), output);
+
+    auto ctx = get_test_ctx();
+    graph_driver(graph, ctx);
+    auto f = lower_graph(ctx, graph, args);
+    auto fptr = jit_engine_t::make(ctx)->get_entry_func(f);
+
+    auto A = alloc_array<float>(cal_size(A_dims));
+    auto B = alloc_array<float>(cal_size(B_dims));
+    auto bias = alloc_array<float>(N);
+    auto out = alloc_array<float>(cal_size(out_dims), INIT_NOOP);
+    if (with_bias) {
+        fptr->call_default(&out[0], &A[0], &B[0], &bias[0]);
+    } else {
+        fptr->call_default(&out[0], &A[0], &B[0]);
+    }
+
+    std::vector<float> ref_out(cal_size(out_dims));
+    const int batch_size = cal_size(batch_dims);
+    gemm_params gemm_param {
+            false, trans_b, M, N, K, 1.0, 0.0, K, trans_b ? K : N, N};
+    for (int b = 0; b < batch_size; b++) {
+        // the index of the B matrix, which is 0 over the broadcast dims
+        int b_w = 0, stride_w = 1;
+        for (int d = static_cast<int>(ndims) - 3, idx = b; d >= 0; --d) {
+            if (B_dims[d] != 1) b_w += idx % A_dims[d] * stride_w;
+            stride_w *= B_dims[d];
+            idx /= A_dims[d];
+        }
+        ref_gemm(gemm_param, &A[b * M * K], &B[b_w * K * N],
+                &ref_out[b * M * N], with_bias ? &bias[0] : nullptr);
+    }
+    test_utils::compare_data(
+            out.data(), ref_out.data(), ref_out.size(), 1e-4, 1e-4);
+}
+
+// grouped-query attention: a key/value head is shared by 4 query heads
+TEST(GCCore_batch_matmul_test, TestFoldedBcastMatmulGQA) {
+    check_folded_bcast_matmul(
+            {2, 2, 4, 32, 64}, {2, 2, 1, 64, 48}, false, false);
+}
+
+// multi-query attention: one key/value head is shared by all query heads
+TEST(GCCore_batch_matmul_test, TestFoldedBcastMatmulMQA) {
+    check_folded_bcast_matmul({2, 8, 32, 64}, {2, 1, 64, 48}, false, false);
+}
+
+TEST(GCCore_batch_matmul_test, TestFoldedBcastMatmulTransB) {
+    check_folded_bcast_matmul(
+            {2, 2, 4, 32, 64}, {2, 2, 1, 48, 64}, true, false);
+}
+
+TEST(GCCore_batch_matmul_test, TestFoldedBcastMatmulBias) {
+    check_folded_bcast_matmul({2, 8, 32, 64}, {2, 1, 48, 64}, true, true);
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "context.hpp"
+#include "gtest/gtest.h"
+#include <compiler/ir/graph/driver.hpp>
+#include <compiler/ir/graph/graph.hpp>
+#include <compiler/ir/graph/lowering.hpp>
+#include <compiler/ir/graph/pass/graph_constant_cache.hpp>
+#include <compiler/ir/graph/pass/pass.hpp>
+#include <compiler/jit/jit.hpp>
+#include <util/utils.hpp>
+
+using namespace dnnl::impl::graph::gc;
+
+static constexpr int M = 32, N = 64;
+
+struct const_cache_capacity_guard_t {
+    size_t old_;
+    const_cache_capacity_guard_t(size_t capacity) {
+        auto &cfg = utils::compiler_configs_t::get();
+        old_ = cfg.const_cache_capacity_;
+        cfg.const_cache_capacity_ = capacity;
+    }
+    ~const_cache_capacity_guard_t() {
+        utils::compiler_configs_t::get().const_cache_capacity_ = old_;
+    }
+};
+
+// compiles out = in + relu(weight), where weight is a constant input with a
+// fixed tensor id, so that relu(weight) is folded into the shared cache. The
+// graphs of the same non-zero scope promise the same weight
+static std::shared_ptr<jit_function_t> compile_const_graph(size_t scope) {
+    sc_graph_t graph;
+    if (scope) { graph.attrs_[attr_keys::shared_const_scope] = scope; }
+    auto in = graph.make_input({graph_tensor::make({M, N})});
+    auto weight = graph.make_input({graph_tensor::make({M, N})},
+            {{"constant", const_kind::local_const},
+                    {"temp.tensor_id", size_t(0x7fff1234)}});
+    auto relu = graph.make("relu", weight->get_outputs(), {}, {});
+    auto add = graph.make(
+            "add", {in->get_outputs()[0], relu->get_outputs()[0]}, {}, {});
+    auto out = graph.make_output(add->get_outputs());
+    auto ctx = get_test_ctx();
+    graph_driver(graph, ctx);
+    auto mod = lower_graph(
+            ctx, graph, std::vector<sc_op_ptr> {out, in, weight});
+    return jit_engine_t::make(ctx)->get_entry_func(mod);
+}
+
+// if the module skips folding, as its constants are already folded by the
+// modules of the same scope
+static bool skips_folding(const std::shared_ptr<jit_function_t> &f) {
+    auto mod = f->get_module();
+    return !mod->shared_globals_.empty() && mod->shared_const_guards_.empty();
+}
+
+static void run_const_graph(const std::shared_ptr<jit_function_t> &f,
+        std::vector<float> &out, std::vector<float> &in,
+        std::vector<float> &weight) {
+    std::vector<generic_val> args = {out.data(), in.data(), weight.data()};
+    f->call_generic_default(args.data());
+}
+
+TEST(GCCore_graph_constant_cache_cpp, TestShareFoldedConstAcrossModules) {
+    const_cache_capacity_guard_t guard {1024 * 1024};
+    const size_t scope = 0x5c09e, other_scope = 0x5c09f;
+
+    std::vector<float> in(M * N), weight(M * N), other_weight(M * N);
+    std::vector<float> out(M * N), expected(M * N), other_expected(M * N);
+    for (int i = 0; i < M * N; i++) {
+        in[i] = float(i % 7);
+        weight[i] = float(i % 5) - 2.f;
+        other_weight[i] = float(i % 3);
+        expected[i] = in[i] + std::max(weight[i], 0.f);
+        other_expected[i] = in[i] + other_weight[i];
+    }
+    {
+        auto hits = get_const_cache_stats().hits_;
+        auto f1 = compile_const_graph(scope);
+        auto f2 = compile_const_graph(scope);
+        // the second module reuses the folded tensor of the first one
+        EXPECT_GT(get_const_cache_stats().hits_, hits);
+        EXPECT_FALSE(skips_folding(f1));
+        EXPECT_FALSE(skips_folding(f2));
+
+        run_const_graph(f1, out, in, weight);
+        EXPECT_EQ(out, expected);
+
+        // the modules of the same scope compiled after the tensor is folded
+        // skip folding
+        auto f3 = compile_const_graph(scope);
+        EXPECT_TRUE(skips_folding(f3));
+        std::fill(out.begin(), out.end(), 0.f);
+        run_const_graph(f3, out, in, weight);
+        EXPECT_EQ(out, expected);
+
+        // the modules of other scopes or without a scope fold their own
+        // weight, even if it has the same tensor id
+        auto f4 = compile_const_graph(other_scope);
+        EXPECT_FALSE(skips_folding(f4));
+        run_const_graph(f4, out, in, other_weight);
+        EXPECT_EQ(out, other_expected);
+        auto f5 = compile_const_graph(0);
+        EXPECT_FALSE(skips_folding(f5));
+        run_const_graph(f5, out, in, weight);
+        EXPECT_EQ(out, expected);
+    }
+    // the folded tensor is kept after all modules are released, and reused by
+    // the next compilation. It was last folded by a module without a scope,
+    // so that the module folds again
+    EXPECT_GT(get_const_cache_stats().unused_bytes_, 0UL);
+    {
+        auto hits = get_const_cache_stats().hits_;
+        auto f6 = compile_const_graph(scope);
+        EXPECT_GT(get_const_cache_stats().hits_, hits);
+        EXPECT_FALSE(skips_folding(f6));
+        std::fill(out.begin(), out.end(), 0.f);
+        run_const_graph(f6, out, in, weight);
+        EXPECT_EQ(out, expected);
+        EXPECT_TRUE(skips_folding(compile_const_graph(scope)));
+    }
+
+    auto evictions = get_const_cache_stats().evictions_;
+    utils::compiler_configs_t::get().const_cache_capacity_ = 0;
+    trim_const_cache();
+    auto stats = get_const_cache_stats();
+    EXPECT_EQ(stats.unused_bytes_, 0UL);
+    EXPECT_GT(stats.evictions_, evictions);
+}
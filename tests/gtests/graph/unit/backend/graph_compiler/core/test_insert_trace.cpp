@@ -28,6 +28,8 @@ namespace impl {
 namespace graph {
 namespace gc {
 extern int get_last_trace_func_id();
+extern bool get_traced_func_info(
+        int id, std::string &graph_ops, int64_t &arg_bytes);
 
 }
 } // namespace graph
@@ -102,3 +104,30 @@ TEST(GCCore_insert_trace, TestInsertTrace) {
     EXPECT_TRUE(cmper.compare(outmod->get_contents()[1], eccc2));
     EXPECT_TRUE(cmper.compare(outmod->get_contents()[2], eccc3));
 }
+
+TEST(GCCore_insert_trace, TestInsertTraceGraphOps) {
+    builder::ir_builder_t builder;
+    _function_(datatypes::void_t, ccc1, _arg_("A", datatypes::f32, {10000})) {
+        _bind_(A);
+        A[1010] = A[3010];
+    }
+    _function_(datatypes::void_t, ccc2, _arg_("A", datatypes::f32, {10000})) {
+        _bind_(A);
+        A[1010] = A[3010];
+    }
+    ccc1->attr()[function_attrs::graph_op_ids]
+            = std::string("MatMul:1,ReLU:2");
+    ccc1->attr()[function_attrs::arg_bytes] = INT64_C(40000);
+
+    ir_module_ptr mod = std::make_shared<ir_module_t>(get_default_context());
+    mod->add_func({ccc1, ccc2});
+    trace_inserter_t()(mod);
+
+    int func_id = get_last_trace_func_id();
+    std::string graph_ops;
+    int64_t arg_bytes = 0;
+    ASSERT_TRUE(get_traced_func_info(func_id - 1, graph_ops, arg_bytes));
+    EXPECT_EQ(graph_ops, "MatMul:1,ReLU:2");
+    EXPECT_EQ(arg_bytes, 40000);
+    EXPECT_FALSE(get_traced_func_info(func_id, graph_ops, arg_bytes));
+}
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <numeric>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "context.hpp"
+#include "test_utils.hpp"
+#include "gtest/gtest.h"
+#include <compiler/ir/graph/driver.hpp>
+#include <compiler/ir/graph/lowering.hpp>
+#include <compiler/jit/jit.hpp>
+#include <compiler/jit/module_cache.hpp>
+#if SC_CFAKE_JIT_ENABLED
+#include <compiler/jit/cfake/cfake_jit.hpp>
+#endif
+
+using namespace dnnl::impl::graph::gc;
+
+// sets the cache dir in the scope and restores it on exit
+struct cache_dir_guard_t {
+    std::string old_dir_;
+    cache_dir_guard_t(const std::string &dir) {
+        auto &cfg = utils::compiler_configs_t::get();
+        old_dir_ = cfg.jit_cache_dir_;
+        cfg.jit_cache_dir_ = dir;
+    }
+    ~cache_dir_guard_t() {
+        utils::compiler_configs_t::get().jit_cache_dir_ = old_dir_;
+    }
+};
+
+static void remove_cache_entry(const std::string &key) {
+    auto base_path = module_cache::get_entry_path(key);
+    for (auto ext : {".so", ".data", ".meta"}) {
+        remove((base_path + ext).c_str());
+    }
+}
+
+// makes a graph of out = in0 + in1, and returns {in0 & in1, out} as the args
+static std::vector<sc_op_ptr> make_add_graph(
+        sc_graph_t &graph, const sc_dims &shape) {
+    auto in = graph.make_input(
+            {graph_tensor::make(shape), graph_tensor::make(shape)});
+    auto add = graph.make("add", in->get_outputs(), {}, {});
+    auto out = graph.make_output(add->get_outputs());
+    return {in, out};
+}
+
+TEST(GCCore_module_cache_cpp, TestCacheKey) {
+    auto ctx = get_test_ctx();
+    sc_graph_t graph1, graph2, graph3;
+    auto args1 = make_add_graph(graph1, {16, 32});
+    auto args2 = make_add_graph(graph2, {16, 32});
+    auto args3 = make_add_graph(graph3, {16, 64});
+    {
+        cache_dir_guard_t guard {""};
+        EXPECT_TRUE(module_cache::make_cache_key(graph1, args1, ctx).empty());
+    }
+    cache_dir_guard_t guard {utils::compiler_configs_t::get_temp_dir_path()};
+    auto key1 = module_cache::make_cache_key(graph1, args1, ctx);
+    EXPECT_FALSE(key1.empty());
+    EXPECT_EQ(key1, module_cache::make_cache_key(graph2, args2, ctx));
+    EXPECT_NE(key1, module_cache::make_cache_key(graph3, args3, ctx));
+    EXPECT_NE(key1,
+            module_cache::make_cache_key(
+                    graph1, {args1[1], args1[0]}, ctx));
+
+    auto ctx2 = std::make_shared<context_t>(*ctx);
+    ctx2->flags_.backend_opt_level = ctx->flags_.backend_opt_level ? 0 : 3;
+    EXPECT_NE(key1, module_cache::make_cache_key(graph1, args1, ctx2));
+
+    // entries are only found with exactly the same key
+    module_cache::entry_meta_t meta;
+    meta.entry_name_ = "main_entry";
+    meta.generic_wrapper_ = true;
+    remove_cache_entry(key1);
+    EXPECT_FALSE(module_cache::load_entry_meta(key1, meta));
+    module_cache::store_entry_meta(key1, meta);
+    module_cache::entry_meta_t loaded;
+    EXPECT_TRUE(module_cache::load_entry_meta(key1, loaded));
+    EXPECT_EQ(loaded.entry_name_, "main_entry");
+    EXPECT_TRUE(loaded.generic_wrapper_);
+    EXPECT_FALSE(loaded.managed_thread_pool_);
+    EXPECT_FALSE(module_cache::load_entry_meta(key1 + " ", loaded));
+    remove_cache_entry(key1);
+}
+
+#if SC_CFAKE_JIT_ENABLED
+TEST(GCCore_module_cache_cpp, TestCfakeJITRoundTrip) {
+    auto ctx = std::make_shared<context_t>(*get_test_ctx());
+    ctx->flags_.jit_kind_ = jit_kind::cfake;
+    cache_dir_guard_t guard {utils::compiler_configs_t::get_temp_dir_path()};
+    sc_graph_t graph;
+    auto args = make_add_graph(graph, {16, 32});
+    auto key = module_cache::make_cache_key(graph, args, ctx);
+    ASSERT_FALSE(key.empty());
+    remove_cache_entry(key);
+
+    cfake_jit engine {ctx};
+    EXPECT_EQ(engine.load_cached_entry_func(key), nullptr);
+    graph_driver(graph, ctx);
+    auto mod = lower_graph(ctx, graph, args);
+    mod->attr_[ir_module_t::attr_key_t::JIT_CACHE_KEY] = key;
+    auto compiled = engine.get_entry_func(mod, true);
+    ASSERT_TRUE(compiled);
+    auto cached = engine.load_cached_entry_func(key);
+    ASSERT_TRUE(cached);
+
+    std::vector<float> in0(16 * 32), in1(16 * 32);
+    std::iota(in0.begin(), in0.end(), 0.f);
+    std::iota(in1.begin(), in1.end(), 1.f);
+    std::vector<float> out_compiled(16 * 32), out_cached(16 * 32);
+    compiled->call_default(in0.data(), in1.data(), out_compiled.data());
+    cached->call_default(in0.data(), in1.data(), out_cached.data());
+    for (size_t i = 0; i < in0.size(); i++) {
+        EXPECT_EQ(out_cached[i], in0[i] + in1[i]);
+    }
+    test_utils::compare_data(out_cached, out_compiled);
+    remove_cache_entry(key);
+}
+#endif
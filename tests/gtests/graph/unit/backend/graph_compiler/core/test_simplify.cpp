@@ -19,7 +19,9 @@
 #include <compiler/ir/transform/auto_cast.hpp>
 #include <compiler/ir/transform/constant_fold.hpp>
 #include <compiler/ir/transform/simplify.hpp>
+#include <compiler/ir/util_module_passes.hpp>
 #include <util/any_map.hpp>
+#include <util/utils.hpp>
 
 #include <iostream>
 #include "gtest/gtest.h"
@@ -389,3 +391,49 @@ TEST(GCCore_ir_simplify, TestSimplifyIfAndElseEliminate) {
     ir_comparer cmper;
     EXPECT_TRUE(cmper.compare(out, expected));
 }
+
+TEST(GCCore_ir_simplify, TestParallelModulePass) {
+    builder::ir_builder_t builder;
+    std::vector<func_t> funcs;
+    for (int i = 0; i < 16; i++) {
+        _function_(
+                datatypes::void_t, ccc, _arg_("A", datatypes::f32, {10000})) {
+            _bind_(A);
+            _var_(aaa, datatypes::s32);
+            aaa = i;
+            builder.push_scope();
+            { A[i] = 1.0f; }
+            builder.emit(builder.pop_scope());
+            _if_(A[0] == 0) {}
+            _else_ { A[i + 1] = 0.0f; }
+        }
+        ccc->name_ += std::to_string(i);
+        funcs.emplace_back(ccc);
+    }
+    auto mod = std::make_shared<ir_module_t>(get_default_context(), funcs);
+    auto pass = module_function_pass_t::make<ir_simplifier_t>(false);
+    auto expected = (*pass)(mod);
+
+    struct compile_threads_guard_t {
+        int old_;
+        compile_threads_guard_t(int threads) {
+            old_ = utils::compiler_configs_t::get().compile_threads_;
+            utils::compiler_configs_t::get().compile_threads_ = threads;
+        }
+        ~compile_threads_guard_t() {
+            utils::compiler_configs_t::get().compile_threads_ = old_;
+        }
+    };
+    const_ir_module_ptr out;
+    {
+        compile_threads_guard_t guard {4};
+        out = (*pass)(mod);
+    }
+
+    ASSERT_EQ(out->get_contents().size(), funcs.size());
+    for (size_t i = 0; i < funcs.size(); i++) {
+        ir_comparer cmper;
+        EXPECT_TRUE(cmper.compare(
+                out->get_contents()[i], expected->get_contents()[i]));
+    }
+}
@@ -24,6 +24,7 @@
 #include <runtime/managed_thread_pool.hpp>
 #include <runtime/managed_thread_pool_exports.hpp>
 #include <runtime/parallel.hpp>
+#include <runtime/thread_pool_flags.hpp>
 #if SC_CPU_THREADPOOL == SC_THREAD_POOL_CUSTOM
 #include <test_thread.hpp>
 #define dnnl_thread_env() \
@@ -132,6 +133,37 @@ TEST(GCCore_thread_pool, TestThreadPool) {
     cfg.thread_pool_table_->set_num_threads(old_num_threads);
     EXPECT_EQ(cfg.thread_pool_table_->get_num_threads(), old_num_threads);
 }
+
+TEST(GCCore_thread_pool, TestWorkStealing) {
+    dnnl_thread_env();
+    auto &cfg = runtime_config_t::get();
+    if (!cfg.managed_thread_pool_) { return; }
+    // the jobs at the front are much slower than the others, so that the
+    // threads owning them have jobs to be stolen
+    std::vector<std::atomic<int>> v(1000);
+    auto funct = [](runtime::stream_t *s, void *mod_data,
+                         generic_val *args) noexcept {
+        runtime_config_t::get().thread_pool_table_->parallel_call_managed(
+                [](void *a, void *b, int64_t idx, generic_val *args) {
+                    std::vector<std::atomic<int>> &v
+                            = *(std::vector<std::atomic<int>> *)b;
+                    if (idx < 100) {
+                        std::this_thread::sleep_for(
+                                std::chrono::microseconds(200));
+                    }
+                    v.at(idx)++;
+                },
+                runtime::thread_pool_flags::THREAD_POOL_WORK_STEALING,
+                nullptr, mod_data, 0, 1000, 1, nullptr);
+    };
+    for (int i = 0; i < 3; i++) {
+        runtime::thread_manager::cur_mgr.run_main_function(
+                funct, nullptr, &v, nullptr);
+    }
+    for (size_t i = 0; i < v.size(); i++) {
+        ASSERT_EQ(v[i].load(), 3);
+    }
+}
 #endif
 
 #if SC_CPU_THREADPOOL != SC_THREAD_POOL_CUSTOM
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "context.hpp"
+#include "test_utils.hpp"
+#include "gtest/gtest.h"
+#include <compiler/ir/graph/driver.hpp>
+#include <compiler/ir/graph/pass/pass.hpp>
+#include <compiler/ir/graph/tunable_op.hpp>
+#include <compiler/ir/graph/tuning_db.hpp>
+#include <ops/templates/managed_matmul_core.hpp>
+#include <util/file.hpp>
+
+using namespace dnnl::impl::graph::gc;
+using ops::managed_matmul_core_config_t;
+
+// sets the tuning configs in the scope and restores them on exit
+struct tuning_cfg_guard_t {
+    std::string old_path_;
+    int old_trials_;
+    tuning_cfg_guard_t(const std::string &path, int trials) {
+        auto &cfg = utils::compiler_configs_t::get();
+        old_path_ = cfg.tuning_db_path_;
+        old_trials_ = cfg.tuning_trials_;
+        cfg.tuning_db_path_ = path;
+        cfg.tuning_trials_ = trials;
+    }
+    ~tuning_cfg_guard_t() {
+        auto &cfg = utils::compiler_configs_t::get();
+        cfg.tuning_db_path_ = old_path_;
+        cfg.tuning_trials_ = old_trials_;
+    }
+};
+
+static std::string get_temp_db_path() {
+    return utils::compiler_configs_t::get_temp_dir_path() + "/sc_tuning_"
+            + utils::get_unique_name_for_file() + ".db";
+}
+
+static sc_op_ptr make_matmul_graph(sc_graph_t &graph) {
+    auto data = graph.make_input({graph_tensor::make({64, 128})});
+    auto weight = graph.make_input({graph_tensor::make({128, 64})},
+            {{"constant", const_kind::local_const}});
+    auto mmm = graph.make("managed_matmul_core",
+            {data->get_outputs()[0], weight->get_outputs()[0]},
+            {graph_tensor::make({64, 64})}, {});
+    graph.make_output(mmm->get_outputs());
+    return mmm;
+}
+
+TEST(GCCore_tuning_db_cpp, TestRoundTrip) {
+    auto path = get_temp_db_path();
+    managed_matmul_core_config_t expected {2, 4, 1, 2, 8, 1};
+    config_ptr default_cfg = reflection::general_object_t::make(
+            managed_matmul_core_config_t {1, 1, 1, 1, 1, 0});
+    {
+        tuning_db_t db {path};
+        EXPECT_EQ(db.size(), 0UL);
+        db.store("key1", reflection::general_object_t::make(expected));
+        db.store("key2", default_cfg);
+    }
+    tuning_db_t db {path};
+    EXPECT_EQ(db.size(), 2UL);
+    config_ptr cfg;
+    EXPECT_FALSE(db.lookup("key3", default_cfg, cfg));
+    ASSERT_TRUE(db.lookup("key1", default_cfg, cfg));
+    auto &result = *cfg.get_as<managed_matmul_core_config_t>();
+    EXPECT_EQ(result.M_split_num, expected.M_split_num);
+    EXPECT_EQ(result.N_split_num, expected.N_split_num);
+    EXPECT_EQ(result.M_sub_block, expected.M_sub_block);
+    EXPECT_EQ(result.N_sub_block, expected.N_sub_block);
+    EXPECT_EQ(result.K_sub_block, expected.K_sub_block);
+    EXPECT_EQ(result.im_loop_order, expected.im_loop_order);
+    remove(path.c_str());
+}
+
+TEST(GCCore_tuning_db_cpp, TestTuneAndReuse) {
+    REQUIRE_AVX2();
+    auto ctx = get_test_ctx();
+    auto path = get_temp_db_path();
+    config_ptr tuned;
+    {
+        tuning_cfg_guard_t guard {path, 4};
+        sc_graph_t graph;
+        auto mmm = make_matmul_graph(graph);
+        graph_driver(graph, ctx);
+        tuned = mmm->stc_cast<tunable_op_t>()->get_config();
+        ASSERT_TRUE(tuned.data_);
+        EXPECT_EQ(tuning_db_t::get()->size(), 1UL);
+    }
+    {
+        // the stored config is used without tuning
+        tuning_cfg_guard_t guard {path, 0};
+        sc_graph_t graph;
+        auto mmm = make_matmul_graph(graph);
+        graph_driver(graph, ctx);
+        auto cfg = mmm->stc_cast<tunable_op_t>()->get_config();
+        EXPECT_EQ(serialize_tuning_config(cfg),
+                serialize_tuning_config(tuned));
+        EXPECT_EQ(tuning_db_t::get()->size(), 1UL);
+    }
+    remove(path.c_str());
+}
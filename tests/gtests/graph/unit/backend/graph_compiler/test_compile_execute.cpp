@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 #include "backend/graph_compiler/compiler_backend.hpp"
+#include "backend/graph_compiler/compiler_partition_impl.hpp"
 #include "interface/allocator.hpp"
 #include "interface/graph.hpp"
 #include "interface/partition.hpp"
@@ -21,8 +22,13 @@
 #include "graph/unit/unit_test_common.hpp"
 #include "test_utils.hpp"
 
+#include <chrono>
+#include <random>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <runtime/context.hpp>
+#include <util/utils.hpp>
 
 #if SC_CPU_THREADPOOL == SC_THREAD_POOL_CUSTOM
 struct gc_env_initializer {
@@ -456,6 +462,60 @@ TEST(GCGraphTest, INT8MHAAlternative4CompileExecution) {
     compile_execution_pipeline(agraph, 1);
 }
 
+TEST(GCGraphTest, FP32GQACompileExecution) {
+    REQUIRE_AVX512();
+    impl::graph_t agraph;
+    compiler_utils::add_gqa_subgraph(&agraph, false);
+    agraph.finalize();
+
+    compile_execution_pipeline(agraph, 1);
+}
+
+TEST(GCGraphTest, FP32MQACompileExecution) {
+    REQUIRE_AVX512();
+    impl::graph_t agraph;
+    compiler_utils::add_gqa_subgraph(&agraph, false, 4, 128, 1, 8);
+    agraph.finalize();
+
+    compile_execution_pipeline(agraph, 1);
+}
+
+TEST(GCGraphTest, BF16GQACompileExecution) {
+    REQUIRE_BF16_AMXBF16();
+    impl::graph_t agraph;
+    compiler_utils::add_gqa_subgraph(&agraph, true);
+    agraph.finalize();
+
+    compile_execution_pipeline(agraph, 1);
+}
+
+TEST(GCGraphTest, FP32GatedMLPCompileExecution) {
+    REQUIRE_AVX512();
+    impl::graph_t agraph;
+    compiler_utils::add_gated_mlp_subgraph(&agraph, false);
+    agraph.finalize();
+
+    compile_execution_pipeline(agraph, 1);
+}
+
+TEST(GCGraphTest, FP32GatedMLPWithoutDownCompileExecution) {
+    REQUIRE_AVX512();
+    impl::graph_t agraph;
+    compiler_utils::add_gated_mlp_subgraph(&agraph, false, false);
+    agraph.finalize();
+
+    compile_execution_pipeline(agraph, 1);
+}
+
+TEST(GCGraphTest, BF16GatedMLPCompileExecution) {
+    REQUIRE_BF16_AMXBF16();
+    impl::graph_t agraph;
+    compiler_utils::add_gated_mlp_subgraph(&agraph, true);
+    agraph.finalize();
+
+    compile_execution_pipeline(agraph, 1);
+}
+
 TEST(GCGraphTest, FP32BartMHACompileExecution) {
     REQUIRE_AVX512();
     impl::graph_t agraph;
@@ -580,6 +640,129 @@ TEST(GCGraphTest, FP32MLPDynamicGraphCompileExecution) {
                     std::placeholders::_1, std::placeholders::_2));
 }
 
+struct specialize_limit_guard_t {
+    int old_;
+    specialize_limit_guard_t(int limit) {
+        auto &cfg = dnnl::impl::graph::gc::utils::compiler_configs_t::get();
+        old_ = cfg.dynamic_specialize_limit_;
+        cfg.dynamic_specialize_limit_ = limit;
+    }
+    ~specialize_limit_guard_t() {
+        dnnl::impl::graph::gc::utils::compiler_configs_t::get()
+                .dynamic_specialize_limit_
+                = old_;
+    }
+};
+
+static void set_dense_strides(impl::logical_tensor_t &lt) {
+    lt.layout_type = impl::layout_type::strided;
+    int64_t stride = 1;
+    for (int i = lt.ndims - 1; i >= 0; --i) {
+        lt.layout.strides[i] = stride;
+        stride *= lt.dims[i];
+    }
+}
+
+TEST(GCGraphTest, FP32MLPDynamicGraphSpecializeExecution) {
+    REQUIRE_AVX512();
+    REQUIRE_AMX();
+    const int64_t batch_size = 4;
+    impl::graph_t agraph;
+    compiler_utils::add_mlp_subgraph(&agraph, false, -1, 5,
+            {479, 1024, 1024, 512, 256, 1},
+            {impl::op_kind::ReLU, impl::op_kind::ReLU, impl::op_kind::ReLU,
+                    impl::op_kind::ReLU, impl::op_kind::Sigmoid});
+    agraph.finalize();
+    auto &compiler_backend_ptr
+            = impl::compiler_impl::compiler_backend_t::get_singleton();
+    compiler_backend_ptr.get_partitions(agraph, impl::partition_policy::fusion);
+    auto partitions = agraph.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+    impl::partition_t p;
+    p.init(partitions[0]);
+    auto partition_inputs = p.get_inputs();
+    auto partition_outputs = p.get_outputs();
+    std::vector<const impl::logical_tensor_t *> inputs, outputs;
+    for (auto &lt : partition_inputs) {
+        inputs.push_back(&lt);
+    }
+    for (auto &lt : partition_outputs) {
+        outputs.push_back(&lt);
+    }
+
+    // compiles the generic dynamic kernel as the reference, and the one which
+    // specializes at most one shape
+    impl::engine_t &eng = *get_engine();
+    impl::compiled_partition_t cp_ref(p), cp(p);
+    {
+        specialize_limit_guard_t guard {0};
+        ASSERT_EQ(p.compile(&cp_ref, inputs, outputs, &eng),
+                impl::status::success);
+    }
+    {
+        specialize_limit_guard_t guard {1};
+        ASSERT_EQ(p.compile(&cp, inputs, outputs, &eng), impl::status::success);
+    }
+    auto pimpl = dynamic_cast<
+            const impl::compiler_impl::compiler_compiled_partition_impl_t *>(
+            cp.get_pimpl());
+    ASSERT_NE(pimpl, nullptr);
+
+    ltsr_vec in_lts = partition_inputs, out_lts;
+    in_lts[0].dims[0] = batch_size;
+    for (auto &lt : outputs) {
+        impl::logical_tensor_t compiled_output;
+        cp.query_logical_tensor(lt->id, &compiled_output);
+        compiled_output.dims[0] = batch_size;
+        out_lts.push_back(compiled_output);
+    }
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::vector<test::vector<float>> in_data;
+    std::vector<impl::tensor_t> in_tensors;
+    for (auto &lt : in_lts) {
+        set_dense_strides(lt);
+        in_data.emplace_back(compiler_backend_ptr.get_mem_size(lt)
+                / sizeof(float));
+        for (auto &v : in_data.back()) {
+            v = distribution(generator);
+        }
+        in_tensors.emplace_back(lt, &eng, in_data.back().data());
+    }
+    set_dense_strides(out_lts[0]);
+    size_t out_size
+            = compiler_backend_ptr.get_mem_size(out_lts[0]) / sizeof(float);
+    test::vector<float> ref_data(out_size), out_data(out_size);
+    std::vector<impl::tensor_t> ref_tensors {
+            impl::tensor_t(out_lts[0], &eng, ref_data.data())};
+    std::vector<impl::tensor_t> out_tensors {
+            impl::tensor_t(out_lts[0], &eng, out_data.data())};
+
+    impl::stream_t &strm = *get_stream();
+    ASSERT_EQ(cp_ref.execute(&strm, in_tensors, ref_tensors),
+            impl::status::success);
+    strm.wait();
+
+    // the first execution requests the static kernel and runs the generic one
+    // until it is compiled in the background
+    for (int i = 0; i < 600 && !pimpl->is_specialized(in_tensors, out_tensors);
+            ++i) {
+        ASSERT_EQ(cp.execute(&strm, in_tensors, out_tensors),
+                impl::status::success);
+        strm.wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_TRUE(pimpl->is_specialized(in_tensors, out_tensors));
+    std::fill(out_data.begin(), out_data.end(), 0.f);
+    ASSERT_EQ(cp.execute(&strm, in_tensors, out_tensors),
+            impl::status::success);
+    strm.wait();
+    for (size_t i = 0; i < out_size; ++i) {
+        ASSERT_NEAR(out_data[i], ref_data[i],
+                1e-4f + 1e-3f * std::abs(ref_data[i]));
+    }
+}
+
 TEST(GCGraphTest, INT8MLPDynamicGraphCompileExecution) {
     REQUIRE_VNNI_AMXINT8();
     impl::graph_t agraph;
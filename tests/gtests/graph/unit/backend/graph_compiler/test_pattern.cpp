@@ -130,6 +130,79 @@ TEST(GCPatternTests, FP32MHAPatternAlternative) {
             std::vector<partition_info_t> {{7, 5, 1}});
 }
 
+// test fp32 grouped-query and multi-query attention pattern
+TEST(GCPatternTests, FP32GQAPattern) {
+    REQUIRE_AVX512();
+    graph::graph_t agraph;
+    compiler_utils::add_gqa_subgraph(&agraph, false);
+    agraph.finalize();
+
+    test_pattern_matched(agraph, {"fp32_gqa_pattern"}, 1,
+            std::vector<partition_info_t> {{5, 5, 1}});
+}
+
+TEST(GCPatternTests, FP32MQAPattern) {
+    REQUIRE_AVX512();
+    graph::graph_t agraph;
+    compiler_utils::add_gqa_subgraph(&agraph, false, 4, 128, 1, 8);
+    agraph.finalize();
+
+    test_pattern_matched(agraph, {"fp32_gqa_pattern"}, 1,
+            std::vector<partition_info_t> {{5, 5, 1}});
+}
+
+TEST(GCPatternTests, BF16GQAPattern) {
+    REQUIRE_BF16_AMXBF16();
+    graph::graph_t agraph;
+    compiler_utils::add_gqa_subgraph(&agraph, true);
+    agraph.finalize();
+
+    test_pattern_matched(agraph, {"bf16_gqa_pattern"}, 1,
+            std::vector<partition_info_t> {{5, 5, 1}});
+}
+
+// test gated mlp (SwiGLU) pattern
+TEST(GCPatternTests, FP32GatedMLPPattern) {
+    REQUIRE_AVX512();
+    graph::graph_t agraph;
+    compiler_utils::add_gated_mlp_subgraph(&agraph, false);
+    agraph.finalize();
+
+    test_pattern_matched(agraph, {"fp32_gated_mlp_pattern"}, 1,
+            std::vector<partition_info_t> {{6, 4, 1}});
+}
+
+TEST(GCPatternTests, FP32GatedMLPPatternWithoutDown) {
+    REQUIRE_AVX512();
+    graph::graph_t agraph;
+    compiler_utils::add_gated_mlp_subgraph(&agraph, false, false);
+    agraph.finalize();
+
+    test_pattern_matched(agraph, {"fp32_gated_mlp_pattern"}, 1,
+            std::vector<partition_info_t> {{5, 3, 1}});
+}
+
+TEST(GCPatternTests, BF16GatedMLPPattern) {
+    REQUIRE_BF16_AMXBF16();
+    graph::graph_t agraph;
+    compiler_utils::add_gated_mlp_subgraph(&agraph, true);
+    agraph.finalize();
+
+    test_pattern_matched(agraph, {"bf16_gated_mlp_pattern"}, 1,
+            std::vector<partition_info_t> {{6, 4, 1}});
+}
+
+// MHA with a key/value head per query head is not matched
+TEST(GCPatternTests, FP32GQAPatternNotMatchMHA) {
+    REQUIRE_AVX512();
+    graph::graph_t agraph;
+    compiler_utils::add_gqa_subgraph(&agraph, false, 4, 128, 8, 1);
+    agraph.finalize();
+
+    test_pattern_matched(
+            agraph, {"fp32_gqa_pattern"}, 0, std::vector<partition_info_t> {});
+}
+
 // test fp32 MHA pattern (no reshape)
 TEST(GCPatternTests, FP32MHAPatternOptionalReshape) {
     REQUIRE_AVX512();
@@ -2696,6 +2696,156 @@ static inline void add_MHA_subgraph_alternative4(graph::graph_t *agraph,
     if (use_int8) { agraph->add_op(&quantize_output); }
 }
 
+// Grouped-query attention, in which each of the num_kv_head key/value heads is
+// shared by num_group query heads. num_kv_head = 1 makes it multi-query.
+static inline void add_gqa_subgraph(graph::graph_t *agraph,
+        bool use_bf16 = false, int batch_size = 4, int seq_len = 128,
+        int num_kv_head = 2, int num_group = 4, int size_per_head = 64) {
+    size_t logical_tensor_idx = 0;
+    size_t op_idx = 0;
+    std::vector<graph::dim_t> QUERY_SHAPE {
+            batch_size, num_kv_head, num_group, seq_len, size_per_head};
+    std::vector<graph::dim_t> KEY_SHAPE {
+            batch_size, num_kv_head, 1, size_per_head, seq_len};
+    std::vector<graph::dim_t> VALUE_SHAPE {
+            batch_size, num_kv_head, 1, seq_len, size_per_head};
+    std::vector<graph::dim_t> MATMUL_QK_SHAPE {
+            batch_size, num_kv_head, num_group, seq_len, seq_len};
+    std::vector<graph::dim_t> MASK_SHAPE {batch_size, 1, 1, 1, seq_len};
+    std::vector<graph::dim_t> CONST_SHAPE {1};
+
+    auto dtype = use_bf16 ? graph::data_type::bf16 : graph::data_type::f32;
+
+    graph::logical_tensor_t query_input, key_input, value_input;
+    query_input = utils::logical_tensor_init(
+            logical_tensor_idx++, QUERY_SHAPE, dtype);
+    key_input = utils::logical_tensor_init(
+            logical_tensor_idx++, KEY_SHAPE, dtype);
+    value_input = utils::logical_tensor_init(
+            logical_tensor_idx++, VALUE_SHAPE, dtype);
+
+    graph::logical_tensor_t matmul_qk_out, fscore_scale, fscore_div_out,
+            attention_mask, fscore_add_out, softmax_out, matmul_v_out;
+    matmul_qk_out = utils::logical_tensor_init(
+            logical_tensor_idx++, MATMUL_QK_SHAPE, dtype);
+    fscore_scale = utils::logical_tensor_init(
+            logical_tensor_idx++, CONST_SHAPE, dtype);
+    fscore_div_out = utils::logical_tensor_init(
+            logical_tensor_idx++, MATMUL_QK_SHAPE, dtype);
+    attention_mask = utils::logical_tensor_init(
+            logical_tensor_idx++, MASK_SHAPE, dtype);
+    fscore_add_out = utils::logical_tensor_init(
+            logical_tensor_idx++, MATMUL_QK_SHAPE, dtype);
+    softmax_out = utils::logical_tensor_init(
+            logical_tensor_idx++, MATMUL_QK_SHAPE, dtype);
+    matmul_v_out = utils::logical_tensor_init(
+            logical_tensor_idx++, QUERY_SHAPE, dtype);
+
+    graph::op_t matmul_qk {op_idx++, graph::op_kind::MatMul, "matmul_qk"};
+    graph::op_t fscore_div {op_idx++, graph::op_kind::Divide, "fscore_div"};
+    fscore_div.set_attr(graph::op_attr::auto_broadcast, std::string("numpy"));
+    graph::op_t fscore_add {op_idx++, graph::op_kind::Add, "fscore_add"};
+    fscore_add.set_attr(graph::op_attr::auto_broadcast, std::string("numpy"));
+    graph::op_t softmax {op_idx++, graph::op_kind::SoftMax, "softmax"};
+    softmax.set_attr(graph::op_attr::axis, (int64_t)4);
+    graph::op_t matmul_v {op_idx++, graph::op_kind::MatMul, "matmul_v"};
+
+    matmul_qk.add_input(query_input);
+    matmul_qk.add_input(key_input);
+    matmul_qk.add_output(matmul_qk_out);
+    fscore_div.add_input(matmul_qk_out);
+    fscore_div.add_input(fscore_scale);
+    fscore_div.add_output(fscore_div_out);
+    fscore_add.add_input(fscore_div_out);
+    fscore_add.add_input(attention_mask);
+    fscore_add.add_output(fscore_add_out);
+    softmax.add_input(fscore_add_out);
+    softmax.add_output(softmax_out);
+    matmul_v.add_input(softmax_out);
+    matmul_v.add_input(value_input);
+    matmul_v.add_output(matmul_v_out);
+
+    agraph->add_op(&matmul_qk);
+    agraph->add_op(&fscore_div);
+    agraph->add_op(&fscore_add);
+    agraph->add_op(&softmax);
+    agraph->add_op(&matmul_v);
+}
+
+// gated mlp (SwiGLU): silu(x * W1) * (x * W3) [* W2], with silu decomposed to
+// Sigmoid and Multiply
+static inline void add_gated_mlp_subgraph(graph::graph_t *agraph,
+        bool use_bf16 = false, bool with_down = true, int batch_size = 32,
+        int hidden_size = 256, int intermediate_size = 512) {
+    size_t logical_tensor_idx = 0;
+    size_t op_idx = 0;
+    std::vector<graph::dim_t> INPUT_SHAPE {batch_size, hidden_size};
+    std::vector<graph::dim_t> UP_WEIGHT_SHAPE {hidden_size, intermediate_size};
+    std::vector<graph::dim_t> DOWN_WEIGHT_SHAPE {
+            intermediate_size, hidden_size};
+    std::vector<graph::dim_t> INTERMEDIATE_SHAPE {
+            batch_size, intermediate_size};
+
+    auto dtype = use_bf16 ? graph::data_type::bf16 : graph::data_type::f32;
+
+    graph::logical_tensor_t input, gate_weight, up_weight, down_weight;
+    input = utils::logical_tensor_init(
+            logical_tensor_idx++, INPUT_SHAPE, dtype);
+    gate_weight = utils::logical_tensor_init(
+            logical_tensor_idx++, UP_WEIGHT_SHAPE, dtype);
+    up_weight = utils::logical_tensor_init(
+            logical_tensor_idx++, UP_WEIGHT_SHAPE, dtype);
+    down_weight = utils::logical_tensor_init(
+            logical_tensor_idx++, DOWN_WEIGHT_SHAPE, dtype);
+
+    graph::logical_tensor_t gate_out, sigmoid_out, silu_out, up_out, mul_out,
+            down_out;
+    gate_out = utils::logical_tensor_init(
+            logical_tensor_idx++, INTERMEDIATE_SHAPE, dtype);
+    sigmoid_out = utils::logical_tensor_init(
+            logical_tensor_idx++, INTERMEDIATE_SHAPE, dtype);
+    silu_out = utils::logical_tensor_init(
+            logical_tensor_idx++, INTERMEDIATE_SHAPE, dtype);
+    up_out = utils::logical_tensor_init(
+            logical_tensor_idx++, INTERMEDIATE_SHAPE, dtype);
+    mul_out = utils::logical_tensor_init(
+            logical_tensor_idx++, INTERMEDIATE_SHAPE, dtype);
+    down_out = utils::logical_tensor_init(
+            logical_tensor_idx++, INPUT_SHAPE, dtype);
+
+    graph::op_t matmul_gate {op_idx++, graph::op_kind::MatMul, "matmul_gate"};
+    graph::op_t sigmoid {op_idx++, graph::op_kind::Sigmoid, "sigmoid"};
+    graph::op_t silu {op_idx++, graph::op_kind::Multiply, "silu"};
+    graph::op_t matmul_up {op_idx++, graph::op_kind::MatMul, "matmul_up"};
+    graph::op_t gate_mul {op_idx++, graph::op_kind::Multiply, "gate_mul"};
+    graph::op_t matmul_down {op_idx++, graph::op_kind::MatMul, "matmul_down"};
+
+    matmul_gate.add_input(input);
+    matmul_gate.add_input(gate_weight);
+    matmul_gate.add_output(gate_out);
+    sigmoid.add_input(gate_out);
+    sigmoid.add_output(sigmoid_out);
+    silu.add_input(gate_out);
+    silu.add_input(sigmoid_out);
+    silu.add_output(silu_out);
+    matmul_up.add_input(input);
+    matmul_up.add_input(up_weight);
+    matmul_up.add_output(up_out);
+    gate_mul.add_input(silu_out);
+    gate_mul.add_input(up_out);
+    gate_mul.add_output(mul_out);
+    matmul_down.add_input(mul_out);
+    matmul_down.add_input(down_weight);
+    matmul_down.add_output(down_out);
+
+    agraph->add_op(&matmul_gate);
+    agraph->add_op(&sigmoid);
+    agraph->add_op(&silu);
+    agraph->add_op(&matmul_up);
+    agraph->add_op(&gate_mul);
+    if (with_down) agraph->add_op(&matmul_down);
+}
+
 // returned vector with shape {ic, ks, oc}
 static std::vector<graph::dim_t> extract_filter_info(
         const dims &shape, const std::string &filter_format) {
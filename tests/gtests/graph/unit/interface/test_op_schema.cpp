@@ -3331,6 +3331,93 @@ TEST(OpSchema, Select) {
             expected_attr_size, attrs_data);
 }
 
+TEST(OpSchema, RotaryEmbedding) {
+    const op_kind_t op_kind_ = op_kind::RotaryEmbedding;
+    const size_t expected_in_size = 3;
+    const size_t expected_out_size = 1;
+    const size_t expected_attr_size = 1;
+    const std::map<op_attr_t, bool> attrs_data = {{op_attr::mode, false}};
+
+    verify_op_schema(op_kind_, expected_in_size, expected_out_size,
+            expected_attr_size, attrs_data);
+}
+
+TEST(OpSchema, TopK) {
+    const op_kind_t op_kind_ = op_kind::TopK;
+    const size_t expected_in_size = 1;
+    const size_t expected_out_size = 2;
+    const size_t expected_attr_size = 2;
+    const std::map<op_attr_t, bool> attrs_data
+            = {{op_attr::axis, false}, {op_attr::k, true}};
+
+    verify_op_schema(op_kind_, expected_in_size, expected_out_size,
+            expected_attr_size, attrs_data);
+}
+
+TEST(OpSchema, InferTopKOutputShape) {
+    const op_schema_t *op_schema_
+            = op_schema_registry_t::get_op_schema(op_kind::TopK);
+
+    op_t op_ {op_kind::TopK, op_t::kind2str(op_kind::TopK)};
+    op_.set_attr<int64_t>(op_attr::axis, -1);
+    op_.set_attr<int64_t>(op_attr::k, 4);
+
+    logical_tensor_t lt_in
+            = logical_tensor_init(0, {2, 3, 16}, data_type::f32);
+    logical_tensor_t lt_out = logical_tensor_init(1, data_type::f32);
+    logical_tensor_t lt_indices = logical_tensor_init(2, data_type::s32);
+    std::vector<logical_tensor_t *> in {&lt_in};
+    std::vector<logical_tensor_t *> out {&lt_out, &lt_indices};
+
+    ASSERT_EQ(op_schema_->shape_infer(&op_, in, out), status::success);
+    const std::vector<int64_t> expected_dims {2, 3, 4};
+    EXPECT_EQ(logical_tensor_wrapper_t(lt_out).vdims(), expected_dims);
+    EXPECT_EQ(logical_tensor_wrapper_t(lt_indices).vdims(), expected_dims);
+
+    // k exceeds the size of the axis
+    op_.set_attr<int64_t>(op_attr::k, 17);
+    lt_out = logical_tensor_init(1, data_type::f32);
+    lt_indices = logical_tensor_init(2, data_type::s32);
+    ASSERT_EQ(op_schema_->shape_infer(&op_, in, out), status::invalid_shape);
+}
+
+TEST(OpSchema, EmbeddingBag) {
+    const op_kind_t op_kind_ = op_kind::EmbeddingBag;
+    const std::set<size_t> expected_in_sizes = {2, 3};
+    const size_t expected_out_size = 1;
+    const size_t expected_attr_size = 1;
+    const std::map<op_attr_t, bool> attrs_data = {{op_attr::mode, false}};
+
+    for (auto expected_in_size : expected_in_sizes) {
+        verify_op_schema(op_kind_, expected_in_size, expected_out_size,
+                expected_attr_size, attrs_data);
+    }
+}
+
+TEST(OpSchema, InferEmbeddingBagOutputShape) {
+    const op_schema_t *op_schema_
+            = op_schema_registry_t::get_op_schema(op_kind::EmbeddingBag);
+    op_t op_ {op_kind::EmbeddingBag, op_t::kind2str(op_kind::EmbeddingBag)};
+
+    logical_tensor_t lt_src = logical_tensor_init(0, {100, 64}, data_type::f32);
+    logical_tensor_t lt_indices = logical_tensor_init(1, {30}, data_type::s32);
+    logical_tensor_t lt_offsets = logical_tensor_init(2, {8}, data_type::s32);
+    logical_tensor_t lt_out = logical_tensor_init(3, data_type::f32);
+    std::vector<logical_tensor_t *> in {&lt_src, &lt_indices, &lt_offsets};
+    std::vector<logical_tensor_t *> out {&lt_out};
+
+    ASSERT_EQ(op_schema_->shape_infer(&op_, in, out), status::success);
+    const std::vector<int64_t> expected_dims {8, 64};
+    EXPECT_EQ(logical_tensor_wrapper_t(lt_out).vdims(), expected_dims);
+
+    // without offsets, each index makes a bag
+    in.pop_back();
+    lt_out = logical_tensor_init(3, data_type::f32);
+    ASSERT_EQ(op_schema_->shape_infer(&op_, in, out), status::success);
+    const std::vector<int64_t> expected_gather_dims {30, 64};
+    EXPECT_EQ(logical_tensor_wrapper_t(lt_out).vdims(), expected_gather_dims);
+}
+
 TEST(OpSchema, InferSelectOutputShapeWithoutBroadcast) {
     const op_kind_t op_kind_ = op_kind::Select;
     const op_schema_t *op_schema_
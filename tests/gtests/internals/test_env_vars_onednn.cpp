@@ -20,11 +20,17 @@
 
 #include "stdlib.h"
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
 #include "oneapi/dnnl/dnnl.hpp"
 
+#include "src/common/scratchpad.hpp"
+
 // Note: use one non-default value to validate functionality. Rest values, if
 // check in loop will not take effect.
 
@@ -114,4 +120,106 @@ TEST(onednn_default_fpmath_mode_env_var_test, TestEnvVars) {
     EXPECT_EQ(func_got_val, dnnl_fpmath_mode_strict);
 }
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+TEST(onednn_scratchpad_pool_env_var_test, TestEnvVars) {
+    custom_setenv("ONEDNN_SCRATCHPAD_POOL", "1", 1);
+    custom_setenv("ONEDNN_SCRATCHPAD_POOL_TRIM_MS", "100", 1);
+
+    using dt = memory::data_type;
+    using tag = memory::format_tag;
+    const memory::dim N = 2, IC = 16, OC = 16, IH = 14, IW = 14, KH = 3,
+                      KW = 3;
+    const memory::dim OH = IH - KH + 1, OW = IW - KW + 1;
+
+    engine eng(engine::kind::cpu, 0);
+    auto src_md = memory::desc({N, IC, IH, IW}, dt::f32, tag::nchw);
+    auto wei_md = memory::desc({OC, IC, KH, KW}, dt::f32, tag::oihw);
+    auto dst_md = memory::desc({N, OC, OH, OW}, dt::f32, tag::nchw);
+    auto pd = convolution_forward::primitive_desc(eng, prop_kind::forward,
+            algorithm::convolution_direct, src_md, wei_md, dst_md, {1, 1},
+            {0, 0}, {0, 0});
+    auto conv = convolution_forward(pd);
+
+    // The same implementation in the user mode reports the scratchpad size
+    // the pool has to provide on every execution.
+    primitive_attr user_attr;
+    user_attr.set_scratchpad_mode(scratchpad_mode::user);
+    auto user_pd = convolution_forward::primitive_desc(eng,
+            prop_kind::forward, algorithm::convolution_direct, src_md, wei_md,
+            dst_md, {1, 1}, {0, 0}, {0, 0}, user_attr);
+    const bool has_scratchpad = user_pd.scratchpad_desc().get_size() > 0;
+
+    auto fill = [](const memory &mem, float value) {
+        auto *ptr = static_cast<float *>(mem.get_data_handle());
+        const size_t nelems = mem.get_desc().get_size() / sizeof(float);
+        for (size_t i = 0; i < nelems; i++)
+            ptr[i] = value;
+    };
+    memory src(src_md, eng), wei(wei_md, eng);
+    fill(src, 1.f);
+    fill(wei, 1.f);
+
+    // The same primitive is executed from several threads at once, each
+    // execution borrows its own scratchpad from the shared pool.
+    const int nthr = 4;
+    std::vector<memory> dsts;
+    for (int i = 0; i < nthr; i++)
+        dsts.emplace_back(dst_md, eng);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nthr; i++) {
+        workers.emplace_back([&, i]() {
+            stream strm(eng);
+            conv.execute(strm,
+                    {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                            {DNNL_ARG_DST, dsts[i]}});
+            strm.wait();
+        });
+    }
+    for (auto &w : workers)
+        w.join();
+
+    for (const auto &dst : dsts) {
+        const auto *ptr = static_cast<const float *>(dst.get_data_handle());
+        const size_t nelems = dst_md.get_size() / sizeof(float);
+        for (size_t i = 0; i < nelems; i++)
+            ASSERT_EQ(ptr[i], float(IC * KH * KW));
+    }
+
+    auto stats = impl::get_scratchpad_pool_stats();
+    if (!has_scratchpad) {
+        EXPECT_EQ(stats.allocations + stats.reuses, 0u);
+        return;
+    }
+    EXPECT_GE(stats.allocations, 1u);
+    EXPECT_LE(stats.allocations, size_t(nthr));
+    EXPECT_EQ(stats.allocations + stats.reuses, size_t(nthr));
+    EXPECT_EQ(stats.idle_buffers, stats.allocations);
+
+    // Sequential executions keep reusing the idle buffers.
+    stream strm(eng);
+    const int nexecs = 3;
+    for (int i = 0; i < nexecs; i++)
+        conv.execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                        {DNNL_ARG_DST, dsts[0]}});
+    strm.wait();
+    auto reuse_stats = impl::get_scratchpad_pool_stats();
+    EXPECT_EQ(reuse_stats.allocations, stats.allocations);
+    EXPECT_EQ(reuse_stats.reuses, stats.reuses + nexecs);
+
+    // Once the trimming time has passed, taking a buffer releases all the
+    // idle buffers first, so the execution gets a fresh one.
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    conv.execute(strm,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_DST, dsts[0]}});
+    strm.wait();
+    auto trim_stats = impl::get_scratchpad_pool_stats();
+    EXPECT_EQ(trim_stats.allocations, stats.allocations + 1);
+    EXPECT_EQ(trim_stats.reuses, reuse_stats.reuses);
+    EXPECT_EQ(trim_stats.idle_buffers, 1u);
+}
+#endif
+
 } // namespace dnnl
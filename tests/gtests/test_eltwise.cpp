@@ -14,6 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cmath>
+#include <cstring>
+
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
@@ -443,4 +446,86 @@ INST_TEST_CASE(EltwiseSimpleF32, all_cases, EXPAND_DTS(f32, f32, f32));
 INST_TEST_CASE(EltwiseSimpleBF16, all_cases, EXPAND_DTS(bf16, bf16, bf16));
 INST_TEST_CASE(EltwiseSimpleF16, all_cases, EXPAND_DTS(f16, f16, undef));
 INST_TEST_CASE(EltwiseSimpleU8, all_cases, EXPAND_DTS(u8, u8, undef));
+
+// The bf16 and any fpmath modes let x64 kernels use fast approximations of
+// some algorithms within the error bounds documented for the modes. The
+// other modes keep the accurate results, identical to the default ones.
+TEST(eltwise_fast_math_test_t, TestsErrorBounds) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Fast math approximations are implemented on CPU only.");
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    struct case_t {
+        algorithm alg;
+        float lo, hi;
+        float fast_trh, strict_trh;
+        // The error of gelu_erf is bounded relatively to the source.
+        bool is_err_wrt_src;
+    };
+    // The log arguments stay away from 1 where its relative error isn't
+    // meaningful.
+    const std::vector<case_t> cases {
+            {algorithm::eltwise_exp, -80.f, 80.f, 1.1e-4f, 4e-6f, false},
+            {algorithm::eltwise_tanh, -10.f, 10.f, 5.2e-4f, 4e-5f, false},
+            {algorithm::eltwise_log, 1e-3f, 0.6f, 4.7e-4f, 4e-5f, false},
+            {algorithm::eltwise_log, 1.5f, 1e3f, 4.7e-4f, 4e-5f, false},
+            {algorithm::eltwise_gelu_erf, -8.f, 8.f, 3.4e-5f, 4e-6f, true}};
+
+    const memory::dim n = 16 * 1024 + 3;
+    const memory::desc md({n}, dt::f32, tag::a);
+    for (const auto &c : cases) {
+        auto src = test::make_memory(md, eng);
+        {
+            auto src_ptr = map_memory<float>(src);
+            for (memory::dim i = 0; i < n; i++)
+                src_ptr[i] = c.lo + (c.hi - c.lo) * i / (n - 1);
+        }
+
+        const auto execute = [&](fpmath_mode mode) {
+            primitive_attr attr;
+            attr.set_fpmath_mode(mode);
+            auto pd = eltwise_forward::primitive_desc(eng,
+                    prop_kind::forward_inference, c.alg, md, md, 0.f, 0.f,
+                    attr);
+            auto dst = test::make_memory(md, eng);
+            eltwise_forward(pd).execute(
+                    strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+            strm.wait();
+            auto dst_ptr = map_memory<float>(dst);
+            const float *d = dst_ptr;
+            return std::vector<float>(d, d + n);
+        };
+
+        const auto check = [&](const std::vector<float> &got, float trh) {
+            auto src_ptr = map_memory<float>(src);
+            for (memory::dim i = 0; i < n; i++) {
+                const double s = src_ptr[i];
+                double ref = 0;
+                switch (c.alg) {
+                    case algorithm::eltwise_exp: ref = std::exp(s); break;
+                    case algorithm::eltwise_tanh: ref = std::tanh(s); break;
+                    case algorithm::eltwise_log: ref = std::log(s); break;
+                    default:
+                        ref = 0.5 * s * (1 + std::erf(s / std::sqrt(2.)));
+                }
+                const double scale
+                        = c.is_err_wrt_src ? std::fabs(s) : std::fabs(ref);
+                ASSERT_LE(std::fabs(got[i] - ref), trh * scale)
+                        << "alg: " << static_cast<int>(c.alg) << " src: " << s;
+            }
+        };
+
+        const auto strict = execute(fpmath_mode::strict);
+        check(strict, c.strict_trh);
+        for (auto mode : {fpmath_mode::tf32, fpmath_mode::f16}) {
+            const auto same = execute(mode);
+            const size_t size = n * sizeof(float);
+            ASSERT_EQ(std::memcmp(same.data(), strict.data(), size), 0);
+        }
+        for (auto mode : {fpmath_mode::bf16, fpmath_mode::any})
+            check(execute(mode), c.fast_trh);
+    }
+}
+
 } // namespace dnnl
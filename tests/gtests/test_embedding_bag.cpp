@@ -0,0 +1,288 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using tag = memory::format_tag;
+using dt = memory::data_type;
+
+enum class scales_kind_t { none, common, per_row };
+
+struct embedding_bag_test_params_t {
+    dt src_dt;
+    dt dst_dt;
+    dt indices_dt;
+    algorithm alg;
+    tag src_tag;
+    memory::dim nrows;
+    memory::dim emb_dim;
+    memory::dim nbags;
+    // Without offsets, each index makes a bag.
+    bool with_offsets;
+    scales_kind_t scales_kind;
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+class embedding_bag_test_t
+    : public ::testing::TestWithParam<embedding_bag_test_params_t> {
+private:
+    embedding_bag_test_params_t p;
+
+protected:
+    void SetUp() override {
+        p = ::testing::TestWithParam<embedding_bag_test_params_t>::GetParam();
+
+        SKIP_IF_CUDA(true, "Embedding bag primitive not supported by CUDA");
+        SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+                "Embedding bag primitive not supported by GPU");
+
+        SKIP_IF(unsupported_data_type(p.src_dt, p.dst_dt),
+                "Engine does not support this data type.");
+
+        catch_expected_failures(
+                [=]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    // The bag b pools (b * 5) % 7 indices, so some bags are empty.
+    std::vector<int32_t> make_offsets(memory::dim &nindices) const {
+        std::vector<int32_t> offsets(p.nbags);
+        nindices = 0;
+        for (memory::dim b = 0; b < p.nbags; ++b) {
+            offsets[b] = static_cast<int32_t>(nindices);
+            nindices += (b * 5) % 7;
+        }
+        return offsets;
+    }
+
+    void Test() {
+        using pd_t = embedding_bag::primitive_desc;
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        auto aa = allows_attr_t {false};
+        aa.scales = true;
+
+        memory::dim nindices = p.nbags;
+        std::vector<int32_t> offsets_data;
+        if (p.with_offsets) offsets_data = make_offsets(nindices);
+
+        auto src_md = memory::desc({p.nrows, p.emb_dim}, p.src_dt, p.src_tag);
+        auto indices_md = memory::desc({nindices}, p.indices_dt, tag::a);
+        auto offsets_md = memory::desc({p.nbags}, dt::s32, tag::a);
+        auto dst_md = memory::desc({p.nbags, p.emb_dim}, p.dst_dt, tag::any);
+
+        primitive_attr attr;
+        if (p.scales_kind != scales_kind_t::none)
+            attr.set_scales_mask(
+                    DNNL_ARG_SRC, p.scales_kind == scales_kind_t::per_row);
+
+        // default pd ctor
+        auto pd = pd_t();
+        // regular pd ctors
+        if (p.with_offsets) {
+            pd = pd_t(eng, p.alg, src_md, indices_md, offsets_md, dst_md,
+                    attr);
+            test_fwd_pd_constructors<pd_t>(
+                    pd, aa, p.alg, src_md, indices_md, offsets_md, dst_md);
+        } else {
+            pd = pd_t(eng, p.alg, src_md, indices_md, dst_md, attr);
+            test_fwd_pd_constructors<pd_t>(
+                    pd, aa, p.alg, src_md, indices_md, dst_md);
+        }
+
+        EXPECT_ANY_THROW(embedding_bag(pd, {}));
+        // default primitive ctor
+        auto eb = embedding_bag();
+        // regular primitive ctor
+        eb = embedding_bag(pd);
+
+        // check primitive kind is embedding_bag
+        ASSERT_TRUE(eb.get_kind() == primitive::kind::embedding_bag);
+        // query for descs from pd
+        const auto src_desc = pd.src_desc();
+        const auto dst_desc = pd.dst_desc();
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_SRC) == src_desc);
+        ASSERT_TRUE(src_md == src_desc);
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_SRC_1)
+                == pd.indices_desc());
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_SRC_2)
+                == pd.offsets_desc());
+        ASSERT_EQ(pd.offsets_desc().is_zero(), !p.with_offsets);
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST) == dst_desc);
+        ASSERT_EQ(pd.get_algorithm(), p.alg);
+
+        // check primitive returns zero_md for all rest md
+        ASSERT_TRUE(pd.weights_desc().is_zero());
+        ASSERT_TRUE(pd.diff_src_desc().is_zero());
+        ASSERT_TRUE(pd.diff_dst_desc().is_zero());
+        ASSERT_TRUE(pd.diff_weights_desc().is_zero());
+
+        // Small integers, exact in all the data types.
+        const float shift = p.src_dt == dt::u8 ? 0.f : 6.f;
+        std::vector<float> src_data(p.nrows * p.emb_dim);
+        for (size_t i = 0; i < src_data.size(); ++i)
+            src_data[i] = static_cast<float>((i * 7) % 13) - shift;
+        std::vector<int32_t> indices_data(nindices);
+        for (memory::dim i = 0; i < nindices; ++i)
+            indices_data[i] = static_cast<int32_t>((i * 31 + 7) % p.nrows);
+        std::vector<float> scales_data(
+                p.scales_kind == scales_kind_t::per_row ? p.nrows : 1);
+        for (size_t i = 0; i < scales_data.size(); ++i)
+            scales_data[i] = 0.25f * (1 + i % 3);
+
+        auto src_f32 = test::make_memory(
+                memory::desc({p.nrows, p.emb_dim}, dt::f32, tag::ab), eng);
+        fill_memory(src_f32, src_data);
+        auto src = test::make_memory(src_desc, eng);
+        reorder(src_f32, src).execute(strm, src_f32, src);
+
+        auto indices = test::make_memory(pd.indices_desc(), eng);
+        fill_memory(indices, indices_data);
+        auto dst = test::make_memory(dst_desc, eng);
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, src},
+                {DNNL_ARG_SRC_1, indices}, {DNNL_ARG_DST, dst}};
+        if (p.with_offsets) {
+            auto offsets = test::make_memory(pd.offsets_desc(), eng);
+            fill_memory(offsets, offsets_data);
+            args.insert({DNNL_ARG_SRC_2, offsets});
+        }
+        if (p.scales_kind != scales_kind_t::none) {
+            auto scales = test::make_memory(
+                    memory::desc({(memory::dim)scales_data.size()}, dt::f32,
+                            tag::a),
+                    eng);
+            fill_memory(scales, scales_data);
+            args.insert({DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, scales});
+        }
+        eb.execute(strm, args);
+
+        auto dst_f32 = test::make_memory(
+                memory::desc({p.nbags, p.emb_dim}, dt::f32, tag::ab), eng);
+        reorder(dst, dst_f32).execute(strm, dst, dst_f32);
+        strm.wait();
+
+        check_result(src_data, indices_data, offsets_data, scales_data,
+                nindices, dst_f32);
+    }
+
+    template <typename T>
+    void fill_memory(const memory &mem, const std::vector<T> &data) {
+        auto ptr = map_memory<T>(mem);
+        std::copy(data.begin(), data.end(), &ptr[0]);
+    }
+
+    void check_result(const std::vector<float> &src_data,
+            const std::vector<int32_t> &indices_data,
+            const std::vector<int32_t> &offsets_data,
+            const std::vector<float> &scales_data, memory::dim nindices,
+            const memory &dst) {
+        auto dst_ptr = map_memory<float>(dst);
+        const float eps = p.dst_dt == dt::bf16
+                ? 8e-3f
+                : (p.dst_dt == dt::f16 ? 1e-3f : 1e-6f);
+
+        for (memory::dim b = 0; b < p.nbags; ++b) {
+            const memory::dim begin = p.with_offsets ? offsets_data[b] : b;
+            const memory::dim end = p.with_offsets
+                    ? (b + 1 < p.nbags ? offsets_data[b + 1] : nindices)
+                    : b + 1;
+            for (memory::dim d = 0; d < p.emb_dim; ++d) {
+                float ref = 0.f;
+                for (memory::dim i = begin; i < end; ++i) {
+                    const memory::dim row = indices_data[i];
+                    const float s = p.scales_kind == scales_kind_t::per_row
+                            ? scales_data[row]
+                            : (p.scales_kind == scales_kind_t::common
+                                            ? scales_data[0]
+                                            : 1.f);
+                    ref += s * src_data[row * p.emb_dim + d];
+                }
+                if (p.alg == algorithm::reduction_mean && end > begin)
+                    ref /= (end - begin);
+                const float got = dst_ptr[b * p.emb_dim + d];
+                ASSERT_NEAR(got, ref, eps * std::max(1.f, std::fabs(ref)))
+                        << "bag " << b << " channel " << d;
+            }
+        }
+    }
+};
+
+using tp = embedding_bag_test_params_t;
+static const auto sum = algorithm::reduction_sum;
+static const auto mean = algorithm::reduction_mean;
+static const auto none = scales_kind_t::none;
+static const auto common = scales_kind_t::common;
+static const auto per_row = scales_kind_t::per_row;
+
+TEST_P(embedding_bag_test_t, TestsEmbeddingBag) {}
+
+INSTANTIATE_TEST_SUITE_P(Test_EmbeddingBag_EF, embedding_bag_test_t,
+        ::testing::Values(
+                // Indices are not s32
+                tp {dt::f32, dt::f32, dt::f32, sum, tag::ab, 16, 8, 4, true,
+                        none, true, dnnl_invalid_arguments},
+                // Algorithm is not a pooling one
+                tp {dt::f32, dt::f32, dt::s32, algorithm::reduction_max,
+                        tag::ab, 16, 8, 4, true, none, true,
+                        dnnl_invalid_arguments},
+                // Tag for src is not specified
+                tp {dt::f32, dt::f32, dt::s32, sum, tag::any, 16, 8, 4, true,
+                        none, true, dnnl_invalid_arguments},
+                // Destination cannot be integer
+                tp {dt::f32, dt::s8, dt::s32, sum, tag::ab, 16, 8, 4, true,
+                        none, true, dnnl_unimplemented}));
+
+static auto all_cases = [](dt src_dt, dt dst_dt) {
+    return ::testing::Values(
+            tp {src_dt, dst_dt, dt::s32, sum, tag::ab, 16, 8, 10, true, none},
+            tp {src_dt, dst_dt, dt::s32, mean, tag::ab, 100, 64, 33, true,
+                    none},
+            tp {src_dt, dst_dt, dt::s32, sum, tag::ab, 50, 129, 20, true,
+                    per_row},
+            tp {src_dt, dst_dt, dt::s32, mean, tag::ab, 50, 300, 17, true,
+                    common},
+            tp {src_dt, dst_dt, dt::s32, sum, tag::ba, 40, 24, 9, true,
+                    per_row},
+            // Gather
+            tp {src_dt, dst_dt, dt::s32, sum, tag::ab, 1000, 37, 64, false,
+                    none},
+            tp {src_dt, dst_dt, dt::s32, mean, tag::ab, 20, 16, 5, false,
+                    per_row});
+};
+
+#define INST_TEST_CASE(name, suite, ...) \
+    INSTANTIATE_TEST_SUITE_P(name, embedding_bag_test_t, suite(__VA_ARGS__));
+
+INST_TEST_CASE(EmbeddingBagF32, all_cases, dt::f32, dt::f32);
+INST_TEST_CASE(EmbeddingBagBF16, all_cases, dt::bf16, dt::bf16);
+INST_TEST_CASE(EmbeddingBagF16, all_cases, dt::f16, dt::f32);
+INST_TEST_CASE(EmbeddingBagS8, all_cases, dt::s8, dt::f32);
+INST_TEST_CASE(EmbeddingBagU8, all_cases, dt::u8, dt::bf16);
+
+} // namespace dnnl
@@ -116,6 +116,41 @@ TEST(primitive_cache_test, TestCacheHit) {
 #endif
     ASSERT_EQ(get_primitive_cache_size(), 2);
 }
+
+TEST(primitive_cache_test, TestStats) {
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(2);
+    const auto before = get_primitive_cache_stats();
+    fill_primitive_cache(1);
+    fill_primitive_cache(1);
+    const auto after = get_primitive_cache_stats();
+
+    ASSERT_EQ(after.size, size_t(get_primitive_cache_size()));
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL
+    if (get_test_engine_kind() == engine::kind::cpu) {
+        // Regular CPU engines are always considered equal.
+        ASSERT_EQ(after.misses - before.misses, 1u);
+        ASSERT_EQ(after.hits - before.hits, 1u);
+        return;
+    }
+#endif
+    ASSERT_EQ(after.misses - before.misses, 2u);
+}
+
+TEST(primitive_cache_test, TestMemoryCapacity) {
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(22);
+    set_primitive_cache_memory_capacity(1);
+    ASSERT_EQ(get_primitive_cache_memory_capacity(), 1u);
+    fill_primitive_cache(10);
+
+    // Only the most recently used primitive may stay above the limit.
+    const auto stats = get_primitive_cache_stats();
+    ASSERT_TRUE(stats.size <= 1 || stats.memory_size <= 1);
+
+    set_primitive_cache_memory_capacity(0);
+    ASSERT_EQ(get_primitive_cache_memory_capacity(), 0u);
+}
 #endif
 
 } // namespace dnnl
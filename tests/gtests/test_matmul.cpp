@@ -19,6 +19,8 @@
 
 #include "oneapi/dnnl/dnnl.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 namespace dnnl {
@@ -368,6 +370,115 @@ HANDLE_EXCEPTIONS_FOR_TEST_P(
     ASSERT_EQ(impl_info_no_postops, impl_info_with_postops);
 }
 
+struct src_dyn_quant_test_params_t {
+    memory::dim M, K, N;
+    memory::dim group_size;
+    bool with_bias;
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+class src_dyn_quant_test_t
+    : public ::testing::TestWithParam<src_dyn_quant_test_params_t> {
+private:
+    src_dyn_quant_test_params_t p;
+
+protected:
+    void SetUp() override {
+        p = ::testing::TestWithParam<src_dyn_quant_test_params_t>::GetParam();
+
+        SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+                "Dynamic source quantization is not supported by GPU");
+
+        catch_expected_failures(
+                [=]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    void Test() {
+        using tag = memory::format_tag;
+        using dt = memory::data_type;
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        auto src_md = memory::desc({p.M, p.K}, dt::f32, tag::ab);
+        auto wei_md = memory::desc({p.K, p.N}, dt::s8, tag::ab);
+        auto dst_md = memory::desc({p.M, p.N}, dt::f32, tag::ab);
+        auto bia_md = p.with_bias
+                ? memory::desc({1, p.N}, dt::f32, tag::ab)
+                : memory::desc();
+
+        primitive_attr attr;
+        attr.set_src_dyn_quant_params(p.group_size);
+        ASSERT_EQ(attr.get_src_dyn_quant_params(), (uint64_t)p.group_size);
+
+        auto pd = matmul::primitive_desc(
+                eng, src_md, wei_md, bia_md, dst_md, attr);
+
+        std::vector<float> src_data(p.M * p.K);
+        for (size_t i = 0; i < src_data.size(); i++)
+            src_data[i] = 3.f * std::sin(0.29f * i) * (i % 5 == 1 ? 4.f : 1.f);
+        // an all-zero row must stay finite
+        std::fill(src_data.begin(), src_data.begin() + p.K, 0.f);
+        std::vector<int8_t> wei_data(p.K * p.N);
+        for (size_t i = 0; i < wei_data.size(); i++)
+            wei_data[i] = static_cast<int8_t>((int)(i * 7 % 31) - 15);
+        std::vector<float> bia_data(p.with_bias ? p.N : 0);
+        for (size_t i = 0; i < bia_data.size(); i++)
+            bia_data[i] = 0.25f * (i % 9);
+
+        auto src = test::make_memory(src_md, eng);
+        auto wei = test::make_memory(wei_md, eng);
+        auto dst = test::make_memory(dst_md, eng);
+        fill_memory(src, src_data);
+        fill_memory(wei, wei_data);
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, src},
+                {DNNL_ARG_WEIGHTS, wei}, {DNNL_ARG_DST, dst}};
+        if (p.with_bias) {
+            auto bia = test::make_memory(bia_md, eng);
+            fill_memory(bia, bia_data);
+            args.insert({DNNL_ARG_BIAS, bia});
+        }
+        matmul(pd).execute(strm, args);
+        strm.wait();
+
+        check_result(src_data, wei_data, bia_data, dst);
+    }
+
+    template <typename T>
+    void fill_memory(const memory &mem, const std::vector<T> &data) {
+        auto ptr = map_memory<T>(mem);
+        std::copy(data.begin(), data.end(), &ptr[0]);
+    }
+
+    void check_result(const std::vector<float> &src_data,
+            const std::vector<int8_t> &wei_data,
+            const std::vector<float> &bia_data, const memory &dst) {
+        auto dst_ptr = map_memory<float>(dst);
+        for (memory::dim m = 0; m < p.M; m++)
+            for (memory::dim n = 0; n < p.N; n++) {
+                float ref = p.with_bias ? bia_data[n] : 0.f;
+                for (memory::dim g = 0; g < p.K; g += p.group_size) {
+                    const float *s = &src_data[m * p.K + g];
+                    float absmax = 0.f;
+                    for (memory::dim k = 0; k < p.group_size; k++)
+                        absmax = std::max(absmax, std::fabs(s[k]));
+                    const float mult = 127.f / std::max(absmax, 1e-30f);
+                    int acc = 0;
+                    for (memory::dim k = 0; k < p.group_size; k++) {
+                        const float q = std::min(
+                                127.f, std::max(-128.f, s[k] * mult));
+                        acc += (int)std::nearbyint(q)
+                                * wei_data[(g + k) * p.N + n];
+                    }
+                    ref += acc * (absmax * (1.f / 127.f));
+                }
+                const float got = dst_ptr[m * p.N + n];
+                ASSERT_NEAR(got, ref, 1e-4f * std::max(1.f, std::fabs(ref)))
+                        << "m: " << m << " n: " << n;
+            }
+    }
+};
+
 /********************************* TEST CASES *********************************/
 
 using iface = matmul_iface_test_t;
@@ -668,4 +779,19 @@ INSTANTIATE_TEST_SUITE_P(TensorDims, attr_test_t,
                         memory::dims {2, 10, 10, 10}, tag::abcd,
                         memory::data_type::f16, 4)));
 
+using src_dyn_quant = src_dyn_quant_test_t;
+using sdq = src_dyn_quant_test_params_t;
+
+TEST_P(src_dyn_quant, TestsMatMul) {}
+
+INSTANTIATE_TEST_SUITE_P(SrcDynQuant_EF, src_dyn_quant,
+        ::testing::Values(
+                // group does not divide K
+                sdq {4, 24, 8, 7, false, true, dnnl_unimplemented}));
+
+INSTANTIATE_TEST_SUITE_P(SrcDynQuant, src_dyn_quant,
+        ::testing::Values(sdq {1, 16, 16, 16, false},
+                sdq {7, 37, 19, 37, true}, sdq {33, 256, 64, 256, false},
+                sdq {64, 1000, 48, 1000, true}, sdq {5, 64, 16, 32, true}));
+
 } // namespace dnnl
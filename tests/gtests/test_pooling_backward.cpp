@@ -67,6 +67,7 @@ class pooling_bwd_test_t
 private:
     std::shared_ptr<memory::desc> src_desc;
     std::shared_ptr<memory::desc> dst_desc;
+    memory src;
     memory workspace;
     pooling_forward::primitive_desc pool_prim_desc;
     pool_bwd_test_params_t p;
@@ -178,7 +179,7 @@ protected:
     }
 
     void Forward() {
-        auto src = test::make_memory(*src_desc, eng);
+        src = test::make_memory(*src_desc, eng);
         auto dst = test::make_memory(*dst_desc, eng);
 
         fill_data<data_t>(src.get_desc().get_size() / sizeof(data_t), src);
@@ -230,6 +231,39 @@ protected:
         strm.wait();
 
         check_zero_tail<data_t>(0, diff_src);
+
+        if (p.aalgorithm == algorithm::pooling_max
+                && get_test_engine_kind() == engine::kind::cpu)
+            BackwardArgmaxRecompute(diff_dst, diff_src);
+    }
+
+    // A forward inference hint provides no workspace, so the backward has to
+    // recompute argmax from src. The result must match the workspace path.
+    void BackwardArgmaxRecompute(
+            const memory &diff_dst, const memory &ref_diff_src) {
+        auto diff_src = test::make_memory(*src_desc, eng);
+
+        auto pool_inf_prim_desc = pooling_forward::primitive_desc(eng,
+                prop_kind::forward_inference, p.aalgorithm, *src_desc,
+                *dst_desc, strides, ker, dilation, pad_l, pad_r);
+        ASSERT_EQ(pool_inf_prim_desc.workspace_desc().get_size(), 0U);
+
+        auto pool_bwd_prim_desc = pooling_backward::primitive_desc(eng,
+                p.aalgorithm, *src_desc, *dst_desc, strides, ker, dilation,
+                pad_l, pad_r, pool_inf_prim_desc);
+        ASSERT_EQ(pool_bwd_prim_desc.workspace_desc().get_size(), 0U);
+        ASSERT_TRUE(pool_bwd_prim_desc.query_md(
+                            query::exec_arg_md, DNNL_ARG_SRC)
+                == pool_bwd_prim_desc.src_desc());
+
+        pooling_backward(pool_bwd_prim_desc)
+                .execute(strm,
+                        {{DNNL_ARG_DIFF_DST, diff_dst},
+                                {DNNL_ARG_SRC, src},
+                                {DNNL_ARG_DIFF_SRC, diff_src}});
+        strm.wait();
+
+        compare_data<data_t>(ref_diff_src, diff_src);
     }
 };
 
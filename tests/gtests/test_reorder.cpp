@@ -359,4 +359,89 @@ GPU_INSTANTIATE_TEST_SUITE_P(PaddedWeights, reorder_simple_test_f32_f32,
         ::testing::Values(cfg_f32 {fmt::oihw, fmt::IOhw16i16o, {17, 23, 2, 1}},
                 cfg_f32 {fmt::goihw, fmt::gOIhw16o16i, {2, 17, 23, 1, 2}}));
 
+TEST(reorder_batch_test_t, TestsBatchMatchesSingleReorders) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+    auto eng = get_test_engine();
+    auto strm = make_stream(eng);
+
+    struct pair_t {
+        memory::dims dims;
+        dt src_dt, dst_dt;
+        tag src_tag, dst_tag;
+    };
+    // Repeated descriptors share a primitive, the big pair is reordered on
+    // its own, and the rest are spread over threads.
+    std::vector<pair_t> pairs;
+    for (int i = 0; i < 8; i++)
+        pairs.push_back({{16, 32, 3, 3}, dt::f32, dt::f32, tag::oihw,
+                tag::OIhw16i16o});
+    pairs.push_back({{64, 64, 56, 56}, dt::f32, dt::f32, tag::nchw,
+            tag::nChw16c});
+    pairs.push_back({{7, 13}, dt::f32, dt::f32, tag::ab, tag::ba});
+    pairs.push_back({{3, 17, 5, 5}, dt::f32, dt::s8, tag::nchw, tag::nhwc});
+    pairs.push_back({{1}, dt::s32, dt::f32, tag::a, tag::a});
+
+    std::vector<memory> src, dst, dst_ref;
+    for (const auto &p : pairs) {
+        src.push_back(test::make_memory({p.dims, p.src_dt, p.src_tag}, eng));
+        dst.push_back(test::make_memory({p.dims, p.dst_dt, p.dst_tag}, eng));
+        dst_ref.push_back(
+                test::make_memory({p.dims, p.dst_dt, p.dst_tag}, eng));
+        fill_data(p.src_dt, src.back(), 1.f, 2.f);
+    }
+
+    reorder::execute_batch(strm, src, dst);
+    for (size_t i = 0; i < pairs.size(); i++)
+        reorder(src[i], dst_ref[i]).execute(strm, src[i], dst_ref[i]);
+    strm.wait();
+
+    for (size_t i = 0; i < pairs.size(); i++) {
+        const size_t size = dst[i].get_desc().get_size();
+        auto got = map_memory<uint8_t>(dst[i]);
+        auto ref = map_memory<uint8_t>(dst_ref[i]);
+        for (size_t b = 0; b < size; b++)
+            ASSERT_EQ(got[b], ref[b]) << "pair: " << i << " byte: " << b;
+    }
+
+    EXPECT_ANY_THROW(reorder::execute_batch(strm, src, {dst[0]}));
+}
+
+TEST(reorder_batch_test_t, TestsBatchOnOutOfOrderStream) {
+    SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+            "Out-of-order streams are tested on CPU only.");
+    SKIP_IF(DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
+                    || DNNL_CPU_RUNTIME == DNNL_RUNTIME_SYCL,
+            "Out-of-order CPU streams are not supported by the runtime.");
+    using tag = memory::format_tag;
+    auto eng = get_test_engine();
+    stream strm(eng, stream::flags::out_of_order);
+
+    // The batch reads the output of a reorder submitted right before it.
+    const memory::dims dims {8, 64, 56, 56};
+    memory::desc plain_md(dims, memory::data_type::f32, tag::nchw);
+    memory::desc blocked_md(dims, memory::data_type::f32, tag::nChw16c);
+    auto src = test::make_memory(plain_md, eng);
+    auto mid = test::make_memory(blocked_md, eng);
+    auto dst = test::make_memory(plain_md, eng);
+    fill_data(memory::data_type::f32, src, 1.f, 2.f);
+
+    const std::vector<memory> batch_src {mid}, batch_dst {dst};
+    reorder(src, mid).execute(strm, src, mid);
+    reorder::execute_batch(strm, batch_src, batch_dst);
+    strm.wait();
+
+    const size_t nelems = plain_md.get_size() / sizeof(float);
+    auto got = map_memory<float>(dst);
+    auto ref = map_memory<float>(src);
+    for (size_t i = 0; i < nelems; i++)
+        ASSERT_EQ(got[i], ref[i]) << "element: " << i;
+
+    // A stream of another engine than the one of the reorders is rejected.
+    engine other_eng(get_test_engine_kind(), 0);
+    stream other_strm(other_eng);
+    EXPECT_ANY_THROW(
+            reorder::execute_batch(other_strm, batch_src, batch_dst));
+}
+
 } // namespace dnnl
@@ -14,6 +14,11 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
@@ -541,4 +546,227 @@ INSTANTIATE_TEST_SUITE_P(Test_Softmax_Forward_S8, softmax_test_t,
                         tag::nhwc, tag::nhwc, tag::undef, {2, 1011, 32, 1},
                         2}));
 
+struct softmax_pre_ops_test_params_t {
+    algorithm aalgorithm;
+    dt dst_dt;
+    memory::dims dims;
+    int axis;
+    float scale;
+    softmax_mask_kind mask_kind;
+    memory::dims mask_dims;
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+class softmax_pre_ops_test_t
+    : public ::testing::TestWithParam<softmax_pre_ops_test_params_t> {
+private:
+    softmax_pre_ops_test_params_t p;
+
+protected:
+    void SetUp() override {
+        p = ::testing::TestWithParam<softmax_pre_ops_test_params_t>::GetParam();
+
+        SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+                "Softmax pre-ops are not supported by GPU");
+        SKIP_IF(unsupported_data_type(p.dst_dt),
+                "Engine does not support this data type.");
+
+        catch_expected_failures(
+                [=]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    static tag plain_tag(size_t ndims) {
+        switch (ndims) {
+            case 2: return tag::ab;
+            case 3: return tag::abc;
+            default: return tag::abcd;
+        }
+    }
+
+    static memory::dim count(const memory::dims &dims) {
+        return std::accumulate(dims.begin(), dims.end(), (memory::dim)1,
+                std::multiplies<memory::dim>());
+    }
+
+    // Returns the dense strides of a plain tensor with `dims`.
+    static memory::dims plain_strides(const memory::dims &dims) {
+        memory::dims strides(dims.size(), 1);
+        for (int d = (int)dims.size() - 2; d >= 0; d--)
+            strides[d] = strides[d + 1] * dims[d + 1];
+        return strides;
+    }
+
+    void Test() {
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        const auto ndims = p.dims.size();
+        auto src_md = memory::desc(p.dims, dt::f32, plain_tag(ndims));
+        auto dst_md = memory::desc(p.dims, p.dst_dt, plain_tag(ndims));
+        memory::desc mask_md;
+        if (!p.mask_dims.empty())
+            mask_md = memory::desc(p.mask_dims, dt::f32, plain_tag(ndims));
+
+        primitive_attr attr;
+        attr.set_softmax_pre_ops(p.scale, p.mask_kind, mask_md);
+        float scale = 0.f;
+        softmax_mask_kind mask_kind = softmax_mask_kind::none;
+        memory::desc queried_mask_md;
+        attr.get_softmax_pre_ops(scale, mask_kind, queried_mask_md);
+        ASSERT_EQ(scale, p.scale);
+        ASSERT_EQ(mask_kind, p.mask_kind);
+        ASSERT_TRUE(queried_mask_md == mask_md);
+
+        auto pd = softmax_forward::primitive_desc(eng,
+                prop_kind::forward_inference, p.aalgorithm, src_md, dst_md,
+                p.axis, attr);
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_ATTR_SOFTMAX_MASK)
+                == mask_md);
+
+        const auto nelems = count(p.dims);
+        std::vector<float> src_data(nelems);
+        for (memory::dim i = 0; i < nelems; i++)
+            src_data[i] = 4.f * std::sin(0.37f * i);
+        std::vector<float> mask_data(
+                p.mask_dims.empty() ? 0 : count(p.mask_dims));
+        for (size_t i = 0; i < mask_data.size(); i++)
+            mask_data[i] = i % 7 == 3 ? -INFINITY : 0.5f * (i % 3);
+
+        auto src = test::make_memory(src_md, eng);
+        fill_memory(src, src_data);
+        auto dst = test::make_memory(dst_md, eng);
+        std::unordered_map<int, memory> args
+                = {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}};
+        if (!mask_data.empty()) {
+            auto mask = test::make_memory(mask_md, eng);
+            fill_memory(mask, mask_data);
+            args.insert({DNNL_ARG_ATTR_SOFTMAX_MASK, mask});
+        }
+        softmax_forward(pd).execute(strm, args);
+
+        auto dst_f32 = test::make_memory(
+                memory::desc(p.dims, dt::f32, plain_tag(ndims)), eng);
+        reorder(dst, dst_f32).execute(strm, dst, dst_f32);
+        strm.wait();
+
+        check_result(src_data, mask_data, dst_f32);
+    }
+
+    void fill_memory(const memory &mem, const std::vector<float> &data) {
+        auto ptr = map_memory<float>(mem);
+        std::copy(data.begin(), data.end(), &ptr[0]);
+    }
+
+    // Returns the masked and scaled source value at logical offset `off`.
+    float pre_op_value(const std::vector<float> &src_data,
+            const std::vector<float> &mask_data, memory::dim off) const {
+        const auto ndims = p.dims.size();
+        const auto strides = plain_strides(p.dims);
+        float s = p.scale * src_data[off];
+        if (p.mask_kind == softmax_mask_kind::buffer) {
+            const auto mask_strides = plain_strides(p.mask_dims);
+            memory::dim mask_off = 0;
+            for (size_t d = 0; d < ndims; d++) {
+                const auto pos = (off / strides[d]) % p.dims[d];
+                if (p.mask_dims[d] != 1) mask_off += pos * mask_strides[d];
+            }
+            s += mask_data[mask_off];
+        } else if (p.mask_kind != softmax_mask_kind::none) {
+            const auto M = p.dims[ndims - 2], N = p.dims[ndims - 1];
+            const auto row = (off / strides[ndims - 2]) % M;
+            const auto col = off % N;
+            const auto shift
+                    = p.mask_kind == softmax_mask_kind::causal_bottom_right
+                    ? N - M
+                    : 0;
+            if (col > row + shift) s = -INFINITY;
+        }
+        return s;
+    }
+
+    void check_result(const std::vector<float> &src_data,
+            const std::vector<float> &mask_data, const memory &dst) {
+        auto dst_ptr = map_memory<float>(dst);
+        const auto strides = plain_strides(p.dims);
+        const auto axis_size = p.dims[p.axis];
+        const auto axis_stride = strides[p.axis];
+        const auto nelems = count(p.dims);
+        const bool is_int8 = p.dst_dt == dt::s8 || p.dst_dt == dt::u8;
+
+        for (memory::dim off0 = 0; off0 < nelems; off0++) {
+            // visit each softmax row once, from its first element
+            if ((off0 / axis_stride) % axis_size != 0) continue;
+
+            float max = -FLT_MAX;
+            for (memory::dim c = 0; c < axis_size; c++)
+                max = std::max(max,
+                        pre_op_value(
+                                src_data, mask_data, off0 + c * axis_stride));
+            float sum = 0.f;
+            for (memory::dim c = 0; c < axis_size; c++)
+                sum += std::exp(
+                        pre_op_value(src_data, mask_data,
+                                off0 + c * axis_stride)
+                        - max);
+
+            for (memory::dim c = 0; c < axis_size; c++) {
+                const auto off = off0 + c * axis_stride;
+                const float d
+                        = pre_op_value(src_data, mask_data, off) - max;
+                float ref = 0.f;
+                if (p.aalgorithm == algorithm::softmax_accurate)
+                    ref = sum > 0.f ? std::exp(d) / sum : 0.f;
+                else
+                    ref = d - std::log(sum);
+                if (is_int8) ref = std::nearbyint(ref);
+                const float got = dst_ptr[off];
+                ASSERT_NEAR(got, ref, is_int8 ? 1.f : 1e-5f)
+                        << "offset " << off;
+            }
+        }
+    }
+};
+
+using pp = softmax_pre_ops_test_params_t;
+
+static const auto mask_none = softmax_mask_kind::none;
+static const auto mask_buffer = softmax_mask_kind::buffer;
+static const auto causal_tl = softmax_mask_kind::causal_top_left;
+static const auto causal_br = softmax_mask_kind::causal_bottom_right;
+
+TEST_P(softmax_pre_ops_test_t, TestsSoftmaxPreOps) {}
+
+INSTANTIATE_TEST_SUITE_P(Test_Softmax_PreOps_EF, softmax_pre_ops_test_t,
+        ::testing::Values(
+                // Mask is not broadcastable to src
+                pp {alg_softmax, dt::f32, {2, 3, 8, 16}, 3, 1.f, mask_buffer,
+                        {2, 3, 8, 8}, true, dnnl_unimplemented},
+                // Causal mask is not on the softmax axis
+                pp {alg_softmax, dt::f32, {2, 3, 8, 16}, 2, 1.f, causal_tl,
+                        {}, true, dnnl_unimplemented}));
+
+INSTANTIATE_TEST_SUITE_P(Test_Softmax_PreOps, softmax_pre_ops_test_t,
+        ::testing::Values(
+                pp {alg_softmax, dt::f32, {2, 3, 8, 37}, 3, 0.125f, mask_none,
+                        {}},
+                pp {alg_softmax, dt::f32, {2, 3, 8, 37}, 3, 0.5f, mask_buffer,
+                        {2, 1, 8, 37}},
+                pp {alg_softmax, dt::f32, {2, 3, 8, 64}, 3, 1.f, mask_buffer,
+                        {1, 1, 1, 64}},
+                pp {alg_softmax, dt::f32, {4, 19, 16}, 1, 0.25f, mask_buffer,
+                        {1, 19, 16}},
+                pp {alg_softmax, dt::f32, {2, 2, 13, 13}, 3, 0.3f, causal_tl,
+                        {}},
+                pp {alg_softmax, dt::f32, {2, 2, 7, 21}, 3, 1.f, causal_br,
+                        {}},
+                // Rows above the diagonal are entirely masked
+                pp {alg_softmax, dt::f32, {2, 9, 5}, 2, 1.f, causal_br, {}},
+                pp {alg_logsoftmax, dt::f32, {2, 3, 8, 40}, 2, 0.5f,
+                        mask_buffer, {1, 3, 8, 1}},
+                pp {alg_softmax, dt::s8, {2, 4, 16, 48}, 3, 0.125f,
+                        mask_buffer, {2, 1, 16, 48}},
+                pp {alg_softmax, dt::u8, {2, 4, 9, 33}, 3, 1.f, causal_br,
+                        {}}));
+
 } // namespace dnnl
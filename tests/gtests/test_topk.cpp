@@ -0,0 +1,229 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using tag = memory::format_tag;
+using dt = memory::data_type;
+
+struct topk_test_params_t {
+    dt src_dt;
+    dt dst_dt;
+    dt indices_dt;
+    tag src_tag;
+    memory::dims dims;
+    int axis;
+    memory::dim k;
+    bool expect_to_fail;
+    dnnl_status_t expected_status;
+};
+
+class topk_test_t : public ::testing::TestWithParam<topk_test_params_t> {
+private:
+    topk_test_params_t p;
+
+protected:
+    void SetUp() override {
+        p = ::testing::TestWithParam<topk_test_params_t>::GetParam();
+
+        SKIP_IF_CUDA(true, "TopK primitive not supported by CUDA");
+        SKIP_IF(get_test_engine_kind() == engine::kind::gpu,
+                "TopK primitive not supported by GPU");
+
+        SKIP_IF(unsupported_data_type(p.src_dt, p.dst_dt),
+                "Engine does not support this data type.");
+
+        catch_expected_failures(
+                [=]() { Test(); }, p.expect_to_fail, p.expected_status);
+    }
+
+    static tag plain_tag(size_t ndims) {
+        switch (ndims) {
+            case 1: return tag::a;
+            case 2: return tag::ab;
+            case 3: return tag::abc;
+            case 4: return tag::abcd;
+            default: return tag::abcde;
+        }
+    }
+
+    void Test() {
+        using pd_t = topk::primitive_desc;
+
+        auto eng = get_test_engine();
+        auto strm = make_stream(eng);
+
+        auto aa = allows_attr_t {false};
+
+        memory::dims dst_dims = p.dims;
+        if (p.axis >= 0 && p.axis < (int)dst_dims.size())
+            dst_dims[p.axis] = p.k;
+
+        auto src_md = memory::desc(p.dims, p.src_dt, p.src_tag);
+        auto dst_md = memory::desc(dst_dims, p.dst_dt, tag::any);
+        auto indices_md = memory::desc(dst_dims, p.indices_dt, tag::any);
+
+        // default pd ctor
+        auto pd = pd_t();
+        // regular pd ctor
+        pd = pd_t(eng, src_md, dst_md, indices_md, p.axis);
+        // test all pd ctors
+        test_fwd_pd_constructors<pd_t>(
+                pd, aa, src_md, dst_md, indices_md, p.axis);
+
+        EXPECT_ANY_THROW(topk(pd, {}));
+        // default primitive ctor
+        auto topk_prim = topk();
+        // regular primitive ctor
+        topk_prim = topk(pd);
+
+        // check primitive kind is topk
+        ASSERT_TRUE(topk_prim.get_kind() == primitive::kind::topk);
+        // query for descs from pd
+        const auto src_desc = pd.src_desc();
+        const auto dst_desc = pd.dst_desc();
+        const auto indices_desc = pd.indices_desc();
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_SRC) == src_desc);
+        ASSERT_TRUE(src_md == src_desc);
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST) == dst_desc);
+        ASSERT_TRUE(pd.query_md(query::exec_arg_md, DNNL_ARG_DST_1)
+                == indices_desc);
+        ASSERT_EQ(pd.get_axis(), p.axis);
+
+        // check primitive returns zero_md for all rest md
+        ASSERT_TRUE(pd.weights_desc().is_zero());
+        ASSERT_TRUE(pd.diff_src_desc().is_zero());
+        ASSERT_TRUE(pd.diff_dst_desc().is_zero());
+        ASSERT_TRUE(pd.diff_weights_desc().is_zero());
+
+        // The values are small integers with many duplicates, exact in all
+        // the data types, to check the order of the equal values.
+        const tag ptag = plain_tag(p.dims.size());
+        auto src_f32_md = memory::desc(p.dims, dt::f32, ptag);
+        auto src_f32 = test::make_memory(src_f32_md, eng);
+        const memory::dim nelems = std::accumulate(p.dims.begin(),
+                p.dims.end(), (memory::dim)1, std::multiplies<memory::dim>());
+        std::vector<float> src_data(nelems);
+        for (memory::dim i = 0; i < nelems; ++i)
+            src_data[i] = static_cast<float>((i * 37) % 101 - 50);
+        {
+            auto ptr = map_memory<float>(src_f32);
+            std::copy(src_data.begin(), src_data.end(), &ptr[0]);
+        }
+
+        auto src = test::make_memory(src_desc, eng);
+        auto dst = test::make_memory(dst_desc, eng);
+        auto indices = test::make_memory(indices_desc, eng);
+        reorder(src_f32, src).execute(strm, src_f32, src);
+
+        topk_prim.execute(strm,
+                {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst},
+                        {DNNL_ARG_DST_1, indices}});
+
+        auto dst_f32 = test::make_memory(
+                memory::desc(dst_dims, dt::f32, ptag), eng);
+        auto indices_s32 = test::make_memory(
+                memory::desc(dst_dims, dt::s32, ptag), eng);
+        reorder(dst, dst_f32).execute(strm, dst, dst_f32);
+        reorder(indices, indices_s32).execute(strm, indices, indices_s32);
+        strm.wait();
+
+        check_result(src_data, dst_f32, indices_s32);
+    }
+
+    void check_result(const std::vector<float> &src_data, const memory &dst,
+            const memory &indices) {
+        auto dst_ptr = map_memory<float>(dst);
+        auto indices_ptr = map_memory<int32_t>(indices);
+
+        const memory::dim axis_size = p.dims[p.axis];
+        const memory::dim outer = std::accumulate(p.dims.begin(),
+                p.dims.begin() + p.axis, (memory::dim)1,
+                std::multiplies<memory::dim>());
+        const memory::dim inner = std::accumulate(p.dims.begin() + p.axis + 1,
+                p.dims.end(), (memory::dim)1, std::multiplies<memory::dim>());
+
+        std::vector<memory::dim> order(axis_size);
+        for (memory::dim ou = 0; ou < outer; ++ou)
+            for (memory::dim in = 0; in < inner; ++in) {
+                auto src_at = [&](memory::dim a) {
+                    return src_data[(ou * axis_size + a) * inner + in];
+                };
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(),
+                        [&](memory::dim a, memory::dim b) {
+                            return src_at(a) > src_at(b);
+                        });
+                for (memory::dim j = 0; j < p.k; ++j) {
+                    const memory::dim off = (ou * p.k + j) * inner + in;
+                    ASSERT_EQ(indices_ptr[off], order[j]);
+                    ASSERT_EQ(dst_ptr[off], src_at(order[j]));
+                }
+            }
+    }
+};
+
+using tp = topk_test_params_t;
+
+TEST_P(topk_test_t, TestsTopK) {}
+
+INSTANTIATE_TEST_SUITE_P(Test_TopK_EF, topk_test_t,
+        ::testing::Values(
+                // k exceeds the axis size
+                tp {dt::f32, dt::f32, dt::s32, tag::ab, {2, 8}, 1, 9, true,
+                        dnnl_invalid_arguments},
+                // Axis exceeds ndims
+                tp {dt::f32, dt::f32, dt::s32, tag::ab, {2, 8}, 2, 1, true,
+                        dnnl_invalid_arguments},
+                // Indices are not s32
+                tp {dt::f32, dt::f32, dt::f32, tag::ab, {2, 8}, 1, 2, true,
+                        dnnl_invalid_arguments},
+                // Tag for src is not specified
+                tp {dt::f32, dt::f32, dt::s32, tag::any, {2, 8}, 1, 2, true,
+                        dnnl_invalid_arguments},
+                // Different data types are not supported
+                tp {dt::f32, dt::bf16, dt::s32, tag::ab, {2, 8}, 1, 2, true,
+                        dnnl_unimplemented}));
+
+static auto all_cases = [](dt src_dt) {
+    return ::testing::Values(
+            tp {src_dt, src_dt, dt::s32, tag::ab, {2, 64}, 1, 5},
+            tp {src_dt, src_dt, dt::s32, tag::ab, {3, 1000}, 1, 1},
+            tp {src_dt, src_dt, dt::s32, tag::ab, {4, 5000}, 1, 64},
+            tp {src_dt, src_dt, dt::s32, tag::ab, {1, 100000}, 1, 10},
+            tp {src_dt, src_dt, dt::s32, tag::abc, {2, 17, 9}, 1, 4},
+            tp {src_dt, src_dt, dt::s32, tag::acb, {2, 33, 5}, 1, 7},
+            tp {src_dt, src_dt, dt::s32, tag::abcd, {2, 3, 4, 32}, 3, 32},
+            tp {src_dt, src_dt, dt::s32, tag::abcd, {6, 3, 4, 5}, 0, 2});
+};
+
+#define INST_TEST_CASE(name, suite, ...) \
+    INSTANTIATE_TEST_SUITE_P(name, topk_test_t, suite(__VA_ARGS__));
+
+INST_TEST_CASE(TopKF32, all_cases, dt::f32);
+INST_TEST_CASE(TopKBF16, all_cases, dt::bf16);
+INST_TEST_CASE(TopKF16, all_cases, dt::f16);
+
+} // namespace dnnl